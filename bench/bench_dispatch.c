@@ -0,0 +1,285 @@
+/**
+ * \file bench_dispatch.c
+ * \author Isaiah Lateer
+ * 
+ * Measures the per-frame cost of routing events to many windows. Each frame
+ * sends a few events to every window and times how long polling takes to
+ * deliver them. The same load is also routed on a plain Xlib connection,
+ * once with the per-window XCheckIfEvent() scan windows used to poll with
+ * and once with a single pass over the queue, to compare the two.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+
+#include "timer.h"
+#include "window.h"
+
+#define MAX_WINDOWS 256
+#define FRAMES 200
+#define EVENTS_PER_WINDOW 4
+#define MAX_TITLE_LENGTH 64
+#define MAX_EVENTS 64
+#define DELIVERY_TIMEOUT 1000000000
+
+typedef struct frame_times {
+    uint64_t total;
+    uint64_t max;
+} frame_times;
+
+/**
+ * Adds a frame to a set of frame times.
+ * 
+ * \param[in] times Frame times.
+ * \param[in] elapsed Frame time in nanoseconds.
+ */
+static void add_frame(frame_times* times, uint64_t elapsed) {
+    times->total += elapsed;
+    if (elapsed > times->max) {
+        times->max = elapsed;
+    }
+}
+
+/**
+ * Finds a window by title below a parent, looking through window manager
+ * frames.
+ * 
+ * \param[in] display Connection to the X server.
+ * \param[in] parent Window to search below.
+ * \param[in] title Window title.
+ * \return Window, or None if no window has the title.
+ */
+static Window find_window(Display* display, Window parent, const char* title) {
+    Window root, grandparent;
+    Window* children = NULL;
+    unsigned count = 0;
+    if (!XQueryTree(display, parent, &root, &grandparent, &children,
+        &count)) {
+        return None;
+    }
+
+    Window found = None;
+    for (unsigned i = 0; i < count && found == None; ++i) {
+        char* name = NULL;
+        if (XFetchName(display, children[i], &name) && name) {
+            if (!strcmp(name, title)) {
+                found = children[i];
+            }
+
+            XFree(name);
+        }
+
+        if (found == None) {
+            found = find_window(display, children[i], title);
+        }
+    }
+
+    if (children) {
+        XFree(children);
+    }
+
+    return found;
+}
+
+/**
+ * Sends expose events to windows and waits until the server has queued them
+ * for their clients.
+ * 
+ * \param[in] display Connection to the X server.
+ * \param[in] targets Windows.
+ * \param[in] count Number of windows.
+ */
+static void send_events(Display* display, const Window* targets, int count) {
+    for (int i = 0; i < count; ++i) {
+        XEvent event;
+        memset(&event, 0, sizeof(event));
+        event.xexpose.type = Expose;
+        event.xexpose.window = targets[i];
+        event.xexpose.width = 1;
+        event.xexpose.height = 1;
+
+        for (int j = 0; j < EVENTS_PER_WINDOW; ++j) {
+            event.xexpose.x = j;
+            XSendEvent(display, targets[i], False, ExposureMask, &event);
+        }
+    }
+
+    XSync(display, False);
+}
+
+/**
+ * Matches the events of one window, as windows used to poll with.
+ * 
+ * \param[in] display Connection to the X server.
+ * \param[in] event Event.
+ * \param[in] argument Window.
+ * \return Whether the event belongs to the window.
+ */
+static Bool is_window_event(Display* display, XEvent* event,
+    XPointer argument) {
+    return event->xany.window == *(const Window*) argument;
+}
+
+/**
+ * Routes events to windows created through the library.
+ * 
+ * \param[in] sender Connection to send events from.
+ * \param[in] count Number of windows.
+ * \param[out] times Frame times.
+ * \return Whether every window was created and found.
+ */
+static bool route_window_events(Display* sender, int count,
+    frame_times* times) {
+    static window* windows[MAX_WINDOWS];
+    static Window targets[MAX_WINDOWS];
+
+    bool found = true;
+    int created = 0;
+    for (; created < count && found; ++created) {
+        char title[MAX_TITLE_LENGTH];
+        snprintf(title, sizeof(title), "Dispatch Benchmark %d", created);
+
+        windows[created] = create_window(title, 64, 64);
+        if (!windows[created]) {
+            found = false;
+            break;
+        }
+
+        poll_events(windows[created]);
+
+        targets[created] =
+            find_window(sender, DefaultRootWindow(sender), title);
+        found = targets[created] != None;
+    }
+
+    for (int frame = 0; found && frame < FRAMES; ++frame) {
+        send_events(sender, targets, count);
+
+        const int expected = count * EVENTS_PER_WINDOW;
+        int received = 0;
+
+        const uint64_t start = get_time();
+        while (received < expected
+            && get_time() - start < DELIVERY_TIMEOUT) {
+            for (int i = 0; i < count; ++i) {
+                poll_events(windows[i]);
+
+                window_event events[MAX_EVENTS];
+                received +=
+                    (int) get_window_events(windows[i], events, MAX_EVENTS);
+            }
+        }
+
+        add_frame(times, get_time() - start);
+    }
+
+    for (int i = 0; i < created; ++i) {
+        destroy_window(windows[i]);
+    }
+
+    if (!found) {
+        fprintf(stderr, "[ERROR] Failed to find benchmark windows.\n");
+    }
+
+    return found;
+}
+
+/**
+ * Routes events on a plain Xlib connection, with the old per-window scan and
+ * with a single pass over the queue.
+ * 
+ * \param[in] display Connection to the X server.
+ * \param[in] count Number of windows.
+ * \param[out] scan Frame times of the per-window scan.
+ * \param[out] single Frame times of the single pass.
+ */
+static void route_xlib_events(Display* display, int count, frame_times* scan,
+    frame_times* single) {
+    static Window targets[MAX_WINDOWS];
+    static int indices[MAX_WINDOWS];
+
+    const XContext context = XUniqueContext();
+
+    for (int i = 0; i < count; ++i) {
+        targets[i] = XCreateSimpleWindow(display, DefaultRootWindow(display),
+            0, 0, 64, 64, 0, 0, 0);
+        XSelectInput(display, targets[i], ExposureMask);
+
+        indices[i] = i;
+        XSaveContext(display, targets[i], context, (XPointer) &indices[i]);
+    }
+
+    for (int frame = 0; frame < FRAMES; ++frame) {
+        send_events(display, targets, count);
+
+        uint64_t start = get_time();
+        for (int i = 0; i < count; ++i) {
+            XEvent event;
+            while (XCheckIfEvent(display, &event, is_window_event,
+                (XPointer) &targets[i])) {
+            }
+        }
+
+        add_frame(scan, get_time() - start);
+
+        send_events(display, targets, count);
+
+        start = get_time();
+        while (XPending(display)) {
+            XEvent event;
+            XNextEvent(display, &event);
+
+            XPointer index = NULL;
+            XFindContext(display, event.xany.window, context, &index);
+        }
+
+        add_frame(single, get_time() - start);
+    }
+
+    for (int i = 0; i < count; ++i) {
+        XDeleteContext(display, targets[i], context);
+        XDestroyWindow(display, targets[i]);
+    }
+
+    XSync(display, False);
+}
+
+/**
+ * Entry point for the benchmark.
+ * 
+ * \return Exit code.
+ */
+int main() {
+    Display* display = XOpenDisplay(NULL);
+    if (!display) {
+        fprintf(stderr, "[ERROR] Failed to open display.\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("%-8s %12s %12s %12s %12s\n", "windows", "poll (us)",
+        "poll max", "scan (us)", "single (us)");
+
+    for (int count = 1; count <= MAX_WINDOWS; count *= 2) {
+        frame_times windows = { 0, 0 };
+        if (!route_window_events(display, count, &windows)) {
+            XCloseDisplay(display);
+            return EXIT_FAILURE;
+        }
+
+        frame_times scan = { 0, 0 };
+        frame_times single = { 0, 0 };
+        route_xlib_events(display, count, &scan, &single);
+
+        printf("%-8d %12.1f %12.1f %12.1f %12.1f\n", count,
+            windows.total / 1e3 / FRAMES, windows.max / 1e3,
+            scan.total / 1e3 / FRAMES, single.total / 1e3 / FRAMES);
+    }
+
+    XCloseDisplay(display);
+
+    return EXIT_SUCCESS;
+}
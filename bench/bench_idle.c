@@ -0,0 +1,129 @@
+/**
+ * \file bench_idle.c
+ * \author Isaiah Lateer
+ * 
+ * Measures idle CPU usage and wake-up latency of wait_events() against a
+ * poll_events() busy loop.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "timer.h"
+#include "window.h"
+
+#define DURATION 2000000000
+#define WAKE_PERIOD 100000000
+
+typedef struct waker {
+    window* window;
+    atomic_bool stop;
+    _Atomic uint64_t wake_time;
+} waker;
+
+/**
+ * Gets the CPU time used by the process.
+ * 
+ * \return Time in nanoseconds.
+ */
+static uint64_t get_cpu_time(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+
+    return (uint64_t) now.tv_sec * 1000000000 + (uint64_t) now.tv_nsec;
+}
+
+/**
+ * Wakes the window periodically.
+ * 
+ * \param[in] arg Waker.
+ * \return Unused.
+ */
+static void* wake_loop(void* arg) {
+    waker* waker = arg;
+
+    uint64_t deadline = get_time();
+    while (!atomic_load(&waker->stop)) {
+        deadline += WAKE_PERIOD;
+        sleep_until(deadline);
+
+        atomic_store(&waker->wake_time, get_time());
+        wake_window(waker->window);
+    }
+
+    return NULL;
+}
+
+/**
+ * Entry point for the benchmark.
+ * 
+ * \return Exit code.
+ */
+int main() {
+    window* window = create_window("Idle Benchmark", 400, 300);
+    if (!window) {
+        return EXIT_FAILURE;
+    }
+
+    set_swap_interval(window, 0);
+
+    uint64_t frames = 0;
+    uint64_t cpu_start = get_cpu_time();
+    uint64_t start = get_time();
+    while (get_time() - start < DURATION) {
+        poll_events(window);
+        swap_buffer(window);
+        ++frames;
+    }
+
+    const uint64_t busy_cpu = get_cpu_time() - cpu_start;
+    const uint64_t busy_wall = get_time() - start;
+
+    waker waker = { window, false, 0 };
+
+    pthread_t thread;
+    pthread_create(&thread, NULL, wake_loop, &waker);
+
+    uint64_t wakes = 0;
+    uint64_t total_latency = 0;
+    uint64_t max_latency = 0;
+
+    cpu_start = get_cpu_time();
+    start = get_time();
+    while (get_time() - start < DURATION) {
+        wait_events(window, -1);
+
+        const uint64_t wake_time = atomic_load(&waker.wake_time);
+        const uint64_t latency = get_time() - wake_time;
+        if (wake_time) {
+            total_latency += latency;
+            if (latency > max_latency) {
+                max_latency = latency;
+            }
+
+            ++wakes;
+        }
+    }
+
+    const uint64_t idle_cpu = get_cpu_time() - cpu_start;
+    const uint64_t idle_wall = get_time() - start;
+
+    atomic_store(&waker.stop, true);
+    pthread_join(thread, NULL);
+
+    destroy_window(window);
+
+    printf("busy loop: %llu frames, %.1f%% CPU\n", (unsigned long long) frames,
+        100.0 * busy_cpu / busy_wall);
+    printf("wait_events: %llu wakes, %.1f%% CPU, latency mean %.1f us, "
+        "max %.1f us\n", (unsigned long long) wakes,
+        100.0 * idle_cpu / idle_wall,
+        wakes ? total_latency / 1e3 / wakes : 0.0, max_latency / 1e3);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,99 @@
+/**
+ * \file bench_loader.c
+ * \author Isaiah Lateer
+ * 
+ * Measures how long the OpenGL loader takes to build dispatch tables in bulk
+ * and lazily, and the cost of calling through a table against calling the
+ * exported function directly, on a headless window.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "gl_loader.h"
+#include "timer.h"
+#include "window.h"
+
+#define DEFAULT_CALLS 10000000
+#define TABLES 100
+
+/**
+ * Entry point for the benchmark.
+ * 
+ * \param[in] argc Argument count.
+ * \param[in] argv Arguments. The first is the number of calls to time.
+ * \return Exit code.
+ */
+int main(int argc, char** argv) {
+    const int calls = argc > 1 ? atoi(argv[1]) : DEFAULT_CALLS;
+    if (calls <= 0) {
+        fprintf(stderr, "[ERROR] Invalid call count.\n");
+        return EXIT_FAILURE;
+    }
+
+    const window_settings settings = {
+        .title = "Loader Benchmark",
+        .width = 64,
+        .height = 64,
+        .backend = WINDOW_BACKEND_HEADLESS
+    };
+
+    window* window = create_window_with_settings(&settings);
+    if (!window) {
+        return EXIT_FAILURE;
+    }
+
+    make_current(window);
+
+    uint64_t bulk_time = 0;
+    uint64_t lazy_time = 0;
+    size_t resolved = 0;
+    size_t missing = 0;
+
+    for (int i = 0; i < TABLES; ++i) {
+        gl_dispatch* bulk = create_gl_dispatch(window, GL_LOADING_BULK);
+        bulk_time += bulk->load_time;
+        resolved = bulk->resolved;
+        missing = bulk->missing;
+        destroy_gl_dispatch(bulk);
+
+        gl_dispatch* lazy = create_gl_dispatch(window, GL_LOADING_LAZY);
+        lazy_time += lazy->load_time;
+        destroy_gl_dispatch(lazy);
+    }
+
+    gl_dispatch* gl = create_gl_dispatch(window, GL_LOADING_LAZY);
+    set_current_gl_dispatch(gl);
+
+    uint64_t start = get_time();
+    gl->glGetError();
+    const uint64_t first_call = get_time() - start;
+
+    GLenum errors = 0;
+
+    start = get_time();
+    for (int i = 0; i < calls; ++i) {
+        errors |= glGetError();
+    }
+    const uint64_t direct = get_time() - start;
+
+    start = get_time();
+    for (int i = 0; i < calls; ++i) {
+        errors |= gl->glGetError();
+    }
+    const uint64_t dispatched = get_time() - start;
+
+    set_current_gl_dispatch(NULL);
+    destroy_gl_dispatch(gl);
+    destroy_window(window);
+
+    printf("%-28s %12zu\n", "functions resolved", resolved);
+    printf("%-28s %12zu\n", "functions missing", missing);
+    printf("%-28s %12.3f ms\n", "bulk load", bulk_time / 1e6 / TABLES);
+    printf("%-28s %12.3f ms\n", "lazy load", lazy_time / 1e6 / TABLES);
+    printf("%-28s %12.3f us\n", "lazy first call", first_call / 1e3);
+    printf("%-28s %12.3f ns\n", "direct call", (double) direct / calls);
+    printf("%-28s %12.3f ns\n", "dispatched call", (double) dispatched / calls);
+
+    return errors ? EXIT_FAILURE : EXIT_SUCCESS;
+}
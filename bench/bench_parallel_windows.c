@@ -0,0 +1,144 @@
+/**
+ * \file bench_parallel_windows.c
+ * \author Isaiah Lateer
+ * 
+ * Creates a batch of windows on one thread and then spread across several
+ * threads, and reports how long each batch took.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "thread.h"
+#include "timer.h"
+#include "window.h"
+
+#define DEFAULT_WINDOWS 64
+#define DEFAULT_THREADS 8
+
+typedef struct worker {
+    window** windows;
+    int count;
+} worker;
+
+/**
+ * Creates a worker's share of the windows and releases each context so the
+ * main thread can destroy them.
+ * 
+ * \param[in] data Worker.
+ */
+static void create_windows(void* data) {
+    worker* worker = data;
+
+    for (int i = 0; i < worker->count; ++i) {
+        worker->windows[i] =
+            create_window("Parallel Window Benchmark", 64, 64);
+        if (worker->windows[i]) {
+            release_current(worker->windows[i]);
+        }
+    }
+}
+
+/**
+ * Destroys a batch of windows.
+ * 
+ * \param[in] windows Windows.
+ * \param[in] count Number of windows.
+ * \return Whether every window had been created.
+ */
+static bool destroy_windows(window** windows, int count) {
+    bool created = true;
+
+    for (int i = 0; i < count; ++i) {
+        if (windows[i]) {
+            destroy_window(windows[i]);
+        } else {
+            created = false;
+        }
+    }
+
+    return created;
+}
+
+/**
+ * Entry point for the benchmark.
+ * 
+ * \param[in] argc Argument count.
+ * \param[in] argv Arguments. The first is the number of windows and the
+ * second the number of threads.
+ * \return Exit code.
+ */
+int main(int argc, char** argv) {
+    const int windows = argc > 1 ? atoi(argv[1]) : DEFAULT_WINDOWS;
+    const int threads = argc > 2 ? atoi(argv[2]) : DEFAULT_THREADS;
+    if (windows <= 0 || threads <= 0) {
+        fprintf(stderr, "[ERROR] Invalid window or thread count.\n");
+        return EXIT_FAILURE;
+    }
+
+    // Keeps the display open between batches so both measure window
+    // creation rather than connecting to the server.
+    window* anchor = create_window("Parallel Window Benchmark", 64, 64);
+    if (!anchor) {
+        return EXIT_FAILURE;
+    }
+
+    release_current(anchor);
+
+    window** created = malloc(windows * sizeof(window*));
+
+    worker serial = { created, windows };
+
+    uint64_t start = get_time();
+    create_windows(&serial);
+    const uint64_t serial_elapsed = get_time() - start;
+
+    bool result = destroy_windows(created, windows);
+
+    worker* workers = malloc(threads * sizeof(worker));
+    thread** handles = malloc(threads * sizeof(thread*));
+
+    start = get_time();
+
+    int first = 0;
+    for (int i = 0; i < threads; ++i) {
+        const int count = windows / threads + (i < windows % threads);
+
+        workers[i].windows = created + first;
+        workers[i].count = count;
+        handles[i] = create_thread(create_windows, &workers[i]);
+
+        // A worker that cannot be started has its share created here, so
+        // every window still exists when the run is timed.
+        if (!handles[i]) {
+            create_windows(&workers[i]);
+        }
+
+        first += count;
+    }
+
+    for (int i = 0; i < threads; ++i) {
+        if (handles[i]) {
+            join_thread(handles[i]);
+        }
+    }
+
+    const uint64_t parallel_elapsed = get_time() - start;
+
+    result = destroy_windows(created, windows) && result;
+
+    free(handles);
+    free(workers);
+    free(created);
+
+    destroy_window(anchor);
+
+    printf("%-10s %8s %8s %12s %12s\n", "method", "windows", "threads",
+        "total (ms)", "windows/s");
+    printf("%-10s %8d %8d %12.2f %12.1f\n", "serial", windows, 1,
+        serial_elapsed / 1e6, windows / (serial_elapsed / 1e9));
+    printf("%-10s %8d %8d %12.2f %12.1f\n", "parallel", windows, threads,
+        parallel_elapsed / 1e6, windows / (parallel_elapsed / 1e9));
+
+    return result ? EXIT_SUCCESS : EXIT_FAILURE;
+}
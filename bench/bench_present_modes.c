@@ -0,0 +1,137 @@
+/**
+ * \file bench_present_modes.c
+ * \author Isaiah Lateer
+ * 
+ * Presents the same frames with buffer swaps and with each X Present mode,
+ * and reports the frame rate and how long presents took to reach the screen.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "opengl.h"
+#include "timer.h"
+#include "window.h"
+
+#define DEFAULT_FRAMES 300
+#define WIDTH 640
+#define HEIGHT 480
+
+typedef struct mode_result {
+    double frames_per_second;
+    double latency;
+} mode_result;
+
+static const char* mode_names[] = {
+    "swap",
+    "fifo",
+    "mailbox",
+    "immediate"
+};
+
+/**
+ * Presents frames in one present mode.
+ * 
+ * \param[in] mode Present mode.
+ * \param[in] frames Number of frames.
+ * \param[out] result Frame rate, and mean latency in milliseconds or a
+ * negative value if the window reports no present timing.
+ * \return Whether the window was created.
+ */
+static bool present_frames(present_mode mode, int frames,
+    mode_result* result) {
+    const window_settings settings = {
+        .title = "Present Mode Benchmark",
+        .width = WIDTH,
+        .height = HEIGHT,
+        .present_mode = mode
+    };
+
+    window* window = create_window_with_settings(&settings);
+    if (!window) {
+        return false;
+    }
+
+    // FIFO is the only mode that should wait for the vertical blank.
+    set_swap_interval(window, mode == PRESENT_MODE_FIFO);
+
+    uint64_t* submitted = malloc((frames + 1) * sizeof(uint64_t));
+    uint64_t latency = 0;
+    uint64_t latency_count = 0;
+    uint64_t last_sbc = 0;
+
+    const uint64_t start = get_time();
+
+    for (int i = 0; i < frames; ++i) {
+        poll_events(window);
+
+        glClearColor((float) (i % 60) / 60.0f, 0.2f, 0.4f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        submitted[i + 1] = get_time();
+        swap_buffer(window);
+
+        present_timing timing;
+        if (get_present_timing_source(window) != PRESENT_TIMING_SOFTWARE
+            && get_present_timing(window, &timing) && timing.sbc > last_sbc
+            && timing.sbc <= (uint64_t) frames) {
+            last_sbc = timing.sbc;
+
+            if (timing.time > submitted[timing.sbc]) {
+                latency += timing.time - submitted[timing.sbc];
+                ++latency_count;
+            }
+        }
+    }
+
+    glFinish();
+
+    const uint64_t elapsed = get_time() - start;
+
+    destroy_window(window);
+    free(submitted);
+
+    result->frames_per_second = frames / (elapsed / 1e9);
+    result->latency = latency_count ? latency / 1e6 / latency_count : -1.0;
+
+    return true;
+}
+
+/**
+ * Entry point for the benchmark.
+ * 
+ * \param[in] argc Argument count.
+ * \param[in] argv Arguments. The first is the number of frames per mode.
+ * \return Exit code.
+ */
+int main(int argc, char** argv) {
+    const int frames = argc > 1 ? atoi(argv[1]) : DEFAULT_FRAMES;
+    if (frames <= 0) {
+        fprintf(stderr, "[ERROR] Invalid frame count.\n");
+        return EXIT_FAILURE;
+    }
+
+    mode_result results[PRESENT_MODE_IMMEDIATE + 1];
+    for (int mode = PRESENT_MODE_SWAP; mode <= PRESENT_MODE_IMMEDIATE;
+        ++mode) {
+        if (!present_frames((present_mode) mode, frames, &results[mode])) {
+            return EXIT_FAILURE;
+        }
+    }
+
+    printf("%-10s %8s %12s %14s\n", "mode", "frames", "frames/s",
+        "latency (ms)");
+
+    for (int mode = PRESENT_MODE_SWAP; mode <= PRESENT_MODE_IMMEDIATE;
+        ++mode) {
+        if (results[mode].latency >= 0.0) {
+            printf("%-10s %8d %12.1f %14.3f\n", mode_names[mode], frames,
+                results[mode].frames_per_second, results[mode].latency);
+        } else {
+            printf("%-10s %8d %12.1f %14s\n", mode_names[mode], frames,
+                results[mode].frames_per_second, "-");
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
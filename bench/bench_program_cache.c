@@ -0,0 +1,171 @@
+/**
+ * \file bench_program_cache.c
+ * \author Isaiah Lateer
+ *
+ * Builds a set of programs on a headless window twice, first against an empty
+ * program cache and then against the cache the first pass saved, and reports
+ * the cold and warm startup times.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "opengl.h"
+#include "program_cache.h"
+#include "timer.h"
+#include "window.h"
+
+#define DEFAULT_PROGRAMS 64
+#define CACHE_PATH "bench_program_cache.tmp"
+#define MAX_SOURCE_LENGTH 2048
+
+static const char* vertex_source =
+    "#version 330 core\n"
+    "layout(location = 0) in vec2 position;\n"
+    "out vec2 uv;\n"
+    "void main() {\n"
+    "    uv = position * 0.5 + 0.5;\n"
+    "    gl_Position = vec4(position, 0.0, 1.0);\n"
+    "}\n";
+
+/**
+ * Writes a fragment shader that differs per program and per run, so neither
+ * this cache nor the driver's own shader cache has seen it before the cold
+ * pass.
+ *
+ * \param[out] source Source buffer of MAX_SOURCE_LENGTH bytes.
+ * \param[in] run Value unique to this run.
+ * \param[in] index Program index.
+ */
+static void write_fragment_source(char* source, uint64_t run, int index) {
+    snprintf(source, MAX_SOURCE_LENGTH,
+        "#version 330 core\n"
+        "in vec2 uv;\n"
+        "out vec4 color;\n"
+        "uniform sampler2D image;\n"
+        "const float seed = %llu.0;\n"
+        "void main() {\n"
+        "    vec4 sum = vec4(0.0);\n"
+        "    for (int i = 0; i < %d; ++i) {\n"
+        "        vec2 offset = vec2(cos(float(i) + seed), sin(float(i)));\n"
+        "        sum += texture(image, uv + offset * 0.01) * exp(-float(i));\n"
+        "    }\n"
+        "    color = pow(sum, vec4(1.0 / 2.2)) + vec4(%d.0 / 255.0);\n"
+        "}\n",
+        (unsigned long long) (run % 1000000), 8 + index % 8, index);
+}
+
+/**
+ * Builds every program through a program cache opened on the benchmark's
+ * cache file.
+ *
+ * \param[in] window Window.
+ * \param[in] run Value unique to this run.
+ * \param[in] programs Number of programs.
+ * \param[out] statistics Cache statistics.
+ * \param[out] save_time Time taken to save the cache.
+ * \return Time taken to open the cache and build the programs.
+ */
+static uint64_t build_programs(window* window, uint64_t run, int programs,
+    program_cache_statistics* statistics, uint64_t* save_time) {
+    PFNGLDELETEPROGRAMPROC glDeleteProgram = (PFNGLDELETEPROGRAMPROC)
+        get_procedure_address(window, "glDeleteProgram");
+
+    GLuint* names = malloc(programs * sizeof(GLuint));
+
+    const uint64_t start = get_time();
+
+    program_cache* cache = create_program_cache(window, CACHE_PATH);
+
+    for (int i = 0; i < programs; ++i) {
+        char fragment_source[MAX_SOURCE_LENGTH];
+        write_fragment_source(fragment_source, run, i);
+
+        const shader_source shaders[] = {
+            { GL_VERTEX_SHADER, vertex_source },
+            { GL_FRAGMENT_SHADER, fragment_source }
+        };
+
+        names[i] = get_cached_program(cache, shaders, 2);
+    }
+
+    glFinish();
+
+    const uint64_t elapsed = get_time() - start;
+
+    *statistics = get_program_cache_statistics(cache);
+
+    const uint64_t save_start = get_time();
+    destroy_program_cache(cache);
+    *save_time = get_time() - save_start;
+
+    for (int i = 0; i < programs; ++i) {
+        glDeleteProgram(names[i]);
+    }
+
+    free(names);
+
+    return elapsed;
+}
+
+/**
+ * Entry point for the benchmark.
+ *
+ * \param[in] argc Argument count.
+ * \param[in] argv Arguments. The first is the number of programs.
+ * \return Exit code.
+ */
+int main(int argc, char** argv) {
+    const int programs = argc > 1 ? atoi(argv[1]) : DEFAULT_PROGRAMS;
+    if (programs <= 0) {
+        fprintf(stderr, "[ERROR] Invalid program count.\n");
+        return EXIT_FAILURE;
+    }
+
+    const window_settings settings = {
+        .title = "Program Cache Benchmark",
+        .width = 64,
+        .height = 64,
+        .backend = WINDOW_BACKEND_HEADLESS
+    };
+
+    window* window = create_window_with_settings(&settings);
+    if (!window) {
+        return EXIT_FAILURE;
+    }
+
+    const uint64_t run = get_time();
+    remove(CACHE_PATH);
+
+    program_cache_statistics cold, warm;
+    uint64_t cold_save, warm_save;
+    const uint64_t cold_time =
+        build_programs(window, run, programs, &cold, &cold_save);
+    const uint64_t warm_time =
+        build_programs(window, run, programs, &warm, &warm_save);
+
+    destroy_window(window);
+
+    FILE* file = fopen(CACHE_PATH, "rb");
+    long size = 0;
+    if (file) {
+        fseek(file, 0, SEEK_END);
+        size = ftell(file);
+        fclose(file);
+    }
+
+    remove(CACHE_PATH);
+
+    printf("%-8s %10s %10s %10s %12s %12s\n", "pass", "hits", "misses",
+        "rejected", "build (ms)", "save (ms)");
+    printf("%-8s %10llu %10llu %10llu %12.2f %12.2f\n", "cold",
+        (unsigned long long) cold.hits, (unsigned long long) cold.misses,
+        (unsigned long long) cold.rejected, cold_time / 1e6, cold_save / 1e6);
+    printf("%-8s %10llu %10llu %10llu %12.2f %12.2f\n", "warm",
+        (unsigned long long) warm.hits, (unsigned long long) warm.misses,
+        (unsigned long long) warm.rejected, warm_time / 1e6, warm_save / 1e6);
+    printf("%d programs, %ld byte cache, %.1fx faster warm\n", programs, size,
+        (double) cold_time / warm_time);
+
+    return warm.hits == (uint64_t) programs ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,151 @@
+/**
+ * \file bench_readback.c
+ * \author Isaiah Lateer
+ * 
+ * Renders and captures frames on a headless window, once with synchronous
+ * reads and once through the readback ring, and reports the throughput of
+ * each.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "opengl.h"
+#include "timer.h"
+#include "window.h"
+
+#define DEFAULT_FRAMES 300
+#define WIDTH 1920
+#define HEIGHT 1080
+#define DEPTH 3
+
+typedef struct consumer {
+    uint64_t frames;
+    uint64_t checksum;
+} consumer;
+
+/**
+ * Touches one pixel per row so the mapped frame is actually read.
+ * 
+ * \param[in] pixels Mapped pixel data.
+ * \param[in] width Frame width.
+ * \param[in] height Frame height.
+ * \param[in] frame Index of the captured frame.
+ * \param[in] user_data Consumer.
+ */
+static void consume_frame(const void* pixels, unsigned width, unsigned height,
+    uint64_t frame, void* user_data) {
+    consumer* consumer = user_data;
+    const unsigned char* bytes = pixels;
+
+    for (unsigned y = 0; y < height; ++y) {
+        consumer->checksum += bytes[(size_t) y * width * 4];
+    }
+
+    ++consumer->frames;
+}
+
+/**
+ * Clears the framebuffer to a colour that changes every frame.
+ * 
+ * \param[in] frame Frame index.
+ */
+static void render_frame(int frame) {
+    glClearColor((frame & 0xFF) / 255.0f, 0.5f, 0.25f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+}
+
+/**
+ * Prints a throughput line.
+ * 
+ * \param[in] name Capture method.
+ * \param[in] frames Frames captured.
+ * \param[in] elapsed Elapsed time in nanoseconds.
+ */
+static void print_result(const char* name, int frames, uint64_t elapsed) {
+    const double seconds = elapsed / 1e9;
+    const double bytes = (double) frames * WIDTH * HEIGHT * 4;
+
+    printf("%-12s %8d %12.1f %12.1f\n", name, frames, frames / seconds,
+        bytes / seconds / (1024.0 * 1024.0));
+}
+
+/**
+ * Entry point for the benchmark.
+ * 
+ * \param[in] argc Argument count.
+ * \param[in] argv Arguments. The first is the number of frames.
+ * \return Exit code.
+ */
+int main(int argc, char** argv) {
+    const int frames = argc > 1 ? atoi(argv[1]) : DEFAULT_FRAMES;
+    if (frames <= 0) {
+        fprintf(stderr, "[ERROR] Invalid frame count.\n");
+        return EXIT_FAILURE;
+    }
+
+    window_settings settings = {
+        .title = "Readback Benchmark",
+        .width = WIDTH,
+        .height = HEIGHT,
+        .backend = WINDOW_BACKEND_HEADLESS
+    };
+
+    window* window = create_window_with_settings(&settings);
+    if (!window) {
+        return EXIT_FAILURE;
+    }
+
+    make_current(window);
+
+    unsigned char* pixels = malloc((size_t) WIDTH * HEIGHT * 4);
+    consumer sync_consumer = { 0 };
+
+    uint64_t start = get_time();
+
+    for (int i = 0; i < frames; ++i) {
+        render_frame(i);
+        glReadPixels(0, 0, WIDTH, HEIGHT, GL_BGRA, GL_UNSIGNED_BYTE, pixels);
+        consume_frame(pixels, WIDTH, HEIGHT, i, &sync_consumer);
+        swap_buffer(window);
+    }
+
+    const uint64_t sync_elapsed = get_time() - start;
+
+    free(pixels);
+
+    consumer ring_consumer = { 0 };
+
+    readback* readback = create_readback(window, WIDTH, HEIGHT, DEPTH,
+        consume_frame, &ring_consumer);
+    if (!readback) {
+        destroy_window(window);
+        return EXIT_FAILURE;
+    }
+
+    start = get_time();
+
+    for (int i = 0; i < frames; ++i) {
+        render_frame(i);
+        capture_frame(readback);
+        swap_buffer(window);
+    }
+
+    destroy_readback(readback);
+
+    const uint64_t ring_elapsed = get_time() - start;
+
+    destroy_window(window);
+
+    if (ring_consumer.frames != (uint64_t) frames
+        || ring_consumer.checksum != sync_consumer.checksum) {
+        fprintf(stderr, "[ERROR] Readback ring delivered wrong frames.\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("%-12s %8s %12s %12s\n", "method", "frames", "frames/s", "MB/s");
+    print_result("synchronous", frames, sync_elapsed);
+    print_result("ring", frames, ring_elapsed);
+
+    return EXIT_SUCCESS;
+}
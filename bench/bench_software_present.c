@@ -0,0 +1,140 @@
+/**
+ * \file bench_software_present.c
+ * \author Isaiah Lateer
+ * 
+ * Draws and presents frames on a software window, once asking for MIT-SHM and
+ * once for XPutImage, and reports the throughput of each along with the
+ * method the window actually used.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "timer.h"
+#include "window.h"
+
+#define DEFAULT_FRAMES 300
+#define WIDTH 1280
+#define HEIGHT 720
+
+/**
+ * Fills a framebuffer with a pattern that moves every frame.
+ * 
+ * \param[in] framebuffer Framebuffer.
+ * \param[in] frame Frame index.
+ */
+static void draw_frame(const software_framebuffer* framebuffer, int frame) {
+    for (unsigned y = 0; y < framebuffer->height; ++y) {
+        uint32_t* row = (uint32_t*) ((char*) framebuffer->pixels
+            + y * framebuffer->stride);
+
+        for (unsigned x = 0; x < framebuffer->width; ++x) {
+            row[x] = 0xFF000000 | ((x + frame) & 0xFF) << 16
+                | ((y + frame) & 0xFF) << 8 | (frame & 0xFF);
+        }
+    }
+}
+
+/**
+ * Presents frames on a new software window.
+ * 
+ * \param[in] frames Number of frames.
+ * \param[out] elapsed Elapsed time in nanoseconds.
+ * \param[out] shared Whether the window presented through MIT-SHM.
+ * \return Whether every frame was presented.
+ */
+static bool present_frames(int frames, uint64_t* elapsed, bool* shared) {
+    const window_settings settings = {
+        .title = "Software Present Benchmark",
+        .width = WIDTH,
+        .height = HEIGHT,
+        .backend = WINDOW_BACKEND_SOFTWARE
+    };
+
+    window* window = create_window_with_settings(&settings);
+    if (!window) {
+        return false;
+    }
+
+    const uint64_t start = get_time();
+
+    for (int i = 0; i < frames; ++i) {
+        poll_events(window);
+
+        software_framebuffer framebuffer;
+        if (!map_software_framebuffer(window, &framebuffer)) {
+            destroy_window(window);
+            return false;
+        }
+
+        draw_frame(&framebuffer, i);
+        swap_buffer(window);
+
+        *shared = framebuffer.shared;
+    }
+
+    // The last frames may still be queued in the socket buffer, so the clock
+    // stops only once the server has processed them.
+    finish_software_presents(window);
+
+    *elapsed = get_time() - start;
+
+    destroy_window(window);
+
+    return true;
+}
+
+/**
+ * Prints a throughput line.
+ * 
+ * \param[in] name Present method.
+ * \param[in] frames Frames presented.
+ * \param[in] elapsed Elapsed time in nanoseconds.
+ */
+static void print_result(const char* name, int frames, uint64_t elapsed) {
+    const double seconds = elapsed / 1e9;
+    const double bytes = (double) frames * WIDTH * HEIGHT * 4;
+
+    printf("%-12s %8d %12.1f %12.1f\n", name, frames, frames / seconds,
+        bytes / seconds / (1024.0 * 1024.0));
+}
+
+/**
+ * Entry point for the benchmark.
+ * 
+ * \param[in] argc Argument count.
+ * \param[in] argv Arguments. The first is the number of frames.
+ * \return Exit code.
+ */
+int main(int argc, char** argv) {
+    const int frames = argc > 1 ? atoi(argv[1]) : DEFAULT_FRAMES;
+    if (frames <= 0) {
+        fprintf(stderr, "[ERROR] Invalid frame count.\n");
+        return EXIT_FAILURE;
+    }
+
+    uint64_t shm_elapsed, put_elapsed;
+    bool shm_shared, put_shared;
+
+    setenv("OPENGL_CONTEXT_SHM", "1", 1);
+    if (!present_frames(frames, &shm_elapsed, &shm_shared)) {
+        return EXIT_FAILURE;
+    }
+
+    if (!shm_shared) {
+        printf("[INFO] MIT-SHM was unavailable; both runs used XPutImage.\n");
+    }
+
+    setenv("OPENGL_CONTEXT_SHM", "0", 1);
+    if (!present_frames(frames, &put_elapsed, &put_shared)) {
+        return EXIT_FAILURE;
+    }
+
+    printf("%-12s %8s %12s %12s\n", "method", "frames", "frames/s", "MB/s");
+    print_result(shm_shared ? "MIT-SHM" : "XPutImage", frames, shm_elapsed);
+    print_result(put_shared ? "MIT-SHM" : "XPutImage", frames, put_elapsed);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,113 @@
+/**
+ * \file bench_startup.c
+ * \author Isaiah Lateer
+ * 
+ * Creates and destroys windows repeatedly and reports the 50th and 99th
+ * percentile time of each traced startup stage.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "trace.h"
+#include "window.h"
+
+#define DEFAULT_ITERATIONS 100
+#define MAX_STAGES 64
+
+typedef struct stage {
+    const char* name;
+    uint64_t* samples;
+    size_t count;
+} stage;
+
+/**
+ * Compares two samples.
+ * 
+ * \param[in] a First sample.
+ * \param[in] b Second sample.
+ * \return Comparison result.
+ */
+static int compare_samples(const void* a, const void* b) {
+    const uint64_t x = *(const uint64_t*) a;
+    const uint64_t y = *(const uint64_t*) b;
+
+    return (x > y) - (x < y);
+}
+
+/**
+ * Entry point for the benchmark.
+ * 
+ * \param[in] argc Argument count.
+ * \param[in] argv Arguments. The first is the number of iterations.
+ * \return Exit code.
+ */
+int main(int argc, char** argv) {
+    const int iterations = argc > 1 ? atoi(argv[1]) : DEFAULT_ITERATIONS;
+    if (iterations <= 0) {
+        fprintf(stderr, "[ERROR] Invalid iteration count.\n");
+        return EXIT_FAILURE;
+    }
+
+    stage stages[MAX_STAGES];
+    int stage_count = 0;
+
+    set_tracing(true);
+
+    for (int i = 0; i < iterations; ++i) {
+        clear_trace_events();
+
+        window* window = create_window("Startup Benchmark", 400, 300);
+        if (!window) {
+            return EXIT_FAILURE;
+        }
+
+        destroy_window(window);
+
+        size_t event_count;
+        const trace_event* events = get_trace_events(&event_count);
+
+        for (size_t j = 0; j < event_count; ++j) {
+            int index = 0;
+            while (index < stage_count
+                && strcmp(stages[index].name, events[j].name)) {
+                ++index;
+            }
+
+            if (index == stage_count) {
+                if (stage_count == MAX_STAGES) {
+                    continue;
+                }
+
+                stages[index].name = events[j].name;
+                stages[index].samples = malloc(iterations * sizeof(uint64_t));
+                stages[index].count = 0;
+                ++stage_count;
+            }
+
+            if (stages[index].count < (size_t) iterations) {
+                stages[index].samples[stages[index].count++] =
+                    events[j].duration;
+            }
+        }
+    }
+
+    printf("%-28s %8s %12s %12s\n", "stage", "samples", "p50 (ms)",
+        "p99 (ms)");
+
+    for (int i = 0; i < stage_count; ++i) {
+        qsort(stages[i].samples, stages[i].count, sizeof(uint64_t),
+            compare_samples);
+
+        const size_t p50 = (stages[i].count - 1) * 50 / 100;
+        const size_t p99 = (stages[i].count - 1) * 99 / 100;
+
+        printf("%-28s %8zu %12.3f %12.3f\n", stages[i].name, stages[i].count,
+            stages[i].samples[p50] / 1e6, stages[i].samples[p99] / 1e6);
+
+        free(stages[i].samples);
+    }
+
+    return EXIT_SUCCESS;
+}
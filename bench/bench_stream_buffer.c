@@ -0,0 +1,260 @@
+/**
+ * \file bench_stream_buffer.c
+ * \author Isaiah Lateer
+ * 
+ * Streams vertex data to the GPU on a headless window, once by re-uploading a
+ * single buffer with glBufferSubData before every draw and once through a
+ * stream buffer, and reports the throughput of each.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "opengl.h"
+#include "stream_buffer.h"
+#include "timer.h"
+#include "window.h"
+
+#define DEFAULT_FRAMES 300
+#define DRAWS 64
+#define VERTICES 4096
+#define FRAMES_IN_FLIGHT 3
+#define CHUNK_SIZE (VERTICES * 4 * sizeof(float))
+
+static const char* vertex_source =
+    "#version 330 core\n"
+    "layout(location = 0) in vec4 position;\n"
+    "void main() {\n"
+    "    gl_Position = position;\n"
+    "}\n";
+
+typedef struct procedures {
+    PFNGLGENBUFFERSPROC glGenBuffers;
+    PFNGLDELETEBUFFERSPROC glDeleteBuffers;
+    PFNGLBINDBUFFERPROC glBindBuffer;
+    PFNGLBUFFERDATAPROC glBufferData;
+    PFNGLBUFFERSUBDATAPROC glBufferSubData;
+    PFNGLGENVERTEXARRAYSPROC glGenVertexArrays;
+    PFNGLDELETEVERTEXARRAYSPROC glDeleteVertexArrays;
+    PFNGLBINDVERTEXARRAYPROC glBindVertexArray;
+    PFNGLVERTEXATTRIBPOINTERPROC glVertexAttribPointer;
+    PFNGLENABLEVERTEXATTRIBARRAYPROC glEnableVertexAttribArray;
+    PFNGLCREATESHADERPROC glCreateShader;
+    PFNGLSHADERSOURCEPROC glShaderSource;
+    PFNGLCOMPILESHADERPROC glCompileShader;
+    PFNGLDELETESHADERPROC glDeleteShader;
+    PFNGLCREATEPROGRAMPROC glCreateProgram;
+    PFNGLATTACHSHADERPROC glAttachShader;
+    PFNGLLINKPROGRAMPROC glLinkProgram;
+    PFNGLUSEPROGRAMPROC glUseProgram;
+    PFNGLDELETEPROGRAMPROC glDeleteProgram;
+} procedures;
+
+/**
+ * Loads the procedures the benchmark calls.
+ * 
+ * \param[in] window Window.
+ * \param[out] gl Procedures.
+ */
+static void load_procedures(window* window, procedures* gl) {
+    gl->glGenBuffers = (PFNGLGENBUFFERSPROC)
+        get_procedure_address(window, "glGenBuffers");
+    gl->glDeleteBuffers = (PFNGLDELETEBUFFERSPROC)
+        get_procedure_address(window, "glDeleteBuffers");
+    gl->glBindBuffer = (PFNGLBINDBUFFERPROC)
+        get_procedure_address(window, "glBindBuffer");
+    gl->glBufferData = (PFNGLBUFFERDATAPROC)
+        get_procedure_address(window, "glBufferData");
+    gl->glBufferSubData = (PFNGLBUFFERSUBDATAPROC)
+        get_procedure_address(window, "glBufferSubData");
+    gl->glGenVertexArrays = (PFNGLGENVERTEXARRAYSPROC)
+        get_procedure_address(window, "glGenVertexArrays");
+    gl->glDeleteVertexArrays = (PFNGLDELETEVERTEXARRAYSPROC)
+        get_procedure_address(window, "glDeleteVertexArrays");
+    gl->glBindVertexArray = (PFNGLBINDVERTEXARRAYPROC)
+        get_procedure_address(window, "glBindVertexArray");
+    gl->glVertexAttribPointer = (PFNGLVERTEXATTRIBPOINTERPROC)
+        get_procedure_address(window, "glVertexAttribPointer");
+    gl->glEnableVertexAttribArray = (PFNGLENABLEVERTEXATTRIBARRAYPROC)
+        get_procedure_address(window, "glEnableVertexAttribArray");
+    gl->glCreateShader = (PFNGLCREATESHADERPROC)
+        get_procedure_address(window, "glCreateShader");
+    gl->glShaderSource = (PFNGLSHADERSOURCEPROC)
+        get_procedure_address(window, "glShaderSource");
+    gl->glCompileShader = (PFNGLCOMPILESHADERPROC)
+        get_procedure_address(window, "glCompileShader");
+    gl->glDeleteShader = (PFNGLDELETESHADERPROC)
+        get_procedure_address(window, "glDeleteShader");
+    gl->glCreateProgram = (PFNGLCREATEPROGRAMPROC)
+        get_procedure_address(window, "glCreateProgram");
+    gl->glAttachShader = (PFNGLATTACHSHADERPROC)
+        get_procedure_address(window, "glAttachShader");
+    gl->glLinkProgram = (PFNGLLINKPROGRAMPROC)
+        get_procedure_address(window, "glLinkProgram");
+    gl->glUseProgram = (PFNGLUSEPROGRAMPROC)
+        get_procedure_address(window, "glUseProgram");
+    gl->glDeleteProgram = (PFNGLDELETEPROGRAMPROC)
+        get_procedure_address(window, "glDeleteProgram");
+}
+
+/**
+ * Fills a chunk of vertices with values that change every draw.
+ * 
+ * \param[out] vertices Vertex data of CHUNK_SIZE bytes.
+ * \param[in] draw Draw index.
+ */
+static void write_vertices(float* vertices, int draw) {
+    for (int i = 0; i < VERTICES; ++i) {
+        vertices[i * 4] = (float) (i % 64) / 32.0f - 1.0f;
+        vertices[i * 4 + 1] = (float) (i / 64) / 32.0f - 1.0f;
+        vertices[i * 4 + 2] = (float) (draw & 0xFF) / 255.0f;
+        vertices[i * 4 + 3] = 1.0f;
+    }
+}
+
+/**
+ * Prints a throughput line.
+ * 
+ * \param[in] name Upload method.
+ * \param[in] frames Frames drawn.
+ * \param[in] elapsed Elapsed time in nanoseconds.
+ */
+static void print_result(const char* name, int frames, uint64_t elapsed) {
+    const double seconds = elapsed / 1e9;
+    const double bytes = (double) frames * DRAWS * CHUNK_SIZE;
+
+    printf("%-12s %8d %12.1f %12.1f\n", name, frames, frames / seconds,
+        bytes / seconds / (1024.0 * 1024.0));
+}
+
+/**
+ * Entry point for the benchmark.
+ * 
+ * \param[in] argc Argument count.
+ * \param[in] argv Arguments. The first is the number of frames.
+ * \return Exit code.
+ */
+int main(int argc, char** argv) {
+    const int frames = argc > 1 ? atoi(argv[1]) : DEFAULT_FRAMES;
+    if (frames <= 0) {
+        fprintf(stderr, "[ERROR] Invalid frame count.\n");
+        return EXIT_FAILURE;
+    }
+
+    const window_settings settings = {
+        .title = "Stream Buffer Benchmark",
+        .width = 64,
+        .height = 64,
+        .backend = WINDOW_BACKEND_HEADLESS
+    };
+
+    window* window = create_window_with_settings(&settings);
+    if (!window) {
+        return EXIT_FAILURE;
+    }
+
+    make_current(window);
+
+    procedures gl;
+    load_procedures(window, &gl);
+
+    const GLuint shader = gl.glCreateShader(GL_VERTEX_SHADER);
+    gl.glShaderSource(shader, 1, &vertex_source, NULL);
+    gl.glCompileShader(shader);
+
+    const GLuint program = gl.glCreateProgram();
+    gl.glAttachShader(program, shader);
+    gl.glLinkProgram(program);
+    gl.glDeleteShader(shader);
+
+    GLuint vertex_array;
+    gl.glGenVertexArrays(1, &vertex_array);
+    gl.glBindVertexArray(vertex_array);
+    gl.glEnableVertexAttribArray(0);
+    gl.glUseProgram(program);
+
+    // Only vertex processing is measured; nothing needs to be rasterized.
+    glEnable(GL_RASTERIZER_DISCARD);
+
+    float* vertices = malloc(CHUNK_SIZE);
+
+    GLuint buffer;
+    gl.glGenBuffers(1, &buffer);
+    gl.glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    gl.glBufferData(GL_ARRAY_BUFFER, CHUNK_SIZE, NULL, GL_STREAM_DRAW);
+    gl.glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 0, NULL);
+
+    uint64_t start = get_time();
+
+    for (int i = 0; i < frames; ++i) {
+        for (int j = 0; j < DRAWS; ++j) {
+            write_vertices(vertices, i * DRAWS + j);
+            gl.glBufferSubData(GL_ARRAY_BUFFER, 0, CHUNK_SIZE, vertices);
+            glDrawArrays(GL_POINTS, 0, VERTICES);
+        }
+
+        swap_buffer(window);
+    }
+
+    glFinish();
+
+    const uint64_t subdata_elapsed = get_time() - start;
+
+    gl.glDeleteBuffers(1, &buffer);
+
+    stream_buffer* stream = create_stream_buffer(window, GL_ARRAY_BUFFER,
+        DRAWS * CHUNK_SIZE, FRAMES_IN_FLIGHT);
+    if (!stream) {
+        free(vertices);
+        destroy_window(window);
+        return EXIT_FAILURE;
+    }
+
+    gl.glBindBuffer(GL_ARRAY_BUFFER, get_stream_buffer_name(stream));
+    gl.glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 0, NULL);
+
+    start = get_time();
+
+    for (int i = 0; i < frames; ++i) {
+        for (int j = 0; j < DRAWS; ++j) {
+            size_t offset;
+            float* chunk = map_stream_buffer(stream, CHUNK_SIZE,
+                4 * sizeof(float), &offset);
+            if (!chunk) {
+                break;
+            }
+
+            write_vertices(chunk, i * DRAWS + j);
+            unmap_stream_buffer(stream);
+
+            // The attribute points at the start of the buffer, so the
+            // chunk is selected by its first vertex.
+            glDrawArrays(GL_POINTS, (GLint) (offset / (4 * sizeof(float))),
+                VERTICES);
+        }
+
+        end_stream_frame(stream);
+        swap_buffer(window);
+    }
+
+    glFinish();
+
+    const uint64_t stream_elapsed = get_time() - start;
+    const bool persistent = is_stream_buffer_persistent(stream);
+
+    destroy_stream_buffer(stream);
+    free(vertices);
+
+    gl.glDeleteVertexArrays(1, &vertex_array);
+    gl.glDeleteProgram(program);
+
+    destroy_window(window);
+
+    printf("%-12s %8s %12s %12s\n", "method", "frames", "frames/s", "MB/s");
+    print_result("subdata", frames, subdata_elapsed);
+    print_result(persistent ? "persistent" : "orphaning", frames,
+        stream_elapsed);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,196 @@
+/**
+ * \file context_pool.c
+ * \author Isaiah Lateer
+ * 
+ * Source file for the context pool functions.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "opengl.h"
+#include "shared_context.h"
+#include "thread.h"
+#include "window.h"
+
+typedef struct pooled_context {
+    shared_context* context;
+    struct pooled_context* next;
+} pooled_context;
+
+typedef struct context_pool {
+    pooled_context* contexts;
+    unsigned count;
+    pooled_context* free_contexts;
+    mutex* mutex;
+    condition* released;
+    PFNGLFENCESYNCPROC glFenceSync;
+    PFNGLCLIENTWAITSYNCPROC glClientWaitSync;
+    PFNGLWAITSYNCPROC glWaitSync;
+    PFNGLDELETESYNCPROC glDeleteSync;
+} context_pool;
+
+/**
+ * Creates a pool of contexts that share objects with the window's context, so
+ * worker threads can upload textures and buffers without stalling the thread
+ * that renders. Each context has the window's version and error mode and
+ * renders into a 1x1 pbuffer or no surface at all. Must be called from the
+ * thread that created the window, and needs OpenGL 3.2 or ARB_sync.
+ * 
+ * \param[in] window Window.
+ * \param[in] count Number of contexts.
+ * \return New context pool.
+ */
+context_pool* create_context_pool(window* window, unsigned count) {
+    if (!count) {
+        fprintf(stderr, "[ERROR] Context pool must hold a context.\n");
+        return NULL;
+    }
+
+    context_pool* pool = malloc(sizeof(struct context_pool));
+    memset(pool, 0, sizeof(struct context_pool));
+
+    pool->glFenceSync = (PFNGLFENCESYNCPROC)
+        get_procedure_address(window, "glFenceSync");
+    pool->glClientWaitSync = (PFNGLCLIENTWAITSYNCPROC)
+        get_procedure_address(window, "glClientWaitSync");
+    pool->glWaitSync = (PFNGLWAITSYNCPROC)
+        get_procedure_address(window, "glWaitSync");
+    pool->glDeleteSync = (PFNGLDELETESYNCPROC)
+        get_procedure_address(window, "glDeleteSync");
+
+    if (!pool->glFenceSync || !pool->glClientWaitSync || !pool->glWaitSync
+        || !pool->glDeleteSync) {
+        fprintf(stderr, "[ERROR] Failed to load sync functions.\n");
+
+        free(pool);
+
+        return NULL;
+    }
+
+    pool->contexts = malloc(count * sizeof(pooled_context));
+
+    for (; pool->count < count; ++pool->count) {
+        pooled_context* context = &pool->contexts[pool->count];
+
+        context->context = create_shared_context(window);
+        if (!context->context) {
+            destroy_context_pool(pool);
+            return NULL;
+        }
+
+        context->next = pool->free_contexts;
+        pool->free_contexts = context;
+    }
+
+    pool->mutex = create_mutex();
+    pool->released = create_condition();
+
+    return pool;
+}
+
+/**
+ * Destroys a context pool. Every context must have been released.
+ * 
+ * \param[in] pool Context pool.
+ */
+void destroy_context_pool(context_pool* pool) {
+    for (unsigned i = 0; i < pool->count; ++i) {
+        destroy_shared_context(pool->contexts[i].context);
+    }
+
+    if (pool->mutex) {
+        destroy_condition(pool->released);
+        destroy_mutex(pool->mutex);
+    }
+
+    free(pool->contexts);
+    free(pool);
+}
+
+/**
+ * Takes a context from the pool and makes it current on the calling thread,
+ * waiting for another thread to release one if none are free.
+ * 
+ * \param[in] pool Context pool.
+ * \return Pooled context, or null if it could not be made current.
+ */
+pooled_context* acquire_pooled_context(context_pool* pool) {
+    lock_mutex(pool->mutex);
+
+    while (!pool->free_contexts) {
+        wait_condition(pool->released, pool->mutex);
+    }
+
+    pooled_context* context = pool->free_contexts;
+    pool->free_contexts = context->next;
+
+    unlock_mutex(pool->mutex);
+
+    if (!make_shared_context_current(context->context)) {
+        lock_mutex(pool->mutex);
+        context->next = pool->free_contexts;
+        pool->free_contexts = context;
+        unlock_mutex(pool->mutex);
+
+        signal_condition(pool->released);
+
+        return NULL;
+    }
+
+    return context;
+}
+
+/**
+ * Fences the commands issued on a pooled context, flushes them so the fence
+ * is visible to other contexts, then releases the context back to the pool.
+ * 
+ * \param[in] pool Context pool.
+ * \param[in] context Pooled context current on the calling thread.
+ * \return Fence signalled when the uploads are complete.
+ */
+upload_fence* release_pooled_context(context_pool* pool,
+    pooled_context* context) {
+    const GLsync fence = pool->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    // A fence only becomes visible to other contexts once the commands
+    // before it have been flushed.
+    glFlush();
+
+    release_shared_context(context->context);
+
+    lock_mutex(pool->mutex);
+    context->next = pool->free_contexts;
+    pool->free_contexts = context;
+    unlock_mutex(pool->mutex);
+
+    signal_condition(pool->released);
+
+    return (upload_fence*) fence;
+}
+
+/**
+ * Checks without blocking whether the uploads behind a fence are complete.
+ * 
+ * \param[in] pool Context pool.
+ * \param[in] fence Upload fence.
+ * \return Whether the uploads are complete.
+ */
+bool is_upload_complete(context_pool* pool, upload_fence* fence) {
+    const GLenum status = pool->glClientWaitSync((GLsync) fence, 0, 0);
+    return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+}
+
+/**
+ * Makes the GPU wait for the uploads behind a fence before running later
+ * commands from the current context, then destroys the fence. Does not block
+ * the calling thread. Call before the first use of the uploaded objects.
+ * 
+ * \param[in] pool Context pool.
+ * \param[in] fence Upload fence.
+ */
+void wait_for_upload(context_pool* pool, upload_fence* fence) {
+    pool->glWaitSync((GLsync) fence, 0, GL_TIMEOUT_IGNORED);
+    pool->glDeleteSync((GLsync) fence);
+}
@@ -0,0 +1,150 @@
+/**
+ * \file damage.c
+ * \author Isaiah Lateer
+ * 
+ * Source file for the damage history functions.
+ */
+
+#include "damage.h"
+
+#include <string.h>
+
+/**
+ * Gets the smallest rectangle containing two rectangles. Empty rectangles are
+ * ignored.
+ * 
+ * \param[in] a First rectangle.
+ * \param[in] b Second rectangle.
+ * \return Union of the rectangles.
+ */
+static rect unite_rects(rect a, rect b) {
+    if (!a.width || !a.height) {
+        return b;
+    }
+
+    if (!b.width || !b.height) {
+        return a;
+    }
+
+    const long left = a.x < b.x ? a.x : b.x;
+    const long bottom = a.y < b.y ? a.y : b.y;
+    const long a_right = (long) a.x + a.width;
+    const long b_right = (long) b.x + b.width;
+    const long a_top = (long) a.y + a.height;
+    const long b_top = (long) b.y + b.height;
+    const long right = a_right > b_right ? a_right : b_right;
+    const long top = a_top > b_top ? a_top : b_top;
+
+    const rect result = {
+        (int) left, (int) bottom,
+        (unsigned) (right - left), (unsigned) (top - bottom)
+    };
+
+    return result;
+}
+
+/**
+ * Clips a rectangle to a framebuffer.
+ * 
+ * \param[in] area Rectangle.
+ * \param[in] width Framebuffer width.
+ * \param[in] height Framebuffer height.
+ * \return Clipped rectangle.
+ */
+static rect clip_rect(rect area, unsigned width, unsigned height) {
+    long left = area.x;
+    long bottom = area.y;
+    long right = left + (long) area.width;
+    long top = bottom + (long) area.height;
+
+    left = left < 0 ? 0 : left;
+    bottom = bottom < 0 ? 0 : bottom;
+    right = right > (long) width ? (long) width : right;
+    top = top > (long) height ? (long) height : top;
+
+    if (right <= left || top <= bottom) {
+        const rect empty = { 0, 0, 0, 0 };
+        return empty;
+    }
+
+    const rect result = {
+        (int) left, (int) bottom,
+        (unsigned) (right - left), (unsigned) (top - bottom)
+    };
+
+    return result;
+}
+
+/**
+ * Gets the smallest rectangle containing a set of rectangles, clipped to the
+ * framebuffer.
+ * 
+ * \param[in] rects Rectangles.
+ * \param[in] count Number of rectangles.
+ * \param[in] width Framebuffer width.
+ * \param[in] height Framebuffer height.
+ * \return Bounding rectangle, empty if there are no rectangles.
+ */
+rect bound_rects(const rect* rects, size_t count, unsigned width,
+    unsigned height) {
+    rect bounds = { 0, 0, 0, 0 };
+
+    for (size_t i = 0; i < count; ++i) {
+        bounds = unite_rects(bounds, rects[i]);
+    }
+
+    return clip_rect(bounds, width, height);
+}
+
+/**
+ * Records the damage of a presented frame.
+ * 
+ * \param[in] history Damage history.
+ * \param[in] damage Bounding rectangle of the frame's damage.
+ */
+void record_damage(damage_history* history, rect damage) {
+    history->frames[history->next] = damage;
+    history->next = (history->next + 1) % DAMAGE_HISTORY_LENGTH;
+
+    if (history->count < DAMAGE_HISTORY_LENGTH) {
+        ++history->count;
+    }
+}
+
+/**
+ * Forgets every recorded frame, for example after a resize.
+ * 
+ * \param[in] history Damage history.
+ */
+void clear_damage(damage_history* history) {
+    memset(history, 0, sizeof(damage_history));
+}
+
+/**
+ * Gets the region of a back buffer that has to be redrawn: the new damage
+ * plus the damage of every frame presented since the buffer was last drawn.
+ * 
+ * \param[in] history Damage history.
+ * \param[in] age Buffer age, or zero if the contents are undefined.
+ * \param[in] damage Bounding rectangle of the new damage.
+ * \param[in] width Framebuffer width.
+ * \param[in] height Framebuffer height.
+ * \return Region to redraw.
+ */
+rect get_stale_region(const damage_history* history, unsigned age,
+    rect damage, unsigned width, unsigned height) {
+    if (!age || age - 1 > history->count) {
+        const rect full = { 0, 0, width, height };
+        return full;
+    }
+
+    // A buffer of age n last held the frame presented n frames ago, so it
+    // misses the damage of the n - 1 frames presented after it.
+    for (unsigned i = 1; i < age; ++i) {
+        const unsigned index =
+            (history->next + DAMAGE_HISTORY_LENGTH - i) % DAMAGE_HISTORY_LENGTH;
+        damage = unite_rects(damage, history->frames[index]);
+    }
+
+    return clip_rect(damage, width, height);
+}
@@ -0,0 +1,67 @@
+/**
+ * \file damage.h
+ * \author Isaiah Lateer
+ * 
+ * Header file for the damage history struct and functions. Used by the
+ * platform window implementations to work out which part of a reused back
+ * buffer is stale.
+ */
+
+#ifndef OPENGL_CONTEXT_DAMAGE_HEADER
+#define OPENGL_CONTEXT_DAMAGE_HEADER
+
+#include <stddef.h>
+
+#include "window.h"
+
+#define DAMAGE_HISTORY_LENGTH 8
+
+typedef struct damage_history {
+    rect frames[DAMAGE_HISTORY_LENGTH];
+    unsigned count;
+    unsigned next;
+} damage_history;
+
+/**
+ * Gets the smallest rectangle containing a set of rectangles, clipped to the
+ * framebuffer.
+ * 
+ * \param[in] rects Rectangles.
+ * \param[in] count Number of rectangles.
+ * \param[in] width Framebuffer width.
+ * \param[in] height Framebuffer height.
+ * \return Bounding rectangle, empty if there are no rectangles.
+ */
+rect bound_rects(const rect* rects, size_t count, unsigned width,
+    unsigned height);
+
+/**
+ * Records the damage of a presented frame.
+ * 
+ * \param[in] history Damage history.
+ * \param[in] damage Bounding rectangle of the frame's damage.
+ */
+void record_damage(damage_history* history, rect damage);
+
+/**
+ * Forgets every recorded frame, for example after a resize.
+ * 
+ * \param[in] history Damage history.
+ */
+void clear_damage(damage_history* history);
+
+/**
+ * Gets the region of a back buffer that has to be redrawn: the new damage
+ * plus the damage of every frame presented since the buffer was last drawn.
+ * 
+ * \param[in] history Damage history.
+ * \param[in] age Buffer age, or zero if the contents are undefined.
+ * \param[in] damage Bounding rectangle of the new damage.
+ * \param[in] width Framebuffer width.
+ * \param[in] height Framebuffer height.
+ * \return Region to redraw.
+ */
+rect get_stale_region(const damage_history* history, unsigned age,
+    rect damage, unsigned width, unsigned height);
+
+#endif
@@ -0,0 +1,328 @@
+/**
+ * \file debug_output.c
+ * \author Isaiah Lateer
+ * 
+ * Source file for the debug output functions.
+ */
+
+#include "debug_output.h"
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "opengl.h"
+#include "thread.h"
+#include "timer.h"
+
+#define CACHE_LINE_SIZE 64
+#define DRAIN_INTERVAL 10000000
+
+typedef struct debug_slot {
+    atomic_size_t sequence;
+    debug_message message;
+} debug_slot;
+
+typedef struct debug_output {
+    debug_callback callback;
+    void* user_data;
+    thread* thread;
+    atomic_bool stopping;
+    atomic_uint_fast64_t dropped;
+
+    // Drivers may report from their own threads as well as from every thread
+    // a sharing context is current on, so producers claim slots with a
+    // compare and swap on the tail. Each slot's sequence tells the drain
+    // thread when its message is complete and producers when it is free.
+    _Alignas(CACHE_LINE_SIZE) atomic_size_t tail;
+    _Alignas(CACHE_LINE_SIZE) size_t head;
+    debug_slot slots[DEBUG_QUEUE_CAPACITY];
+} debug_output;
+
+/**
+ * Gets a readable name for a debug message source.
+ * 
+ * \param[in] source Message source.
+ * \return Source name.
+ */
+static const char* get_source_name(GLenum source) {
+    switch (source) {
+        case GL_DEBUG_SOURCE_API:
+            return "API";
+        case GL_DEBUG_SOURCE_WINDOW_SYSTEM:
+            return "Window system";
+        case GL_DEBUG_SOURCE_SHADER_COMPILER:
+            return "Shader compiler";
+        case GL_DEBUG_SOURCE_THIRD_PARTY:
+            return "Third party";
+        case GL_DEBUG_SOURCE_APPLICATION:
+            return "Application";
+        default:
+            return "Other";
+    }
+}
+
+/**
+ * Gets a readable name for a debug message type.
+ * 
+ * \param[in] type Message type.
+ * \return Type name.
+ */
+static const char* get_type_name(GLenum type) {
+    switch (type) {
+        case GL_DEBUG_TYPE_ERROR:
+            return "error";
+        case GL_DEBUG_TYPE_DEPRECATED_BEHAVIOR:
+            return "deprecated behavior";
+        case GL_DEBUG_TYPE_UNDEFINED_BEHAVIOR:
+            return "undefined behavior";
+        case GL_DEBUG_TYPE_PORTABILITY:
+            return "portability";
+        case GL_DEBUG_TYPE_PERFORMANCE:
+            return "performance";
+        case GL_DEBUG_TYPE_MARKER:
+            return "marker";
+        default:
+            return "other";
+    }
+}
+
+/**
+ * Gets a readable name for a debug message severity.
+ * 
+ * \param[in] severity Message severity.
+ * \return Severity name.
+ */
+static const char* get_severity_name(GLenum severity) {
+    switch (severity) {
+        case GL_DEBUG_SEVERITY_HIGH:
+            return "high";
+        case GL_DEBUG_SEVERITY_MEDIUM:
+            return "medium";
+        case GL_DEBUG_SEVERITY_LOW:
+            return "low";
+        default:
+            return "notification";
+    }
+}
+
+/**
+ * Prints a debug message to stderr.
+ * 
+ * \param[in] message Message.
+ * \param[in] user_data Unused.
+ */
+static void print_debug_message(const debug_message* message,
+    void* user_data) {
+    fprintf(stderr, "[GL] %s %s, %s severity, %u: %s\n",
+        get_source_name(message->source), get_type_name(message->type),
+        get_severity_name(message->severity), message->id, message->text);
+}
+
+/**
+ * Queues a message reported by the driver without blocking. Messages that
+ * find the queue full are counted and dropped.
+ * 
+ * \param[in] source Message source.
+ * \param[in] type Message type.
+ * \param[in] id Message identifier.
+ * \param[in] severity Message severity.
+ * \param[in] length Message length, or negative if null terminated.
+ * \param[in] text Message text.
+ * \param[in] user_param Debug output.
+ */
+static void APIENTRY receive_debug_message(GLenum source, GLenum type,
+    GLuint id, GLenum severity, GLsizei length, const GLchar* text,
+    const void* user_param) {
+    debug_output* output = (debug_output*) user_param;
+
+    size_t tail = atomic_load_explicit(&output->tail, memory_order_relaxed);
+    debug_slot* slot;
+
+    for (;;) {
+        slot = &output->slots[tail % DEBUG_QUEUE_CAPACITY];
+
+        const size_t sequence =
+            atomic_load_explicit(&slot->sequence, memory_order_acquire);
+        const ptrdiff_t difference = (ptrdiff_t) (sequence - tail);
+
+        if (!difference) {
+            if (atomic_compare_exchange_weak_explicit(&output->tail, &tail,
+                tail + 1, memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            atomic_fetch_add_explicit(&output->dropped, 1,
+                memory_order_relaxed);
+            return;
+        } else {
+            tail = atomic_load_explicit(&output->tail, memory_order_relaxed);
+        }
+    }
+
+    size_t text_length = length < 0 ? strlen(text) : (size_t) length;
+    if (text_length >= DEBUG_MESSAGE_LENGTH) {
+        text_length = DEBUG_MESSAGE_LENGTH - 1;
+    }
+
+    slot->message.source = source;
+    slot->message.type = type;
+    slot->message.id = id;
+    slot->message.severity = severity;
+    slot->message.time = get_time();
+    memcpy(slot->message.text, text, text_length);
+    slot->message.text[text_length] = '\0';
+
+    atomic_store_explicit(&slot->sequence, tail + 1, memory_order_release);
+}
+
+/**
+ * Passes every complete message in the queue to the callback.
+ * 
+ * \param[in] output Debug output.
+ */
+static void drain_debug_messages(debug_output* output) {
+    for (;;) {
+        debug_slot* slot = &output->slots[output->head % DEBUG_QUEUE_CAPACITY];
+        if (atomic_load_explicit(&slot->sequence, memory_order_acquire)
+            != output->head + 1) {
+            return;
+        }
+
+        output->callback(&slot->message, output->user_data);
+
+        atomic_store_explicit(&slot->sequence,
+            output->head + DEBUG_QUEUE_CAPACITY, memory_order_release);
+        ++output->head;
+    }
+}
+
+/**
+ * Drains the queue periodically until stopped, then once more so messages
+ * reported before the context was destroyed are not lost.
+ * 
+ * \param[in] data Debug output.
+ */
+static void run_drain_thread(void* data) {
+    debug_output* output = data;
+
+    while (!atomic_load_explicit(&output->stopping, memory_order_relaxed)) {
+        drain_debug_messages(output);
+        sleep_until(get_time() + DRAIN_INTERVAL);
+    }
+
+    drain_debug_messages(output);
+}
+
+/**
+ * Checks whether the current context lists an extension.
+ * 
+ * \param[in] window Window.
+ * \param[in] name Extension name.
+ * \return Whether the extension is listed.
+ */
+static bool has_gl_extension(const window* window, const char* name) {
+    PFNGLGETSTRINGIPROC glGetStringi = (PFNGLGETSTRINGIPROC)
+        get_procedure_address(window, "glGetStringi");
+    if (!glGetStringi) {
+        return false;
+    }
+
+    GLint extension_count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &extension_count);
+
+    for (GLint i = 0; i < extension_count; ++i) {
+        const char* extension = (const char*) glGetStringi(GL_EXTENSIONS, i);
+        if (extension && !strcmp(extension, name)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Installs a debug message callback on the window's context, which must be
+ * current, and starts a thread that passes queued messages on. Every message
+ * the driver can report is enabled, including low severity performance
+ * warnings.
+ * 
+ * \param[in] window Window.
+ * \param[in] callback Called for each message, or null to print to stderr.
+ * \param[in] user_data User data passed to the callback.
+ * \return New debug output, or null if the context has no debug output.
+ */
+debug_output* create_debug_output(const window* window,
+    debug_callback callback, void* user_data) {
+    const version version = get_context_version(window);
+    if ((version.major < 4 || (version.major == 4 && version.minor < 3))
+        && !has_gl_extension(window, "GL_KHR_debug")) {
+        printf("[INFO] The context has no debug output.\n");
+        return NULL;
+    }
+
+    PFNGLDEBUGMESSAGECALLBACKPROC glDebugMessageCallback =
+        (PFNGLDEBUGMESSAGECALLBACKPROC)
+        get_procedure_address(window, "glDebugMessageCallback");
+    PFNGLDEBUGMESSAGECONTROLPROC glDebugMessageControl =
+        (PFNGLDEBUGMESSAGECONTROLPROC)
+        get_procedure_address(window, "glDebugMessageControl");
+    if (!glDebugMessageCallback || !glDebugMessageControl) {
+        fprintf(stderr, "[ERROR] Failed to load debug output functions.\n");
+        return NULL;
+    }
+
+    debug_output* output = malloc(sizeof(struct debug_output));
+    memset(output, 0, sizeof(struct debug_output));
+
+    output->callback = callback ? callback : print_debug_message;
+    output->user_data = user_data;
+
+    atomic_init(&output->stopping, false);
+    atomic_init(&output->dropped, 0);
+    atomic_init(&output->tail, 0);
+
+    for (size_t i = 0; i < DEBUG_QUEUE_CAPACITY; ++i) {
+        atomic_init(&output->slots[i].sequence, i);
+    }
+
+    output->thread = create_thread(run_drain_thread, output);
+    if (!output->thread) {
+        free(output);
+        return NULL;
+    }
+
+    glDebugMessageCallback(receive_debug_message, output);
+    glDebugMessageControl(GL_DONT_CARE, GL_DONT_CARE, GL_DONT_CARE, 0, NULL,
+        GL_TRUE);
+    glEnable(GL_DEBUG_OUTPUT);
+
+    return output;
+}
+
+/**
+ * Stops the drain thread after it passes on the queued messages, then
+ * destroys the debug output. The context must already be destroyed so the
+ * driver cannot report further messages.
+ * 
+ * \param[in] output Debug output.
+ */
+void destroy_debug_output(debug_output* output) {
+    atomic_store(&output->stopping, true);
+    join_thread(output->thread);
+
+    free(output);
+}
+
+/**
+ * Gets the number of messages dropped because the queue was full.
+ * 
+ * \param[in] output Debug output.
+ * \return Dropped message count.
+ */
+uint64_t get_dropped_messages(debug_output* output) {
+    return atomic_load_explicit(&output->dropped, memory_order_relaxed);
+}
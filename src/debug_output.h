@@ -0,0 +1,51 @@
+/**
+ * \file debug_output.h
+ * \author Isaiah Lateer
+ * 
+ * Header file for the debug output struct and functions. Used by the window
+ * implementations for windows created with GL_ERRORS_DEBUG.
+ */
+
+#ifndef OPENGL_CONTEXT_DEBUG_OUTPUT_HEADER
+#define OPENGL_CONTEXT_DEBUG_OUTPUT_HEADER
+
+#include <stdint.h>
+
+#include "window.h"
+
+#define DEBUG_QUEUE_CAPACITY 1024
+
+typedef struct debug_output debug_output;
+
+/**
+ * Installs a debug message callback on the window's context, which must be
+ * current, and starts a thread that passes queued messages on. Every message
+ * the driver can report is enabled, including low severity performance
+ * warnings.
+ * 
+ * \param[in] window Window.
+ * \param[in] callback Called for each message, or null to print to stderr.
+ * \param[in] user_data User data passed to the callback.
+ * \return New debug output, or null if the context has no debug output.
+ */
+debug_output* create_debug_output(const window* window,
+    debug_callback callback, void* user_data);
+
+/**
+ * Stops the drain thread after it passes on the queued messages, then
+ * destroys the debug output. The context must already be destroyed so the
+ * driver cannot report further messages.
+ * 
+ * \param[in] output Debug output.
+ */
+void destroy_debug_output(debug_output* output);
+
+/**
+ * Gets the number of messages dropped because the queue was full.
+ * 
+ * \param[in] output Debug output.
+ * \return Dropped message count.
+ */
+uint64_t get_dropped_messages(debug_output* output);
+
+#endif
@@ -0,0 +1,124 @@
+/**
+ * \file event_queue.c
+ * \author Isaiah Lateer
+ * 
+ * Source file for the event queue functions.
+ */
+
+#include "event_queue.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+/**
+ * Checks whether an event ends a press, which must reach the application so
+ * that nothing is left held down.
+ * 
+ * \param[in] type Event type.
+ * \return Whether the event is a release.
+ */
+static bool is_release(window_event_type type) {
+    return type == WINDOW_EVENT_KEY_RELEASE
+        || type == WINDOW_EVENT_BUTTON_RELEASE;
+}
+
+/**
+ * Finds the oldest event in a queue that is not of a given type or, with
+ * match set, the oldest that is.
+ * 
+ * \param[in] queue Event queue.
+ * \param[in] match Whether to find an event that passes the test.
+ * \param[in] test Event test.
+ * \return Index of the event, or the queue's count if there is none.
+ */
+static size_t find_event(const event_queue* queue, bool match,
+    bool (*test)(window_event_type type)) {
+    size_t index = 0;
+    while (index < queue->count
+        && test(queue->events[index].type) != match) {
+        ++index;
+    }
+
+    return index;
+}
+
+/**
+ * Checks whether an event is a motion event.
+ * 
+ * \param[in] type Event type.
+ * \return Whether the event is a motion event.
+ */
+static bool is_motion(window_event_type type) {
+    return type == WINDOW_EVENT_MOTION;
+}
+
+/**
+ * Appends an event to a queue. Motion and resize events replace an event of
+ * the same type at the back of the queue, so a burst of them costs one slot.
+ * When the queue is full, the oldest motion event makes room. Failing that,
+ * key and button releases push out the oldest event that is not a release,
+ * so no key is left held down, and other events are dropped. Every event
+ * lost either way is counted.
+ * 
+ * \param[in] queue Event queue.
+ * \param[in] event Event.
+ */
+void push_event(event_queue* queue, const window_event* event) {
+    if (queue->count
+        && (event->type == WINDOW_EVENT_MOTION
+        || event->type == WINDOW_EVENT_RESIZE)
+        && queue->events[queue->count - 1].type == event->type) {
+        queue->events[queue->count - 1] = *event;
+        return;
+    }
+
+    if (queue->count == MAX_QUEUED_EVENTS) {
+        ++queue->dropped;
+
+        size_t index = find_event(queue, true, is_motion);
+        if (index == queue->count && is_release(event->type)) {
+            index = find_event(queue, false, is_release);
+        }
+
+        if (index == queue->count) {
+            return;
+        }
+
+        memmove(queue->events + index, queue->events + index + 1,
+            (queue->count - index - 1) * sizeof(window_event));
+        --queue->count;
+    }
+
+    queue->events[queue->count++] = *event;
+}
+
+/**
+ * Moves events from the front of a queue into an array.
+ * 
+ * \param[in] queue Event queue.
+ * \param[out] events Array to fill.
+ * \param[in] capacity Size of the array.
+ * \return Number of events moved.
+ */
+size_t take_events(event_queue* queue, window_event* events,
+    size_t capacity) {
+    const size_t count = queue->count < capacity ? queue->count : capacity;
+
+    memcpy(events, queue->events, count * sizeof(window_event));
+    memmove(queue->events, queue->events + count,
+        (queue->count - count) * sizeof(window_event));
+
+    queue->count -= count;
+
+    return count;
+}
+
+/**
+ * Gets the number of events dropped because the queue was full.
+ * 
+ * \param[in] queue Event queue.
+ * \return Number of dropped events.
+ */
+size_t get_dropped_events(const event_queue* queue) {
+    return queue->dropped;
+}
@@ -0,0 +1,56 @@
+/**
+ * \file event_queue.h
+ * \author Isaiah Lateer
+ * 
+ * Header file for the event queue struct and functions. Used by the platform
+ * window implementations to buffer decoded events between polls.
+ */
+
+#ifndef OPENGL_CONTEXT_EVENT_QUEUE_HEADER
+#define OPENGL_CONTEXT_EVENT_QUEUE_HEADER
+
+#include <stddef.h>
+
+#include "window.h"
+
+#define MAX_QUEUED_EVENTS 256
+
+typedef struct event_queue {
+    window_event events[MAX_QUEUED_EVENTS];
+    size_t count;
+    size_t dropped;
+} event_queue;
+
+/**
+ * Appends an event to a queue. Motion and resize events replace an event of
+ * the same type at the back of the queue, so a burst of them costs one slot.
+ * When the queue is full, the oldest motion event makes room. Failing that,
+ * key and button releases push out the oldest event that is not a release,
+ * so no key is left held down, and other events are dropped. Every event
+ * lost either way is counted.
+ * 
+ * \param[in] queue Event queue.
+ * \param[in] event Event.
+ */
+void push_event(event_queue* queue, const window_event* event);
+
+/**
+ * Moves events from the front of a queue into an array.
+ * 
+ * \param[in] queue Event queue.
+ * \param[out] events Array to fill.
+ * \param[in] capacity Size of the array.
+ * \return Number of events moved.
+ */
+size_t take_events(event_queue* queue, window_event* events,
+    size_t capacity);
+
+/**
+ * Gets the number of events dropped because the queue was full.
+ * 
+ * \param[in] queue Event queue.
+ * \return Number of dropped events.
+ */
+size_t get_dropped_events(const event_queue* queue);
+
+#endif
@@ -0,0 +1,186 @@
+/**
+ * \file frame_pacer.c
+ * \author Isaiah Lateer
+ * 
+ * Source file for the frame pacer functions.
+ */
+
+#include "frame_pacer.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "timer.h"
+
+#define BUCKET_COUNT 64
+#define BUCKET_WIDTH 500000
+
+typedef struct histogram {
+    uint64_t buckets[BUCKET_COUNT + 1];
+    uint64_t count;
+    uint64_t total;
+    uint64_t min;
+    uint64_t max;
+} histogram;
+
+typedef struct frame_pacer {
+    uint64_t period;
+    uint64_t deadline;
+    uint64_t frame_start;
+    uint64_t swap_start;
+    histogram cpu;
+    histogram swap;
+    histogram frame;
+} frame_pacer;
+
+/**
+ * Adds a sample to a histogram. Samples past the last bucket are counted in
+ * an overflow bucket.
+ * 
+ * \param[in] histogram Histogram.
+ * \param[in] sample Sample in nanoseconds.
+ */
+static void record_sample(histogram* histogram, uint64_t sample) {
+    uint64_t bucket = sample / BUCKET_WIDTH;
+    if (bucket > BUCKET_COUNT) {
+        bucket = BUCKET_COUNT;
+    }
+
+    ++histogram->buckets[bucket];
+    ++histogram->count;
+    histogram->total += sample;
+
+    if (histogram->count == 1 || sample < histogram->min) {
+        histogram->min = sample;
+    }
+
+    if (sample > histogram->max) {
+        histogram->max = sample;
+    }
+}
+
+/**
+ * Writes a histogram.
+ * 
+ * \param[in] histogram Histogram.
+ * \param[in] name Histogram name.
+ * \param[in] stream Output stream.
+ */
+static void dump_histogram(const histogram* histogram, const char* name,
+    FILE* stream) {
+    if (!histogram->count) {
+        fprintf(stream, "[INFO] %s: no samples\n", name);
+        return;
+    }
+
+    fprintf(stream, "[INFO] %s: %llu samples, min %.3f ms, mean %.3f ms, "
+        "max %.3f ms\n", name, (unsigned long long) histogram->count,
+        histogram->min / 1e6, histogram->total / 1e6 / histogram->count,
+        histogram->max / 1e6);
+
+    for (int i = 0; i <= BUCKET_COUNT; ++i) {
+        if (!histogram->buckets[i]) {
+            continue;
+        }
+
+        if (i == BUCKET_COUNT) {
+            fprintf(stream, "[INFO]   >= %6.2f ms: %llu\n",
+                i * BUCKET_WIDTH / 1e6,
+                (unsigned long long) histogram->buckets[i]);
+        } else {
+            fprintf(stream, "[INFO]   %6.2f ms: %llu\n",
+                i * BUCKET_WIDTH / 1e6,
+                (unsigned long long) histogram->buckets[i]);
+        }
+    }
+}
+
+/**
+ * Creates a frame pacer.
+ * 
+ * \param[in] target_fps Frames per second to limit to, or zero for no limit.
+ * \return New frame pacer.
+ */
+frame_pacer* create_frame_pacer(unsigned target_fps) {
+    frame_pacer* pacer = malloc(sizeof(struct frame_pacer));
+    memset(pacer, 0, sizeof(struct frame_pacer));
+
+    if (target_fps) {
+        pacer->period = 1000000000 / target_fps;
+    }
+
+    return pacer;
+}
+
+/**
+ * Destroys a frame pacer.
+ * 
+ * \param[in] pacer Frame pacer.
+ */
+void destroy_frame_pacer(frame_pacer* pacer) {
+    free(pacer);
+}
+
+/**
+ * Marks the start of a frame.
+ * 
+ * \param[in] pacer Frame pacer.
+ */
+void begin_frame(frame_pacer* pacer) {
+    pacer->frame_start = get_time();
+    pacer->swap_start = pacer->frame_start;
+}
+
+/**
+ * Marks the point where the frame's CPU work is done and the buffer swap
+ * starts.
+ * 
+ * \param[in] pacer Frame pacer.
+ */
+void begin_swap(frame_pacer* pacer) {
+    pacer->swap_start = get_time();
+}
+
+/**
+ * Marks the end of a frame, records its timings and sleeps until the next
+ * frame is due.
+ * 
+ * \param[in] pacer Frame pacer.
+ */
+void end_frame(frame_pacer* pacer) {
+    const uint64_t swap_end = get_time();
+
+    record_sample(&pacer->cpu, pacer->swap_start - pacer->frame_start);
+    record_sample(&pacer->swap, swap_end - pacer->swap_start);
+
+    if (pacer->period) {
+        if (!pacer->deadline) {
+            pacer->deadline = pacer->frame_start;
+        }
+
+        pacer->deadline += pacer->period;
+
+        // Missed deadlines are dropped rather than caught up on, otherwise a
+        // single long frame would be followed by a burst of unpaced frames.
+        if (pacer->deadline < swap_end) {
+            pacer->deadline = swap_end;
+        } else {
+            sleep_until(pacer->deadline);
+        }
+    }
+
+    record_sample(&pacer->frame, get_time() - pacer->frame_start);
+}
+
+/**
+ * Writes the frame time histograms.
+ * 
+ * \param[in] pacer Frame pacer.
+ * \param[in] stream Output stream.
+ */
+void dump_frame_statistics(const frame_pacer* pacer, FILE* stream) {
+    dump_histogram(&pacer->cpu, "CPU time", stream);
+    dump_histogram(&pacer->swap, "Swap time", stream);
+    dump_histogram(&pacer->frame, "Frame time", stream);
+}
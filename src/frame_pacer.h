@@ -0,0 +1,61 @@
+/**
+ * \file frame_pacer.h
+ * \author Isaiah Lateer
+ * 
+ * Header file for the frame pacer struct and functions.
+ */
+
+#ifndef OPENGL_CONTEXT_FRAME_PACER_HEADER
+#define OPENGL_CONTEXT_FRAME_PACER_HEADER
+
+#include <stdio.h>
+
+typedef struct frame_pacer frame_pacer;
+
+/**
+ * Creates a frame pacer.
+ * 
+ * \param[in] target_fps Frames per second to limit to, or zero for no limit.
+ * \return New frame pacer.
+ */
+frame_pacer* create_frame_pacer(unsigned target_fps);
+
+/**
+ * Destroys a frame pacer.
+ * 
+ * \param[in] pacer Frame pacer.
+ */
+void destroy_frame_pacer(frame_pacer* pacer);
+
+/**
+ * Marks the start of a frame.
+ * 
+ * \param[in] pacer Frame pacer.
+ */
+void begin_frame(frame_pacer* pacer);
+
+/**
+ * Marks the point where the frame's CPU work is done and the buffer swap
+ * starts.
+ * 
+ * \param[in] pacer Frame pacer.
+ */
+void begin_swap(frame_pacer* pacer);
+
+/**
+ * Marks the end of a frame, records its timings and sleeps until the next
+ * frame is due.
+ * 
+ * \param[in] pacer Frame pacer.
+ */
+void end_frame(frame_pacer* pacer);
+
+/**
+ * Writes the frame time histograms.
+ * 
+ * \param[in] pacer Frame pacer.
+ * \param[in] stream Output stream.
+ */
+void dump_frame_statistics(const frame_pacer* pacer, FILE* stream);
+
+#endif
@@ -0,0 +1,668 @@
+/**
+ * \file gl_functions.h
+ * \author Isaiah Lateer
+ * 
+ * OpenGL 4.6 core profile functions, generated by
+ * tools/generate_gl_functions.py from glcorearb.h. Do not edit.
+ * 
+ * Define GL_FUNCTION(type, name, parameters, arguments) and
+ * GL_VOID_FUNCTION(name, parameters, arguments) before including.
+ */
+
+GL_VOID_FUNCTION(glCullFace, (GLenum mode), (mode))
+GL_VOID_FUNCTION(glFrontFace, (GLenum mode), (mode))
+GL_VOID_FUNCTION(glHint, (GLenum target, GLenum mode), (target, mode))
+GL_VOID_FUNCTION(glLineWidth, (GLfloat width), (width))
+GL_VOID_FUNCTION(glPointSize, (GLfloat size), (size))
+GL_VOID_FUNCTION(glPolygonMode, (GLenum face, GLenum mode), (face, mode))
+GL_VOID_FUNCTION(glScissor, (GLint x, GLint y, GLsizei width, GLsizei height), (x, y, width, height))
+GL_VOID_FUNCTION(glTexParameterf, (GLenum target, GLenum pname, GLfloat param), (target, pname, param))
+GL_VOID_FUNCTION(glTexParameterfv, (GLenum target, GLenum pname, const GLfloat *params), (target, pname, params))
+GL_VOID_FUNCTION(glTexParameteri, (GLenum target, GLenum pname, GLint param), (target, pname, param))
+GL_VOID_FUNCTION(glTexParameteriv, (GLenum target, GLenum pname, const GLint *params), (target, pname, params))
+GL_VOID_FUNCTION(glTexImage1D, (GLenum target, GLint level, GLint internalformat, GLsizei width, GLint border, GLenum format, GLenum type, const void *pixels), (target, level, internalformat, width, border, format, type, pixels))
+GL_VOID_FUNCTION(glTexImage2D, (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const void *pixels), (target, level, internalformat, width, height, border, format, type, pixels))
+GL_VOID_FUNCTION(glDrawBuffer, (GLenum buf), (buf))
+GL_VOID_FUNCTION(glClear, (GLbitfield mask), (mask))
+GL_VOID_FUNCTION(glClearColor, (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha), (red, green, blue, alpha))
+GL_VOID_FUNCTION(glClearStencil, (GLint s), (s))
+GL_VOID_FUNCTION(glClearDepth, (GLdouble depth), (depth))
+GL_VOID_FUNCTION(glStencilMask, (GLuint mask), (mask))
+GL_VOID_FUNCTION(glColorMask, (GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha), (red, green, blue, alpha))
+GL_VOID_FUNCTION(glDepthMask, (GLboolean flag), (flag))
+GL_VOID_FUNCTION(glDisable, (GLenum cap), (cap))
+GL_VOID_FUNCTION(glEnable, (GLenum cap), (cap))
+GL_VOID_FUNCTION(glFinish, (void), ())
+GL_VOID_FUNCTION(glFlush, (void), ())
+GL_VOID_FUNCTION(glBlendFunc, (GLenum sfactor, GLenum dfactor), (sfactor, dfactor))
+GL_VOID_FUNCTION(glLogicOp, (GLenum opcode), (opcode))
+GL_VOID_FUNCTION(glStencilFunc, (GLenum func, GLint ref, GLuint mask), (func, ref, mask))
+GL_VOID_FUNCTION(glStencilOp, (GLenum fail, GLenum zfail, GLenum zpass), (fail, zfail, zpass))
+GL_VOID_FUNCTION(glDepthFunc, (GLenum func), (func))
+GL_VOID_FUNCTION(glPixelStoref, (GLenum pname, GLfloat param), (pname, param))
+GL_VOID_FUNCTION(glPixelStorei, (GLenum pname, GLint param), (pname, param))
+GL_VOID_FUNCTION(glReadBuffer, (GLenum src), (src))
+GL_VOID_FUNCTION(glReadPixels, (GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, void *pixels), (x, y, width, height, format, type, pixels))
+GL_VOID_FUNCTION(glGetBooleanv, (GLenum pname, GLboolean *data), (pname, data))
+GL_VOID_FUNCTION(glGetDoublev, (GLenum pname, GLdouble *data), (pname, data))
+GL_FUNCTION(GLenum, glGetError, (void), ())
+GL_VOID_FUNCTION(glGetFloatv, (GLenum pname, GLfloat *data), (pname, data))
+GL_VOID_FUNCTION(glGetIntegerv, (GLenum pname, GLint *data), (pname, data))
+GL_FUNCTION(const GLubyte *, glGetString, (GLenum name), (name))
+GL_VOID_FUNCTION(glGetTexImage, (GLenum target, GLint level, GLenum format, GLenum type, void *pixels), (target, level, format, type, pixels))
+GL_VOID_FUNCTION(glGetTexParameterfv, (GLenum target, GLenum pname, GLfloat *params), (target, pname, params))
+GL_VOID_FUNCTION(glGetTexParameteriv, (GLenum target, GLenum pname, GLint *params), (target, pname, params))
+GL_VOID_FUNCTION(glGetTexLevelParameterfv, (GLenum target, GLint level, GLenum pname, GLfloat *params), (target, level, pname, params))
+GL_VOID_FUNCTION(glGetTexLevelParameteriv, (GLenum target, GLint level, GLenum pname, GLint *params), (target, level, pname, params))
+GL_FUNCTION(GLboolean, glIsEnabled, (GLenum cap), (cap))
+GL_VOID_FUNCTION(glDepthRange, (GLdouble n, GLdouble f), (n, f))
+GL_VOID_FUNCTION(glViewport, (GLint x, GLint y, GLsizei width, GLsizei height), (x, y, width, height))
+GL_VOID_FUNCTION(glDrawArrays, (GLenum mode, GLint first, GLsizei count), (mode, first, count))
+GL_VOID_FUNCTION(glDrawElements, (GLenum mode, GLsizei count, GLenum type, const void *indices), (mode, count, type, indices))
+GL_VOID_FUNCTION(glGetPointerv, (GLenum pname, void **params), (pname, params))
+GL_VOID_FUNCTION(glPolygonOffset, (GLfloat factor, GLfloat units), (factor, units))
+GL_VOID_FUNCTION(glCopyTexImage1D, (GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLint border), (target, level, internalformat, x, y, width, border))
+GL_VOID_FUNCTION(glCopyTexImage2D, (GLenum target, GLint level, GLenum internalformat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border), (target, level, internalformat, x, y, width, height, border))
+GL_VOID_FUNCTION(glCopyTexSubImage1D, (GLenum target, GLint level, GLint xoffset, GLint x, GLint y, GLsizei width), (target, level, xoffset, x, y, width))
+GL_VOID_FUNCTION(glCopyTexSubImage2D, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height), (target, level, xoffset, yoffset, x, y, width, height))
+GL_VOID_FUNCTION(glTexSubImage1D, (GLenum target, GLint level, GLint xoffset, GLsizei width, GLenum format, GLenum type, const void *pixels), (target, level, xoffset, width, format, type, pixels))
+GL_VOID_FUNCTION(glTexSubImage2D, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void *pixels), (target, level, xoffset, yoffset, width, height, format, type, pixels))
+GL_VOID_FUNCTION(glBindTexture, (GLenum target, GLuint texture), (target, texture))
+GL_VOID_FUNCTION(glDeleteTextures, (GLsizei n, const GLuint *textures), (n, textures))
+GL_VOID_FUNCTION(glGenTextures, (GLsizei n, GLuint *textures), (n, textures))
+GL_FUNCTION(GLboolean, glIsTexture, (GLuint texture), (texture))
+GL_VOID_FUNCTION(glDrawRangeElements, (GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type, const void *indices), (mode, start, end, count, type, indices))
+GL_VOID_FUNCTION(glTexImage3D, (GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const void *pixels), (target, level, internalformat, width, height, depth, border, format, type, pixels))
+GL_VOID_FUNCTION(glTexSubImage3D, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void *pixels), (target, level, xoffset, yoffset, zoffset, width, height, depth, format, type, pixels))
+GL_VOID_FUNCTION(glCopyTexSubImage3D, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLint x, GLint y, GLsizei width, GLsizei height), (target, level, xoffset, yoffset, zoffset, x, y, width, height))
+GL_VOID_FUNCTION(glActiveTexture, (GLenum texture), (texture))
+GL_VOID_FUNCTION(glSampleCoverage, (GLfloat value, GLboolean invert), (value, invert))
+GL_VOID_FUNCTION(glCompressedTexImage3D, (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLsizei imageSize, const void *data), (target, level, internalformat, width, height, depth, border, imageSize, data))
+GL_VOID_FUNCTION(glCompressedTexImage2D, (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLsizei height, GLint border, GLsizei imageSize, const void *data), (target, level, internalformat, width, height, border, imageSize, data))
+GL_VOID_FUNCTION(glCompressedTexImage1D, (GLenum target, GLint level, GLenum internalformat, GLsizei width, GLint border, GLsizei imageSize, const void *data), (target, level, internalformat, width, border, imageSize, data))
+GL_VOID_FUNCTION(glCompressedTexSubImage3D, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLsizei imageSize, const void *data), (target, level, xoffset, yoffset, zoffset, width, height, depth, format, imageSize, data))
+GL_VOID_FUNCTION(glCompressedTexSubImage2D, (GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const void *data), (target, level, xoffset, yoffset, width, height, format, imageSize, data))
+GL_VOID_FUNCTION(glCompressedTexSubImage1D, (GLenum target, GLint level, GLint xoffset, GLsizei width, GLenum format, GLsizei imageSize, const void *data), (target, level, xoffset, width, format, imageSize, data))
+GL_VOID_FUNCTION(glGetCompressedTexImage, (GLenum target, GLint level, void *img), (target, level, img))
+GL_VOID_FUNCTION(glBlendFuncSeparate, (GLenum sfactorRGB, GLenum dfactorRGB, GLenum sfactorAlpha, GLenum dfactorAlpha), (sfactorRGB, dfactorRGB, sfactorAlpha, dfactorAlpha))
+GL_VOID_FUNCTION(glMultiDrawArrays, (GLenum mode, const GLint *first, const GLsizei *count, GLsizei drawcount), (mode, first, count, drawcount))
+GL_VOID_FUNCTION(glMultiDrawElements, (GLenum mode, const GLsizei *count, GLenum type, const void *const*indices, GLsizei drawcount), (mode, count, type, indices, drawcount))
+GL_VOID_FUNCTION(glPointParameterf, (GLenum pname, GLfloat param), (pname, param))
+GL_VOID_FUNCTION(glPointParameterfv, (GLenum pname, const GLfloat *params), (pname, params))
+GL_VOID_FUNCTION(glPointParameteri, (GLenum pname, GLint param), (pname, param))
+GL_VOID_FUNCTION(glPointParameteriv, (GLenum pname, const GLint *params), (pname, params))
+GL_VOID_FUNCTION(glBlendColor, (GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha), (red, green, blue, alpha))
+GL_VOID_FUNCTION(glBlendEquation, (GLenum mode), (mode))
+GL_VOID_FUNCTION(glGenQueries, (GLsizei n, GLuint *ids), (n, ids))
+GL_VOID_FUNCTION(glDeleteQueries, (GLsizei n, const GLuint *ids), (n, ids))
+GL_FUNCTION(GLboolean, glIsQuery, (GLuint id), (id))
+GL_VOID_FUNCTION(glBeginQuery, (GLenum target, GLuint id), (target, id))
+GL_VOID_FUNCTION(glEndQuery, (GLenum target), (target))
+GL_VOID_FUNCTION(glGetQueryiv, (GLenum target, GLenum pname, GLint *params), (target, pname, params))
+GL_VOID_FUNCTION(glGetQueryObjectiv, (GLuint id, GLenum pname, GLint *params), (id, pname, params))
+GL_VOID_FUNCTION(glGetQueryObjectuiv, (GLuint id, GLenum pname, GLuint *params), (id, pname, params))
+GL_VOID_FUNCTION(glBindBuffer, (GLenum target, GLuint buffer), (target, buffer))
+GL_VOID_FUNCTION(glDeleteBuffers, (GLsizei n, const GLuint *buffers), (n, buffers))
+GL_VOID_FUNCTION(glGenBuffers, (GLsizei n, GLuint *buffers), (n, buffers))
+GL_FUNCTION(GLboolean, glIsBuffer, (GLuint buffer), (buffer))
+GL_VOID_FUNCTION(glBufferData, (GLenum target, GLsizeiptr size, const void *data, GLenum usage), (target, size, data, usage))
+GL_VOID_FUNCTION(glBufferSubData, (GLenum target, GLintptr offset, GLsizeiptr size, const void *data), (target, offset, size, data))
+GL_VOID_FUNCTION(glGetBufferSubData, (GLenum target, GLintptr offset, GLsizeiptr size, void *data), (target, offset, size, data))
+GL_FUNCTION(void *, glMapBuffer, (GLenum target, GLenum access), (target, access))
+GL_FUNCTION(GLboolean, glUnmapBuffer, (GLenum target), (target))
+GL_VOID_FUNCTION(glGetBufferParameteriv, (GLenum target, GLenum pname, GLint *params), (target, pname, params))
+GL_VOID_FUNCTION(glGetBufferPointerv, (GLenum target, GLenum pname, void **params), (target, pname, params))
+GL_VOID_FUNCTION(glBlendEquationSeparate, (GLenum modeRGB, GLenum modeAlpha), (modeRGB, modeAlpha))
+GL_VOID_FUNCTION(glDrawBuffers, (GLsizei n, const GLenum *bufs), (n, bufs))
+GL_VOID_FUNCTION(glStencilOpSeparate, (GLenum face, GLenum sfail, GLenum dpfail, GLenum dppass), (face, sfail, dpfail, dppass))
+GL_VOID_FUNCTION(glStencilFuncSeparate, (GLenum face, GLenum func, GLint ref, GLuint mask), (face, func, ref, mask))
+GL_VOID_FUNCTION(glStencilMaskSeparate, (GLenum face, GLuint mask), (face, mask))
+GL_VOID_FUNCTION(glAttachShader, (GLuint program, GLuint shader), (program, shader))
+GL_VOID_FUNCTION(glBindAttribLocation, (GLuint program, GLuint index, const GLchar *name), (program, index, name))
+GL_VOID_FUNCTION(glCompileShader, (GLuint shader), (shader))
+GL_FUNCTION(GLuint, glCreateProgram, (void), ())
+GL_FUNCTION(GLuint, glCreateShader, (GLenum type), (type))
+GL_VOID_FUNCTION(glDeleteProgram, (GLuint program), (program))
+GL_VOID_FUNCTION(glDeleteShader, (GLuint shader), (shader))
+GL_VOID_FUNCTION(glDetachShader, (GLuint program, GLuint shader), (program, shader))
+GL_VOID_FUNCTION(glDisableVertexAttribArray, (GLuint index), (index))
+GL_VOID_FUNCTION(glEnableVertexAttribArray, (GLuint index), (index))
+GL_VOID_FUNCTION(glGetActiveAttrib, (GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name), (program, index, bufSize, length, size, type, name))
+GL_VOID_FUNCTION(glGetActiveUniform, (GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLint *size, GLenum *type, GLchar *name), (program, index, bufSize, length, size, type, name))
+GL_VOID_FUNCTION(glGetAttachedShaders, (GLuint program, GLsizei maxCount, GLsizei *count, GLuint *shaders), (program, maxCount, count, shaders))
+GL_FUNCTION(GLint, glGetAttribLocation, (GLuint program, const GLchar *name), (program, name))
+GL_VOID_FUNCTION(glGetProgramiv, (GLuint program, GLenum pname, GLint *params), (program, pname, params))
+GL_VOID_FUNCTION(glGetProgramInfoLog, (GLuint program, GLsizei bufSize, GLsizei *length, GLchar *infoLog), (program, bufSize, length, infoLog))
+GL_VOID_FUNCTION(glGetShaderiv, (GLuint shader, GLenum pname, GLint *params), (shader, pname, params))
+GL_VOID_FUNCTION(glGetShaderInfoLog, (GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *infoLog), (shader, bufSize, length, infoLog))
+GL_VOID_FUNCTION(glGetShaderSource, (GLuint shader, GLsizei bufSize, GLsizei *length, GLchar *source), (shader, bufSize, length, source))
+GL_FUNCTION(GLint, glGetUniformLocation, (GLuint program, const GLchar *name), (program, name))
+GL_VOID_FUNCTION(glGetUniformfv, (GLuint program, GLint location, GLfloat *params), (program, location, params))
+GL_VOID_FUNCTION(glGetUniformiv, (GLuint program, GLint location, GLint *params), (program, location, params))
+GL_VOID_FUNCTION(glGetVertexAttribdv, (GLuint index, GLenum pname, GLdouble *params), (index, pname, params))
+GL_VOID_FUNCTION(glGetVertexAttribfv, (GLuint index, GLenum pname, GLfloat *params), (index, pname, params))
+GL_VOID_FUNCTION(glGetVertexAttribiv, (GLuint index, GLenum pname, GLint *params), (index, pname, params))
+GL_VOID_FUNCTION(glGetVertexAttribPointerv, (GLuint index, GLenum pname, void **pointer), (index, pname, pointer))
+GL_FUNCTION(GLboolean, glIsProgram, (GLuint program), (program))
+GL_FUNCTION(GLboolean, glIsShader, (GLuint shader), (shader))
+GL_VOID_FUNCTION(glLinkProgram, (GLuint program), (program))
+GL_VOID_FUNCTION(glShaderSource, (GLuint shader, GLsizei count, const GLchar *const*string, const GLint *length), (shader, count, string, length))
+GL_VOID_FUNCTION(glUseProgram, (GLuint program), (program))
+GL_VOID_FUNCTION(glUniform1f, (GLint location, GLfloat v0), (location, v0))
+GL_VOID_FUNCTION(glUniform2f, (GLint location, GLfloat v0, GLfloat v1), (location, v0, v1))
+GL_VOID_FUNCTION(glUniform3f, (GLint location, GLfloat v0, GLfloat v1, GLfloat v2), (location, v0, v1, v2))
+GL_VOID_FUNCTION(glUniform4f, (GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3), (location, v0, v1, v2, v3))
+GL_VOID_FUNCTION(glUniform1i, (GLint location, GLint v0), (location, v0))
+GL_VOID_FUNCTION(glUniform2i, (GLint location, GLint v0, GLint v1), (location, v0, v1))
+GL_VOID_FUNCTION(glUniform3i, (GLint location, GLint v0, GLint v1, GLint v2), (location, v0, v1, v2))
+GL_VOID_FUNCTION(glUniform4i, (GLint location, GLint v0, GLint v1, GLint v2, GLint v3), (location, v0, v1, v2, v3))
+GL_VOID_FUNCTION(glUniform1fv, (GLint location, GLsizei count, const GLfloat *value), (location, count, value))
+GL_VOID_FUNCTION(glUniform2fv, (GLint location, GLsizei count, const GLfloat *value), (location, count, value))
+GL_VOID_FUNCTION(glUniform3fv, (GLint location, GLsizei count, const GLfloat *value), (location, count, value))
+GL_VOID_FUNCTION(glUniform4fv, (GLint location, GLsizei count, const GLfloat *value), (location, count, value))
+GL_VOID_FUNCTION(glUniform1iv, (GLint location, GLsizei count, const GLint *value), (location, count, value))
+GL_VOID_FUNCTION(glUniform2iv, (GLint location, GLsizei count, const GLint *value), (location, count, value))
+GL_VOID_FUNCTION(glUniform3iv, (GLint location, GLsizei count, const GLint *value), (location, count, value))
+GL_VOID_FUNCTION(glUniform4iv, (GLint location, GLsizei count, const GLint *value), (location, count, value))
+GL_VOID_FUNCTION(glUniformMatrix2fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (location, count, transpose, value))
+GL_VOID_FUNCTION(glUniformMatrix3fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (location, count, transpose, value))
+GL_VOID_FUNCTION(glUniformMatrix4fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (location, count, transpose, value))
+GL_VOID_FUNCTION(glValidateProgram, (GLuint program), (program))
+GL_VOID_FUNCTION(glVertexAttrib1d, (GLuint index, GLdouble x), (index, x))
+GL_VOID_FUNCTION(glVertexAttrib1dv, (GLuint index, const GLdouble *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttrib1f, (GLuint index, GLfloat x), (index, x))
+GL_VOID_FUNCTION(glVertexAttrib1fv, (GLuint index, const GLfloat *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttrib1s, (GLuint index, GLshort x), (index, x))
+GL_VOID_FUNCTION(glVertexAttrib1sv, (GLuint index, const GLshort *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttrib2d, (GLuint index, GLdouble x, GLdouble y), (index, x, y))
+GL_VOID_FUNCTION(glVertexAttrib2dv, (GLuint index, const GLdouble *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttrib2f, (GLuint index, GLfloat x, GLfloat y), (index, x, y))
+GL_VOID_FUNCTION(glVertexAttrib2fv, (GLuint index, const GLfloat *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttrib2s, (GLuint index, GLshort x, GLshort y), (index, x, y))
+GL_VOID_FUNCTION(glVertexAttrib2sv, (GLuint index, const GLshort *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttrib3d, (GLuint index, GLdouble x, GLdouble y, GLdouble z), (index, x, y, z))
+GL_VOID_FUNCTION(glVertexAttrib3dv, (GLuint index, const GLdouble *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttrib3f, (GLuint index, GLfloat x, GLfloat y, GLfloat z), (index, x, y, z))
+GL_VOID_FUNCTION(glVertexAttrib3fv, (GLuint index, const GLfloat *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttrib3s, (GLuint index, GLshort x, GLshort y, GLshort z), (index, x, y, z))
+GL_VOID_FUNCTION(glVertexAttrib3sv, (GLuint index, const GLshort *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttrib4Nbv, (GLuint index, const GLbyte *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttrib4Niv, (GLuint index, const GLint *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttrib4Nsv, (GLuint index, const GLshort *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttrib4Nub, (GLuint index, GLubyte x, GLubyte y, GLubyte z, GLubyte w), (index, x, y, z, w))
+GL_VOID_FUNCTION(glVertexAttrib4Nubv, (GLuint index, const GLubyte *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttrib4Nuiv, (GLuint index, const GLuint *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttrib4Nusv, (GLuint index, const GLushort *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttrib4bv, (GLuint index, const GLbyte *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttrib4d, (GLuint index, GLdouble x, GLdouble y, GLdouble z, GLdouble w), (index, x, y, z, w))
+GL_VOID_FUNCTION(glVertexAttrib4dv, (GLuint index, const GLdouble *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttrib4f, (GLuint index, GLfloat x, GLfloat y, GLfloat z, GLfloat w), (index, x, y, z, w))
+GL_VOID_FUNCTION(glVertexAttrib4fv, (GLuint index, const GLfloat *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttrib4iv, (GLuint index, const GLint *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttrib4s, (GLuint index, GLshort x, GLshort y, GLshort z, GLshort w), (index, x, y, z, w))
+GL_VOID_FUNCTION(glVertexAttrib4sv, (GLuint index, const GLshort *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttrib4ubv, (GLuint index, const GLubyte *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttrib4uiv, (GLuint index, const GLuint *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttrib4usv, (GLuint index, const GLushort *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttribPointer, (GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void *pointer), (index, size, type, normalized, stride, pointer))
+GL_VOID_FUNCTION(glUniformMatrix2x3fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (location, count, transpose, value))
+GL_VOID_FUNCTION(glUniformMatrix3x2fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (location, count, transpose, value))
+GL_VOID_FUNCTION(glUniformMatrix2x4fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (location, count, transpose, value))
+GL_VOID_FUNCTION(glUniformMatrix4x2fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (location, count, transpose, value))
+GL_VOID_FUNCTION(glUniformMatrix3x4fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (location, count, transpose, value))
+GL_VOID_FUNCTION(glUniformMatrix4x3fv, (GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (location, count, transpose, value))
+GL_VOID_FUNCTION(glColorMaski, (GLuint index, GLboolean r, GLboolean g, GLboolean b, GLboolean a), (index, r, g, b, a))
+GL_VOID_FUNCTION(glGetBooleani_v, (GLenum target, GLuint index, GLboolean *data), (target, index, data))
+GL_VOID_FUNCTION(glGetIntegeri_v, (GLenum target, GLuint index, GLint *data), (target, index, data))
+GL_VOID_FUNCTION(glEnablei, (GLenum target, GLuint index), (target, index))
+GL_VOID_FUNCTION(glDisablei, (GLenum target, GLuint index), (target, index))
+GL_FUNCTION(GLboolean, glIsEnabledi, (GLenum target, GLuint index), (target, index))
+GL_VOID_FUNCTION(glBeginTransformFeedback, (GLenum primitiveMode), (primitiveMode))
+GL_VOID_FUNCTION(glEndTransformFeedback, (void), ())
+GL_VOID_FUNCTION(glBindBufferRange, (GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size), (target, index, buffer, offset, size))
+GL_VOID_FUNCTION(glBindBufferBase, (GLenum target, GLuint index, GLuint buffer), (target, index, buffer))
+GL_VOID_FUNCTION(glTransformFeedbackVaryings, (GLuint program, GLsizei count, const GLchar *const*varyings, GLenum bufferMode), (program, count, varyings, bufferMode))
+GL_VOID_FUNCTION(glGetTransformFeedbackVarying, (GLuint program, GLuint index, GLsizei bufSize, GLsizei *length, GLsizei *size, GLenum *type, GLchar *name), (program, index, bufSize, length, size, type, name))
+GL_VOID_FUNCTION(glClampColor, (GLenum target, GLenum clamp), (target, clamp))
+GL_VOID_FUNCTION(glBeginConditionalRender, (GLuint id, GLenum mode), (id, mode))
+GL_VOID_FUNCTION(glEndConditionalRender, (void), ())
+GL_VOID_FUNCTION(glVertexAttribIPointer, (GLuint index, GLint size, GLenum type, GLsizei stride, const void *pointer), (index, size, type, stride, pointer))
+GL_VOID_FUNCTION(glGetVertexAttribIiv, (GLuint index, GLenum pname, GLint *params), (index, pname, params))
+GL_VOID_FUNCTION(glGetVertexAttribIuiv, (GLuint index, GLenum pname, GLuint *params), (index, pname, params))
+GL_VOID_FUNCTION(glVertexAttribI1i, (GLuint index, GLint x), (index, x))
+GL_VOID_FUNCTION(glVertexAttribI2i, (GLuint index, GLint x, GLint y), (index, x, y))
+GL_VOID_FUNCTION(glVertexAttribI3i, (GLuint index, GLint x, GLint y, GLint z), (index, x, y, z))
+GL_VOID_FUNCTION(glVertexAttribI4i, (GLuint index, GLint x, GLint y, GLint z, GLint w), (index, x, y, z, w))
+GL_VOID_FUNCTION(glVertexAttribI1ui, (GLuint index, GLuint x), (index, x))
+GL_VOID_FUNCTION(glVertexAttribI2ui, (GLuint index, GLuint x, GLuint y), (index, x, y))
+GL_VOID_FUNCTION(glVertexAttribI3ui, (GLuint index, GLuint x, GLuint y, GLuint z), (index, x, y, z))
+GL_VOID_FUNCTION(glVertexAttribI4ui, (GLuint index, GLuint x, GLuint y, GLuint z, GLuint w), (index, x, y, z, w))
+GL_VOID_FUNCTION(glVertexAttribI1iv, (GLuint index, const GLint *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttribI2iv, (GLuint index, const GLint *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttribI3iv, (GLuint index, const GLint *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttribI4iv, (GLuint index, const GLint *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttribI1uiv, (GLuint index, const GLuint *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttribI2uiv, (GLuint index, const GLuint *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttribI3uiv, (GLuint index, const GLuint *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttribI4uiv, (GLuint index, const GLuint *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttribI4bv, (GLuint index, const GLbyte *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttribI4sv, (GLuint index, const GLshort *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttribI4ubv, (GLuint index, const GLubyte *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttribI4usv, (GLuint index, const GLushort *v), (index, v))
+GL_VOID_FUNCTION(glGetUniformuiv, (GLuint program, GLint location, GLuint *params), (program, location, params))
+GL_VOID_FUNCTION(glBindFragDataLocation, (GLuint program, GLuint color, const GLchar *name), (program, color, name))
+GL_FUNCTION(GLint, glGetFragDataLocation, (GLuint program, const GLchar *name), (program, name))
+GL_VOID_FUNCTION(glUniform1ui, (GLint location, GLuint v0), (location, v0))
+GL_VOID_FUNCTION(glUniform2ui, (GLint location, GLuint v0, GLuint v1), (location, v0, v1))
+GL_VOID_FUNCTION(glUniform3ui, (GLint location, GLuint v0, GLuint v1, GLuint v2), (location, v0, v1, v2))
+GL_VOID_FUNCTION(glUniform4ui, (GLint location, GLuint v0, GLuint v1, GLuint v2, GLuint v3), (location, v0, v1, v2, v3))
+GL_VOID_FUNCTION(glUniform1uiv, (GLint location, GLsizei count, const GLuint *value), (location, count, value))
+GL_VOID_FUNCTION(glUniform2uiv, (GLint location, GLsizei count, const GLuint *value), (location, count, value))
+GL_VOID_FUNCTION(glUniform3uiv, (GLint location, GLsizei count, const GLuint *value), (location, count, value))
+GL_VOID_FUNCTION(glUniform4uiv, (GLint location, GLsizei count, const GLuint *value), (location, count, value))
+GL_VOID_FUNCTION(glTexParameterIiv, (GLenum target, GLenum pname, const GLint *params), (target, pname, params))
+GL_VOID_FUNCTION(glTexParameterIuiv, (GLenum target, GLenum pname, const GLuint *params), (target, pname, params))
+GL_VOID_FUNCTION(glGetTexParameterIiv, (GLenum target, GLenum pname, GLint *params), (target, pname, params))
+GL_VOID_FUNCTION(glGetTexParameterIuiv, (GLenum target, GLenum pname, GLuint *params), (target, pname, params))
+GL_VOID_FUNCTION(glClearBufferiv, (GLenum buffer, GLint drawbuffer, const GLint *value), (buffer, drawbuffer, value))
+GL_VOID_FUNCTION(glClearBufferuiv, (GLenum buffer, GLint drawbuffer, const GLuint *value), (buffer, drawbuffer, value))
+GL_VOID_FUNCTION(glClearBufferfv, (GLenum buffer, GLint drawbuffer, const GLfloat *value), (buffer, drawbuffer, value))
+GL_VOID_FUNCTION(glClearBufferfi, (GLenum buffer, GLint drawbuffer, GLfloat depth, GLint stencil), (buffer, drawbuffer, depth, stencil))
+GL_FUNCTION(const GLubyte *, glGetStringi, (GLenum name, GLuint index), (name, index))
+GL_FUNCTION(GLboolean, glIsRenderbuffer, (GLuint renderbuffer), (renderbuffer))
+GL_VOID_FUNCTION(glBindRenderbuffer, (GLenum target, GLuint renderbuffer), (target, renderbuffer))
+GL_VOID_FUNCTION(glDeleteRenderbuffers, (GLsizei n, const GLuint *renderbuffers), (n, renderbuffers))
+GL_VOID_FUNCTION(glGenRenderbuffers, (GLsizei n, GLuint *renderbuffers), (n, renderbuffers))
+GL_VOID_FUNCTION(glRenderbufferStorage, (GLenum target, GLenum internalformat, GLsizei width, GLsizei height), (target, internalformat, width, height))
+GL_VOID_FUNCTION(glGetRenderbufferParameteriv, (GLenum target, GLenum pname, GLint *params), (target, pname, params))
+GL_FUNCTION(GLboolean, glIsFramebuffer, (GLuint framebuffer), (framebuffer))
+GL_VOID_FUNCTION(glBindFramebuffer, (GLenum target, GLuint framebuffer), (target, framebuffer))
+GL_VOID_FUNCTION(glDeleteFramebuffers, (GLsizei n, const GLuint *framebuffers), (n, framebuffers))
+GL_VOID_FUNCTION(glGenFramebuffers, (GLsizei n, GLuint *framebuffers), (n, framebuffers))
+GL_FUNCTION(GLenum, glCheckFramebufferStatus, (GLenum target), (target))
+GL_VOID_FUNCTION(glFramebufferTexture1D, (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level), (target, attachment, textarget, texture, level))
+GL_VOID_FUNCTION(glFramebufferTexture2D, (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level), (target, attachment, textarget, texture, level))
+GL_VOID_FUNCTION(glFramebufferTexture3D, (GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level, GLint zoffset), (target, attachment, textarget, texture, level, zoffset))
+GL_VOID_FUNCTION(glFramebufferRenderbuffer, (GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer), (target, attachment, renderbuffertarget, renderbuffer))
+GL_VOID_FUNCTION(glGetFramebufferAttachmentParameteriv, (GLenum target, GLenum attachment, GLenum pname, GLint *params), (target, attachment, pname, params))
+GL_VOID_FUNCTION(glGenerateMipmap, (GLenum target), (target))
+GL_VOID_FUNCTION(glBlitFramebuffer, (GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter), (srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter))
+GL_VOID_FUNCTION(glRenderbufferStorageMultisample, (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height), (target, samples, internalformat, width, height))
+GL_VOID_FUNCTION(glFramebufferTextureLayer, (GLenum target, GLenum attachment, GLuint texture, GLint level, GLint layer), (target, attachment, texture, level, layer))
+GL_FUNCTION(void *, glMapBufferRange, (GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access), (target, offset, length, access))
+GL_VOID_FUNCTION(glFlushMappedBufferRange, (GLenum target, GLintptr offset, GLsizeiptr length), (target, offset, length))
+GL_VOID_FUNCTION(glBindVertexArray, (GLuint array), (array))
+GL_VOID_FUNCTION(glDeleteVertexArrays, (GLsizei n, const GLuint *arrays), (n, arrays))
+GL_VOID_FUNCTION(glGenVertexArrays, (GLsizei n, GLuint *arrays), (n, arrays))
+GL_FUNCTION(GLboolean, glIsVertexArray, (GLuint array), (array))
+GL_VOID_FUNCTION(glDrawArraysInstanced, (GLenum mode, GLint first, GLsizei count, GLsizei instancecount), (mode, first, count, instancecount))
+GL_VOID_FUNCTION(glDrawElementsInstanced, (GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instancecount), (mode, count, type, indices, instancecount))
+GL_VOID_FUNCTION(glTexBuffer, (GLenum target, GLenum internalformat, GLuint buffer), (target, internalformat, buffer))
+GL_VOID_FUNCTION(glPrimitiveRestartIndex, (GLuint index), (index))
+GL_VOID_FUNCTION(glCopyBufferSubData, (GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size), (readTarget, writeTarget, readOffset, writeOffset, size))
+GL_VOID_FUNCTION(glGetUniformIndices, (GLuint program, GLsizei uniformCount, const GLchar *const*uniformNames, GLuint *uniformIndices), (program, uniformCount, uniformNames, uniformIndices))
+GL_VOID_FUNCTION(glGetActiveUniformsiv, (GLuint program, GLsizei uniformCount, const GLuint *uniformIndices, GLenum pname, GLint *params), (program, uniformCount, uniformIndices, pname, params))
+GL_VOID_FUNCTION(glGetActiveUniformName, (GLuint program, GLuint uniformIndex, GLsizei bufSize, GLsizei *length, GLchar *uniformName), (program, uniformIndex, bufSize, length, uniformName))
+GL_FUNCTION(GLuint, glGetUniformBlockIndex, (GLuint program, const GLchar *uniformBlockName), (program, uniformBlockName))
+GL_VOID_FUNCTION(glGetActiveUniformBlockiv, (GLuint program, GLuint uniformBlockIndex, GLenum pname, GLint *params), (program, uniformBlockIndex, pname, params))
+GL_VOID_FUNCTION(glGetActiveUniformBlockName, (GLuint program, GLuint uniformBlockIndex, GLsizei bufSize, GLsizei *length, GLchar *uniformBlockName), (program, uniformBlockIndex, bufSize, length, uniformBlockName))
+GL_VOID_FUNCTION(glUniformBlockBinding, (GLuint program, GLuint uniformBlockIndex, GLuint uniformBlockBinding), (program, uniformBlockIndex, uniformBlockBinding))
+GL_VOID_FUNCTION(glDrawElementsBaseVertex, (GLenum mode, GLsizei count, GLenum type, const void *indices, GLint basevertex), (mode, count, type, indices, basevertex))
+GL_VOID_FUNCTION(glDrawRangeElementsBaseVertex, (GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type, const void *indices, GLint basevertex), (mode, start, end, count, type, indices, basevertex))
+GL_VOID_FUNCTION(glDrawElementsInstancedBaseVertex, (GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instancecount, GLint basevertex), (mode, count, type, indices, instancecount, basevertex))
+GL_VOID_FUNCTION(glMultiDrawElementsBaseVertex, (GLenum mode, const GLsizei *count, GLenum type, const void *const*indices, GLsizei drawcount, const GLint *basevertex), (mode, count, type, indices, drawcount, basevertex))
+GL_VOID_FUNCTION(glProvokingVertex, (GLenum mode), (mode))
+GL_FUNCTION(GLsync, glFenceSync, (GLenum condition, GLbitfield flags), (condition, flags))
+GL_FUNCTION(GLboolean, glIsSync, (GLsync sync), (sync))
+GL_VOID_FUNCTION(glDeleteSync, (GLsync sync), (sync))
+GL_FUNCTION(GLenum, glClientWaitSync, (GLsync sync, GLbitfield flags, GLuint64 timeout), (sync, flags, timeout))
+GL_VOID_FUNCTION(glWaitSync, (GLsync sync, GLbitfield flags, GLuint64 timeout), (sync, flags, timeout))
+GL_VOID_FUNCTION(glGetInteger64v, (GLenum pname, GLint64 *data), (pname, data))
+GL_VOID_FUNCTION(glGetSynciv, (GLsync sync, GLenum pname, GLsizei count, GLsizei *length, GLint *values), (sync, pname, count, length, values))
+GL_VOID_FUNCTION(glGetInteger64i_v, (GLenum target, GLuint index, GLint64 *data), (target, index, data))
+GL_VOID_FUNCTION(glGetBufferParameteri64v, (GLenum target, GLenum pname, GLint64 *params), (target, pname, params))
+GL_VOID_FUNCTION(glFramebufferTexture, (GLenum target, GLenum attachment, GLuint texture, GLint level), (target, attachment, texture, level))
+GL_VOID_FUNCTION(glTexImage2DMultisample, (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLboolean fixedsamplelocations), (target, samples, internalformat, width, height, fixedsamplelocations))
+GL_VOID_FUNCTION(glTexImage3DMultisample, (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLboolean fixedsamplelocations), (target, samples, internalformat, width, height, depth, fixedsamplelocations))
+GL_VOID_FUNCTION(glGetMultisamplefv, (GLenum pname, GLuint index, GLfloat *val), (pname, index, val))
+GL_VOID_FUNCTION(glSampleMaski, (GLuint maskNumber, GLbitfield mask), (maskNumber, mask))
+GL_VOID_FUNCTION(glBindFragDataLocationIndexed, (GLuint program, GLuint colorNumber, GLuint index, const GLchar *name), (program, colorNumber, index, name))
+GL_FUNCTION(GLint, glGetFragDataIndex, (GLuint program, const GLchar *name), (program, name))
+GL_VOID_FUNCTION(glGenSamplers, (GLsizei count, GLuint *samplers), (count, samplers))
+GL_VOID_FUNCTION(glDeleteSamplers, (GLsizei count, const GLuint *samplers), (count, samplers))
+GL_FUNCTION(GLboolean, glIsSampler, (GLuint sampler), (sampler))
+GL_VOID_FUNCTION(glBindSampler, (GLuint unit, GLuint sampler), (unit, sampler))
+GL_VOID_FUNCTION(glSamplerParameteri, (GLuint sampler, GLenum pname, GLint param), (sampler, pname, param))
+GL_VOID_FUNCTION(glSamplerParameteriv, (GLuint sampler, GLenum pname, const GLint *param), (sampler, pname, param))
+GL_VOID_FUNCTION(glSamplerParameterf, (GLuint sampler, GLenum pname, GLfloat param), (sampler, pname, param))
+GL_VOID_FUNCTION(glSamplerParameterfv, (GLuint sampler, GLenum pname, const GLfloat *param), (sampler, pname, param))
+GL_VOID_FUNCTION(glSamplerParameterIiv, (GLuint sampler, GLenum pname, const GLint *param), (sampler, pname, param))
+GL_VOID_FUNCTION(glSamplerParameterIuiv, (GLuint sampler, GLenum pname, const GLuint *param), (sampler, pname, param))
+GL_VOID_FUNCTION(glGetSamplerParameteriv, (GLuint sampler, GLenum pname, GLint *params), (sampler, pname, params))
+GL_VOID_FUNCTION(glGetSamplerParameterIiv, (GLuint sampler, GLenum pname, GLint *params), (sampler, pname, params))
+GL_VOID_FUNCTION(glGetSamplerParameterfv, (GLuint sampler, GLenum pname, GLfloat *params), (sampler, pname, params))
+GL_VOID_FUNCTION(glGetSamplerParameterIuiv, (GLuint sampler, GLenum pname, GLuint *params), (sampler, pname, params))
+GL_VOID_FUNCTION(glQueryCounter, (GLuint id, GLenum target), (id, target))
+GL_VOID_FUNCTION(glGetQueryObjecti64v, (GLuint id, GLenum pname, GLint64 *params), (id, pname, params))
+GL_VOID_FUNCTION(glGetQueryObjectui64v, (GLuint id, GLenum pname, GLuint64 *params), (id, pname, params))
+GL_VOID_FUNCTION(glVertexAttribDivisor, (GLuint index, GLuint divisor), (index, divisor))
+GL_VOID_FUNCTION(glVertexAttribP1ui, (GLuint index, GLenum type, GLboolean normalized, GLuint value), (index, type, normalized, value))
+GL_VOID_FUNCTION(glVertexAttribP1uiv, (GLuint index, GLenum type, GLboolean normalized, const GLuint *value), (index, type, normalized, value))
+GL_VOID_FUNCTION(glVertexAttribP2ui, (GLuint index, GLenum type, GLboolean normalized, GLuint value), (index, type, normalized, value))
+GL_VOID_FUNCTION(glVertexAttribP2uiv, (GLuint index, GLenum type, GLboolean normalized, const GLuint *value), (index, type, normalized, value))
+GL_VOID_FUNCTION(glVertexAttribP3ui, (GLuint index, GLenum type, GLboolean normalized, GLuint value), (index, type, normalized, value))
+GL_VOID_FUNCTION(glVertexAttribP3uiv, (GLuint index, GLenum type, GLboolean normalized, const GLuint *value), (index, type, normalized, value))
+GL_VOID_FUNCTION(glVertexAttribP4ui, (GLuint index, GLenum type, GLboolean normalized, GLuint value), (index, type, normalized, value))
+GL_VOID_FUNCTION(glVertexAttribP4uiv, (GLuint index, GLenum type, GLboolean normalized, const GLuint *value), (index, type, normalized, value))
+GL_VOID_FUNCTION(glMinSampleShading, (GLfloat value), (value))
+GL_VOID_FUNCTION(glBlendEquationi, (GLuint buf, GLenum mode), (buf, mode))
+GL_VOID_FUNCTION(glBlendEquationSeparatei, (GLuint buf, GLenum modeRGB, GLenum modeAlpha), (buf, modeRGB, modeAlpha))
+GL_VOID_FUNCTION(glBlendFunci, (GLuint buf, GLenum src, GLenum dst), (buf, src, dst))
+GL_VOID_FUNCTION(glBlendFuncSeparatei, (GLuint buf, GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha), (buf, srcRGB, dstRGB, srcAlpha, dstAlpha))
+GL_VOID_FUNCTION(glDrawArraysIndirect, (GLenum mode, const void *indirect), (mode, indirect))
+GL_VOID_FUNCTION(glDrawElementsIndirect, (GLenum mode, GLenum type, const void *indirect), (mode, type, indirect))
+GL_VOID_FUNCTION(glUniform1d, (GLint location, GLdouble x), (location, x))
+GL_VOID_FUNCTION(glUniform2d, (GLint location, GLdouble x, GLdouble y), (location, x, y))
+GL_VOID_FUNCTION(glUniform3d, (GLint location, GLdouble x, GLdouble y, GLdouble z), (location, x, y, z))
+GL_VOID_FUNCTION(glUniform4d, (GLint location, GLdouble x, GLdouble y, GLdouble z, GLdouble w), (location, x, y, z, w))
+GL_VOID_FUNCTION(glUniform1dv, (GLint location, GLsizei count, const GLdouble *value), (location, count, value))
+GL_VOID_FUNCTION(glUniform2dv, (GLint location, GLsizei count, const GLdouble *value), (location, count, value))
+GL_VOID_FUNCTION(glUniform3dv, (GLint location, GLsizei count, const GLdouble *value), (location, count, value))
+GL_VOID_FUNCTION(glUniform4dv, (GLint location, GLsizei count, const GLdouble *value), (location, count, value))
+GL_VOID_FUNCTION(glUniformMatrix2dv, (GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (location, count, transpose, value))
+GL_VOID_FUNCTION(glUniformMatrix3dv, (GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (location, count, transpose, value))
+GL_VOID_FUNCTION(glUniformMatrix4dv, (GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (location, count, transpose, value))
+GL_VOID_FUNCTION(glUniformMatrix2x3dv, (GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (location, count, transpose, value))
+GL_VOID_FUNCTION(glUniformMatrix2x4dv, (GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (location, count, transpose, value))
+GL_VOID_FUNCTION(glUniformMatrix3x2dv, (GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (location, count, transpose, value))
+GL_VOID_FUNCTION(glUniformMatrix3x4dv, (GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (location, count, transpose, value))
+GL_VOID_FUNCTION(glUniformMatrix4x2dv, (GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (location, count, transpose, value))
+GL_VOID_FUNCTION(glUniformMatrix4x3dv, (GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (location, count, transpose, value))
+GL_VOID_FUNCTION(glGetUniformdv, (GLuint program, GLint location, GLdouble *params), (program, location, params))
+GL_FUNCTION(GLint, glGetSubroutineUniformLocation, (GLuint program, GLenum shadertype, const GLchar *name), (program, shadertype, name))
+GL_FUNCTION(GLuint, glGetSubroutineIndex, (GLuint program, GLenum shadertype, const GLchar *name), (program, shadertype, name))
+GL_VOID_FUNCTION(glGetActiveSubroutineUniformiv, (GLuint program, GLenum shadertype, GLuint index, GLenum pname, GLint *values), (program, shadertype, index, pname, values))
+GL_VOID_FUNCTION(glGetActiveSubroutineUniformName, (GLuint program, GLenum shadertype, GLuint index, GLsizei bufSize, GLsizei *length, GLchar *name), (program, shadertype, index, bufSize, length, name))
+GL_VOID_FUNCTION(glGetActiveSubroutineName, (GLuint program, GLenum shadertype, GLuint index, GLsizei bufSize, GLsizei *length, GLchar *name), (program, shadertype, index, bufSize, length, name))
+GL_VOID_FUNCTION(glUniformSubroutinesuiv, (GLenum shadertype, GLsizei count, const GLuint *indices), (shadertype, count, indices))
+GL_VOID_FUNCTION(glGetUniformSubroutineuiv, (GLenum shadertype, GLint location, GLuint *params), (shadertype, location, params))
+GL_VOID_FUNCTION(glGetProgramStageiv, (GLuint program, GLenum shadertype, GLenum pname, GLint *values), (program, shadertype, pname, values))
+GL_VOID_FUNCTION(glPatchParameteri, (GLenum pname, GLint value), (pname, value))
+GL_VOID_FUNCTION(glPatchParameterfv, (GLenum pname, const GLfloat *values), (pname, values))
+GL_VOID_FUNCTION(glBindTransformFeedback, (GLenum target, GLuint id), (target, id))
+GL_VOID_FUNCTION(glDeleteTransformFeedbacks, (GLsizei n, const GLuint *ids), (n, ids))
+GL_VOID_FUNCTION(glGenTransformFeedbacks, (GLsizei n, GLuint *ids), (n, ids))
+GL_FUNCTION(GLboolean, glIsTransformFeedback, (GLuint id), (id))
+GL_VOID_FUNCTION(glPauseTransformFeedback, (void), ())
+GL_VOID_FUNCTION(glResumeTransformFeedback, (void), ())
+GL_VOID_FUNCTION(glDrawTransformFeedback, (GLenum mode, GLuint id), (mode, id))
+GL_VOID_FUNCTION(glDrawTransformFeedbackStream, (GLenum mode, GLuint id, GLuint stream), (mode, id, stream))
+GL_VOID_FUNCTION(glBeginQueryIndexed, (GLenum target, GLuint index, GLuint id), (target, index, id))
+GL_VOID_FUNCTION(glEndQueryIndexed, (GLenum target, GLuint index), (target, index))
+GL_VOID_FUNCTION(glGetQueryIndexediv, (GLenum target, GLuint index, GLenum pname, GLint *params), (target, index, pname, params))
+GL_VOID_FUNCTION(glReleaseShaderCompiler, (void), ())
+GL_VOID_FUNCTION(glShaderBinary, (GLsizei count, const GLuint *shaders, GLenum binaryFormat, const void *binary, GLsizei length), (count, shaders, binaryFormat, binary, length))
+GL_VOID_FUNCTION(glGetShaderPrecisionFormat, (GLenum shadertype, GLenum precisiontype, GLint *range, GLint *precision), (shadertype, precisiontype, range, precision))
+GL_VOID_FUNCTION(glDepthRangef, (GLfloat n, GLfloat f), (n, f))
+GL_VOID_FUNCTION(glClearDepthf, (GLfloat d), (d))
+GL_VOID_FUNCTION(glGetProgramBinary, (GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary), (program, bufSize, length, binaryFormat, binary))
+GL_VOID_FUNCTION(glProgramBinary, (GLuint program, GLenum binaryFormat, const void *binary, GLsizei length), (program, binaryFormat, binary, length))
+GL_VOID_FUNCTION(glProgramParameteri, (GLuint program, GLenum pname, GLint value), (program, pname, value))
+GL_VOID_FUNCTION(glUseProgramStages, (GLuint pipeline, GLbitfield stages, GLuint program), (pipeline, stages, program))
+GL_VOID_FUNCTION(glActiveShaderProgram, (GLuint pipeline, GLuint program), (pipeline, program))
+GL_FUNCTION(GLuint, glCreateShaderProgramv, (GLenum type, GLsizei count, const GLchar *const*strings), (type, count, strings))
+GL_VOID_FUNCTION(glBindProgramPipeline, (GLuint pipeline), (pipeline))
+GL_VOID_FUNCTION(glDeleteProgramPipelines, (GLsizei n, const GLuint *pipelines), (n, pipelines))
+GL_VOID_FUNCTION(glGenProgramPipelines, (GLsizei n, GLuint *pipelines), (n, pipelines))
+GL_FUNCTION(GLboolean, glIsProgramPipeline, (GLuint pipeline), (pipeline))
+GL_VOID_FUNCTION(glGetProgramPipelineiv, (GLuint pipeline, GLenum pname, GLint *params), (pipeline, pname, params))
+GL_VOID_FUNCTION(glProgramUniform1i, (GLuint program, GLint location, GLint v0), (program, location, v0))
+GL_VOID_FUNCTION(glProgramUniform1iv, (GLuint program, GLint location, GLsizei count, const GLint *value), (program, location, count, value))
+GL_VOID_FUNCTION(glProgramUniform1f, (GLuint program, GLint location, GLfloat v0), (program, location, v0))
+GL_VOID_FUNCTION(glProgramUniform1fv, (GLuint program, GLint location, GLsizei count, const GLfloat *value), (program, location, count, value))
+GL_VOID_FUNCTION(glProgramUniform1d, (GLuint program, GLint location, GLdouble v0), (program, location, v0))
+GL_VOID_FUNCTION(glProgramUniform1dv, (GLuint program, GLint location, GLsizei count, const GLdouble *value), (program, location, count, value))
+GL_VOID_FUNCTION(glProgramUniform1ui, (GLuint program, GLint location, GLuint v0), (program, location, v0))
+GL_VOID_FUNCTION(glProgramUniform1uiv, (GLuint program, GLint location, GLsizei count, const GLuint *value), (program, location, count, value))
+GL_VOID_FUNCTION(glProgramUniform2i, (GLuint program, GLint location, GLint v0, GLint v1), (program, location, v0, v1))
+GL_VOID_FUNCTION(glProgramUniform2iv, (GLuint program, GLint location, GLsizei count, const GLint *value), (program, location, count, value))
+GL_VOID_FUNCTION(glProgramUniform2f, (GLuint program, GLint location, GLfloat v0, GLfloat v1), (program, location, v0, v1))
+GL_VOID_FUNCTION(glProgramUniform2fv, (GLuint program, GLint location, GLsizei count, const GLfloat *value), (program, location, count, value))
+GL_VOID_FUNCTION(glProgramUniform2d, (GLuint program, GLint location, GLdouble v0, GLdouble v1), (program, location, v0, v1))
+GL_VOID_FUNCTION(glProgramUniform2dv, (GLuint program, GLint location, GLsizei count, const GLdouble *value), (program, location, count, value))
+GL_VOID_FUNCTION(glProgramUniform2ui, (GLuint program, GLint location, GLuint v0, GLuint v1), (program, location, v0, v1))
+GL_VOID_FUNCTION(glProgramUniform2uiv, (GLuint program, GLint location, GLsizei count, const GLuint *value), (program, location, count, value))
+GL_VOID_FUNCTION(glProgramUniform3i, (GLuint program, GLint location, GLint v0, GLint v1, GLint v2), (program, location, v0, v1, v2))
+GL_VOID_FUNCTION(glProgramUniform3iv, (GLuint program, GLint location, GLsizei count, const GLint *value), (program, location, count, value))
+GL_VOID_FUNCTION(glProgramUniform3f, (GLuint program, GLint location, GLfloat v0, GLfloat v1, GLfloat v2), (program, location, v0, v1, v2))
+GL_VOID_FUNCTION(glProgramUniform3fv, (GLuint program, GLint location, GLsizei count, const GLfloat *value), (program, location, count, value))
+GL_VOID_FUNCTION(glProgramUniform3d, (GLuint program, GLint location, GLdouble v0, GLdouble v1, GLdouble v2), (program, location, v0, v1, v2))
+GL_VOID_FUNCTION(glProgramUniform3dv, (GLuint program, GLint location, GLsizei count, const GLdouble *value), (program, location, count, value))
+GL_VOID_FUNCTION(glProgramUniform3ui, (GLuint program, GLint location, GLuint v0, GLuint v1, GLuint v2), (program, location, v0, v1, v2))
+GL_VOID_FUNCTION(glProgramUniform3uiv, (GLuint program, GLint location, GLsizei count, const GLuint *value), (program, location, count, value))
+GL_VOID_FUNCTION(glProgramUniform4i, (GLuint program, GLint location, GLint v0, GLint v1, GLint v2, GLint v3), (program, location, v0, v1, v2, v3))
+GL_VOID_FUNCTION(glProgramUniform4iv, (GLuint program, GLint location, GLsizei count, const GLint *value), (program, location, count, value))
+GL_VOID_FUNCTION(glProgramUniform4f, (GLuint program, GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3), (program, location, v0, v1, v2, v3))
+GL_VOID_FUNCTION(glProgramUniform4fv, (GLuint program, GLint location, GLsizei count, const GLfloat *value), (program, location, count, value))
+GL_VOID_FUNCTION(glProgramUniform4d, (GLuint program, GLint location, GLdouble v0, GLdouble v1, GLdouble v2, GLdouble v3), (program, location, v0, v1, v2, v3))
+GL_VOID_FUNCTION(glProgramUniform4dv, (GLuint program, GLint location, GLsizei count, const GLdouble *value), (program, location, count, value))
+GL_VOID_FUNCTION(glProgramUniform4ui, (GLuint program, GLint location, GLuint v0, GLuint v1, GLuint v2, GLuint v3), (program, location, v0, v1, v2, v3))
+GL_VOID_FUNCTION(glProgramUniform4uiv, (GLuint program, GLint location, GLsizei count, const GLuint *value), (program, location, count, value))
+GL_VOID_FUNCTION(glProgramUniformMatrix2fv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (program, location, count, transpose, value))
+GL_VOID_FUNCTION(glProgramUniformMatrix3fv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (program, location, count, transpose, value))
+GL_VOID_FUNCTION(glProgramUniformMatrix4fv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (program, location, count, transpose, value))
+GL_VOID_FUNCTION(glProgramUniformMatrix2dv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (program, location, count, transpose, value))
+GL_VOID_FUNCTION(glProgramUniformMatrix3dv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (program, location, count, transpose, value))
+GL_VOID_FUNCTION(glProgramUniformMatrix4dv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (program, location, count, transpose, value))
+GL_VOID_FUNCTION(glProgramUniformMatrix2x3fv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (program, location, count, transpose, value))
+GL_VOID_FUNCTION(glProgramUniformMatrix3x2fv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (program, location, count, transpose, value))
+GL_VOID_FUNCTION(glProgramUniformMatrix2x4fv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (program, location, count, transpose, value))
+GL_VOID_FUNCTION(glProgramUniformMatrix4x2fv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (program, location, count, transpose, value))
+GL_VOID_FUNCTION(glProgramUniformMatrix3x4fv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (program, location, count, transpose, value))
+GL_VOID_FUNCTION(glProgramUniformMatrix4x3fv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLfloat *value), (program, location, count, transpose, value))
+GL_VOID_FUNCTION(glProgramUniformMatrix2x3dv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (program, location, count, transpose, value))
+GL_VOID_FUNCTION(glProgramUniformMatrix3x2dv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (program, location, count, transpose, value))
+GL_VOID_FUNCTION(glProgramUniformMatrix2x4dv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (program, location, count, transpose, value))
+GL_VOID_FUNCTION(glProgramUniformMatrix4x2dv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (program, location, count, transpose, value))
+GL_VOID_FUNCTION(glProgramUniformMatrix3x4dv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (program, location, count, transpose, value))
+GL_VOID_FUNCTION(glProgramUniformMatrix4x3dv, (GLuint program, GLint location, GLsizei count, GLboolean transpose, const GLdouble *value), (program, location, count, transpose, value))
+GL_VOID_FUNCTION(glValidateProgramPipeline, (GLuint pipeline), (pipeline))
+GL_VOID_FUNCTION(glGetProgramPipelineInfoLog, (GLuint pipeline, GLsizei bufSize, GLsizei *length, GLchar *infoLog), (pipeline, bufSize, length, infoLog))
+GL_VOID_FUNCTION(glVertexAttribL1d, (GLuint index, GLdouble x), (index, x))
+GL_VOID_FUNCTION(glVertexAttribL2d, (GLuint index, GLdouble x, GLdouble y), (index, x, y))
+GL_VOID_FUNCTION(glVertexAttribL3d, (GLuint index, GLdouble x, GLdouble y, GLdouble z), (index, x, y, z))
+GL_VOID_FUNCTION(glVertexAttribL4d, (GLuint index, GLdouble x, GLdouble y, GLdouble z, GLdouble w), (index, x, y, z, w))
+GL_VOID_FUNCTION(glVertexAttribL1dv, (GLuint index, const GLdouble *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttribL2dv, (GLuint index, const GLdouble *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttribL3dv, (GLuint index, const GLdouble *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttribL4dv, (GLuint index, const GLdouble *v), (index, v))
+GL_VOID_FUNCTION(glVertexAttribLPointer, (GLuint index, GLint size, GLenum type, GLsizei stride, const void *pointer), (index, size, type, stride, pointer))
+GL_VOID_FUNCTION(glGetVertexAttribLdv, (GLuint index, GLenum pname, GLdouble *params), (index, pname, params))
+GL_VOID_FUNCTION(glViewportArrayv, (GLuint first, GLsizei count, const GLfloat *v), (first, count, v))
+GL_VOID_FUNCTION(glViewportIndexedf, (GLuint index, GLfloat x, GLfloat y, GLfloat w, GLfloat h), (index, x, y, w, h))
+GL_VOID_FUNCTION(glViewportIndexedfv, (GLuint index, const GLfloat *v), (index, v))
+GL_VOID_FUNCTION(glScissorArrayv, (GLuint first, GLsizei count, const GLint *v), (first, count, v))
+GL_VOID_FUNCTION(glScissorIndexed, (GLuint index, GLint left, GLint bottom, GLsizei width, GLsizei height), (index, left, bottom, width, height))
+GL_VOID_FUNCTION(glScissorIndexedv, (GLuint index, const GLint *v), (index, v))
+GL_VOID_FUNCTION(glDepthRangeArrayv, (GLuint first, GLsizei count, const GLdouble *v), (first, count, v))
+GL_VOID_FUNCTION(glDepthRangeIndexed, (GLuint index, GLdouble n, GLdouble f), (index, n, f))
+GL_VOID_FUNCTION(glGetFloati_v, (GLenum target, GLuint index, GLfloat *data), (target, index, data))
+GL_VOID_FUNCTION(glGetDoublei_v, (GLenum target, GLuint index, GLdouble *data), (target, index, data))
+GL_VOID_FUNCTION(glDrawArraysInstancedBaseInstance, (GLenum mode, GLint first, GLsizei count, GLsizei instancecount, GLuint baseinstance), (mode, first, count, instancecount, baseinstance))
+GL_VOID_FUNCTION(glDrawElementsInstancedBaseInstance, (GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instancecount, GLuint baseinstance), (mode, count, type, indices, instancecount, baseinstance))
+GL_VOID_FUNCTION(glDrawElementsInstancedBaseVertexBaseInstance, (GLenum mode, GLsizei count, GLenum type, const void *indices, GLsizei instancecount, GLint basevertex, GLuint baseinstance), (mode, count, type, indices, instancecount, basevertex, baseinstance))
+GL_VOID_FUNCTION(glGetInternalformativ, (GLenum target, GLenum internalformat, GLenum pname, GLsizei count, GLint *params), (target, internalformat, pname, count, params))
+GL_VOID_FUNCTION(glGetActiveAtomicCounterBufferiv, (GLuint program, GLuint bufferIndex, GLenum pname, GLint *params), (program, bufferIndex, pname, params))
+GL_VOID_FUNCTION(glBindImageTexture, (GLuint unit, GLuint texture, GLint level, GLboolean layered, GLint layer, GLenum access, GLenum format), (unit, texture, level, layered, layer, access, format))
+GL_VOID_FUNCTION(glMemoryBarrier, (GLbitfield barriers), (barriers))
+GL_VOID_FUNCTION(glTexStorage1D, (GLenum target, GLsizei levels, GLenum internalformat, GLsizei width), (target, levels, internalformat, width))
+GL_VOID_FUNCTION(glTexStorage2D, (GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height), (target, levels, internalformat, width, height))
+GL_VOID_FUNCTION(glTexStorage3D, (GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth), (target, levels, internalformat, width, height, depth))
+GL_VOID_FUNCTION(glDrawTransformFeedbackInstanced, (GLenum mode, GLuint id, GLsizei instancecount), (mode, id, instancecount))
+GL_VOID_FUNCTION(glDrawTransformFeedbackStreamInstanced, (GLenum mode, GLuint id, GLuint stream, GLsizei instancecount), (mode, id, stream, instancecount))
+GL_VOID_FUNCTION(glClearBufferData, (GLenum target, GLenum internalformat, GLenum format, GLenum type, const void *data), (target, internalformat, format, type, data))
+GL_VOID_FUNCTION(glClearBufferSubData, (GLenum target, GLenum internalformat, GLintptr offset, GLsizeiptr size, GLenum format, GLenum type, const void *data), (target, internalformat, offset, size, format, type, data))
+GL_VOID_FUNCTION(glDispatchCompute, (GLuint num_groups_x, GLuint num_groups_y, GLuint num_groups_z), (num_groups_x, num_groups_y, num_groups_z))
+GL_VOID_FUNCTION(glDispatchComputeIndirect, (GLintptr indirect), (indirect))
+GL_VOID_FUNCTION(glCopyImageSubData, (GLuint srcName, GLenum srcTarget, GLint srcLevel, GLint srcX, GLint srcY, GLint srcZ, GLuint dstName, GLenum dstTarget, GLint dstLevel, GLint dstX, GLint dstY, GLint dstZ, GLsizei srcWidth, GLsizei srcHeight, GLsizei srcDepth), (srcName, srcTarget, srcLevel, srcX, srcY, srcZ, dstName, dstTarget, dstLevel, dstX, dstY, dstZ, srcWidth, srcHeight, srcDepth))
+GL_VOID_FUNCTION(glFramebufferParameteri, (GLenum target, GLenum pname, GLint param), (target, pname, param))
+GL_VOID_FUNCTION(glGetFramebufferParameteriv, (GLenum target, GLenum pname, GLint *params), (target, pname, params))
+GL_VOID_FUNCTION(glGetInternalformati64v, (GLenum target, GLenum internalformat, GLenum pname, GLsizei count, GLint64 *params), (target, internalformat, pname, count, params))
+GL_VOID_FUNCTION(glInvalidateTexSubImage, (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth), (texture, level, xoffset, yoffset, zoffset, width, height, depth))
+GL_VOID_FUNCTION(glInvalidateTexImage, (GLuint texture, GLint level), (texture, level))
+GL_VOID_FUNCTION(glInvalidateBufferSubData, (GLuint buffer, GLintptr offset, GLsizeiptr length), (buffer, offset, length))
+GL_VOID_FUNCTION(glInvalidateBufferData, (GLuint buffer), (buffer))
+GL_VOID_FUNCTION(glInvalidateFramebuffer, (GLenum target, GLsizei numAttachments, const GLenum *attachments), (target, numAttachments, attachments))
+GL_VOID_FUNCTION(glInvalidateSubFramebuffer, (GLenum target, GLsizei numAttachments, const GLenum *attachments, GLint x, GLint y, GLsizei width, GLsizei height), (target, numAttachments, attachments, x, y, width, height))
+GL_VOID_FUNCTION(glMultiDrawArraysIndirect, (GLenum mode, const void *indirect, GLsizei drawcount, GLsizei stride), (mode, indirect, drawcount, stride))
+GL_VOID_FUNCTION(glMultiDrawElementsIndirect, (GLenum mode, GLenum type, const void *indirect, GLsizei drawcount, GLsizei stride), (mode, type, indirect, drawcount, stride))
+GL_VOID_FUNCTION(glGetProgramInterfaceiv, (GLuint program, GLenum programInterface, GLenum pname, GLint *params), (program, programInterface, pname, params))
+GL_FUNCTION(GLuint, glGetProgramResourceIndex, (GLuint program, GLenum programInterface, const GLchar *name), (program, programInterface, name))
+GL_VOID_FUNCTION(glGetProgramResourceName, (GLuint program, GLenum programInterface, GLuint index, GLsizei bufSize, GLsizei *length, GLchar *name), (program, programInterface, index, bufSize, length, name))
+GL_VOID_FUNCTION(glGetProgramResourceiv, (GLuint program, GLenum programInterface, GLuint index, GLsizei propCount, const GLenum *props, GLsizei count, GLsizei *length, GLint *params), (program, programInterface, index, propCount, props, count, length, params))
+GL_FUNCTION(GLint, glGetProgramResourceLocation, (GLuint program, GLenum programInterface, const GLchar *name), (program, programInterface, name))
+GL_FUNCTION(GLint, glGetProgramResourceLocationIndex, (GLuint program, GLenum programInterface, const GLchar *name), (program, programInterface, name))
+GL_VOID_FUNCTION(glShaderStorageBlockBinding, (GLuint program, GLuint storageBlockIndex, GLuint storageBlockBinding), (program, storageBlockIndex, storageBlockBinding))
+GL_VOID_FUNCTION(glTexBufferRange, (GLenum target, GLenum internalformat, GLuint buffer, GLintptr offset, GLsizeiptr size), (target, internalformat, buffer, offset, size))
+GL_VOID_FUNCTION(glTexStorage2DMultisample, (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLboolean fixedsamplelocations), (target, samples, internalformat, width, height, fixedsamplelocations))
+GL_VOID_FUNCTION(glTexStorage3DMultisample, (GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLboolean fixedsamplelocations), (target, samples, internalformat, width, height, depth, fixedsamplelocations))
+GL_VOID_FUNCTION(glTextureView, (GLuint texture, GLenum target, GLuint origtexture, GLenum internalformat, GLuint minlevel, GLuint numlevels, GLuint minlayer, GLuint numlayers), (texture, target, origtexture, internalformat, minlevel, numlevels, minlayer, numlayers))
+GL_VOID_FUNCTION(glBindVertexBuffer, (GLuint bindingindex, GLuint buffer, GLintptr offset, GLsizei stride), (bindingindex, buffer, offset, stride))
+GL_VOID_FUNCTION(glVertexAttribFormat, (GLuint attribindex, GLint size, GLenum type, GLboolean normalized, GLuint relativeoffset), (attribindex, size, type, normalized, relativeoffset))
+GL_VOID_FUNCTION(glVertexAttribIFormat, (GLuint attribindex, GLint size, GLenum type, GLuint relativeoffset), (attribindex, size, type, relativeoffset))
+GL_VOID_FUNCTION(glVertexAttribLFormat, (GLuint attribindex, GLint size, GLenum type, GLuint relativeoffset), (attribindex, size, type, relativeoffset))
+GL_VOID_FUNCTION(glVertexAttribBinding, (GLuint attribindex, GLuint bindingindex), (attribindex, bindingindex))
+GL_VOID_FUNCTION(glVertexBindingDivisor, (GLuint bindingindex, GLuint divisor), (bindingindex, divisor))
+GL_VOID_FUNCTION(glDebugMessageControl, (GLenum source, GLenum type, GLenum severity, GLsizei count, const GLuint *ids, GLboolean enabled), (source, type, severity, count, ids, enabled))
+GL_VOID_FUNCTION(glDebugMessageInsert, (GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar *buf), (source, type, id, severity, length, buf))
+GL_VOID_FUNCTION(glDebugMessageCallback, (GLDEBUGPROC callback, const void *userParam), (callback, userParam))
+GL_FUNCTION(GLuint, glGetDebugMessageLog, (GLuint count, GLsizei bufSize, GLenum *sources, GLenum *types, GLuint *ids, GLenum *severities, GLsizei *lengths, GLchar *messageLog), (count, bufSize, sources, types, ids, severities, lengths, messageLog))
+GL_VOID_FUNCTION(glPushDebugGroup, (GLenum source, GLuint id, GLsizei length, const GLchar *message), (source, id, length, message))
+GL_VOID_FUNCTION(glPopDebugGroup, (void), ())
+GL_VOID_FUNCTION(glObjectLabel, (GLenum identifier, GLuint name, GLsizei length, const GLchar *label), (identifier, name, length, label))
+GL_VOID_FUNCTION(glGetObjectLabel, (GLenum identifier, GLuint name, GLsizei bufSize, GLsizei *length, GLchar *label), (identifier, name, bufSize, length, label))
+GL_VOID_FUNCTION(glObjectPtrLabel, (const void *ptr, GLsizei length, const GLchar *label), (ptr, length, label))
+GL_VOID_FUNCTION(glGetObjectPtrLabel, (const void *ptr, GLsizei bufSize, GLsizei *length, GLchar *label), (ptr, bufSize, length, label))
+GL_VOID_FUNCTION(glBufferStorage, (GLenum target, GLsizeiptr size, const void *data, GLbitfield flags), (target, size, data, flags))
+GL_VOID_FUNCTION(glClearTexImage, (GLuint texture, GLint level, GLenum format, GLenum type, const void *data), (texture, level, format, type, data))
+GL_VOID_FUNCTION(glClearTexSubImage, (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void *data), (texture, level, xoffset, yoffset, zoffset, width, height, depth, format, type, data))
+GL_VOID_FUNCTION(glBindBuffersBase, (GLenum target, GLuint first, GLsizei count, const GLuint *buffers), (target, first, count, buffers))
+GL_VOID_FUNCTION(glBindBuffersRange, (GLenum target, GLuint first, GLsizei count, const GLuint *buffers, const GLintptr *offsets, const GLsizeiptr *sizes), (target, first, count, buffers, offsets, sizes))
+GL_VOID_FUNCTION(glBindTextures, (GLuint first, GLsizei count, const GLuint *textures), (first, count, textures))
+GL_VOID_FUNCTION(glBindSamplers, (GLuint first, GLsizei count, const GLuint *samplers), (first, count, samplers))
+GL_VOID_FUNCTION(glBindImageTextures, (GLuint first, GLsizei count, const GLuint *textures), (first, count, textures))
+GL_VOID_FUNCTION(glBindVertexBuffers, (GLuint first, GLsizei count, const GLuint *buffers, const GLintptr *offsets, const GLsizei *strides), (first, count, buffers, offsets, strides))
+GL_VOID_FUNCTION(glClipControl, (GLenum origin, GLenum depth), (origin, depth))
+GL_VOID_FUNCTION(glCreateTransformFeedbacks, (GLsizei n, GLuint *ids), (n, ids))
+GL_VOID_FUNCTION(glTransformFeedbackBufferBase, (GLuint xfb, GLuint index, GLuint buffer), (xfb, index, buffer))
+GL_VOID_FUNCTION(glTransformFeedbackBufferRange, (GLuint xfb, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size), (xfb, index, buffer, offset, size))
+GL_VOID_FUNCTION(glGetTransformFeedbackiv, (GLuint xfb, GLenum pname, GLint *param), (xfb, pname, param))
+GL_VOID_FUNCTION(glGetTransformFeedbacki_v, (GLuint xfb, GLenum pname, GLuint index, GLint *param), (xfb, pname, index, param))
+GL_VOID_FUNCTION(glGetTransformFeedbacki64_v, (GLuint xfb, GLenum pname, GLuint index, GLint64 *param), (xfb, pname, index, param))
+GL_VOID_FUNCTION(glCreateBuffers, (GLsizei n, GLuint *buffers), (n, buffers))
+GL_VOID_FUNCTION(glNamedBufferStorage, (GLuint buffer, GLsizeiptr size, const void *data, GLbitfield flags), (buffer, size, data, flags))
+GL_VOID_FUNCTION(glNamedBufferData, (GLuint buffer, GLsizeiptr size, const void *data, GLenum usage), (buffer, size, data, usage))
+GL_VOID_FUNCTION(glNamedBufferSubData, (GLuint buffer, GLintptr offset, GLsizeiptr size, const void *data), (buffer, offset, size, data))
+GL_VOID_FUNCTION(glCopyNamedBufferSubData, (GLuint readBuffer, GLuint writeBuffer, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size), (readBuffer, writeBuffer, readOffset, writeOffset, size))
+GL_VOID_FUNCTION(glClearNamedBufferData, (GLuint buffer, GLenum internalformat, GLenum format, GLenum type, const void *data), (buffer, internalformat, format, type, data))
+GL_VOID_FUNCTION(glClearNamedBufferSubData, (GLuint buffer, GLenum internalformat, GLintptr offset, GLsizeiptr size, GLenum format, GLenum type, const void *data), (buffer, internalformat, offset, size, format, type, data))
+GL_FUNCTION(void *, glMapNamedBuffer, (GLuint buffer, GLenum access), (buffer, access))
+GL_FUNCTION(void *, glMapNamedBufferRange, (GLuint buffer, GLintptr offset, GLsizeiptr length, GLbitfield access), (buffer, offset, length, access))
+GL_FUNCTION(GLboolean, glUnmapNamedBuffer, (GLuint buffer), (buffer))
+GL_VOID_FUNCTION(glFlushMappedNamedBufferRange, (GLuint buffer, GLintptr offset, GLsizeiptr length), (buffer, offset, length))
+GL_VOID_FUNCTION(glGetNamedBufferParameteriv, (GLuint buffer, GLenum pname, GLint *params), (buffer, pname, params))
+GL_VOID_FUNCTION(glGetNamedBufferParameteri64v, (GLuint buffer, GLenum pname, GLint64 *params), (buffer, pname, params))
+GL_VOID_FUNCTION(glGetNamedBufferPointerv, (GLuint buffer, GLenum pname, void **params), (buffer, pname, params))
+GL_VOID_FUNCTION(glGetNamedBufferSubData, (GLuint buffer, GLintptr offset, GLsizeiptr size, void *data), (buffer, offset, size, data))
+GL_VOID_FUNCTION(glCreateFramebuffers, (GLsizei n, GLuint *framebuffers), (n, framebuffers))
+GL_VOID_FUNCTION(glNamedFramebufferRenderbuffer, (GLuint framebuffer, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer), (framebuffer, attachment, renderbuffertarget, renderbuffer))
+GL_VOID_FUNCTION(glNamedFramebufferParameteri, (GLuint framebuffer, GLenum pname, GLint param), (framebuffer, pname, param))
+GL_VOID_FUNCTION(glNamedFramebufferTexture, (GLuint framebuffer, GLenum attachment, GLuint texture, GLint level), (framebuffer, attachment, texture, level))
+GL_VOID_FUNCTION(glNamedFramebufferTextureLayer, (GLuint framebuffer, GLenum attachment, GLuint texture, GLint level, GLint layer), (framebuffer, attachment, texture, level, layer))
+GL_VOID_FUNCTION(glNamedFramebufferDrawBuffer, (GLuint framebuffer, GLenum buf), (framebuffer, buf))
+GL_VOID_FUNCTION(glNamedFramebufferDrawBuffers, (GLuint framebuffer, GLsizei n, const GLenum *bufs), (framebuffer, n, bufs))
+GL_VOID_FUNCTION(glNamedFramebufferReadBuffer, (GLuint framebuffer, GLenum src), (framebuffer, src))
+GL_VOID_FUNCTION(glInvalidateNamedFramebufferData, (GLuint framebuffer, GLsizei numAttachments, const GLenum *attachments), (framebuffer, numAttachments, attachments))
+GL_VOID_FUNCTION(glInvalidateNamedFramebufferSubData, (GLuint framebuffer, GLsizei numAttachments, const GLenum *attachments, GLint x, GLint y, GLsizei width, GLsizei height), (framebuffer, numAttachments, attachments, x, y, width, height))
+GL_VOID_FUNCTION(glClearNamedFramebufferiv, (GLuint framebuffer, GLenum buffer, GLint drawbuffer, const GLint *value), (framebuffer, buffer, drawbuffer, value))
+GL_VOID_FUNCTION(glClearNamedFramebufferuiv, (GLuint framebuffer, GLenum buffer, GLint drawbuffer, const GLuint *value), (framebuffer, buffer, drawbuffer, value))
+GL_VOID_FUNCTION(glClearNamedFramebufferfv, (GLuint framebuffer, GLenum buffer, GLint drawbuffer, const GLfloat *value), (framebuffer, buffer, drawbuffer, value))
+GL_VOID_FUNCTION(glClearNamedFramebufferfi, (GLuint framebuffer, GLenum buffer, GLint drawbuffer, GLfloat depth, GLint stencil), (framebuffer, buffer, drawbuffer, depth, stencil))
+GL_VOID_FUNCTION(glBlitNamedFramebuffer, (GLuint readFramebuffer, GLuint drawFramebuffer, GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter), (readFramebuffer, drawFramebuffer, srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter))
+GL_FUNCTION(GLenum, glCheckNamedFramebufferStatus, (GLuint framebuffer, GLenum target), (framebuffer, target))
+GL_VOID_FUNCTION(glGetNamedFramebufferParameteriv, (GLuint framebuffer, GLenum pname, GLint *param), (framebuffer, pname, param))
+GL_VOID_FUNCTION(glGetNamedFramebufferAttachmentParameteriv, (GLuint framebuffer, GLenum attachment, GLenum pname, GLint *params), (framebuffer, attachment, pname, params))
+GL_VOID_FUNCTION(glCreateRenderbuffers, (GLsizei n, GLuint *renderbuffers), (n, renderbuffers))
+GL_VOID_FUNCTION(glNamedRenderbufferStorage, (GLuint renderbuffer, GLenum internalformat, GLsizei width, GLsizei height), (renderbuffer, internalformat, width, height))
+GL_VOID_FUNCTION(glNamedRenderbufferStorageMultisample, (GLuint renderbuffer, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height), (renderbuffer, samples, internalformat, width, height))
+GL_VOID_FUNCTION(glGetNamedRenderbufferParameteriv, (GLuint renderbuffer, GLenum pname, GLint *params), (renderbuffer, pname, params))
+GL_VOID_FUNCTION(glCreateTextures, (GLenum target, GLsizei n, GLuint *textures), (target, n, textures))
+GL_VOID_FUNCTION(glTextureBuffer, (GLuint texture, GLenum internalformat, GLuint buffer), (texture, internalformat, buffer))
+GL_VOID_FUNCTION(glTextureBufferRange, (GLuint texture, GLenum internalformat, GLuint buffer, GLintptr offset, GLsizeiptr size), (texture, internalformat, buffer, offset, size))
+GL_VOID_FUNCTION(glTextureStorage1D, (GLuint texture, GLsizei levels, GLenum internalformat, GLsizei width), (texture, levels, internalformat, width))
+GL_VOID_FUNCTION(glTextureStorage2D, (GLuint texture, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height), (texture, levels, internalformat, width, height))
+GL_VOID_FUNCTION(glTextureStorage3D, (GLuint texture, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth), (texture, levels, internalformat, width, height, depth))
+GL_VOID_FUNCTION(glTextureStorage2DMultisample, (GLuint texture, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLboolean fixedsamplelocations), (texture, samples, internalformat, width, height, fixedsamplelocations))
+GL_VOID_FUNCTION(glTextureStorage3DMultisample, (GLuint texture, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth, GLboolean fixedsamplelocations), (texture, samples, internalformat, width, height, depth, fixedsamplelocations))
+GL_VOID_FUNCTION(glTextureSubImage1D, (GLuint texture, GLint level, GLint xoffset, GLsizei width, GLenum format, GLenum type, const void *pixels), (texture, level, xoffset, width, format, type, pixels))
+GL_VOID_FUNCTION(glTextureSubImage2D, (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const void *pixels), (texture, level, xoffset, yoffset, width, height, format, type, pixels))
+GL_VOID_FUNCTION(glTextureSubImage3D, (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void *pixels), (texture, level, xoffset, yoffset, zoffset, width, height, depth, format, type, pixels))
+GL_VOID_FUNCTION(glCompressedTextureSubImage1D, (GLuint texture, GLint level, GLint xoffset, GLsizei width, GLenum format, GLsizei imageSize, const void *data), (texture, level, xoffset, width, format, imageSize, data))
+GL_VOID_FUNCTION(glCompressedTextureSubImage2D, (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const void *data), (texture, level, xoffset, yoffset, width, height, format, imageSize, data))
+GL_VOID_FUNCTION(glCompressedTextureSubImage3D, (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLsizei imageSize, const void *data), (texture, level, xoffset, yoffset, zoffset, width, height, depth, format, imageSize, data))
+GL_VOID_FUNCTION(glCopyTextureSubImage1D, (GLuint texture, GLint level, GLint xoffset, GLint x, GLint y, GLsizei width), (texture, level, xoffset, x, y, width))
+GL_VOID_FUNCTION(glCopyTextureSubImage2D, (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height), (texture, level, xoffset, yoffset, x, y, width, height))
+GL_VOID_FUNCTION(glCopyTextureSubImage3D, (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLint x, GLint y, GLsizei width, GLsizei height), (texture, level, xoffset, yoffset, zoffset, x, y, width, height))
+GL_VOID_FUNCTION(glTextureParameterf, (GLuint texture, GLenum pname, GLfloat param), (texture, pname, param))
+GL_VOID_FUNCTION(glTextureParameterfv, (GLuint texture, GLenum pname, const GLfloat *param), (texture, pname, param))
+GL_VOID_FUNCTION(glTextureParameteri, (GLuint texture, GLenum pname, GLint param), (texture, pname, param))
+GL_VOID_FUNCTION(glTextureParameterIiv, (GLuint texture, GLenum pname, const GLint *params), (texture, pname, params))
+GL_VOID_FUNCTION(glTextureParameterIuiv, (GLuint texture, GLenum pname, const GLuint *params), (texture, pname, params))
+GL_VOID_FUNCTION(glTextureParameteriv, (GLuint texture, GLenum pname, const GLint *param), (texture, pname, param))
+GL_VOID_FUNCTION(glGenerateTextureMipmap, (GLuint texture), (texture))
+GL_VOID_FUNCTION(glBindTextureUnit, (GLuint unit, GLuint texture), (unit, texture))
+GL_VOID_FUNCTION(glGetTextureImage, (GLuint texture, GLint level, GLenum format, GLenum type, GLsizei bufSize, void *pixels), (texture, level, format, type, bufSize, pixels))
+GL_VOID_FUNCTION(glGetCompressedTextureImage, (GLuint texture, GLint level, GLsizei bufSize, void *pixels), (texture, level, bufSize, pixels))
+GL_VOID_FUNCTION(glGetTextureLevelParameterfv, (GLuint texture, GLint level, GLenum pname, GLfloat *params), (texture, level, pname, params))
+GL_VOID_FUNCTION(glGetTextureLevelParameteriv, (GLuint texture, GLint level, GLenum pname, GLint *params), (texture, level, pname, params))
+GL_VOID_FUNCTION(glGetTextureParameterfv, (GLuint texture, GLenum pname, GLfloat *params), (texture, pname, params))
+GL_VOID_FUNCTION(glGetTextureParameterIiv, (GLuint texture, GLenum pname, GLint *params), (texture, pname, params))
+GL_VOID_FUNCTION(glGetTextureParameterIuiv, (GLuint texture, GLenum pname, GLuint *params), (texture, pname, params))
+GL_VOID_FUNCTION(glGetTextureParameteriv, (GLuint texture, GLenum pname, GLint *params), (texture, pname, params))
+GL_VOID_FUNCTION(glCreateVertexArrays, (GLsizei n, GLuint *arrays), (n, arrays))
+GL_VOID_FUNCTION(glDisableVertexArrayAttrib, (GLuint vaobj, GLuint index), (vaobj, index))
+GL_VOID_FUNCTION(glEnableVertexArrayAttrib, (GLuint vaobj, GLuint index), (vaobj, index))
+GL_VOID_FUNCTION(glVertexArrayElementBuffer, (GLuint vaobj, GLuint buffer), (vaobj, buffer))
+GL_VOID_FUNCTION(glVertexArrayVertexBuffer, (GLuint vaobj, GLuint bindingindex, GLuint buffer, GLintptr offset, GLsizei stride), (vaobj, bindingindex, buffer, offset, stride))
+GL_VOID_FUNCTION(glVertexArrayVertexBuffers, (GLuint vaobj, GLuint first, GLsizei count, const GLuint *buffers, const GLintptr *offsets, const GLsizei *strides), (vaobj, first, count, buffers, offsets, strides))
+GL_VOID_FUNCTION(glVertexArrayAttribBinding, (GLuint vaobj, GLuint attribindex, GLuint bindingindex), (vaobj, attribindex, bindingindex))
+GL_VOID_FUNCTION(glVertexArrayAttribFormat, (GLuint vaobj, GLuint attribindex, GLint size, GLenum type, GLboolean normalized, GLuint relativeoffset), (vaobj, attribindex, size, type, normalized, relativeoffset))
+GL_VOID_FUNCTION(glVertexArrayAttribIFormat, (GLuint vaobj, GLuint attribindex, GLint size, GLenum type, GLuint relativeoffset), (vaobj, attribindex, size, type, relativeoffset))
+GL_VOID_FUNCTION(glVertexArrayAttribLFormat, (GLuint vaobj, GLuint attribindex, GLint size, GLenum type, GLuint relativeoffset), (vaobj, attribindex, size, type, relativeoffset))
+GL_VOID_FUNCTION(glVertexArrayBindingDivisor, (GLuint vaobj, GLuint bindingindex, GLuint divisor), (vaobj, bindingindex, divisor))
+GL_VOID_FUNCTION(glGetVertexArrayiv, (GLuint vaobj, GLenum pname, GLint *param), (vaobj, pname, param))
+GL_VOID_FUNCTION(glGetVertexArrayIndexediv, (GLuint vaobj, GLuint index, GLenum pname, GLint *param), (vaobj, index, pname, param))
+GL_VOID_FUNCTION(glGetVertexArrayIndexed64iv, (GLuint vaobj, GLuint index, GLenum pname, GLint64 *param), (vaobj, index, pname, param))
+GL_VOID_FUNCTION(glCreateSamplers, (GLsizei n, GLuint *samplers), (n, samplers))
+GL_VOID_FUNCTION(glCreateProgramPipelines, (GLsizei n, GLuint *pipelines), (n, pipelines))
+GL_VOID_FUNCTION(glCreateQueries, (GLenum target, GLsizei n, GLuint *ids), (target, n, ids))
+GL_VOID_FUNCTION(glGetQueryBufferObjecti64v, (GLuint id, GLuint buffer, GLenum pname, GLintptr offset), (id, buffer, pname, offset))
+GL_VOID_FUNCTION(glGetQueryBufferObjectiv, (GLuint id, GLuint buffer, GLenum pname, GLintptr offset), (id, buffer, pname, offset))
+GL_VOID_FUNCTION(glGetQueryBufferObjectui64v, (GLuint id, GLuint buffer, GLenum pname, GLintptr offset), (id, buffer, pname, offset))
+GL_VOID_FUNCTION(glGetQueryBufferObjectuiv, (GLuint id, GLuint buffer, GLenum pname, GLintptr offset), (id, buffer, pname, offset))
+GL_VOID_FUNCTION(glMemoryBarrierByRegion, (GLbitfield barriers), (barriers))
+GL_VOID_FUNCTION(glGetTextureSubImage, (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, GLsizei bufSize, void *pixels), (texture, level, xoffset, yoffset, zoffset, width, height, depth, format, type, bufSize, pixels))
+GL_VOID_FUNCTION(glGetCompressedTextureSubImage, (GLuint texture, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLsizei bufSize, void *pixels), (texture, level, xoffset, yoffset, zoffset, width, height, depth, bufSize, pixels))
+GL_FUNCTION(GLenum, glGetGraphicsResetStatus, (void), ())
+GL_VOID_FUNCTION(glGetnCompressedTexImage, (GLenum target, GLint lod, GLsizei bufSize, void *pixels), (target, lod, bufSize, pixels))
+GL_VOID_FUNCTION(glGetnTexImage, (GLenum target, GLint level, GLenum format, GLenum type, GLsizei bufSize, void *pixels), (target, level, format, type, bufSize, pixels))
+GL_VOID_FUNCTION(glGetnUniformdv, (GLuint program, GLint location, GLsizei bufSize, GLdouble *params), (program, location, bufSize, params))
+GL_VOID_FUNCTION(glGetnUniformfv, (GLuint program, GLint location, GLsizei bufSize, GLfloat *params), (program, location, bufSize, params))
+GL_VOID_FUNCTION(glGetnUniformiv, (GLuint program, GLint location, GLsizei bufSize, GLint *params), (program, location, bufSize, params))
+GL_VOID_FUNCTION(glGetnUniformuiv, (GLuint program, GLint location, GLsizei bufSize, GLuint *params), (program, location, bufSize, params))
+GL_VOID_FUNCTION(glReadnPixels, (GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, GLsizei bufSize, void *data), (x, y, width, height, format, type, bufSize, data))
+GL_VOID_FUNCTION(glTextureBarrier, (void), ())
+GL_VOID_FUNCTION(glSpecializeShader, (GLuint shader, const GLchar *pEntryPoint, GLuint numSpecializationConstants, const GLuint *pConstantIndex, const GLuint *pConstantValue), (shader, pEntryPoint, numSpecializationConstants, pConstantIndex, pConstantValue))
+GL_VOID_FUNCTION(glMultiDrawArraysIndirectCount, (GLenum mode, const void *indirect, GLintptr drawcount, GLsizei maxdrawcount, GLsizei stride), (mode, indirect, drawcount, maxdrawcount, stride))
+GL_VOID_FUNCTION(glMultiDrawElementsIndirectCount, (GLenum mode, GLenum type, const void *indirect, GLintptr drawcount, GLsizei maxdrawcount, GLsizei stride), (mode, type, indirect, drawcount, maxdrawcount, stride))
+GL_VOID_FUNCTION(glPolygonOffsetClamp, (GLfloat factor, GLfloat units, GLfloat clamp), (factor, units, clamp))
@@ -0,0 +1,163 @@
+/**
+ * \file gl_loader.c
+ * \author Isaiah Lateer
+ * 
+ * Source file for the OpenGL loader functions.
+ */
+
+#include "gl_loader.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "timer.h"
+#include "trace.h"
+
+#ifdef _MSC_VER
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL _Thread_local
+#endif
+
+static THREAD_LOCAL gl_dispatch* current_dispatch = NULL;
+
+/**
+ * Resolves a function for the current dispatch table on the first call to it.
+ * Calling a function the context lacks is a programming error, so it aborts
+ * with the function's name rather than jumping to null.
+ * 
+ * \param[in] name Function name.
+ * \return Function address.
+ */
+static procedure resolve_lazily(const char* name) {
+    if (!current_dispatch) {
+        fprintf(stderr, "[ERROR] Called %s with no current dispatch table.\n",
+            name);
+        abort();
+    }
+
+    const procedure function =
+        get_procedure_address(current_dispatch->window, name);
+    if (!function) {
+        fprintf(stderr, "[ERROR] Failed to load %s.\n", name);
+        abort();
+    }
+
+    ++current_dispatch->resolved;
+
+    return function;
+}
+
+#define GL_FUNCTION(type, name, parameters, arguments) \
+    static type APIENTRY lazy_##name parameters { \
+        current_dispatch->name = \
+            (type (APIENTRYP) parameters) resolve_lazily(#name); \
+        return current_dispatch->name arguments; \
+    }
+#define GL_VOID_FUNCTION(name, parameters, arguments) \
+    static void APIENTRY lazy_##name parameters { \
+        current_dispatch->name = \
+            (void (APIENTRYP) parameters) resolve_lazily(#name); \
+        current_dispatch->name arguments; \
+    }
+#include "gl_functions.h"
+#undef GL_FUNCTION
+#undef GL_VOID_FUNCTION
+
+/**
+ * Resolves every function in a dispatch table.
+ * 
+ * \param[in] dispatch Dispatch table.
+ */
+static void load_in_bulk(gl_dispatch* dispatch) {
+    const window* window = dispatch->window;
+
+#define GL_FUNCTION(type, name, parameters, arguments) \
+    dispatch->name = \
+        (type (APIENTRYP) parameters) get_procedure_address(window, #name); \
+    dispatch->resolved += dispatch->name != NULL; \
+    dispatch->missing += dispatch->name == NULL;
+#define GL_VOID_FUNCTION(name, parameters, arguments) \
+    GL_FUNCTION(void, name, parameters, arguments)
+#include "gl_functions.h"
+#undef GL_FUNCTION
+#undef GL_VOID_FUNCTION
+}
+
+/**
+ * Points every function in a dispatch table at its lazy loading stub.
+ * 
+ * \param[in] dispatch Dispatch table.
+ */
+static void load_lazily(gl_dispatch* dispatch) {
+#define GL_FUNCTION(type, name, parameters, arguments) \
+    dispatch->name = lazy_##name;
+#define GL_VOID_FUNCTION(name, parameters, arguments) \
+    dispatch->name = lazy_##name;
+#include "gl_functions.h"
+#undef GL_FUNCTION
+#undef GL_VOID_FUNCTION
+}
+
+/**
+ * Creates a dispatch table for a window's context. Bulk loading resolves every
+ * function now. Lazy loading resolves each function on its first call
+ * through the table, which must then be current on the calling thread.
+ * 
+ * \param[in] window Window.
+ * \param[in] loading Loading mode. Must not be GL_LOADING_NONE.
+ * \return New dispatch table.
+ */
+gl_dispatch* create_gl_dispatch(const window* window, gl_loading loading) {
+    gl_dispatch* dispatch = malloc(sizeof(struct gl_dispatch));
+    memset(dispatch, 0, sizeof(struct gl_dispatch));
+
+    dispatch->window = window;
+
+    const uint64_t start = get_time();
+    const uint64_t stage = begin_trace();
+
+    if (loading == GL_LOADING_BULK) {
+        load_in_bulk(dispatch);
+    } else {
+        load_lazily(dispatch);
+    }
+
+    end_trace("create_gl_dispatch", stage);
+    dispatch->load_time = get_time() - start;
+
+    return dispatch;
+}
+
+/**
+ * Destroys a dispatch table.
+ * 
+ * \param[in] dispatch Dispatch table.
+ */
+void destroy_gl_dispatch(gl_dispatch* dispatch) {
+    if (current_dispatch == dispatch) {
+        current_dispatch = NULL;
+    }
+
+    free(dispatch);
+}
+
+/**
+ * Sets the dispatch table lazily loaded functions resolve into on the calling
+ * thread. Called by make_current() for windows that own a table.
+ * 
+ * \param[in] dispatch Dispatch table, or null.
+ */
+void set_current_gl_dispatch(gl_dispatch* dispatch) {
+    current_dispatch = dispatch;
+}
+
+/**
+ * Gets the dispatch table current on the calling thread.
+ * 
+ * \return Dispatch table, or null.
+ */
+gl_dispatch* get_current_gl_dispatch(void) {
+    return current_dispatch;
+}
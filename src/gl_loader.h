@@ -0,0 +1,69 @@
+/**
+ * \file gl_loader.h
+ * \author Isaiah Lateer
+ * 
+ * Header file for the OpenGL dispatch table and loader functions.
+ */
+
+#ifndef OPENGL_CONTEXT_GL_LOADER_HEADER
+#define OPENGL_CONTEXT_GL_LOADER_HEADER
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "opengl.h"
+#include "window.h"
+
+/**
+ * OpenGL core profile entry points of one context. The function pointers come
+ * first and in registry order so hot calls touch as few cache lines as
+ * possible.
+ */
+typedef struct gl_dispatch {
+#define GL_FUNCTION(type, name, parameters, arguments) \
+    type (APIENTRYP name) parameters;
+#define GL_VOID_FUNCTION(name, parameters, arguments) \
+    void (APIENTRYP name) parameters;
+#include "gl_functions.h"
+#undef GL_FUNCTION
+#undef GL_VOID_FUNCTION
+    const window* window;
+    size_t resolved;
+    size_t missing;
+    uint64_t load_time;
+} gl_dispatch;
+
+/**
+ * Creates a dispatch table for a window's context. Bulk loading resolves every
+ * function now. Lazy loading resolves each function on its first call
+ * through the table, which must then be current on the calling thread.
+ * 
+ * \param[in] window Window.
+ * \param[in] loading Loading mode. Must not be GL_LOADING_NONE.
+ * \return New dispatch table.
+ */
+gl_dispatch* create_gl_dispatch(const window* window, gl_loading loading);
+
+/**
+ * Destroys a dispatch table.
+ * 
+ * \param[in] dispatch Dispatch table.
+ */
+void destroy_gl_dispatch(gl_dispatch* dispatch);
+
+/**
+ * Sets the dispatch table lazily loaded functions resolve into on the calling
+ * thread. Called by make_current() for windows that own a table.
+ * 
+ * \param[in] dispatch Dispatch table, or null.
+ */
+void set_current_gl_dispatch(gl_dispatch* dispatch);
+
+/**
+ * Gets the dispatch table current on the calling thread.
+ * 
+ * \return Dispatch table, or null.
+ */
+gl_dispatch* get_current_gl_dispatch(void);
+
+#endif
@@ -0,0 +1,630 @@
+/**
+ * \file linux_headless.c
+ * \author Isaiah Lateer
+ * 
+ * Source file for the headless window functions.
+ */
+
+#include "platform.h"
+
+#ifdef OPENGL_CONTEXT_LINUX_PLATFORM
+
+#include "linux_headless.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <pthread.h>
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <GL/gl.h>
+#include <GL/glext.h>
+
+#include "trace.h"
+
+typedef struct headless_display {
+    EGLDisplay display;
+    unsigned references;
+    bool no_config;
+    bool surfaceless;
+    bool no_error;
+} headless_display;
+
+typedef struct headless_window {
+    EGLConfig config;
+    EGLContext context;
+    EGLSurface surface;
+    gl_errors errors;
+    GLuint framebuffer;
+    GLuint renderbuffers[2];
+    unsigned width, height;
+    PFNGLBINDFRAMEBUFFERPROC glBindFramebuffer;
+    PFNGLDELETEFRAMEBUFFERSPROC glDeleteFramebuffers;
+    PFNGLDELETERENDERBUFFERSPROC glDeleteRenderbuffers;
+} headless_window;
+
+typedef struct headless_context {
+    EGLContext context;
+    EGLSurface surface;
+} headless_context;
+
+static headless_display shared_display = {
+    EGL_NO_DISPLAY, 0, false, false, false
+};
+static pthread_mutex_t display_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+/**
+ * Checks if an extension is in a space separated extension list.
+ * 
+ * \param[in] extensions Extension list.
+ * \param[in] name Extension name.
+ * \return Whether the extension is in the list.
+ */
+static bool has_extension(const char* extensions, const char* name) {
+    if (!extensions) {
+        return false;
+    }
+
+    const size_t length = strlen(name);
+
+    const char* start = extensions;
+    while ((start = strstr(start, name))) {
+        const bool at_start = start == extensions || start[-1] == ' ';
+        const bool at_end = start[length] == ' ' || start[length] == '\0';
+        if (at_start && at_end) {
+            return true;
+        }
+
+        start += length;
+    }
+
+    return false;
+}
+
+/**
+ * Initializes the shared EGL display. Prefers the Mesa surfaceless platform,
+ * which needs neither an X server nor a GPU. The display mutex must be held.
+ * 
+ * \return Whether the display was initialized.
+ */
+static bool initialize_headless_display(void) {
+    const char* client_extensions =
+        eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+
+    EGLDisplay display = EGL_NO_DISPLAY;
+    if (has_extension(client_extensions, "EGL_MESA_platform_surfaceless")) {
+        PFNEGLGETPLATFORMDISPLAYEXTPROC eglGetPlatformDisplayEXT =
+            (PFNEGLGETPLATFORMDISPLAYEXTPROC)
+            eglGetProcAddress("eglGetPlatformDisplayEXT");
+        if (eglGetPlatformDisplayEXT) {
+            display = eglGetPlatformDisplayEXT(EGL_PLATFORM_SURFACELESS_MESA,
+                EGL_DEFAULT_DISPLAY, NULL);
+        }
+    }
+
+    if (display == EGL_NO_DISPLAY) {
+        display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+
+    EGLint major_version, minor_version;
+    if (display == EGL_NO_DISPLAY
+        || !eglInitialize(display, &major_version, &minor_version)) {
+        fprintf(stderr, "[ERROR] Failed to initialize EGL display.\n");
+        return false;
+    }
+
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        fprintf(stderr, "[ERROR] Failed to bind OpenGL API.\n");
+
+        eglTerminate(display);
+
+        return false;
+    }
+
+    const char* extensions = eglQueryString(display, EGL_EXTENSIONS);
+
+    shared_display.display = display;
+    shared_display.references = 1;
+    shared_display.no_config =
+        has_extension(extensions, "EGL_KHR_no_config_context");
+    shared_display.surfaceless =
+        has_extension(extensions, "EGL_KHR_surfaceless_context");
+    shared_display.no_error =
+        has_extension(extensions, "EGL_KHR_create_context_no_error");
+
+    return true;
+}
+
+/**
+ * Gets the shared EGL display, initializing it on first use. Can be called
+ * from any thread.
+ * 
+ * \return Shared display, or null on failure.
+ */
+static headless_display* acquire_headless_display(void) {
+    pthread_mutex_lock(&display_mutex);
+
+    headless_display* display = &shared_display;
+    if (shared_display.references) {
+        ++shared_display.references;
+    } else if (!initialize_headless_display()) {
+        display = NULL;
+    }
+
+    pthread_mutex_unlock(&display_mutex);
+
+    return display;
+}
+
+/**
+ * Releases a reference to the shared EGL display, terminating it once the
+ * last headless window or context is gone. Can be called from any thread.
+ */
+static void release_headless_display(void) {
+    pthread_mutex_lock(&display_mutex);
+
+    if (!--shared_display.references) {
+        eglTerminate(shared_display.display);
+        shared_display.display = EGL_NO_DISPLAY;
+    }
+
+    pthread_mutex_unlock(&display_mutex);
+}
+
+/**
+ * Creates a core profile context, falling back to whatever the driver gives
+ * without attributes.
+ * 
+ * \param[in] display Shared display.
+ * \param[in] config Configuration, or none with EGL_KHR_no_config_context.
+ * \param[in] share_context Context to share objects with, or none.
+ * \param[in] errors Error mode.
+ * \return New context, or none on failure.
+ */
+static EGLContext create_context(const headless_display* display,
+    EGLConfig config, EGLContext share_context, gl_errors errors) {
+    EGLint context_attributes[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 2,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE, EGL_NONE,
+        EGL_NONE
+    };
+
+    if (errors == GL_ERRORS_DEBUG) {
+        context_attributes[6] = EGL_CONTEXT_OPENGL_DEBUG;
+        context_attributes[7] = EGL_TRUE;
+    } else if (errors == GL_ERRORS_NONE && display->no_error) {
+        context_attributes[6] = EGL_CONTEXT_OPENGL_NO_ERROR_KHR;
+        context_attributes[7] = EGL_TRUE;
+    }
+
+    EGLContext context = eglCreateContext(display->display, config,
+        share_context, context_attributes);
+    if (context == EGL_NO_CONTEXT) {
+        context = eglCreateContext(display->display, config, share_context,
+            NULL);
+    }
+
+    return context;
+}
+
+/**
+ * Creates the 1x1 pbuffer a context is made current with when the display
+ * cannot make contexts current without a surface.
+ * 
+ * \param[in] display Shared display.
+ * \param[in] config Configuration.
+ * \return New pbuffer, or none on failure.
+ */
+static EGLSurface create_pbuffer(const headless_display* display,
+    EGLConfig config) {
+    const EGLint surface_attributes[] = {
+        EGL_WIDTH, 1,
+        EGL_HEIGHT, 1,
+        EGL_NONE
+    };
+
+    return eglCreatePbufferSurface(display->display, config,
+        surface_attributes);
+}
+
+/**
+ * Creates the framebuffer object a headless window renders into and leaves it
+ * bound. Like the native path, it takes the cheapest buffers that meet the
+ * settings: no alpha unless asked for, and a 24-bit depth and 8-bit stencil
+ * buffer. Settings it cannot meet, such as multisampling, are reported.
+ * 
+ * \param[in] headless Headless window.
+ * \param[in] settings Framebuffer settings.
+ * \return Whether the framebuffer is complete.
+ */
+static bool create_headless_framebuffer(headless_window* headless,
+    const framebuffer_settings* settings) {
+    PFNGLGENFRAMEBUFFERSPROC glGenFramebuffers = (PFNGLGENFRAMEBUFFERSPROC)
+        eglGetProcAddress("glGenFramebuffers");
+    PFNGLGENRENDERBUFFERSPROC glGenRenderbuffers = (PFNGLGENRENDERBUFFERSPROC)
+        eglGetProcAddress("glGenRenderbuffers");
+    PFNGLBINDRENDERBUFFERPROC glBindRenderbuffer = (PFNGLBINDRENDERBUFFERPROC)
+        eglGetProcAddress("glBindRenderbuffer");
+    PFNGLRENDERBUFFERSTORAGEPROC glRenderbufferStorage =
+        (PFNGLRENDERBUFFERSTORAGEPROC)
+        eglGetProcAddress("glRenderbufferStorage");
+    PFNGLFRAMEBUFFERRENDERBUFFERPROC glFramebufferRenderbuffer =
+        (PFNGLFRAMEBUFFERRENDERBUFFERPROC)
+        eglGetProcAddress("glFramebufferRenderbuffer");
+    PFNGLCHECKFRAMEBUFFERSTATUSPROC glCheckFramebufferStatus =
+        (PFNGLCHECKFRAMEBUFFERSTATUSPROC)
+        eglGetProcAddress("glCheckFramebufferStatus");
+
+    headless->glBindFramebuffer = (PFNGLBINDFRAMEBUFFERPROC)
+        eglGetProcAddress("glBindFramebuffer");
+    headless->glDeleteFramebuffers = (PFNGLDELETEFRAMEBUFFERSPROC)
+        eglGetProcAddress("glDeleteFramebuffers");
+    headless->glDeleteRenderbuffers = (PFNGLDELETERENDERBUFFERSPROC)
+        eglGetProcAddress("glDeleteRenderbuffers");
+
+    if (!glGenFramebuffers || !glGenRenderbuffers || !glBindRenderbuffer
+        || !glRenderbufferStorage || !glFramebufferRenderbuffer
+        || !glCheckFramebufferStatus || !headless->glBindFramebuffer
+        || !headless->glDeleteFramebuffers
+        || !headless->glDeleteRenderbuffers) {
+        return false;
+    }
+
+    if (settings->samples > 0) {
+        printf("[INFO] Rendering without multisampling; headless windows "
+            "have single-sample framebuffers.\n");
+    }
+
+    if (settings->depth_bits > 24 || settings->stencil_bits > 8) {
+        printf("[INFO] Depth and stencil buffers will be limited to 24 and 8 "
+            "bits; headless windows have no larger ones.\n");
+    }
+
+    // There is no renderable sRGB format without alpha.
+    GLenum color_format = settings->alpha ? GL_RGBA8 : GL_RGB8;
+    if (settings->srgb) {
+        color_format = GL_SRGB8_ALPHA8;
+    }
+
+    glGenFramebuffers(1, &headless->framebuffer);
+    headless->glBindFramebuffer(GL_FRAMEBUFFER, headless->framebuffer);
+
+    glGenRenderbuffers(2, headless->renderbuffers);
+
+    glBindRenderbuffer(GL_RENDERBUFFER, headless->renderbuffers[0]);
+    glRenderbufferStorage(GL_RENDERBUFFER, color_format, headless->width,
+        headless->height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+        GL_RENDERBUFFER, headless->renderbuffers[0]);
+
+    if (settings->depth_bits || settings->stencil_bits) {
+        glBindRenderbuffer(GL_RENDERBUFFER, headless->renderbuffers[1]);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8,
+            headless->width, headless->height);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT,
+            GL_RENDERBUFFER, headless->renderbuffers[1]);
+    }
+
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glViewport(0, 0, headless->width, headless->height);
+
+    return glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+}
+
+/**
+ * Creates an offscreen context on an EGL surfaceless display, rendering into
+ * a framebuffer object the size of the window.
+ * 
+ * \param[in] settings Window settings.
+ * \param[in] share Headless window to share objects with, or null.
+ * \return New headless window.
+ */
+headless_window* create_headless_window(const window_settings* settings,
+    const headless_window* share) {
+    uint64_t stage = begin_trace();
+    headless_display* display = acquire_headless_display();
+    end_trace("acquire_headless_display", stage);
+    if (!display) {
+        return NULL;
+    }
+
+    headless_window* headless = malloc(sizeof(struct headless_window));
+    memset(headless, 0, sizeof(struct headless_window));
+
+    headless->width = settings->width;
+    headless->height = settings->height;
+    headless->config = EGL_NO_CONFIG_KHR;
+    headless->surface = EGL_NO_SURFACE;
+
+    if (!display->no_config || !display->surfaceless) {
+        const EGLint config_attributes[] = {
+            EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+            EGL_RED_SIZE, 8,
+            EGL_GREEN_SIZE, 8,
+            EGL_BLUE_SIZE, 8,
+            EGL_NONE
+        };
+
+        EGLint config_count = 0;
+        if (!eglChooseConfig(display->display, config_attributes,
+            &headless->config, 1, &config_count) || !config_count) {
+            fprintf(stderr, "[ERROR] Failed to choose EGL configuration.\n");
+
+            release_headless_display();
+
+            free(headless);
+
+            return NULL;
+        }
+    }
+
+    const EGLContext share_context = share ? share->context : EGL_NO_CONTEXT;
+
+    stage = begin_trace();
+
+    if (settings->errors == GL_ERRORS_NONE && !display->no_error) {
+        printf("[INFO] Errors will be checked; the driver cannot create "
+            "no-error contexts.\n");
+    }
+
+    headless->errors = settings->errors;
+    headless->context = create_context(display, headless->config,
+        share_context, settings->errors);
+
+    end_trace("create_context", stage);
+
+    if (headless->context == EGL_NO_CONTEXT) {
+        fprintf(stderr, "[ERROR] Failed to create context.\n");
+
+        release_headless_display();
+
+        free(headless);
+
+        return NULL;
+    }
+
+    if (!display->surfaceless) {
+        headless->surface = create_pbuffer(display, headless->config);
+        if (headless->surface == EGL_NO_SURFACE) {
+            fprintf(stderr, "[ERROR] Failed to create pbuffer.\n");
+
+            eglDestroyContext(display->display, headless->context);
+            release_headless_display();
+
+            free(headless);
+
+            return NULL;
+        }
+    }
+
+    if (!eglMakeCurrent(display->display, headless->surface, headless->surface,
+        headless->context)) {
+        fprintf(stderr, "[ERROR] Failed to set context.\n");
+
+        if (headless->surface != EGL_NO_SURFACE) {
+            eglDestroySurface(display->display, headless->surface);
+        }
+
+        eglDestroyContext(display->display, headless->context);
+        release_headless_display();
+
+        free(headless);
+
+        return NULL;
+    }
+
+    if (!create_headless_framebuffer(headless, &settings->framebuffer)) {
+        fprintf(stderr, "[ERROR] Failed to create framebuffer.\n");
+
+        destroy_headless_window(headless);
+
+        return NULL;
+    }
+
+    return headless;
+}
+
+/**
+ * Destroys a headless window. Whichever context was current beforehand is
+ * current again afterwards, unless it was this window's.
+ * 
+ * \param[in] headless Headless window.
+ */
+void destroy_headless_window(headless_window* headless) {
+    EGLDisplay display = shared_display.display;
+
+    const EGLContext previous_context = eglGetCurrentContext();
+    const EGLDisplay previous_display = eglGetCurrentDisplay();
+    const EGLSurface previous_draw = eglGetCurrentSurface(EGL_DRAW);
+    const EGLSurface previous_read = eglGetCurrentSurface(EGL_READ);
+
+    bool current = previous_context == headless->context;
+    if (!current) {
+        current = eglMakeCurrent(display, headless->surface,
+            headless->surface, headless->context);
+    }
+
+    if (!current) {
+        fprintf(stderr, "[ERROR] Failed to set context; the framebuffer will "
+            "be released with the context.\n");
+    } else if (headless->glDeleteFramebuffers
+        && headless->glDeleteRenderbuffers) {
+        headless->glDeleteFramebuffers(1, &headless->framebuffer);
+        headless->glDeleteRenderbuffers(2, headless->renderbuffers);
+    }
+
+    if (previous_context != EGL_NO_CONTEXT
+        && previous_context != headless->context) {
+        if (current && !eglMakeCurrent(previous_display, previous_draw,
+            previous_read, previous_context)) {
+            fprintf(stderr, "[ERROR] Failed to restore context.\n");
+        }
+    } else {
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE,
+            EGL_NO_CONTEXT);
+    }
+
+    if (headless->surface != EGL_NO_SURFACE) {
+        eglDestroySurface(display, headless->surface);
+    }
+
+    eglDestroyContext(display, headless->context);
+    release_headless_display();
+
+    free(headless);
+}
+
+/**
+ * Makes the headless window's context current and binds its framebuffer.
+ * 
+ * \param[in] headless Headless window.
+ * \return Whether the context was made current.
+ */
+bool make_headless_current(headless_window* headless) {
+    eglBindAPI(EGL_OPENGL_API);
+
+    if (!eglMakeCurrent(shared_display.display, headless->surface,
+        headless->surface, headless->context)) {
+        fprintf(stderr, "[ERROR] Failed to set context.\n");
+        return false;
+    }
+
+    headless->glBindFramebuffer(GL_FRAMEBUFFER, headless->framebuffer);
+
+    return true;
+}
+
+/**
+ * Releases the headless window's context from the calling thread.
+ * 
+ * \param[in] headless Headless window.
+ */
+void release_headless_current(headless_window* headless) {
+    eglMakeCurrent(shared_display.display, EGL_NO_SURFACE, EGL_NO_SURFACE,
+        EGL_NO_CONTEXT);
+}
+
+/**
+ * Finishes a frame of a headless window.
+ * 
+ * \param[in] headless Headless window.
+ */
+void swap_headless_buffer(headless_window* headless) {
+    glFlush();
+}
+
+/**
+ * Gets the framebuffer object a headless window renders into.
+ * 
+ * \param[in] headless Headless window.
+ * \return Framebuffer object name.
+ */
+unsigned get_headless_framebuffer(const headless_window* headless) {
+    return headless->framebuffer;
+}
+
+/**
+ * Creates a context sharing objects with a headless window's context, with no
+ * framebuffer of its own.
+ * 
+ * \param[in] share Headless window.
+ * \return New headless context.
+ */
+headless_context* create_headless_context(const headless_window* share) {
+    headless_context* context = malloc(sizeof(struct headless_context));
+
+    context->surface = EGL_NO_SURFACE;
+    context->context = create_context(&shared_display, share->config,
+        share->context, share->errors);
+    if (context->context == EGL_NO_CONTEXT) {
+        fprintf(stderr, "[ERROR] Failed to create shared context.\n");
+
+        free(context);
+
+        return NULL;
+    }
+
+    if (!shared_display.surfaceless) {
+        context->surface = create_pbuffer(&shared_display, share->config);
+        if (context->surface == EGL_NO_SURFACE) {
+            fprintf(stderr, "[ERROR] Failed to create pbuffer.\n");
+
+            eglDestroyContext(shared_display.display, context->context);
+
+            free(context);
+
+            return NULL;
+        }
+    }
+
+    pthread_mutex_lock(&display_mutex);
+    ++shared_display.references;
+    pthread_mutex_unlock(&display_mutex);
+
+    return context;
+}
+
+/**
+ * Destroys a headless context.
+ * 
+ * \param[in] context Headless context.
+ */
+void destroy_headless_context(headless_context* context) {
+    if (context->surface != EGL_NO_SURFACE) {
+        eglDestroySurface(shared_display.display, context->surface);
+    }
+
+    eglDestroyContext(shared_display.display, context->context);
+    release_headless_display();
+
+    free(context);
+}
+
+/**
+ * Makes a headless context current.
+ * 
+ * \param[in] context Headless context.
+ * \return Whether the context was made current.
+ */
+bool make_headless_context_current(headless_context* context) {
+    eglBindAPI(EGL_OPENGL_API);
+
+    if (!eglMakeCurrent(shared_display.display, context->surface,
+        context->surface, context->context)) {
+        fprintf(stderr, "[ERROR] Failed to set shared context.\n");
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Releases a headless context from the calling thread.
+ * 
+ * \param[in] context Headless context.
+ */
+void release_headless_context(headless_context* context) {
+    eglMakeCurrent(shared_display.display, EGL_NO_SURFACE, EGL_NO_SURFACE,
+        EGL_NO_CONTEXT);
+}
+
+/**
+ * Gets a procedure address from EGL.
+ * 
+ * \param[in] name Procedure name.
+ * \return Procedure address.
+ */
+procedure get_headless_procedure(const char* name) {
+    return (procedure) eglGetProcAddress(name);
+}
+
+#elif defined(OPENGL_CONTEXT_WINDOWS_PLATFORM)
+static int linux_headless_c;
+#endif
@@ -0,0 +1,105 @@
+/**
+ * \file linux_headless.h
+ * \author Isaiah Lateer
+ * 
+ * Header file for the headless window struct and functions. Used by
+ * linux_window.c to implement headless windows behind window.h.
+ */
+
+#ifndef OPENGL_CONTEXT_LINUX_HEADLESS_HEADER
+#define OPENGL_CONTEXT_LINUX_HEADLESS_HEADER
+
+#include "window.h"
+
+typedef struct headless_window headless_window;
+
+typedef struct headless_context headless_context;
+
+/**
+ * Creates an offscreen context on an EGL surfaceless display, rendering into
+ * a framebuffer object the size of the window.
+ * 
+ * \param[in] settings Window settings.
+ * \param[in] share Headless window to share objects with, or null.
+ * \return New headless window.
+ */
+headless_window* create_headless_window(const window_settings* settings,
+    const headless_window* share);
+
+/**
+ * Destroys a headless window.
+ * 
+ * \param[in] headless Headless window.
+ */
+void destroy_headless_window(headless_window* headless);
+
+/**
+ * Makes the headless window's context current and binds its framebuffer.
+ * 
+ * \param[in] headless Headless window.
+ * \return Whether the context was made current.
+ */
+bool make_headless_current(headless_window* headless);
+
+/**
+ * Releases the headless window's context from the calling thread.
+ * 
+ * \param[in] headless Headless window.
+ */
+void release_headless_current(headless_window* headless);
+
+/**
+ * Finishes a frame of a headless window.
+ * 
+ * \param[in] headless Headless window.
+ */
+void swap_headless_buffer(headless_window* headless);
+
+/**
+ * Gets the framebuffer object a headless window renders into.
+ * 
+ * \param[in] headless Headless window.
+ * \return Framebuffer object name.
+ */
+unsigned get_headless_framebuffer(const headless_window* headless);
+
+/**
+ * Creates a context sharing objects with a headless window's context, with no
+ * framebuffer of its own.
+ * 
+ * \param[in] share Headless window.
+ * \return New headless context.
+ */
+headless_context* create_headless_context(const headless_window* share);
+
+/**
+ * Destroys a headless context.
+ * 
+ * \param[in] context Headless context.
+ */
+void destroy_headless_context(headless_context* context);
+
+/**
+ * Makes a headless context current.
+ * 
+ * \param[in] context Headless context.
+ * \return Whether the context was made current.
+ */
+bool make_headless_context_current(headless_context* context);
+
+/**
+ * Releases a headless context from the calling thread.
+ * 
+ * \param[in] context Headless context.
+ */
+void release_headless_context(headless_context* context);
+
+/**
+ * Gets a procedure address from EGL.
+ * 
+ * \param[in] name Procedure name.
+ * \return Procedure address.
+ */
+procedure get_headless_procedure(const char* name);
+
+#endif
@@ -0,0 +1,94 @@
+/**
+ * \file linux_mapped_file.c
+ * \author Isaiah Lateer
+ * 
+ * Source file for the mapped file functions.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "platform.h"
+
+#ifdef OPENGL_CONTEXT_LINUX_PLATFORM
+
+#include "mapped_file.h"
+
+#include <stdlib.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+typedef struct mapped_file {
+    void* data;
+    size_t size;
+} mapped_file;
+
+/**
+ * Maps a whole file into memory read only. The file must be unmapped before
+ * it is replaced.
+ * 
+ * \param[in] path File path.
+ * \return New mapping, or null if the file is missing or empty.
+ */
+mapped_file* map_file(const char* path) {
+    const int descriptor = open(path, O_RDONLY | O_CLOEXEC);
+    if (descriptor < 0) {
+        return NULL;
+    }
+
+    struct stat status;
+    if (fstat(descriptor, &status) || status.st_size <= 0) {
+        close(descriptor);
+        return NULL;
+    }
+
+    void* data = mmap(NULL, (size_t) status.st_size, PROT_READ, MAP_PRIVATE,
+        descriptor, 0);
+    close(descriptor);
+    if (data == MAP_FAILED) {
+        return NULL;
+    }
+
+    mapped_file* file = malloc(sizeof(struct mapped_file));
+    file->data = data;
+    file->size = (size_t) status.st_size;
+
+    return file;
+}
+
+/**
+ * Unmaps a file.
+ * 
+ * \param[in] file Mapping.
+ */
+void unmap_file(mapped_file* file) {
+    munmap(file->data, file->size);
+
+    free(file);
+}
+
+/**
+ * Gets the mapped contents of a file.
+ * 
+ * \param[in] file Mapping.
+ * \return File contents.
+ */
+const void* get_mapped_data(const mapped_file* file) {
+    return file->data;
+}
+
+/**
+ * Gets the size of a mapped file.
+ * 
+ * \param[in] file Mapping.
+ * \return Size in bytes.
+ */
+size_t get_mapped_size(const mapped_file* file) {
+    return file->size;
+}
+
+#elif defined(OPENGL_CONTEXT_WINDOWS_PLATFORM)
+static int linux_mapped_file_c;
+#endif
@@ -0,0 +1,422 @@
+/**
+ * \file linux_present.c
+ * \author Isaiah Lateer
+ * 
+ * Source file for the present chain functions.
+ */
+
+#include "platform.h"
+
+#if defined(OPENGL_CONTEXT_LINUX_PLATFORM) && defined(OPENGL_CONTEXT_PRESENT)
+
+#include "linux_present.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <X11/Xlib-xcb.h>
+#include <xcb/xcb.h>
+#include <xcb/present.h>
+
+#define MAX_PRESENT_BUFFERS 4
+
+typedef struct present_buffer {
+    Pixmap pixmap;
+    GLXPixmap drawable;
+    unsigned width, height;
+    uint64_t sbc;
+    bool busy;
+} present_buffer;
+
+typedef struct present_chain {
+    Display* display;
+    xcb_connection_t* connection;
+    Window window;
+    GLXFBConfig config;
+    int depth;
+    present_mode mode;
+    int interval;
+    uint32_t event_id;
+    xcb_special_event_t* events;
+    present_buffer buffers[MAX_PRESENT_BUFFERS];
+    unsigned buffer_count;
+    unsigned buffer_limit;
+    present_buffer* current;
+    uint64_t sbc;
+    uint64_t msc;
+    uint64_t target_msc;
+    bool msc_known;
+    present_timing completion;
+    bool completed;
+} present_chain;
+
+/**
+ * Creates the pixmap of a buffer and its GLX drawable.
+ * 
+ * \param[in] chain Present chain.
+ * \param[in] buffer Buffer.
+ * \param[in] width Pixmap width.
+ * \param[in] height Pixmap height.
+ */
+static void create_buffer(present_chain* chain, present_buffer* buffer,
+    unsigned width, unsigned height) {
+    // Pixmaps are at least one pixel in each direction.
+    buffer->width = width ? width : 1;
+    buffer->height = height ? height : 1;
+    buffer->pixmap = XCreatePixmap(chain->display, chain->window,
+        buffer->width, buffer->height, (unsigned) chain->depth);
+    buffer->drawable =
+        glXCreatePixmap(chain->display, chain->config, buffer->pixmap, NULL);
+    buffer->sbc = 0;
+    buffer->busy = false;
+}
+
+/**
+ * Destroys the pixmap of a buffer and its GLX drawable. The server keeps the
+ * pixmap alive until any present still reading it has finished.
+ * 
+ * \param[in] chain Present chain.
+ * \param[in] buffer Buffer.
+ */
+static void destroy_buffer(present_chain* chain, present_buffer* buffer) {
+    glXDestroyPixmap(chain->display, buffer->drawable);
+    XFreePixmap(chain->display, buffer->pixmap);
+}
+
+/**
+ * Records a Present event and frees it.
+ * 
+ * \param[in] chain Present chain.
+ * \param[in] event Event.
+ */
+static void handle_present_event(present_chain* chain,
+    xcb_generic_event_t* event) {
+    const xcb_present_generic_event_t* generic =
+        (const xcb_present_generic_event_t*) event;
+
+    if (generic->evtype == XCB_PRESENT_EVENT_COMPLETE_NOTIFY) {
+        const xcb_present_complete_notify_event_t* complete =
+            (const xcb_present_complete_notify_event_t*) event;
+
+        chain->msc = complete->msc;
+        chain->msc_known = true;
+
+        // Serials are the low bits of the present's swap buffer count.
+        if (complete->kind == XCB_PRESENT_COMPLETE_KIND_PIXMAP
+            && complete->mode != XCB_PRESENT_COMPLETE_MODE_SKIP) {
+            chain->completion.time = complete->ust * 1000;
+            chain->completion.msc = complete->msc;
+            chain->completion.sbc = chain->sbc
+                - (uint32_t) ((uint32_t) chain->sbc - complete->serial);
+            chain->completed = true;
+        }
+    } else if (generic->evtype == XCB_PRESENT_EVENT_IDLE_NOTIFY) {
+        const xcb_present_idle_notify_event_t* idle =
+            (const xcb_present_idle_notify_event_t*) event;
+
+        for (unsigned i = 0; i < chain->buffer_count; ++i) {
+            if (chain->buffers[i].pixmap == idle->pixmap) {
+                chain->buffers[i].busy = false;
+            }
+        }
+    }
+
+    free(event);
+}
+
+/**
+ * Handles every Present event that has already arrived.
+ * 
+ * \param[in] chain Present chain.
+ */
+static void poll_present_events(present_chain* chain) {
+    xcb_generic_event_t* event;
+    while ((event =
+        xcb_poll_for_special_event(chain->connection, chain->events))) {
+        handle_present_event(chain, event);
+    }
+}
+
+/**
+ * Waits for the next Present event and handles it.
+ * 
+ * \param[in] chain Present chain.
+ * \return Whether an event arrived before the connection failed.
+ */
+static bool wait_present_event(present_chain* chain) {
+    xcb_generic_event_t* event =
+        xcb_wait_for_special_event(chain->connection, chain->events);
+    if (!event) {
+        fprintf(stderr, "[ERROR] Lost the connection while waiting for a "
+            "present.\n");
+        return false;
+    }
+
+    handle_present_event(chain, event);
+
+    return true;
+}
+
+/**
+ * Picks the pixmap the next frame renders into. Of the idle pixmaps, the one
+ * presented most recently is taken, since it needs the least redrawing. A
+ * new pixmap is only created when none is idle.
+ * 
+ * \param[in] chain Present chain.
+ * \param[in] width Frame width.
+ * \param[in] height Frame height.
+ * \return Whether a pixmap was picked.
+ */
+static bool acquire_buffer(present_chain* chain, unsigned width,
+    unsigned height) {
+    poll_present_events(chain);
+
+    present_buffer* buffer = NULL;
+    while (!buffer) {
+        for (unsigned i = 0; i < chain->buffer_count; ++i) {
+            if (!chain->buffers[i].busy
+                && (!buffer || chain->buffers[i].sbc > buffer->sbc)) {
+                buffer = &chain->buffers[i];
+            }
+        }
+
+        if (buffer) {
+            break;
+        }
+
+        if (chain->buffer_count < chain->buffer_limit) {
+            buffer = &chain->buffers[chain->buffer_count++];
+            create_buffer(chain, buffer, width, height);
+        } else if (!wait_present_event(chain)) {
+            return false;
+        }
+    }
+
+    if (buffer->width != (width ? width : 1)
+        || buffer->height != (height ? height : 1)) {
+        destroy_buffer(chain, buffer);
+        create_buffer(chain, buffer, width, height);
+    }
+
+    chain->current = buffer;
+
+    return true;
+}
+
+/**
+ * Creates a pool of pixmaps that a window's context renders into in turn and
+ * that are handed to the X server with PresentPixmap. Returns null when the
+ * server lacks the Present extension or the framebuffer configuration cannot
+ * render into pixmaps. The caller should trap errors around this call.
+ * 
+ * \param[in] display Connection to the X server.
+ * \param[in] window Window to present to.
+ * \param[in] config Framebuffer configuration of the window's context.
+ * \param[in] depth Depth of the window's visual.
+ * \param[in] width Pixmap width.
+ * \param[in] height Pixmap height.
+ * \param[in] mode Present mode, other than PRESENT_MODE_SWAP.
+ * \return New present chain.
+ */
+present_chain* create_present_chain(Display* display, Window window,
+    GLXFBConfig config, int depth, unsigned width, unsigned height,
+    present_mode mode) {
+    int drawable_type = 0;
+    if (!config || glXGetFBConfigAttrib(display, config, GLX_DRAWABLE_TYPE,
+        &drawable_type) != Success || !(drawable_type & GLX_PIXMAP_BIT)) {
+        printf("[INFO] The framebuffer configuration cannot render into "
+            "pixmaps.\n");
+        return NULL;
+    }
+
+    xcb_connection_t* connection = XGetXCBConnection(display);
+
+    const xcb_query_extension_reply_t* extension =
+        xcb_get_extension_data(connection, &xcb_present_id);
+    if (!extension || !extension->present) {
+        printf("[INFO] The display does not support the Present "
+            "extension.\n");
+        return NULL;
+    }
+
+    xcb_present_query_version_reply_t* version =
+        xcb_present_query_version_reply(connection,
+        xcb_present_query_version(connection, XCB_PRESENT_MAJOR_VERSION,
+        XCB_PRESENT_MINOR_VERSION), NULL);
+    if (!version) {
+        printf("[INFO] The display does not support the Present "
+            "extension.\n");
+        return NULL;
+    }
+
+    free(version);
+
+    present_chain* chain = malloc(sizeof(struct present_chain));
+    memset(chain, 0, sizeof(struct present_chain));
+
+    chain->display = display;
+    chain->connection = connection;
+    chain->window = window;
+    chain->config = config;
+    chain->depth = depth;
+    chain->mode = mode;
+    chain->interval = 1;
+
+    // Mailbox presents replace each other in the queue instead of waiting, so
+    // they need a pixmap more to never block.
+    chain->buffer_limit =
+        mode == PRESENT_MODE_MAILBOX ? MAX_PRESENT_BUFFERS : 3;
+
+    chain->event_id = xcb_generate_id(connection);
+    chain->events = xcb_register_for_special_xge(connection, &xcb_present_id,
+        chain->event_id, NULL);
+    xcb_present_select_input(connection, chain->event_id, window,
+        XCB_PRESENT_EVENT_MASK_COMPLETE_NOTIFY
+        | XCB_PRESENT_EVENT_MASK_IDLE_NOTIFY);
+
+    // FIFO targets count from the current vertical blank, so ask for it now
+    // rather than on the first present.
+    xcb_present_notify_msc(connection, window, 0, 0, 0, 0);
+    xcb_flush(connection);
+
+    acquire_buffer(chain, width, height);
+
+    return chain;
+}
+
+/**
+ * Destroys a present chain. None of its drawables may be current.
+ * 
+ * \param[in] chain Present chain.
+ */
+void destroy_present_chain(present_chain* chain) {
+    for (unsigned i = 0; i < chain->buffer_count; ++i) {
+        destroy_buffer(chain, &chain->buffers[i]);
+    }
+
+    xcb_present_select_input(chain->connection, chain->event_id,
+        chain->window, XCB_PRESENT_EVENT_MASK_NO_EVENT);
+    xcb_unregister_for_special_event(chain->connection, chain->events);
+
+    free(chain);
+}
+
+/**
+ * Gets the drawable of the pixmap the next frame renders into.
+ * 
+ * \param[in] chain Present chain.
+ * \return GLX drawable.
+ */
+GLXDrawable get_present_drawable(const present_chain* chain) {
+    return chain->current->drawable;
+}
+
+/**
+ * Presents the pixmap the current frame rendered into, then picks an idle one
+ * for the next frame. Only blocks when every pixmap is still in use by the
+ * server.
+ * 
+ * \param[in] chain Present chain.
+ * \param[in] width Width of the next frame.
+ * \param[in] height Height of the next frame.
+ * \return Drawable of the next frame's pixmap, or None if the connection
+ * failed.
+ */
+GLXDrawable swap_present_chain(present_chain* chain, unsigned width,
+    unsigned height) {
+    // Pixmap drawables are single buffered, so the flush is what sends the
+    // frame; the driver orders it before the server reads the pixmap.
+    glFlush();
+
+    uint32_t options = XCB_PRESENT_OPTION_NONE;
+    uint64_t target_msc = 0;
+
+    if (chain->mode == PRESENT_MODE_IMMEDIATE
+        || (chain->mode == PRESENT_MODE_FIFO && chain->interval == 0)) {
+        options |= XCB_PRESENT_OPTION_ASYNC;
+    } else if (chain->mode == PRESENT_MODE_FIFO) {
+        while (!chain->msc_known) {
+            if (!wait_present_event(chain)) {
+                return None;
+            }
+        }
+
+        // Each present gets a vertical blank of its own. A target the server
+        // has already passed is shown at the next one.
+        const uint64_t base = chain->target_msc > chain->msc
+            ? chain->target_msc : chain->msc;
+        target_msc = base
+            + (uint64_t) (chain->interval < 0 ? -chain->interval
+            : chain->interval);
+        chain->target_msc = target_msc;
+
+        if (chain->interval < 0) {
+            options |= XCB_PRESENT_OPTION_ASYNC;
+        }
+    }
+
+    present_buffer* buffer = chain->current;
+    buffer->busy = true;
+    buffer->sbc = ++chain->sbc;
+
+    xcb_present_pixmap(chain->connection, chain->window, buffer->pixmap,
+        (uint32_t) buffer->sbc, XCB_NONE, XCB_NONE, 0, 0, XCB_NONE, XCB_NONE,
+        XCB_NONE, options, target_msc, 0, 0, 0, NULL);
+    xcb_flush(chain->connection);
+
+    if (!acquire_buffer(chain, width, height)) {
+        return None;
+    }
+
+    return chain->current->drawable;
+}
+
+/**
+ * Sets the swap interval used by PRESENT_MODE_FIFO. Zero presents as soon as
+ * possible and a negative value presents late frames without waiting for the
+ * next vertical blank.
+ * 
+ * \param[in] chain Present chain.
+ * \param[in] interval Swap interval.
+ */
+void set_present_interval(present_chain* chain, int interval) {
+    chain->interval = interval;
+}
+
+/**
+ * Gets the age of the pixmap the next frame renders into, as get_buffer_age()
+ * defines it.
+ * 
+ * \param[in] chain Present chain.
+ * \return Buffer age.
+ */
+unsigned get_present_buffer_age(const present_chain* chain) {
+    if (!chain->current->sbc) {
+        return 0;
+    }
+
+    return (unsigned) (chain->sbc - chain->current->sbc + 1);
+}
+
+/**
+ * Handles the Present events that have arrived and gets the timing of the
+ * most recent present that reached the screen. Skipped presents are not
+ * counted.
+ * 
+ * \param[in] chain Present chain.
+ * \param[out] timing Present timing.
+ * \return Whether any present has completed yet.
+ */
+bool get_present_completion(present_chain* chain, present_timing* timing) {
+    poll_present_events(chain);
+
+    *timing = chain->completion;
+
+    return chain->completed;
+}
+
+#elif defined(OPENGL_CONTEXT_WINDOWS_PLATFORM)
+static int linux_present_c;
+#endif
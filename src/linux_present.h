@@ -0,0 +1,101 @@
+/**
+ * \file linux_present.h
+ * \author Isaiah Lateer
+ * 
+ * Header file for the present chain struct and functions. Used by
+ * linux_window.c to present through the X Present extension when built with
+ * OPENGL_CONTEXT_PRESENT.
+ */
+
+#ifndef OPENGL_CONTEXT_LINUX_PRESENT_HEADER
+#define OPENGL_CONTEXT_LINUX_PRESENT_HEADER
+
+#include <stdbool.h>
+
+#include <X11/Xlib.h>
+
+#include <GL/glx.h>
+
+#include "window.h"
+
+typedef struct present_chain present_chain;
+
+/**
+ * Creates a pool of pixmaps that a window's context renders into in turn and
+ * that are handed to the X server with PresentPixmap. Returns null when the
+ * server lacks the Present extension or the framebuffer configuration cannot
+ * render into pixmaps. The caller should trap errors around this call.
+ * 
+ * \param[in] display Connection to the X server.
+ * \param[in] window Window to present to.
+ * \param[in] config Framebuffer configuration of the window's context.
+ * \param[in] depth Depth of the window's visual.
+ * \param[in] width Pixmap width.
+ * \param[in] height Pixmap height.
+ * \param[in] mode Present mode, other than PRESENT_MODE_SWAP.
+ * \return New present chain.
+ */
+present_chain* create_present_chain(Display* display, Window window,
+    GLXFBConfig config, int depth, unsigned width, unsigned height,
+    present_mode mode);
+
+/**
+ * Destroys a present chain. None of its drawables may be current.
+ * 
+ * \param[in] chain Present chain.
+ */
+void destroy_present_chain(present_chain* chain);
+
+/**
+ * Gets the drawable of the pixmap the next frame renders into.
+ * 
+ * \param[in] chain Present chain.
+ * \return GLX drawable.
+ */
+GLXDrawable get_present_drawable(const present_chain* chain);
+
+/**
+ * Presents the pixmap the current frame rendered into, then picks an idle one
+ * for the next frame. Only blocks when every pixmap is still in use by the
+ * server.
+ * 
+ * \param[in] chain Present chain.
+ * \param[in] width Width of the next frame.
+ * \param[in] height Height of the next frame.
+ * \return Drawable of the next frame's pixmap, or None if the connection
+ * failed.
+ */
+GLXDrawable swap_present_chain(present_chain* chain, unsigned width,
+    unsigned height);
+
+/**
+ * Sets the swap interval used by PRESENT_MODE_FIFO. Zero presents as soon as
+ * possible and a negative value presents late frames without waiting for the
+ * next vertical blank.
+ * 
+ * \param[in] chain Present chain.
+ * \param[in] interval Swap interval.
+ */
+void set_present_interval(present_chain* chain, int interval);
+
+/**
+ * Gets the age of the pixmap the next frame renders into, as get_buffer_age()
+ * defines it.
+ * 
+ * \param[in] chain Present chain.
+ * \return Buffer age.
+ */
+unsigned get_present_buffer_age(const present_chain* chain);
+
+/**
+ * Handles the Present events that have arrived and gets the timing of the
+ * most recent present that reached the screen. Skipped presents are not
+ * counted.
+ * 
+ * \param[in] chain Present chain.
+ * \param[out] timing Present timing.
+ * \return Whether any present has completed yet.
+ */
+bool get_present_completion(present_chain* chain, present_timing* timing);
+
+#endif
@@ -0,0 +1,652 @@
+/**
+ * \file linux_software.c
+ * \author Isaiah Lateer
+ * 
+ * Source file for the software surface functions.
+ */
+
+#define _XOPEN_SOURCE 700
+
+#include "platform.h"
+
+#ifdef OPENGL_CONTEXT_LINUX_PLATFORM
+
+#include "linux_software.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <pthread.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
+
+#include <X11/extensions/XShm.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define SOFTWARE_BUFFERS 2
+#define COMPLETION_POLL_NS 1000000
+
+typedef enum pixel_format {
+    PIXEL_FORMAT_DIRECT,
+    PIXEL_FORMAT_SWAP_RED_BLUE,
+    PIXEL_FORMAT_RGB565,
+    PIXEL_FORMAT_GENERIC
+} pixel_format;
+
+typedef struct software_surface {
+    Display* display;
+    Window window;
+    GC gc;
+    Visual* visual;
+    int depth;
+    unsigned long masks[3];
+    bool shared;
+    int completion_type;
+    pixel_format format;
+    unsigned width, height;
+    XImage* images[SOFTWARE_BUFFERS];
+    XShmSegmentInfo segments[SOFTWARE_BUFFERS];
+    pthread_mutex_t pending_mutex;
+    pthread_cond_t completed;
+    bool pending[SOFTWARE_BUFFERS];
+    uint64_t presented[SOFTWARE_BUFFERS];
+    uint32_t* pixels;
+    unsigned back;
+    uint64_t presents;
+} software_surface;
+
+/**
+ * Picks how pixels are converted for an image. The application always draws
+ * 0xAARRGGBB values; the common visuals that differ from that get a SIMD
+ * conversion and anything else goes through XPutPixel().
+ * 
+ * \param[in] surface Software surface.
+ * \param[in] image Image to present from.
+ * \return Pixel format.
+ */
+static pixel_format choose_pixel_format(const software_surface* surface,
+    const XImage* image) {
+    const uint32_t probe = 1;
+    const int host_order =
+        *(const unsigned char*) &probe ? LSBFirst : MSBFirst;
+    if (image->byte_order != host_order) {
+        return PIXEL_FORMAT_GENERIC;
+    }
+
+    const unsigned long* masks = surface->masks;
+
+    if (image->bits_per_pixel == 32 && masks[1] == 0x00FF00) {
+        if (masks[0] == 0xFF0000 && masks[2] == 0x0000FF) {
+            return PIXEL_FORMAT_DIRECT;
+        }
+
+        if (masks[0] == 0x0000FF && masks[2] == 0xFF0000) {
+            return PIXEL_FORMAT_SWAP_RED_BLUE;
+        }
+    }
+
+    if (image->bits_per_pixel == 16 && masks[0] == 0xF800
+        && masks[1] == 0x07E0 && masks[2] == 0x001F) {
+        return PIXEL_FORMAT_RGB565;
+    }
+
+    return PIXEL_FORMAT_GENERIC;
+}
+
+/**
+ * Converts a row of pixels to a visual with red and blue swapped.
+ * 
+ * \param[in] source Source pixels.
+ * \param[out] destination Destination pixels.
+ * \param[in] count Number of pixels.
+ */
+static void convert_swap_red_blue(const uint32_t* source,
+    uint32_t* destination, unsigned count) {
+    unsigned i = 0;
+
+#ifdef __SSE2__
+    const __m128i alpha_green = _mm_set1_epi32((int) 0xFF00FF00);
+    const __m128i low_byte = _mm_set1_epi32(0xFF);
+
+    for (; i + 4 <= count; i += 4) {
+        const __m128i pixels =
+            _mm_loadu_si128((const __m128i*) (source + i));
+        const __m128i red =
+            _mm_and_si128(_mm_srli_epi32(pixels, 16), low_byte);
+        const __m128i blue =
+            _mm_slli_epi32(_mm_and_si128(pixels, low_byte), 16);
+
+        _mm_storeu_si128((__m128i*) (destination + i), _mm_or_si128(
+            _mm_and_si128(pixels, alpha_green), _mm_or_si128(red, blue)));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        const uint32_t pixel = source[i];
+        destination[i] = (pixel & 0xFF00FF00) | ((pixel >> 16) & 0xFF)
+            | ((pixel & 0xFF) << 16);
+    }
+}
+
+/**
+ * Converts a row of pixels to a 16-bit RGB565 visual.
+ * 
+ * \param[in] source Source pixels.
+ * \param[out] destination Destination pixels.
+ * \param[in] count Number of pixels.
+ */
+static void convert_rgb565(const uint32_t* source, uint16_t* destination,
+    unsigned count) {
+    unsigned i = 0;
+
+#ifdef __SSE2__
+    const __m128i red_mask = _mm_set1_epi32(0xF800);
+    const __m128i green_mask = _mm_set1_epi32(0x07E0);
+    const __m128i blue_mask = _mm_set1_epi32(0x001F);
+
+    for (; i + 8 <= count; i += 8) {
+        __m128i packed[2];
+
+        for (int j = 0; j < 2; ++j) {
+            const __m128i pixels =
+                _mm_loadu_si128((const __m128i*) (source + i + j * 4));
+            const __m128i value = _mm_or_si128(
+                _mm_and_si128(_mm_srli_epi32(pixels, 8), red_mask),
+                _mm_or_si128(
+                _mm_and_si128(_mm_srli_epi32(pixels, 5), green_mask),
+                _mm_and_si128(_mm_srli_epi32(pixels, 3), blue_mask)));
+
+            // Sign extending the low half makes the saturating pack exact.
+            packed[j] = _mm_srai_epi32(_mm_slli_epi32(value, 16), 16);
+        }
+
+        _mm_storeu_si128((__m128i*) (destination + i),
+            _mm_packs_epi32(packed[0], packed[1]));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        const uint32_t pixel = source[i];
+        destination[i] = (uint16_t) (((pixel >> 8) & 0xF800)
+            | ((pixel >> 5) & 0x07E0) | ((pixel >> 3) & 0x001F));
+    }
+}
+
+/**
+ * Scales an 8-bit channel into a visual's channel mask.
+ * 
+ * \param[in] value Channel value.
+ * \param[in] mask Channel mask.
+ * \return Channel bits in place.
+ */
+static unsigned long pack_channel(unsigned value, unsigned long mask) {
+    if (!mask) {
+        return 0;
+    }
+
+    int shift = 0;
+    while (!(mask & (1UL << shift))) {
+        ++shift;
+    }
+
+    const unsigned long maximum = mask >> shift;
+
+    return (value * maximum + 127) / 255 << shift;
+}
+
+/**
+ * Converts a row of pixels to any other visual one pixel at a time.
+ * 
+ * \param[in] surface Software surface.
+ * \param[in] source Source pixels.
+ * \param[out] image Destination image.
+ * \param[in] x Left edge in the image.
+ * \param[in] y Row in the image.
+ * \param[in] count Number of pixels.
+ */
+static void convert_generic(const software_surface* surface,
+    const uint32_t* source, XImage* image, int x, int y, unsigned count) {
+    for (unsigned i = 0; i < count; ++i) {
+        const uint32_t pixel = source[i];
+        XPutPixel(image, x + (int) i, y,
+            pack_channel((pixel >> 16) & 0xFF, surface->masks[0])
+            | pack_channel((pixel >> 8) & 0xFF, surface->masks[1])
+            | pack_channel(pixel & 0xFF, surface->masks[2]));
+    }
+}
+
+/**
+ * Releases the images of a software surface. Pending presents must have
+ * completed.
+ * 
+ * \param[in] surface Software surface.
+ */
+static void destroy_images(software_surface* surface) {
+    for (int i = 0; i < SOFTWARE_BUFFERS; ++i) {
+        if (!surface->images[i]) {
+            continue;
+        }
+
+        if (surface->shared) {
+            XShmDetach(surface->display, &surface->segments[i]);
+            XDestroyImage(surface->images[i]);
+            shmdt(surface->segments[i].shmaddr);
+        } else {
+            XDestroyImage(surface->images[i]);
+        }
+
+        surface->images[i] = NULL;
+    }
+
+    free(surface->pixels);
+    surface->pixels = NULL;
+}
+
+/**
+ * Creates a shared memory image and attaches it to the server.
+ * 
+ * \param[in] surface Software surface.
+ * \param[in] index Image index.
+ * \param[in] width Image width.
+ * \param[in] height Image height.
+ * \return Whether the image was created.
+ */
+static bool create_shared_image(software_surface* surface, int index,
+    unsigned width, unsigned height) {
+    XShmSegmentInfo* segment = &surface->segments[index];
+
+    XImage* image = XShmCreateImage(surface->display, surface->visual,
+        (unsigned) surface->depth, ZPixmap, NULL, segment, width, height);
+    if (!image) {
+        return false;
+    }
+
+    segment->shmid = shmget(IPC_PRIVATE,
+        (size_t) image->bytes_per_line * height, IPC_CREAT | 0600);
+    if (segment->shmid < 0) {
+        XDestroyImage(image);
+        return false;
+    }
+
+    segment->shmaddr = shmat(segment->shmid, NULL, 0);
+    if (segment->shmaddr == (char*) -1) {
+        shmctl(segment->shmid, IPC_RMID, NULL);
+        XDestroyImage(image);
+        return false;
+    }
+
+    image->data = segment->shmaddr;
+    segment->readOnly = False;
+
+    XShmAttach(surface->display, segment);
+
+    surface->images[index] = image;
+
+    return true;
+}
+
+/**
+ * Allocates the images of a software surface, falling back to unshared ones
+ * if shared memory runs out.
+ * 
+ * \param[in] surface Software surface.
+ * \param[in] width Image width.
+ * \param[in] height Image height.
+ * \return Whether the images were created.
+ */
+static bool create_images(software_surface* surface, unsigned width,
+    unsigned height) {
+    surface->width = width;
+    surface->height = height;
+    surface->back = 0;
+    surface->presents = 0;
+    memset(surface->presented, 0, sizeof(surface->presented));
+
+    if (surface->shared) {
+        int created = 0;
+        while (created < SOFTWARE_BUFFERS
+            && create_shared_image(surface, created, width, height)) {
+            ++created;
+        }
+
+        // Once the server has attached the segments they can be marked for
+        // removal, so they are freed even if the process dies.
+        XSync(surface->display, False);
+
+        for (int i = 0; i < created; ++i) {
+            shmctl(surface->segments[i].shmid, IPC_RMID, NULL);
+        }
+
+        if (created < SOFTWARE_BUFFERS) {
+            printf("[INFO] Falling back to XPutImage; shared memory could not "
+                "be allocated.\n");
+
+            destroy_images(surface);
+            surface->shared = false;
+        }
+    }
+
+    if (!surface->shared) {
+        for (int i = 0; i < SOFTWARE_BUFFERS; ++i) {
+            XImage* image = XCreateImage(surface->display, surface->visual,
+                (unsigned) surface->depth, ZPixmap, 0, NULL, width, height, 32,
+                0);
+            if (!image) {
+                destroy_images(surface);
+                return false;
+            }
+
+            image->data = malloc((size_t) image->bytes_per_line * height);
+            surface->images[i] = image;
+        }
+    }
+
+    surface->format = choose_pixel_format(surface, surface->images[0]);
+
+    // Converted frames are drawn into one buffer of their own and only the
+    // images the conversion writes into alternate.
+    if (surface->format != PIXEL_FORMAT_DIRECT) {
+        surface->pixels = malloc((size_t) width * height * sizeof(uint32_t));
+        memset(surface->pixels, 0, (size_t) width * height * sizeof(uint32_t));
+    }
+
+    return true;
+}
+
+/**
+ * Matches the completion event of a software surface's presents.
+ * 
+ * \param[in] display Connection to the X server.
+ * \param[in] event Event.
+ * \param[in] argument Software surface.
+ * \return Whether the event matches.
+ */
+static Bool is_completion(Display* display, XEvent* event,
+    XPointer argument) {
+    const software_surface* surface = (const software_surface*) argument;
+
+    return event->type == surface->completion_type
+        && ((const XShmCompletionEvent*) event)->drawable == surface->window;
+}
+
+/**
+ * Waits until the server has finished reading an image. An event thread may
+ * take the completion first, so this never blocks inside Xlib: it takes
+ * completions already sent and otherwise sleeps until the event thread
+ * records one, checking the connection again every millisecond in case no
+ * thread is reading events.
+ * 
+ * \param[in] surface Software surface.
+ * \param[in] index Image index.
+ */
+static void wait_for_image(software_surface* surface, unsigned index) {
+    pthread_mutex_lock(&surface->pending_mutex);
+
+    while (surface->pending[index]) {
+        pthread_mutex_unlock(&surface->pending_mutex);
+
+        XEvent event;
+        const bool found = XCheckIfEvent(surface->display, &event,
+            is_completion, (XPointer) surface);
+        if (found) {
+            complete_software_present(surface, &event);
+        }
+
+        pthread_mutex_lock(&surface->pending_mutex);
+
+        if (!found && surface->pending[index]) {
+            struct timespec deadline;
+            clock_gettime(CLOCK_MONOTONIC, &deadline);
+
+            deadline.tv_nsec += COMPLETION_POLL_NS;
+            if (deadline.tv_nsec >= 1000000000) {
+                deadline.tv_nsec -= 1000000000;
+                ++deadline.tv_sec;
+            }
+
+            pthread_cond_timedwait(&surface->completed,
+                &surface->pending_mutex, &deadline);
+        }
+    }
+
+    pthread_mutex_unlock(&surface->pending_mutex);
+}
+
+/**
+ * Creates the images a software window presents from. With shared set and
+ * the X server supporting MIT-SHM, they live in shared memory segments the
+ * server reads directly; otherwise they are sent with XPutImage. The caller
+ * should trap errors around this call, since attaching a segment fails on
+ * servers that cannot see the client's memory.
+ * 
+ * \param[in] display Connection to the X server.
+ * \param[in] window Window to present to.
+ * \param[in] visual_info Visual of the window.
+ * \param[in] width Surface width.
+ * \param[in] height Surface height.
+ * \param[in] shared Whether to use MIT-SHM.
+ * \return New software surface.
+ */
+software_surface* create_software_surface(Display* display, Window window,
+    const XVisualInfo* visual_info, unsigned width, unsigned height,
+    bool shared) {
+    software_surface* surface = malloc(sizeof(struct software_surface));
+    memset(surface, 0, sizeof(struct software_surface));
+
+    surface->display = display;
+    surface->window = window;
+    surface->visual = visual_info->visual;
+    surface->depth = visual_info->depth;
+    surface->masks[0] = visual_info->red_mask;
+    surface->masks[1] = visual_info->green_mask;
+    surface->masks[2] = visual_info->blue_mask;
+    surface->shared = shared && XShmQueryExtension(display);
+
+    if (surface->shared) {
+        surface->completion_type = XShmGetEventBase(display) + ShmCompletion;
+    }
+
+    surface->gc = XCreateGC(display, window, 0, NULL);
+
+    if (!create_images(surface, width ? width : 1, height ? height : 1)) {
+        fprintf(stderr, "[ERROR] Failed to create software images.\n");
+
+        XFreeGC(display, surface->gc);
+
+        free(surface);
+
+        return NULL;
+    }
+
+    pthread_condattr_t attributes;
+    pthread_condattr_init(&attributes);
+    pthread_condattr_setclock(&attributes, CLOCK_MONOTONIC);
+    pthread_cond_init(&surface->completed, &attributes);
+    pthread_condattr_destroy(&attributes);
+
+    pthread_mutex_init(&surface->pending_mutex, NULL);
+
+    return surface;
+}
+
+/**
+ * Waits for pending presents, then destroys a software surface.
+ * 
+ * \param[in] surface Software surface.
+ */
+void destroy_software_surface(software_surface* surface) {
+    for (unsigned i = 0; i < SOFTWARE_BUFFERS; ++i) {
+        wait_for_image(surface, i);
+    }
+
+    destroy_images(surface);
+    XFreeGC(surface->display, surface->gc);
+
+    pthread_cond_destroy(&surface->completed);
+    pthread_mutex_destroy(&surface->pending_mutex);
+
+    free(surface);
+}
+
+/**
+ * Gets the size of a software surface.
+ * 
+ * \param[in] surface Software surface.
+ * \param[out] width Surface width.
+ * \param[out] height Surface height.
+ */
+void get_software_surface_size(const software_surface* surface,
+    unsigned* width, unsigned* height) {
+    *width = surface->width;
+    *height = surface->height;
+}
+
+/**
+ * Gets the pixels to draw the next frame into, waiting until the server has
+ * finished reading them if they were presented before.
+ * 
+ * \param[in] surface Software surface.
+ * \param[out] stride Bytes between rows.
+ * \return Pixels, as 32-bit 0xAARRGGBB values with the top row first.
+ */
+uint32_t* map_software_surface(software_surface* surface, size_t* stride) {
+    if (surface->format != PIXEL_FORMAT_DIRECT) {
+        *stride = surface->width * sizeof(uint32_t);
+        return surface->pixels;
+    }
+
+    wait_for_image(surface, surface->back);
+
+    XImage* image = surface->images[surface->back];
+    *stride = (size_t) image->bytes_per_line;
+
+    return (uint32_t*) image->data;
+}
+
+/**
+ * Presents a rectangle of the pixels last mapped, converting them to the
+ * window's pixel format if it differs.
+ * 
+ * \param[in] surface Software surface.
+ * \param[in] x Left edge.
+ * \param[in] y Top edge.
+ * \param[in] width Rectangle width.
+ * \param[in] height Rectangle height.
+ */
+void present_software_surface(software_surface* surface, int x, int y,
+    unsigned width, unsigned height) {
+    const unsigned index = surface->back;
+    XImage* image = surface->images[index];
+
+    if (surface->format != PIXEL_FORMAT_DIRECT) {
+        wait_for_image(surface, index);
+
+        for (unsigned row = 0; row < height; ++row) {
+            const uint32_t* source =
+                surface->pixels + (size_t) (y + row) * surface->width + x;
+            char* destination = image->data
+                + (size_t) (y + row) * image->bytes_per_line;
+
+            switch (surface->format) {
+            case PIXEL_FORMAT_SWAP_RED_BLUE:
+                convert_swap_red_blue(source, (uint32_t*) destination + x,
+                    width);
+                break;
+            case PIXEL_FORMAT_RGB565:
+                convert_rgb565(source, (uint16_t*) destination + x, width);
+                break;
+            default:
+                convert_generic(surface, source, image, x, y + (int) row,
+                    width);
+                break;
+            }
+        }
+    }
+
+    if (surface->shared) {
+        // Another thread can flush the request and take its completion as
+        // soon as it is queued.
+        pthread_mutex_lock(&surface->pending_mutex);
+        surface->pending[index] = true;
+        pthread_mutex_unlock(&surface->pending_mutex);
+
+        XShmPutImage(surface->display, surface->window, surface->gc, image, x,
+            y, x, y, width, height, True);
+    } else {
+        XPutImage(surface->display, surface->window, surface->gc, image, x, y,
+            x, y, width, height);
+    }
+
+    XFlush(surface->display);
+
+    surface->presented[index] = ++surface->presents;
+    surface->back = (index + 1) % SOFTWARE_BUFFERS;
+}
+
+/**
+ * Gets the age of the pixels the next map returns, as get_buffer_age()
+ * defines it.
+ * 
+ * \param[in] surface Software surface.
+ * \return Buffer age.
+ */
+unsigned get_software_buffer_age(const software_surface* surface) {
+    if (surface->format != PIXEL_FORMAT_DIRECT) {
+        return surface->presents ? 1 : 0;
+    }
+
+    const uint64_t presented = surface->presented[surface->back];
+
+    return presented ? (unsigned) (surface->presents - presented + 1) : 0;
+}
+
+/**
+ * Records a MIT-SHM completion event for one of the surface's images and
+ * wakes a thread waiting for it. Can be called from any thread.
+ * 
+ * \param[in] surface Software surface.
+ * \param[in] event Event.
+ * \return Whether the event was a completion for this surface.
+ */
+bool complete_software_present(software_surface* surface,
+    const XEvent* event) {
+    if (!surface->shared || event->type != surface->completion_type) {
+        return false;
+    }
+
+    const XShmCompletionEvent* completion =
+        (const XShmCompletionEvent*) event;
+
+    for (int i = 0; i < SOFTWARE_BUFFERS; ++i) {
+        if (surface->images[i]
+            && completion->shmseg == surface->segments[i].shmseg) {
+            pthread_mutex_lock(&surface->pending_mutex);
+            surface->pending[i] = false;
+            pthread_cond_broadcast(&surface->completed);
+            pthread_mutex_unlock(&surface->pending_mutex);
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Checks whether a software surface presents through MIT-SHM.
+ * 
+ * \param[in] surface Software surface.
+ * \return Whether the surface uses shared memory.
+ */
+bool is_software_surface_shared(const software_surface* surface) {
+    return surface->shared;
+}
+
+#elif defined(OPENGL_CONTEXT_WINDOWS_PLATFORM)
+static int linux_software_c;
+#endif
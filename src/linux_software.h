@@ -0,0 +1,108 @@
+/**
+ * \file linux_software.h
+ * \author Isaiah Lateer
+ * 
+ * Header file for the software surface struct and functions. Used by
+ * linux_window.c to implement software windows behind window.h.
+ */
+
+#ifndef OPENGL_CONTEXT_LINUX_SOFTWARE_HEADER
+#define OPENGL_CONTEXT_LINUX_SOFTWARE_HEADER
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+
+typedef struct software_surface software_surface;
+
+/**
+ * Creates the images a software window presents from. With shared set and
+ * the X server supporting MIT-SHM, they live in shared memory segments the
+ * server reads directly; otherwise they are sent with XPutImage. The caller
+ * should trap errors around this call, since attaching a segment fails on
+ * servers that cannot see the client's memory.
+ * 
+ * \param[in] display Connection to the X server.
+ * \param[in] window Window to present to.
+ * \param[in] visual_info Visual of the window.
+ * \param[in] width Surface width.
+ * \param[in] height Surface height.
+ * \param[in] shared Whether to use MIT-SHM.
+ * \return New software surface.
+ */
+software_surface* create_software_surface(Display* display, Window window,
+    const XVisualInfo* visual_info, unsigned width, unsigned height,
+    bool shared);
+
+/**
+ * Waits for pending presents, then destroys a software surface.
+ * 
+ * \param[in] surface Software surface.
+ */
+void destroy_software_surface(software_surface* surface);
+
+/**
+ * Gets the size of a software surface.
+ * 
+ * \param[in] surface Software surface.
+ * \param[out] width Surface width.
+ * \param[out] height Surface height.
+ */
+void get_software_surface_size(const software_surface* surface,
+    unsigned* width, unsigned* height);
+
+/**
+ * Gets the pixels to draw the next frame into, waiting until the server has
+ * finished reading them if they were presented before.
+ * 
+ * \param[in] surface Software surface.
+ * \param[out] stride Bytes between rows.
+ * \return Pixels, as 32-bit 0xAARRGGBB values with the top row first.
+ */
+uint32_t* map_software_surface(software_surface* surface, size_t* stride);
+
+/**
+ * Presents a rectangle of the pixels last mapped, converting them to the
+ * window's pixel format if it differs.
+ * 
+ * \param[in] surface Software surface.
+ * \param[in] x Left edge.
+ * \param[in] y Top edge.
+ * \param[in] width Rectangle width.
+ * \param[in] height Rectangle height.
+ */
+void present_software_surface(software_surface* surface, int x, int y,
+    unsigned width, unsigned height);
+
+/**
+ * Gets the age of the pixels the next map returns, as get_buffer_age()
+ * defines it.
+ * 
+ * \param[in] surface Software surface.
+ * \return Buffer age.
+ */
+unsigned get_software_buffer_age(const software_surface* surface);
+
+/**
+ * Records a MIT-SHM completion event for one of the surface's images and
+ * wakes a thread waiting for it. Can be called from any thread.
+ * 
+ * \param[in] surface Software surface.
+ * \param[in] event Event.
+ * \return Whether the event was a completion for this surface.
+ */
+bool complete_software_present(software_surface* surface,
+    const XEvent* event);
+
+/**
+ * Checks whether a software surface presents through MIT-SHM.
+ * 
+ * \param[in] surface Software surface.
+ * \return Whether the surface uses shared memory.
+ */
+bool is_software_surface_shared(const software_surface* surface);
+
+#endif
@@ -0,0 +1,167 @@
+/**
+ * \file linux_thread.c
+ * \author Isaiah Lateer
+ * 
+ * Source file for the thread functions.
+ */
+
+#include "platform.h"
+
+#ifdef OPENGL_CONTEXT_LINUX_PLATFORM
+
+#include "thread.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <pthread.h>
+
+typedef struct thread {
+    pthread_t handle;
+    thread_function function;
+    void* data;
+} thread;
+
+typedef struct mutex {
+    pthread_mutex_t handle;
+} mutex;
+
+typedef struct condition {
+    pthread_cond_t handle;
+} condition;
+
+/**
+ * Runs a thread's function.
+ * 
+ * \param[in] data Thread.
+ * \return Null.
+ */
+static void* run_thread(void* data) {
+    thread* thread = data;
+    thread->function(thread->data);
+
+    return NULL;
+}
+
+/**
+ * Starts a thread.
+ * 
+ * \param[in] function Function the thread runs.
+ * \param[in] data Data passed to the function.
+ * \return New thread.
+ */
+thread* create_thread(thread_function function, void* data) {
+    thread* thread = malloc(sizeof(struct thread));
+    thread->function = function;
+    thread->data = data;
+
+    if (pthread_create(&thread->handle, NULL, run_thread, thread)) {
+        fprintf(stderr, "[ERROR] Failed to create thread.\n");
+
+        free(thread);
+
+        return NULL;
+    }
+
+    return thread;
+}
+
+/**
+ * Waits for a thread to finish, then destroys it.
+ * 
+ * \param[in] thread Thread.
+ */
+void join_thread(thread* thread) {
+    pthread_join(thread->handle, NULL);
+
+    free(thread);
+}
+
+/**
+ * Creates a mutex.
+ * 
+ * \return New mutex.
+ */
+mutex* create_mutex(void) {
+    mutex* mutex = malloc(sizeof(struct mutex));
+    pthread_mutex_init(&mutex->handle, NULL);
+
+    return mutex;
+}
+
+/**
+ * Destroys a mutex. It must not be locked.
+ * 
+ * \param[in] mutex Mutex.
+ */
+void destroy_mutex(mutex* mutex) {
+    pthread_mutex_destroy(&mutex->handle);
+
+    free(mutex);
+}
+
+/**
+ * Locks a mutex, waiting for another thread to unlock it if needed.
+ * 
+ * \param[in] mutex Mutex.
+ */
+void lock_mutex(mutex* mutex) {
+    pthread_mutex_lock(&mutex->handle);
+}
+
+/**
+ * Unlocks a mutex locked by the calling thread.
+ * 
+ * \param[in] mutex Mutex.
+ */
+void unlock_mutex(mutex* mutex) {
+    pthread_mutex_unlock(&mutex->handle);
+}
+
+/**
+ * Creates a condition variable.
+ * 
+ * \return New condition variable.
+ */
+condition* create_condition(void) {
+    condition* condition = malloc(sizeof(struct condition));
+    pthread_cond_init(&condition->handle, NULL);
+
+    return condition;
+}
+
+/**
+ * Destroys a condition variable. No thread may be waiting on it.
+ * 
+ * \param[in] condition Condition variable.
+ */
+void destroy_condition(condition* condition) {
+    pthread_cond_destroy(&condition->handle);
+
+    free(condition);
+}
+
+/**
+ * Unlocks a mutex and waits for the condition variable to be signalled, then
+ * locks the mutex again. Can wake without a signal, so callers recheck their
+ * condition in a loop.
+ * 
+ * \param[in] condition Condition variable.
+ * \param[in] mutex Mutex locked by the calling thread.
+ */
+void wait_condition(condition* condition, mutex* mutex) {
+    pthread_cond_wait(&condition->handle, &mutex->handle);
+}
+
+/**
+ * Wakes one thread waiting on a condition variable.
+ * 
+ * \param[in] condition Condition variable.
+ */
+void signal_condition(condition* condition) {
+    pthread_cond_signal(&condition->handle);
+}
+
+#elif defined(OPENGL_CONTEXT_WINDOWS_PLATFORM)
+static int linux_thread_c;
+#endif
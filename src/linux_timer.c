@@ -0,0 +1,50 @@
+/**
+ * \file linux_timer.c
+ * \author Isaiah Lateer
+ * 
+ * Source file for the timer functions.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "platform.h"
+
+#ifdef OPENGL_CONTEXT_LINUX_PLATFORM
+
+#include "timer.h"
+
+#include <errno.h>
+#include <time.h>
+
+/**
+ * Gets the current time from a monotonic clock.
+ * 
+ * \return Time in nanoseconds.
+ */
+uint64_t get_time(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint64_t) now.tv_sec * 1000000000 + (uint64_t) now.tv_nsec;
+}
+
+/**
+ * Sleeps until the monotonic clock reaches the given time. Returns immediately
+ * if the time has already passed.
+ * 
+ * \param[in] time Time in nanoseconds.
+ */
+void sleep_until(uint64_t time) {
+    const struct timespec deadline = {
+        (time_t) (time / 1000000000),
+        (long) (time % 1000000000)
+    };
+
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL)
+        == EINTR) {
+    }
+}
+
+#elif defined(OPENGL_CONTEXT_WINDOWS_PLATFORM)
+static int linux_timer_c;
+#endif
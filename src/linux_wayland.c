@@ -0,0 +1,1364 @@
+/**
+ * \file linux_wayland.c
+ * \author Isaiah Lateer
+ * 
+ * Source file for the Wayland window functions.
+ */
+
+#include "platform.h"
+
+#if defined(OPENGL_CONTEXT_LINUX_PLATFORM) && defined(OPENGL_CONTEXT_WAYLAND)
+
+#include "linux_wayland.h"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <poll.h>
+#include <pthread.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <linux/input-event-codes.h>
+
+#include <wayland-client.h>
+#include <wayland-egl.h>
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <X11/X.h>
+#include <X11/keysym.h>
+
+#include "trace.h"
+#include "xdg-shell-client-protocol.h"
+
+#define MAX_CONFIGS 64
+#define MAX_DAMAGE_RECTS 32
+
+typedef struct wayland_display {
+    struct wl_display* display;
+    struct wl_registry* registry;
+    struct wl_compositor* compositor;
+    struct xdg_wm_base* wm_base;
+    struct wl_seat* seat;
+    struct wl_pointer* pointer;
+    struct wl_keyboard* keyboard;
+    EGLDisplay egl_display;
+    unsigned references;
+    wayland_window* pointer_focus;
+    wayland_window* keyboard_focus;
+    int pointer_x, pointer_y;
+    unsigned modifiers;
+    unsigned buttons;
+    uint32_t last_time;
+    bool surfaceless;
+    bool no_error;
+    bool buffer_age;
+    bool colorspace;
+    PFNEGLCREATEPLATFORMWINDOWSURFACEEXTPROC eglCreatePlatformWindowSurfaceEXT;
+    PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC eglSwapBuffersWithDamage;
+} wayland_display;
+
+typedef struct wayland_window {
+    struct wl_surface* surface;
+    struct xdg_surface* xdg_surface;
+    struct xdg_toplevel* toplevel;
+    struct wl_egl_window* native;
+    struct wl_surface* frame_surface;
+    struct wl_event_queue* frame_queue;
+    struct wl_callback* frame;
+    EGLConfig config;
+    EGLContext context;
+    EGLSurface egl_surface;
+    gl_errors errors;
+    event_queue* events;
+    pthread_mutex_t* state_mutex;
+    unsigned width, height;
+    unsigned pending_width, pending_height;
+    bool configured;
+    bool closed;
+    int interval;
+} wayland_window;
+
+typedef struct wayland_context {
+    EGLContext context;
+} wayland_context;
+
+static wayland_display shared_display = { NULL };
+static pthread_mutex_t display_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// Evdev key codes of the keys most applications bind, mapped to the keysyms
+// XLookupKeysym() gives for them on a US layout. Without a keymap library,
+// other keys report no symbol.
+static const unsigned key_symbols[KEY_DELETE + 1] = {
+    [KEY_ESC] = XK_Escape, [KEY_1] = XK_1, [KEY_2] = XK_2, [KEY_3] = XK_3,
+    [KEY_4] = XK_4, [KEY_5] = XK_5, [KEY_6] = XK_6, [KEY_7] = XK_7,
+    [KEY_8] = XK_8, [KEY_9] = XK_9, [KEY_0] = XK_0, [KEY_MINUS] = XK_minus,
+    [KEY_EQUAL] = XK_equal, [KEY_BACKSPACE] = XK_BackSpace,
+    [KEY_TAB] = XK_Tab, [KEY_Q] = XK_q, [KEY_W] = XK_w, [KEY_E] = XK_e,
+    [KEY_R] = XK_r, [KEY_T] = XK_t, [KEY_Y] = XK_y, [KEY_U] = XK_u,
+    [KEY_I] = XK_i, [KEY_O] = XK_o, [KEY_P] = XK_p,
+    [KEY_LEFTBRACE] = XK_bracketleft, [KEY_RIGHTBRACE] = XK_bracketright,
+    [KEY_ENTER] = XK_Return, [KEY_LEFTCTRL] = XK_Control_L, [KEY_A] = XK_a,
+    [KEY_S] = XK_s, [KEY_D] = XK_d, [KEY_F] = XK_f, [KEY_G] = XK_g,
+    [KEY_H] = XK_h, [KEY_J] = XK_j, [KEY_K] = XK_k, [KEY_L] = XK_l,
+    [KEY_SEMICOLON] = XK_semicolon, [KEY_APOSTROPHE] = XK_apostrophe,
+    [KEY_GRAVE] = XK_grave, [KEY_LEFTSHIFT] = XK_Shift_L,
+    [KEY_BACKSLASH] = XK_backslash, [KEY_Z] = XK_z, [KEY_X] = XK_x,
+    [KEY_C] = XK_c, [KEY_V] = XK_v, [KEY_B] = XK_b, [KEY_N] = XK_n,
+    [KEY_M] = XK_m, [KEY_COMMA] = XK_comma, [KEY_DOT] = XK_period,
+    [KEY_SLASH] = XK_slash, [KEY_RIGHTSHIFT] = XK_Shift_R,
+    [KEY_LEFTALT] = XK_Alt_L, [KEY_SPACE] = XK_space,
+    [KEY_CAPSLOCK] = XK_Caps_Lock, [KEY_F1] = XK_F1, [KEY_F2] = XK_F2,
+    [KEY_F3] = XK_F3, [KEY_F4] = XK_F4, [KEY_F5] = XK_F5, [KEY_F6] = XK_F6,
+    [KEY_F7] = XK_F7, [KEY_F8] = XK_F8, [KEY_F9] = XK_F9,
+    [KEY_F10] = XK_F10, [KEY_F11] = XK_F11, [KEY_F12] = XK_F12,
+    [KEY_RIGHTCTRL] = XK_Control_R, [KEY_RIGHTALT] = XK_Alt_R,
+    [KEY_HOME] = XK_Home, [KEY_UP] = XK_Up, [KEY_PAGEUP] = XK_Prior,
+    [KEY_LEFT] = XK_Left, [KEY_RIGHT] = XK_Right, [KEY_END] = XK_End,
+    [KEY_DOWN] = XK_Down, [KEY_PAGEDOWN] = XK_Next,
+    [KEY_INSERT] = XK_Insert, [KEY_DELETE] = XK_Delete
+};
+
+/**
+ * Checks if an extension is in a space separated extension list.
+ * 
+ * \param[in] extensions Extension list.
+ * \param[in] name Extension name.
+ * \return Whether the extension is in the list.
+ */
+static bool has_extension(const char* extensions, const char* name) {
+    if (!extensions) {
+        return false;
+    }
+
+    const size_t length = strlen(name);
+
+    const char* start = extensions;
+    while ((start = strstr(start, name))) {
+        const bool at_start = start == extensions || start[-1] == ' ';
+        const bool at_end = start[length] == ' ' || start[length] == '\0';
+        if (at_start && at_end) {
+            return true;
+        }
+
+        start += length;
+    }
+
+    return false;
+}
+
+/**
+ * Gets the window a surface belongs to.
+ * 
+ * \param[in] surface Surface, or null if it was destroyed.
+ * \return Wayland window, or null.
+ */
+static wayland_window* get_surface_window(struct wl_surface* surface) {
+    return surface ? wl_surface_get_user_data(surface) : NULL;
+}
+
+/**
+ * Appends an event to a window's queue, which the thread polling it may be
+ * taking events from.
+ * 
+ * \param[in] window Wayland window.
+ * \param[in] event Event.
+ */
+static void queue_event(wayland_window* window, const window_event* event) {
+    pthread_mutex_lock(window->state_mutex);
+    push_event(window->events, event);
+    pthread_mutex_unlock(window->state_mutex);
+}
+
+/**
+ * Converts an evdev button to the X button number for it.
+ * 
+ * \param[in] button Evdev button code.
+ * \return X button number.
+ */
+static unsigned get_x_button(uint32_t button) {
+    switch (button) {
+    case BTN_LEFT:
+        return Button1;
+    case BTN_MIDDLE:
+        return Button2;
+    case BTN_RIGHT:
+        return Button3;
+    default:
+        // X numbers the side buttons after the four scroll buttons.
+        return button >= BTN_SIDE ? button - BTN_SIDE + 8 : 0;
+    }
+}
+
+/**
+ * Pushes a button press or release to the window under the pointer.
+ * 
+ * \param[in] time Event time.
+ * \param[in] button X button number.
+ * \param[in] pressed Whether the button was pressed.
+ */
+static void push_button(uint32_t time, unsigned button, bool pressed) {
+    wayland_window* window = shared_display.pointer_focus;
+    if (!window) {
+        return;
+    }
+
+    window_event event;
+    event.type = pressed
+        ? WINDOW_EVENT_BUTTON_PRESS : WINDOW_EVENT_BUTTON_RELEASE;
+    event.time = time;
+    event.button.button = button;
+    event.button.x = shared_display.pointer_x;
+    event.button.y = shared_display.pointer_y;
+    event.button.modifiers =
+        shared_display.modifiers | shared_display.buttons;
+
+    queue_event(window, &event);
+}
+
+/**
+ * Tracks the window the pointer entered.
+ */
+static void handle_pointer_enter(void* data, struct wl_pointer* pointer,
+    uint32_t serial, struct wl_surface* surface, wl_fixed_t x, wl_fixed_t y) {
+    shared_display.pointer_focus = get_surface_window(surface);
+    shared_display.pointer_x = wl_fixed_to_int(x);
+    shared_display.pointer_y = wl_fixed_to_int(y);
+}
+
+/**
+ * Forgets the window the pointer left.
+ */
+static void handle_pointer_leave(void* data, struct wl_pointer* pointer,
+    uint32_t serial, struct wl_surface* surface) {
+    shared_display.pointer_focus = NULL;
+}
+
+/**
+ * Decodes pointer motion.
+ */
+static void handle_pointer_motion(void* data, struct wl_pointer* pointer,
+    uint32_t time, wl_fixed_t x, wl_fixed_t y) {
+    shared_display.pointer_x = wl_fixed_to_int(x);
+    shared_display.pointer_y = wl_fixed_to_int(y);
+    shared_display.last_time = time;
+
+    wayland_window* window = shared_display.pointer_focus;
+    if (!window) {
+        return;
+    }
+
+    window_event event;
+    event.type = WINDOW_EVENT_MOTION;
+    event.time = time;
+    event.motion.x = shared_display.pointer_x;
+    event.motion.y = shared_display.pointer_y;
+    event.motion.modifiers =
+        shared_display.modifiers | shared_display.buttons;
+
+    queue_event(window, &event);
+}
+
+/**
+ * Decodes a button press or release, numbering buttons as X does.
+ */
+static void handle_pointer_button(void* data, struct wl_pointer* pointer,
+    uint32_t serial, uint32_t time, uint32_t button, uint32_t state) {
+    const unsigned x_button = get_x_button(button);
+    const bool pressed = state == WL_POINTER_BUTTON_STATE_PRESSED;
+
+    shared_display.last_time = time;
+
+    // Like X, the state is the one from before the event.
+    push_button(time, x_button, pressed);
+
+    if (x_button >= Button1 && x_button <= Button5) {
+        const unsigned mask = Button1Mask << (x_button - Button1);
+        if (pressed) {
+            shared_display.buttons |= mask;
+        } else {
+            shared_display.buttons &= ~mask;
+        }
+    }
+}
+
+/**
+ * Decodes scrolling as clicks of the X scroll buttons.
+ */
+static void handle_pointer_axis(void* data, struct wl_pointer* pointer,
+    uint32_t time, uint32_t axis, wl_fixed_t value) {
+    if (!value) {
+        return;
+    }
+
+    unsigned button;
+    if (axis == WL_POINTER_AXIS_VERTICAL_SCROLL) {
+        button = value < 0 ? Button4 : Button5;
+    } else {
+        button = value < 0 ? 6 : 7;
+    }
+
+    shared_display.last_time = time;
+
+    push_button(time, button, true);
+    push_button(time, button, false);
+}
+
+/**
+ * Ignores the end of a group of pointer events.
+ */
+static void handle_pointer_frame(void* data, struct wl_pointer* pointer) {
+}
+
+/**
+ * Ignores the source of scrolling.
+ */
+static void handle_pointer_axis_source(void* data,
+    struct wl_pointer* pointer, uint32_t source) {
+}
+
+/**
+ * Ignores the end of scrolling.
+ */
+static void handle_pointer_axis_stop(void* data, struct wl_pointer* pointer,
+    uint32_t time, uint32_t axis) {
+}
+
+/**
+ * Ignores scroll wheel steps, which also arrive as axis events.
+ */
+static void handle_pointer_axis_discrete(void* data,
+    struct wl_pointer* pointer, uint32_t axis, int32_t discrete) {
+}
+
+static const struct wl_pointer_listener pointer_listener = {
+    .enter = handle_pointer_enter,
+    .leave = handle_pointer_leave,
+    .motion = handle_pointer_motion,
+    .button = handle_pointer_button,
+    .axis = handle_pointer_axis,
+    .frame = handle_pointer_frame,
+    .axis_source = handle_pointer_axis_source,
+    .axis_stop = handle_pointer_axis_stop,
+    .axis_discrete = handle_pointer_axis_discrete
+};
+
+/**
+ * Closes the keymap, since keys are mapped with a fixed table.
+ */
+static void handle_keyboard_keymap(void* data, struct wl_keyboard* keyboard,
+    uint32_t format, int32_t fd, uint32_t size) {
+    close(fd);
+}
+
+/**
+ * Decodes keyboard focus entering a window.
+ */
+static void handle_keyboard_enter(void* data, struct wl_keyboard* keyboard,
+    uint32_t serial, struct wl_surface* surface, struct wl_array* keys) {
+    wayland_window* window = get_surface_window(surface);
+    shared_display.keyboard_focus = window;
+    if (!window) {
+        return;
+    }
+
+    window_event event;
+    event.type = WINDOW_EVENT_FOCUS_IN;
+    event.time = shared_display.last_time;
+
+    queue_event(window, &event);
+}
+
+/**
+ * Decodes keyboard focus leaving a window.
+ */
+static void handle_keyboard_leave(void* data, struct wl_keyboard* keyboard,
+    uint32_t serial, struct wl_surface* surface) {
+    wayland_window* window = shared_display.keyboard_focus;
+    shared_display.keyboard_focus = NULL;
+    if (!window) {
+        return;
+    }
+
+    window_event event;
+    event.type = WINDOW_EVENT_FOCUS_OUT;
+    event.time = shared_display.last_time;
+
+    queue_event(window, &event);
+}
+
+/**
+ * Decodes a key press or release. Codes are offset by eight, as X key codes
+ * are, so the same key has the same code on both.
+ */
+static void handle_keyboard_key(void* data, struct wl_keyboard* keyboard,
+    uint32_t serial, uint32_t time, uint32_t key, uint32_t state) {
+    shared_display.last_time = time;
+
+    wayland_window* window = shared_display.keyboard_focus;
+    if (!window) {
+        return;
+    }
+
+    window_event event;
+    event.type = state == WL_KEYBOARD_KEY_STATE_PRESSED
+        ? WINDOW_EVENT_KEY_PRESS : WINDOW_EVENT_KEY_RELEASE;
+    event.time = time;
+    event.key.code = key + 8;
+    event.key.symbol = key <= KEY_DELETE ? key_symbols[key] : 0;
+    event.key.modifiers = shared_display.modifiers | shared_display.buttons;
+
+    queue_event(window, &event);
+}
+
+/**
+ * Records the modifier state. The default keymap numbers its modifiers as X
+ * does, so the masks are used as they are.
+ */
+static void handle_keyboard_modifiers(void* data,
+    struct wl_keyboard* keyboard, uint32_t serial, uint32_t depressed,
+    uint32_t latched, uint32_t locked, uint32_t group) {
+    shared_display.modifiers = (depressed | latched | locked) & 0xFF;
+}
+
+/**
+ * Ignores key repeat settings.
+ */
+static void handle_keyboard_repeat_info(void* data,
+    struct wl_keyboard* keyboard, int32_t rate, int32_t delay) {
+}
+
+static const struct wl_keyboard_listener keyboard_listener = {
+    .keymap = handle_keyboard_keymap,
+    .enter = handle_keyboard_enter,
+    .leave = handle_keyboard_leave,
+    .key = handle_keyboard_key,
+    .modifiers = handle_keyboard_modifiers,
+    .repeat_info = handle_keyboard_repeat_info
+};
+
+/**
+ * Gets or drops the pointer and keyboard as the seat gains or loses them.
+ */
+static void handle_seat_capabilities(void* data, struct wl_seat* seat,
+    uint32_t capabilities) {
+    const bool has_pointer = capabilities & WL_SEAT_CAPABILITY_POINTER;
+    const bool has_keyboard = capabilities & WL_SEAT_CAPABILITY_KEYBOARD;
+
+    if (has_pointer && !shared_display.pointer) {
+        shared_display.pointer = wl_seat_get_pointer(seat);
+        wl_pointer_add_listener(shared_display.pointer, &pointer_listener,
+            NULL);
+    } else if (!has_pointer && shared_display.pointer) {
+        wl_pointer_destroy(shared_display.pointer);
+        shared_display.pointer = NULL;
+        shared_display.pointer_focus = NULL;
+    }
+
+    if (has_keyboard && !shared_display.keyboard) {
+        shared_display.keyboard = wl_seat_get_keyboard(seat);
+        wl_keyboard_add_listener(shared_display.keyboard, &keyboard_listener,
+            NULL);
+    } else if (!has_keyboard && shared_display.keyboard) {
+        wl_keyboard_destroy(shared_display.keyboard);
+        shared_display.keyboard = NULL;
+        shared_display.keyboard_focus = NULL;
+    }
+}
+
+/**
+ * Ignores the seat's name.
+ */
+static void handle_seat_name(void* data, struct wl_seat* seat,
+    const char* name) {
+}
+
+static const struct wl_seat_listener seat_listener = {
+    .capabilities = handle_seat_capabilities,
+    .name = handle_seat_name
+};
+
+/**
+ * Answers the compositor's check that the client is responsive.
+ */
+static void handle_wm_base_ping(void* data, struct xdg_wm_base* wm_base,
+    uint32_t serial) {
+    xdg_wm_base_pong(wm_base, serial);
+}
+
+static const struct xdg_wm_base_listener wm_base_listener = {
+    .ping = handle_wm_base_ping
+};
+
+/**
+ * Binds the globals the windows need as the compositor announces them.
+ */
+static void handle_registry_global(void* data, struct wl_registry* registry,
+    uint32_t name, const char* interface, uint32_t version) {
+    if (!strcmp(interface, wl_compositor_interface.name)) {
+        shared_display.compositor = wl_registry_bind(registry, name,
+            &wl_compositor_interface, version < 4 ? version : 4);
+    } else if (!strcmp(interface, xdg_wm_base_interface.name)) {
+        shared_display.wm_base =
+            wl_registry_bind(registry, name, &xdg_wm_base_interface, 1);
+        xdg_wm_base_add_listener(shared_display.wm_base, &wm_base_listener,
+            NULL);
+    } else if (!strcmp(interface, wl_seat_interface.name)
+        && !shared_display.seat) {
+        shared_display.seat = wl_registry_bind(registry, name,
+            &wl_seat_interface, version < 5 ? version : 5);
+        wl_seat_add_listener(shared_display.seat, &seat_listener, NULL);
+    }
+}
+
+/**
+ * Ignores globals going away; the ones bound here last for the session.
+ */
+static void handle_registry_global_remove(void* data,
+    struct wl_registry* registry, uint32_t name) {
+}
+
+static const struct wl_registry_listener registry_listener = {
+    .global = handle_registry_global,
+    .global_remove = handle_registry_global_remove
+};
+
+/**
+ * Records the size the compositor wants. It is applied when the configure
+ * is acknowledged.
+ */
+static void handle_toplevel_configure(void* data,
+    struct xdg_toplevel* toplevel, int32_t width, int32_t height,
+    struct wl_array* states) {
+    wayland_window* window = data;
+
+    // Zero leaves the size to the client.
+    window->pending_width = width > 0 ? (unsigned) width : 0;
+    window->pending_height = height > 0 ? (unsigned) height : 0;
+}
+
+/**
+ * Records that the compositor asked the window to close.
+ */
+static void handle_toplevel_close(void* data, struct xdg_toplevel* toplevel) {
+    wayland_window* window = data;
+
+    pthread_mutex_lock(window->state_mutex);
+    window->closed = true;
+    pthread_mutex_unlock(window->state_mutex);
+}
+
+static const struct xdg_toplevel_listener toplevel_listener = {
+    .configure = handle_toplevel_configure,
+    .close = handle_toplevel_close
+};
+
+/**
+ * Acknowledges a configure and resizes the window to the size it carried.
+ * The EGL window takes the new size at the next swap.
+ */
+static void handle_xdg_surface_configure(void* data,
+    struct xdg_surface* xdg_surface, uint32_t serial) {
+    wayland_window* window = data;
+
+    xdg_surface_ack_configure(xdg_surface, serial);
+    window->configured = true;
+
+    if (!window->pending_width || !window->pending_height
+        || (window->pending_width == window->width
+        && window->pending_height == window->height)) {
+        return;
+    }
+
+    pthread_mutex_lock(window->state_mutex);
+    window->width = window->pending_width;
+    window->height = window->pending_height;
+    pthread_mutex_unlock(window->state_mutex);
+
+    if (window->native) {
+        wl_egl_window_resize(window->native, (int) window->width,
+            (int) window->height, 0, 0);
+    }
+
+    window_event event;
+    event.type = WINDOW_EVENT_RESIZE;
+    event.time = shared_display.last_time;
+    event.resize.width = window->width;
+    event.resize.height = window->height;
+
+    queue_event(window, &event);
+}
+
+static const struct xdg_surface_listener xdg_surface_listener = {
+    .configure = handle_xdg_surface_configure
+};
+
+/**
+ * Lets the next present go ahead once the compositor has shown a frame.
+ */
+static void handle_frame_done(void* data, struct wl_callback* callback,
+    uint32_t time) {
+    wayland_window* window = data;
+
+    wl_callback_destroy(callback);
+    window->frame = NULL;
+}
+
+static const struct wl_callback_listener frame_listener = {
+    .done = handle_frame_done
+};
+
+/**
+ * Destroys the globals of the shared display and disconnects from the
+ * compositor.
+ */
+static void disconnect_wayland_display(void) {
+    if (shared_display.keyboard) {
+        wl_keyboard_destroy(shared_display.keyboard);
+    }
+
+    if (shared_display.pointer) {
+        wl_pointer_destroy(shared_display.pointer);
+    }
+
+    if (shared_display.seat) {
+        wl_seat_destroy(shared_display.seat);
+    }
+
+    if (shared_display.wm_base) {
+        xdg_wm_base_destroy(shared_display.wm_base);
+    }
+
+    if (shared_display.compositor) {
+        wl_compositor_destroy(shared_display.compositor);
+    }
+
+    wl_registry_destroy(shared_display.registry);
+    wl_display_disconnect(shared_display.display);
+
+    memset(&shared_display, 0, sizeof(shared_display));
+}
+
+/**
+ * Connects the shared display to the compositor and initializes its EGL
+ * display. The display mutex must be held.
+ * 
+ * \return Whether the display was connected.
+ */
+static bool connect_wayland_display(void) {
+    const char* client_extensions =
+        eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if (!has_extension(client_extensions, "EGL_EXT_platform_wayland")
+        && !has_extension(client_extensions, "EGL_KHR_platform_wayland")) {
+        fprintf(stderr, "[ERROR] EGL does not support Wayland.\n");
+        return false;
+    }
+
+    PFNEGLGETPLATFORMDISPLAYEXTPROC eglGetPlatformDisplayEXT =
+        (PFNEGLGETPLATFORMDISPLAYEXTPROC)
+        eglGetProcAddress("eglGetPlatformDisplayEXT");
+    PFNEGLCREATEPLATFORMWINDOWSURFACEEXTPROC
+        eglCreatePlatformWindowSurfaceEXT =
+        (PFNEGLCREATEPLATFORMWINDOWSURFACEEXTPROC)
+        eglGetProcAddress("eglCreatePlatformWindowSurfaceEXT");
+    if (!eglGetPlatformDisplayEXT || !eglCreatePlatformWindowSurfaceEXT) {
+        fprintf(stderr, "[ERROR] EGL does not support Wayland.\n");
+        return false;
+    }
+
+    struct wl_display* display = wl_display_connect(NULL);
+    if (!display) {
+        fprintf(stderr, "[ERROR] Failed to connect to the Wayland "
+            "compositor.\n");
+        return false;
+    }
+
+    shared_display.display = display;
+    shared_display.registry = wl_display_get_registry(display);
+    wl_registry_add_listener(shared_display.registry, &registry_listener,
+        NULL);
+
+    // The first round trip announces the globals and the second delivers
+    // the seat's capabilities.
+    wl_display_roundtrip(display);
+    wl_display_roundtrip(display);
+
+    if (!shared_display.compositor || !shared_display.wm_base) {
+        fprintf(stderr, "[ERROR] The compositor does not support "
+            "xdg-shell.\n");
+
+        disconnect_wayland_display();
+
+        return false;
+    }
+
+    EGLDisplay egl_display =
+        eglGetPlatformDisplayEXT(EGL_PLATFORM_WAYLAND_EXT, display, NULL);
+
+    EGLint major_version, minor_version;
+    if (egl_display == EGL_NO_DISPLAY
+        || !eglInitialize(egl_display, &major_version, &minor_version)) {
+        fprintf(stderr, "[ERROR] Failed to initialize EGL display.\n");
+
+        disconnect_wayland_display();
+
+        return false;
+    }
+
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        fprintf(stderr, "[ERROR] Failed to bind OpenGL API.\n");
+
+        eglTerminate(egl_display);
+        disconnect_wayland_display();
+
+        return false;
+    }
+
+    const char* extensions = eglQueryString(egl_display, EGL_EXTENSIONS);
+
+    shared_display.egl_display = egl_display;
+    shared_display.references = 1;
+    shared_display.surfaceless =
+        has_extension(extensions, "EGL_KHR_surfaceless_context");
+    shared_display.no_error =
+        has_extension(extensions, "EGL_KHR_create_context_no_error");
+    shared_display.buffer_age =
+        has_extension(extensions, "EGL_EXT_buffer_age");
+    shared_display.colorspace =
+        has_extension(extensions, "EGL_KHR_gl_colorspace");
+    shared_display.eglCreatePlatformWindowSurfaceEXT =
+        eglCreatePlatformWindowSurfaceEXT;
+
+    if (has_extension(extensions, "EGL_KHR_swap_buffers_with_damage")) {
+        shared_display.eglSwapBuffersWithDamage =
+            (PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC)
+            eglGetProcAddress("eglSwapBuffersWithDamageKHR");
+    } else if (has_extension(extensions,
+        "EGL_EXT_swap_buffers_with_damage")) {
+        shared_display.eglSwapBuffersWithDamage =
+            (PFNEGLSWAPBUFFERSWITHDAMAGEKHRPROC)
+            eglGetProcAddress("eglSwapBuffersWithDamageEXT");
+    }
+
+    return true;
+}
+
+/**
+ * Gets the shared Wayland connection and EGL display, connecting on first
+ * use. Can be called from any thread.
+ * 
+ * \return Shared display, or null on failure.
+ */
+static wayland_display* acquire_wayland_display(void) {
+    pthread_mutex_lock(&display_mutex);
+
+    wayland_display* display = &shared_display;
+    if (shared_display.references) {
+        ++shared_display.references;
+    } else if (!connect_wayland_display()) {
+        display = NULL;
+    }
+
+    pthread_mutex_unlock(&display_mutex);
+
+    return display;
+}
+
+/**
+ * Releases a reference to the shared display, disconnecting once the last
+ * Wayland window or context is gone. Can be called from any thread.
+ */
+static void release_wayland_display(void) {
+    pthread_mutex_lock(&display_mutex);
+
+    if (!--shared_display.references) {
+        eglTerminate(shared_display.egl_display);
+        disconnect_wayland_display();
+    }
+
+    pthread_mutex_unlock(&display_mutex);
+}
+
+/**
+ * Chooses the EGL configuration for a window. Configurations with alpha make
+ * the compositor blend the window with what is behind it, so an opaque
+ * window takes the first one without.
+ * 
+ * \param[in] display Shared display.
+ * \param[in] settings Framebuffer settings.
+ * \param[out] config Configuration.
+ * \return Whether a configuration meets the settings.
+ */
+static bool choose_config(const wayland_display* display,
+    const framebuffer_settings* settings, EGLConfig* config) {
+    const EGLint config_attributes[] = {
+        EGL_SURFACE_TYPE, EGL_WINDOW_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE, 8,
+        EGL_GREEN_SIZE, 8,
+        EGL_BLUE_SIZE, 8,
+        EGL_ALPHA_SIZE, settings->alpha ? 8 : 0,
+        EGL_DEPTH_SIZE, settings->depth_bits,
+        EGL_STENCIL_SIZE, settings->stencil_bits,
+        EGL_SAMPLE_BUFFERS, settings->samples > 0 ? 1 : 0,
+        EGL_SAMPLES, settings->samples,
+        EGL_NONE
+    };
+
+    EGLConfig configs[MAX_CONFIGS];
+    EGLint config_count = 0;
+    if (!eglChooseConfig(display->egl_display, config_attributes, configs,
+        MAX_CONFIGS, &config_count) || !config_count) {
+        return false;
+    }
+
+    *config = configs[0];
+
+    if (!settings->alpha) {
+        for (EGLint i = 0; i < config_count; ++i) {
+            EGLint alpha_size = 0;
+            eglGetConfigAttrib(display->egl_display, configs[i],
+                EGL_ALPHA_SIZE, &alpha_size);
+            if (!alpha_size) {
+                *config = configs[i];
+                break;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Creates a core profile context, falling back to whatever the driver gives
+ * without attributes.
+ * 
+ * \param[in] display Shared display.
+ * \param[in] config Configuration.
+ * \param[in] share_context Context to share objects with, or none.
+ * \param[in] errors Error mode.
+ * \return New context, or none on failure.
+ */
+static EGLContext create_context(const wayland_display* display,
+    EGLConfig config, EGLContext share_context, gl_errors errors) {
+    EGLint context_attributes[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 2,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE, EGL_NONE,
+        EGL_NONE
+    };
+
+    if (errors == GL_ERRORS_DEBUG) {
+        context_attributes[6] = EGL_CONTEXT_OPENGL_DEBUG;
+        context_attributes[7] = EGL_TRUE;
+    } else if (errors == GL_ERRORS_NONE && display->no_error) {
+        context_attributes[6] = EGL_CONTEXT_OPENGL_NO_ERROR_KHR;
+        context_attributes[7] = EGL_TRUE;
+    }
+
+    EGLContext context = eglCreateContext(display->egl_display, config,
+        share_context, context_attributes);
+    if (context == EGL_NO_CONTEXT) {
+        context = eglCreateContext(display->egl_display, config,
+            share_context, NULL);
+    }
+
+    return context;
+}
+
+/**
+ * Checks whether native windows should be Wayland windows: the session has a
+ * Wayland compositor and OPENGL_CONTEXT_PLATFORM does not ask for X11.
+ * 
+ * \return Whether to use Wayland.
+ */
+bool use_wayland(void) {
+    const char* platform = getenv("OPENGL_CONTEXT_PLATFORM");
+    if (platform && !strcmp(platform, "x11")) {
+        return false;
+    }
+
+    const char* display = getenv("WAYLAND_DISPLAY");
+
+    return (display && *display) || requires_wayland();
+}
+
+/**
+ * Checks whether OPENGL_CONTEXT_PLATFORM asks for Wayland by name, in which
+ * case native windows do not fall back to X11.
+ * 
+ * \return Whether Wayland is required.
+ */
+bool requires_wayland(void) {
+    const char* platform = getenv("OPENGL_CONTEXT_PLATFORM");
+
+    return platform && !strcmp(platform, "wayland");
+}
+
+/**
+ * Creates an xdg-shell toplevel with an EGL window surface and context, and
+ * waits for the compositor's first configure. Input events and resizes are
+ * decoded into the given queue, and the queue, size and close request are
+ * only touched with the given mutex held.
+ * 
+ * \param[in] settings Window settings.
+ * \param[in] share Wayland window to share objects with, or null.
+ * \param[in] events Queue for decoded events.
+ * \param[in] state_mutex Mutex guarding the queue and window state.
+ * \return New Wayland window.
+ */
+wayland_window* create_wayland_window(const window_settings* settings,
+    const wayland_window* share, event_queue* events,
+    pthread_mutex_t* state_mutex) {
+    uint64_t stage = begin_trace();
+    wayland_display* display = acquire_wayland_display();
+    end_trace("acquire_wayland_display", stage);
+    if (!display) {
+        return NULL;
+    }
+
+    wayland_window* wayland = malloc(sizeof(struct wayland_window));
+    memset(wayland, 0, sizeof(struct wayland_window));
+
+    // EGL windows are at least one pixel in each direction.
+    wayland->width = settings->width ? settings->width : 1;
+    wayland->height = settings->height ? settings->height : 1;
+    wayland->events = events;
+    wayland->state_mutex = state_mutex;
+    wayland->errors = settings->errors;
+    wayland->interval = 1;
+    wayland->context = EGL_NO_CONTEXT;
+    wayland->egl_surface = EGL_NO_SURFACE;
+
+    if (!choose_config(display, &settings->framebuffer, &wayland->config)) {
+        fprintf(stderr, "[ERROR] Failed to choose EGL configuration.\n");
+
+        release_wayland_display();
+
+        free(wayland);
+
+        return NULL;
+    }
+
+    stage = begin_trace();
+
+    wayland->surface = wl_compositor_create_surface(display->compositor);
+    wl_surface_set_user_data(wayland->surface, wayland);
+
+    // Frame callbacks arrive on a queue of their own, so waiting for one on
+    // the render thread does not run the input and configure listeners.
+    wayland->frame_queue = wl_display_create_queue(display->display);
+    wayland->frame_surface = wl_proxy_create_wrapper(wayland->surface);
+    wl_proxy_set_queue((struct wl_proxy*) wayland->frame_surface,
+        wayland->frame_queue);
+
+    wayland->xdg_surface =
+        xdg_wm_base_get_xdg_surface(display->wm_base, wayland->surface);
+    xdg_surface_add_listener(wayland->xdg_surface, &xdg_surface_listener,
+        wayland);
+
+    wayland->toplevel = xdg_surface_get_toplevel(wayland->xdg_surface);
+    xdg_toplevel_add_listener(wayland->toplevel, &toplevel_listener,
+        wayland);
+    xdg_toplevel_set_title(wayland->toplevel,
+        settings->title ? settings->title : "");
+
+    // A surface may not have a buffer attached before its first configure.
+    wl_surface_commit(wayland->surface);
+    while (!wayland->configured) {
+        if (wl_display_dispatch(display->display) < 0) {
+            fprintf(stderr, "[ERROR] Failed to configure window.\n");
+
+            destroy_wayland_window(wayland);
+
+            return NULL;
+        }
+    }
+
+    end_trace("xdg_surface_configure", stage);
+
+    wayland->native = wl_egl_window_create(wayland->surface,
+        (int) wayland->width, (int) wayland->height);
+    if (!wayland->native) {
+        fprintf(stderr, "[ERROR] Failed to create EGL window.\n");
+
+        destroy_wayland_window(wayland);
+
+        return NULL;
+    }
+
+    EGLint surface_attributes[] = {
+        EGL_NONE, EGL_NONE,
+        EGL_NONE
+    };
+
+    if (settings->framebuffer.srgb && display->colorspace) {
+        surface_attributes[0] = EGL_GL_COLORSPACE_KHR;
+        surface_attributes[1] = EGL_GL_COLORSPACE_SRGB_KHR;
+    }
+
+    wayland->egl_surface = display->eglCreatePlatformWindowSurfaceEXT(
+        display->egl_display, wayland->config, wayland->native,
+        surface_attributes);
+    if (wayland->egl_surface == EGL_NO_SURFACE) {
+        fprintf(stderr, "[ERROR] Failed to create window surface.\n");
+
+        destroy_wayland_window(wayland);
+
+        return NULL;
+    }
+
+    if (settings->errors == GL_ERRORS_NONE && !display->no_error) {
+        printf("[INFO] Errors will be checked; the driver cannot create "
+            "no-error contexts.\n");
+    }
+
+    stage = begin_trace();
+    wayland->context = create_context(display, wayland->config,
+        share ? share->context : EGL_NO_CONTEXT, settings->errors);
+    end_trace("create_context", stage);
+
+    if (wayland->context == EGL_NO_CONTEXT) {
+        fprintf(stderr, "[ERROR] Failed to create context.\n");
+
+        destroy_wayland_window(wayland);
+
+        return NULL;
+    }
+
+    if (!eglMakeCurrent(display->egl_display, wayland->egl_surface,
+        wayland->egl_surface, wayland->context)) {
+        fprintf(stderr, "[ERROR] Failed to set context.\n");
+
+        destroy_wayland_window(wayland);
+
+        return NULL;
+    }
+
+    // Frame callbacks pace the swaps, so EGL must not wait as well.
+    eglSwapInterval(display->egl_display, 0);
+
+    return wayland;
+}
+
+/**
+ * Destroys a Wayland window.
+ * 
+ * \param[in] wayland Wayland window.
+ */
+void destroy_wayland_window(wayland_window* wayland) {
+    EGLDisplay display = shared_display.egl_display;
+
+    if (wayland->context != EGL_NO_CONTEXT) {
+        if (eglGetCurrentContext() == wayland->context) {
+            eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE,
+                EGL_NO_CONTEXT);
+        }
+
+        eglDestroyContext(display, wayland->context);
+    }
+
+    if (wayland->egl_surface != EGL_NO_SURFACE) {
+        eglDestroySurface(display, wayland->egl_surface);
+    }
+
+    if (wayland->native) {
+        wl_egl_window_destroy(wayland->native);
+    }
+
+    if (wayland->frame) {
+        wl_callback_destroy(wayland->frame);
+    }
+
+    if (wayland->frame_surface) {
+        wl_proxy_wrapper_destroy(wayland->frame_surface);
+    }
+
+    if (wayland->frame_queue) {
+        wl_event_queue_destroy(wayland->frame_queue);
+    }
+
+    if (shared_display.pointer_focus == wayland) {
+        shared_display.pointer_focus = NULL;
+    }
+
+    if (shared_display.keyboard_focus == wayland) {
+        shared_display.keyboard_focus = NULL;
+    }
+
+    xdg_toplevel_destroy(wayland->toplevel);
+    xdg_surface_destroy(wayland->xdg_surface);
+    wl_surface_destroy(wayland->surface);
+    wl_display_flush(shared_display.display);
+
+    release_wayland_display();
+
+    free(wayland);
+}
+
+/**
+ * Makes the Wayland window's context current.
+ * 
+ * \param[in] wayland Wayland window.
+ * \return Whether the context was made current.
+ */
+bool make_wayland_current(wayland_window* wayland) {
+    eglBindAPI(EGL_OPENGL_API);
+
+    if (!eglMakeCurrent(shared_display.egl_display, wayland->egl_surface,
+        wayland->egl_surface, wayland->context)) {
+        fprintf(stderr, "[ERROR] Failed to set context.\n");
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Releases the Wayland window's context from the calling thread.
+ * 
+ * \param[in] wayland Wayland window.
+ */
+void release_wayland_current(wayland_window* wayland) {
+    eglMakeCurrent(shared_display.egl_display, EGL_NO_SURFACE, EGL_NO_SURFACE,
+        EGL_NO_CONTEXT);
+}
+
+/**
+ * Reads and dispatches events from the compositor, for every Wayland window
+ * on the connection.
+ * 
+ * \param[in] wayland Wayland window.
+ * \param[in] timeout Milliseconds to wait for events, or a negative value to
+ * wait indefinitely.
+ * \param[in] wake_fd Event file descriptor that ends the wait early, or -1.
+ */
+void dispatch_wayland_events(wayland_window* wayland, int timeout,
+    int wake_fd) {
+    struct wl_display* display = shared_display.display;
+
+    // Events already read count as having arrived, so they end the wait.
+    while (wl_display_prepare_read(display)) {
+        if (wl_display_dispatch_pending(display) > 0) {
+            timeout = 0;
+        }
+    }
+
+    wl_display_flush(display);
+
+    struct pollfd fds[] = {
+        { wl_display_get_fd(display), POLLIN, 0 },
+        { wake_fd, POLLIN, 0 }
+    };
+
+    const int ready = poll(fds, 2, timeout);
+
+    if (ready > 0 && (fds[0].revents & POLLIN)) {
+        wl_display_read_events(display);
+    } else {
+        wl_display_cancel_read(display);
+    }
+
+    if (ready > 0 && (fds[1].revents & POLLIN)) {
+        eventfd_t value;
+        eventfd_read(wake_fd, &value);
+    }
+
+    wl_display_dispatch_pending(display);
+}
+
+/**
+ * Gets the size of a Wayland window as of its last configure, and whether
+ * the compositor has asked it to close.
+ * 
+ * \param[in] wayland Wayland window.
+ * \param[out] width Window width.
+ * \param[out] height Window height.
+ * \return Whether the window should close.
+ */
+bool get_wayland_window_state(const wayland_window* wayland, unsigned* width,
+    unsigned* height) {
+    pthread_mutex_lock(wayland->state_mutex);
+
+    *width = wayland->width;
+    *height = wayland->height;
+    const bool closed = wayland->closed;
+
+    pthread_mutex_unlock(wayland->state_mutex);
+
+    return closed;
+}
+
+/**
+ * Presents a frame of a Wayland window. With a nonzero swap interval, this
+ * first waits for the frame callback of the previous present, so frames are
+ * paced by the compositor rather than by EGL. Damage is passed to
+ * eglSwapBuffersWithDamage where the driver supports it.
+ * 
+ * \param[in] wayland Wayland window.
+ * \param[in] damage Rectangles that changed, in OpenGL window coordinates,
+ * or null if the whole window changed.
+ * \param[in] count Number of rectangles.
+ */
+void swap_wayland_buffer(wayland_window* wayland, const rect* damage,
+    size_t count) {
+    if (wayland->interval) {
+        while (wayland->frame && !wayland->closed) {
+            if (wl_display_dispatch_queue(shared_display.display,
+                wayland->frame_queue) < 0) {
+                break;
+            }
+        }
+
+        // A connection error leaves the callback unanswered; stop waiting
+        // for it rather than blocking every later frame.
+        if (wayland->frame) {
+            wl_callback_destroy(wayland->frame);
+        }
+
+        // The swap commits the surface, which sends this request with it.
+        wayland->frame = wl_surface_frame(wayland->frame_surface);
+        wl_callback_add_listener(wayland->frame, &frame_listener, wayland);
+    }
+
+    // Swap damage shares OpenGL's bottom left origin. Lists too long for the
+    // buffer fall back to a full swap.
+    if (damage && count && count <= MAX_DAMAGE_RECTS
+        && shared_display.eglSwapBuffersWithDamage) {
+        EGLint rects[MAX_DAMAGE_RECTS * 4];
+        for (size_t i = 0; i < count; ++i) {
+            rects[i * 4] = damage[i].x;
+            rects[i * 4 + 1] = damage[i].y;
+            rects[i * 4 + 2] = (EGLint) damage[i].width;
+            rects[i * 4 + 3] = (EGLint) damage[i].height;
+        }
+
+        shared_display.eglSwapBuffersWithDamage(shared_display.egl_display,
+            wayland->egl_surface, rects, (EGLint) count);
+    } else {
+        eglSwapBuffers(shared_display.egl_display, wayland->egl_surface);
+    }
+}
+
+/**
+ * Gets the age of the back buffer from EGL_EXT_buffer_age.
+ * 
+ * \param[in] wayland Wayland window.
+ * \return Buffer age, or zero if unknown.
+ */
+unsigned get_wayland_buffer_age(wayland_window* wayland) {
+    if (!shared_display.buffer_age) {
+        return 0;
+    }
+
+    EGLint age = 0;
+    eglQuerySurface(shared_display.egl_display, wayland->egl_surface,
+        EGL_BUFFER_AGE_EXT, &age);
+
+    return age > 0 ? (unsigned) age : 0;
+}
+
+/**
+ * Sets whether presents wait for the frame callback of the previous present.
+ * Zero presents without waiting and any other interval waits for one frame
+ * callback, since the compositor rather than the client decides which
+ * refresh a frame is shown at.
+ * 
+ * \param[in] wayland Wayland window.
+ * \param[in] interval Swap interval.
+ */
+void set_wayland_swap_interval(wayland_window* wayland, int interval) {
+    wayland->interval = interval;
+}
+
+/**
+ * Creates a context sharing objects with a Wayland window's context, with no
+ * surface of its own.
+ * 
+ * \param[in] share Wayland window.
+ * \return New Wayland context.
+ */
+wayland_context* create_wayland_context(const wayland_window* share) {
+    if (!shared_display.surfaceless) {
+        fprintf(stderr, "[ERROR] Shared contexts need "
+            "EGL_KHR_surfaceless_context.\n");
+        return NULL;
+    }
+
+    wayland_context* context = malloc(sizeof(struct wayland_context));
+
+    context->context = create_context(&shared_display, share->config,
+        share->context, share->errors);
+    if (context->context == EGL_NO_CONTEXT) {
+        fprintf(stderr, "[ERROR] Failed to create shared context.\n");
+
+        free(context);
+
+        return NULL;
+    }
+
+    pthread_mutex_lock(&display_mutex);
+    ++shared_display.references;
+    pthread_mutex_unlock(&display_mutex);
+
+    return context;
+}
+
+/**
+ * Destroys a Wayland context.
+ * 
+ * \param[in] context Wayland context.
+ */
+void destroy_wayland_context(wayland_context* context) {
+    eglDestroyContext(shared_display.egl_display, context->context);
+    release_wayland_display();
+
+    free(context);
+}
+
+/**
+ * Makes a Wayland context current.
+ * 
+ * \param[in] context Wayland context.
+ * \return Whether the context was made current.
+ */
+bool make_wayland_context_current(wayland_context* context) {
+    eglBindAPI(EGL_OPENGL_API);
+
+    if (!eglMakeCurrent(shared_display.egl_display, EGL_NO_SURFACE,
+        EGL_NO_SURFACE, context->context)) {
+        fprintf(stderr, "[ERROR] Failed to set shared context.\n");
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Releases a Wayland context from the calling thread.
+ * 
+ * \param[in] context Wayland context.
+ */
+void release_wayland_context(wayland_context* context) {
+    eglMakeCurrent(shared_display.egl_display, EGL_NO_SURFACE, EGL_NO_SURFACE,
+        EGL_NO_CONTEXT);
+}
+
+/**
+ * Gets a procedure address from EGL.
+ * 
+ * \param[in] name Procedure name.
+ * \return Procedure address.
+ */
+procedure get_wayland_procedure(const char* name) {
+    return (procedure) eglGetProcAddress(name);
+}
+
+#elif defined(OPENGL_CONTEXT_WINDOWS_PLATFORM)
+static int linux_wayland_c;
+#endif
@@ -0,0 +1,175 @@
+/**
+ * \file linux_wayland.h
+ * \author Isaiah Lateer
+ * 
+ * Header file for the Wayland window struct and functions. Used by
+ * linux_window.c to implement native windows on Wayland compositors when
+ * built with OPENGL_CONTEXT_WAYLAND.
+ */
+
+#ifndef OPENGL_CONTEXT_LINUX_WAYLAND_HEADER
+#define OPENGL_CONTEXT_LINUX_WAYLAND_HEADER
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <pthread.h>
+
+#include "event_queue.h"
+#include "window.h"
+
+typedef struct wayland_window wayland_window;
+
+typedef struct wayland_context wayland_context;
+
+/**
+ * Checks whether native windows should be Wayland windows: the session has a
+ * Wayland compositor and OPENGL_CONTEXT_PLATFORM does not ask for X11.
+ * 
+ * \return Whether to use Wayland.
+ */
+bool use_wayland(void);
+
+/**
+ * Checks whether OPENGL_CONTEXT_PLATFORM asks for Wayland by name, in which
+ * case native windows do not fall back to X11.
+ * 
+ * \return Whether Wayland is required.
+ */
+bool requires_wayland(void);
+
+/**
+ * Creates an xdg-shell toplevel with an EGL window surface and context, and
+ * waits for the compositor's first configure. Input events and resizes are
+ * decoded into the given queue, and the queue, size and close request are
+ * only touched with the given mutex held.
+ * 
+ * \param[in] settings Window settings.
+ * \param[in] share Wayland window to share objects with, or null.
+ * \param[in] events Queue for decoded events.
+ * \param[in] state_mutex Mutex guarding the queue and window state.
+ * \return New Wayland window.
+ */
+wayland_window* create_wayland_window(const window_settings* settings,
+    const wayland_window* share, event_queue* events,
+    pthread_mutex_t* state_mutex);
+
+/**
+ * Destroys a Wayland window.
+ * 
+ * \param[in] wayland Wayland window.
+ */
+void destroy_wayland_window(wayland_window* wayland);
+
+/**
+ * Makes the Wayland window's context current.
+ * 
+ * \param[in] wayland Wayland window.
+ * \return Whether the context was made current.
+ */
+bool make_wayland_current(wayland_window* wayland);
+
+/**
+ * Releases the Wayland window's context from the calling thread.
+ * 
+ * \param[in] wayland Wayland window.
+ */
+void release_wayland_current(wayland_window* wayland);
+
+/**
+ * Reads and dispatches events from the compositor, for every Wayland window
+ * on the connection.
+ * 
+ * \param[in] wayland Wayland window.
+ * \param[in] timeout Milliseconds to wait for events, or a negative value to
+ * wait indefinitely.
+ * \param[in] wake_fd Event file descriptor that ends the wait early, or -1.
+ */
+void dispatch_wayland_events(wayland_window* wayland, int timeout,
+    int wake_fd);
+
+/**
+ * Gets the size of a Wayland window as of its last configure, and whether
+ * the compositor has asked it to close.
+ * 
+ * \param[in] wayland Wayland window.
+ * \param[out] width Window width.
+ * \param[out] height Window height.
+ * \return Whether the window should close.
+ */
+bool get_wayland_window_state(const wayland_window* wayland, unsigned* width,
+    unsigned* height);
+
+/**
+ * Presents a frame of a Wayland window. With a nonzero swap interval, this
+ * first waits for the frame callback of the previous present, so frames are
+ * paced by the compositor rather than by EGL. Damage is passed to
+ * eglSwapBuffersWithDamage where the driver supports it.
+ * 
+ * \param[in] wayland Wayland window.
+ * \param[in] damage Rectangles that changed, in OpenGL window coordinates,
+ * or null if the whole window changed.
+ * \param[in] count Number of rectangles.
+ */
+void swap_wayland_buffer(wayland_window* wayland, const rect* damage,
+    size_t count);
+
+/**
+ * Gets the age of the back buffer from EGL_EXT_buffer_age.
+ * 
+ * \param[in] wayland Wayland window.
+ * \return Buffer age, or zero if unknown.
+ */
+unsigned get_wayland_buffer_age(wayland_window* wayland);
+
+/**
+ * Sets whether presents wait for the frame callback of the previous present.
+ * Zero presents without waiting and any other interval waits for one frame
+ * callback, since the compositor rather than the client decides which
+ * refresh a frame is shown at.
+ * 
+ * \param[in] wayland Wayland window.
+ * \param[in] interval Swap interval.
+ */
+void set_wayland_swap_interval(wayland_window* wayland, int interval);
+
+/**
+ * Creates a context sharing objects with a Wayland window's context, with no
+ * surface of its own.
+ * 
+ * \param[in] share Wayland window.
+ * \return New Wayland context.
+ */
+wayland_context* create_wayland_context(const wayland_window* share);
+
+/**
+ * Destroys a Wayland context.
+ * 
+ * \param[in] context Wayland context.
+ */
+void destroy_wayland_context(wayland_context* context);
+
+/**
+ * Makes a Wayland context current.
+ * 
+ * \param[in] context Wayland context.
+ * \return Whether the context was made current.
+ */
+bool make_wayland_context_current(wayland_context* context);
+
+/**
+ * Releases a Wayland context from the calling thread.
+ * 
+ * \param[in] context Wayland context.
+ */
+void release_wayland_context(wayland_context* context);
+
+/**
+ * Gets a procedure address from EGL.
+ * 
+ * \param[in] name Procedure name.
+ * \return Procedure address.
+ */
+procedure get_wayland_procedure(const char* name);
+
+#endif
@@ -11,443 +11,3318 @@
 
 #include "window.h"
 
+#include <limits.h>
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include <poll.h>
+#include <pthread.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
 #include <X11/Xlib.h>
+#include <X11/Xatom.h>
+#include <X11/Xutil.h>
+#include <X11/extensions/sync.h>
+
+#ifdef OPENGL_CONTEXT_XCB
+#include <X11/Xlib-xcb.h>
+#include <xcb/xcb.h>
+#endif
 
 #include <GL/glx.h>
 #include <GL/glext.h>
 #include <GL/glxext.h>
 
-#include "version.h"
+#include "damage.h"
+#include "debug_output.h"
+#include "event_queue.h"
+#include "gl_loader.h"
+#include "linux_headless.h"
+#include "linux_software.h"
 
-typedef struct window {
+#ifdef OPENGL_CONTEXT_PRESENT
+#include "linux_present.h"
+#endif
+
+#ifdef OPENGL_CONTEXT_WAYLAND
+#include "linux_wayland.h"
+#endif
+#include "shared_context.h"
+#include "timer.h"
+#include "trace.h"
+#include "version.h"
+#include "version_cache.h"
+#include "vblank_model.h"
+
+#define MAX_DRIVER_KEY_LENGTH 256
+#define MAX_TRAPPED_RANGES 16
+#define WINDOW_EVENT_MASK (KeyPressMask | KeyReleaseMask | ButtonPressMask \
+    | ButtonReleaseMask | PointerMotionMask | StructureNotifyMask \
+    | FocusChangeMask | ExposureMask)
+
+typedef struct serial_range {
+    unsigned long first;
+    unsigned long last;
+} serial_range;
+
+typedef struct error_trap {
+    struct error_trap* next;
     Display* display;
+    serial_range ranges[MAX_TRAPPED_RANGES];
+    int range_count;
+    bool error;
+} error_trap;
+
+typedef struct framebuffer_candidate {
+    GLXFBConfig config;
+    int samples;
+    int depth_bits;
+    int stencil_bits;
+    int alpha_bits;
+    int visual_depth;
+    int extra_buffers;
+    bool srgb;
+} framebuffer_candidate;
+
+typedef struct framebuffer_choice {
+    struct framebuffer_choice* next;
+    framebuffer_settings settings;
+    GLXFBConfig config;
     XVisualInfo* visual_info;
     Colormap colormap;
-    Window window;
+} framebuffer_choice;
+
+#ifdef OPENGL_CONTEXT_XCB
+#define ATOM_COUNT 4
+
+typedef struct window_request {
+    xcb_void_cookie_t cookie;
+    const char* failure;
+} window_request;
+#endif
+
+typedef struct platform {
+    Display* display;
+#ifdef OPENGL_CONTEXT_XCB
+    xcb_connection_t* connection;
+    Atom wm_protocols;
+#endif
+    unsigned references;
+    int screen;
+    bool has_glx;
+    int major_version, minor_version;
+    framebuffer_candidate* candidates;
+    int candidate_count;
+    framebuffer_choice* choices;
+    framebuffer_choice* software_choice;
     Atom wm_delete_window;
+    Atom net_wm_sync_request;
+    Atom net_wm_sync_request_counter;
+    bool has_sync;
+    Time last_time;
+    char driver_key[MAX_DRIVER_KEY_LENGTH];
+    version context_version;
+    PFNGLXCREATECONTEXTATTRIBSARBPROC glXCreateContextAttribsARB;
+    PFNGLXSWAPINTERVALEXTPROC glXSwapIntervalEXT;
+    PFNGLXSWAPINTERVALMESAPROC glXSwapIntervalMESA;
+    PFNGLXCOPYSUBBUFFERMESAPROC glXCopySubBufferMESA;
+    PFNGLXGETSYNCVALUESOMLPROC glXGetSyncValuesOML;
+    PFNGLXGETMSCRATEOMLPROC glXGetMscRateOML;
+    bool swap_control_tear;
+    bool buffer_age;
+    bool swap_event;
+    bool no_error;
+    int glx_event_base;
+} platform;
+
+typedef struct window {
+    headless_window* headless;
+    software_surface* software;
+#ifdef OPENGL_CONTEXT_PRESENT
+    present_chain* chain;
+#endif
+#ifdef OPENGL_CONTEXT_WAYLAND
+    wayland_window* wayland;
+#endif
+    platform* platform;
+    const framebuffer_choice* framebuffer;
+    Display* display;
+    Window window;
     GLXContext context;
+    gl_errors errors;
+    version version;
+    // Guards the size, resize synchronization and present timing state,
+    // which the thread that polls events writes and the thread that swaps
+    // reads.
+    pthread_mutex_t state_mutex;
+    unsigned width, height;
+    event_queue events;
+    XSyncCounter sync_counter;
+    XSyncValue sync_value;
+    bool sync_requested;
+    bool sync_configured;
+    // The damage history and back buffer state belong to the thread that
+    // swaps, along with the size they were recorded at.
+    damage_history damage;
+    unsigned damage_width, damage_height;
+    unsigned swaps_since_copy;
+    bool back_buffer_current;
+    present_timing_source timing_source;
+    present_timing present;
+    bool presented;
+    uint64_t swap_count;
+    vblank_model vblank;
+    gl_dispatch* gl;
+    debug_output* debug;
+    int wake_fd;
+    atomic_bool quit;
 } window;
 
-static bool error = false;
+typedef struct shared_context {
+    window* window;
+    headless_context* headless;
+#ifdef OPENGL_CONTEXT_WAYLAND
+    wayland_context* wayland;
+#endif
+    GLXContext context;
+    GLXPbuffer pbuffer;
+} shared_context;
+
+static XContext window_context = 0;
+static platform* shared_platform = NULL;
+static pthread_mutex_t platform_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t trap_mutex = PTHREAD_MUTEX_INITIALIZER;
+static error_trap* traps = NULL;
+static XErrorHandler previous_error_handler = NULL;
+static _Thread_local unsigned locked_displays = 0;
 
 /**
- * Sets a flag when an error has occurred.
- * 
- * \param[in] display Connection to the X server.
- * \param[in] event Error event.
- * \return Result.
+ * Locks the shared platform context. The platform mutex is always taken
+ * before a display is locked, never while one is, so a thread holding a
+ * display lock aborts here instead of risking a deadlock with one that holds
+ * the platform mutex.
  */
-int true_error_handler(Display *display, XErrorEvent *event) {
-    error = true;
-    return 0;
+static void lock_platform(void) {
+    if (locked_displays) {
+        fprintf(stderr, "[ERROR] Locked the platform while holding a display "
+            "lock.\n");
+        abort();
+    }
+
+    pthread_mutex_lock(&platform_mutex);
+}
+
+/**
+ * Unlocks the shared platform context.
+ */
+static void unlock_platform(void) {
+    pthread_mutex_unlock(&platform_mutex);
 }
 
 /**
- * Does nothing.
+ * Marks the error trap whose calls sent the failed request. Errors no trap
+ * claims are passed on to the error handler that was installed before.
  * 
  * \param[in] display Connection to the X server.
  * \param[in] event Error event.
  * \return Result.
  */
-int false_error_handler(Display *display, XErrorEvent *event) {
+static int trap_error_handler(Display* display, XErrorEvent* event) {
+    bool trapped = false;
+
+    pthread_mutex_lock(&trap_mutex);
+
+    for (error_trap* trap = traps; trap && !trapped; trap = trap->next) {
+        if (trap->display != display) {
+            continue;
+        }
+
+        for (int i = 0; i < trap->range_count; ++i) {
+            if (event->serial >= trap->ranges[i].first
+                && event->serial <= trap->ranges[i].last) {
+                trap->error = true;
+                trapped = true;
+                break;
+            }
+        }
+    }
+
+    pthread_mutex_unlock(&trap_mutex);
+
+    if (!trapped && previous_error_handler) {
+        return previous_error_handler(display, event);
+    }
+
     return 0;
 }
 
 /**
- * Checks if an event belongs to the given window.
+ * Starts collecting the errors of requests the calling thread sends between
+ * begin_trapped_calls() and end_trapped_calls(). Each thread uses its own
+ * trap, so windows can be created on several threads at once.
  * 
+ * \param[out] trap Error trap.
  * \param[in] display Connection to the X server.
- * \param[in] event Event.
- * \param[in] arg Window pointer.
- * \return Whether the event belongs to the given window.
  */
-static int predicate(Display* display, XEvent* event, XPointer arg) {
-    return event->xany.window == *(Window*) arg;
+static void open_error_trap(error_trap* trap, Display* display) {
+    memset(trap, 0, sizeof(error_trap));
+    trap->display = display;
+
+    pthread_mutex_lock(&trap_mutex);
+    trap->next = traps;
+    traps = trap;
+    pthread_mutex_unlock(&trap_mutex);
 }
 
 /**
- * Creates a window.
+ * Waits for the errors of every request sent so far, then stops collecting
+ * them.
  * 
- * \param[in] title Window title.
- * \param[in] width Window width.
- * \param[in] height Window height.
- * \return New window.
+ * \param[in] trap Error trap.
+ * \return Whether any trapped request failed.
  */
-window* create_window(const char* title, unsigned width, unsigned height) {
-    window* window = malloc(sizeof(struct window));
-    memset(window, 0, sizeof(struct window));
-
-    XErrorHandler prev_error_handler = XSetErrorHandler(true_error_handler);
-    
-    window->display = XOpenDisplay(NULL);
-    if (!window->display || error) {
-        fprintf(stderr, "[ERROR] Failed to open display.\n");
+static bool close_error_trap(error_trap* trap) {
+    XSync(trap->display, False);
 
-        XSetErrorHandler(prev_error_handler);
+    pthread_mutex_lock(&trap_mutex);
 
-        free(window);
-
-        return NULL;
+    error_trap** link = &traps;
+    while (*link != trap) {
+        link = &(*link)->next;
     }
 
-    int major_version, minor_version;
-    Bool result = glXQueryVersion(window->display, &major_version,
-        &minor_version);
-    if (!result || error) {
-        XCloseDisplay(window->display);
-        XSetErrorHandler(prev_error_handler);
+    *link = trap->next;
 
-        free(window);
+    const bool error = trap->error;
 
-        return NULL;
-    }
+    pthread_mutex_unlock(&trap_mutex);
+
+    return error;
+}
 
-    const int screen = DefaultScreen(window->display);
-    const Window parent = RootWindow(window->display, screen);
+/**
+ * Locks the display and starts a range of requests whose errors go to a
+ * trap. The lock keeps other threads from sending requests in the middle of
+ * the range.
+ * 
+ * \param[in] trap Error trap.
+ */
+static void begin_trapped_calls(error_trap* trap) {
+    XLockDisplay(trap->display);
+    ++locked_displays;
 
-    GLXFBConfig framebuffer = { 0 };
+    pthread_mutex_lock(&trap_mutex);
 
-    if (((major_version == 1) && (minor_version < 3)) || (major_version < 1)) {
-        int visual_attributes[] = {
-            GLX_RGBA,
-            GLX_DOUBLEBUFFER,
-            GLX_RED_SIZE, 8,
-            GLX_GREEN_SIZE, 8,
-            GLX_BLUE_SIZE, 8,
-            GLX_ALPHA_SIZE, 8,
-            None
-        };
-        
-        window->visual_info =
-            glXChooseVisual(window->display, screen, visual_attributes);
+    // A full trap reopens its last range, which may then also cover other
+    // threads' requests.
+    if (trap->range_count == MAX_TRAPPED_RANGES) {
+        trap->ranges[trap->range_count - 1].last = ULONG_MAX;
     } else {
-        const int framebuffer_attributes[] = {
-            GLX_DOUBLEBUFFER, True,
-            GLX_RED_SIZE, 8,
-            GLX_GREEN_SIZE, 8,
-            GLX_BLUE_SIZE, 8,
-            GLX_ALPHA_SIZE, 8,
-            GLX_DRAWABLE_TYPE, GLX_WINDOW_BIT,
-            GLX_RENDER_TYPE, GLX_RGBA_BIT,
-            GLX_X_RENDERABLE, True,
-            None
-        };
+        trap->ranges[trap->range_count].first = NextRequest(trap->display);
+        trap->ranges[trap->range_count].last = ULONG_MAX;
+        ++trap->range_count;
+    }
 
-        int framebuffer_count;
-        GLXFBConfig* framebuffers = glXChooseFBConfig(window->display, screen,
-            framebuffer_attributes, &framebuffer_count);
-        if (!framebuffers || framebuffer_count == 0 || error) {
-            fprintf(stderr,
-                "[ERROR] Failed to choose a framebuffer configuration.\n");
+    pthread_mutex_unlock(&trap_mutex);
+}
+
+/**
+ * Ends the range of requests started by begin_trapped_calls() and unlocks
+ * the display.
+ * 
+ * \param[in] trap Error trap.
+ */
+static void end_trapped_calls(error_trap* trap) {
+    pthread_mutex_lock(&trap_mutex);
+    trap->ranges[trap->range_count - 1].last = NextRequest(trap->display) - 1;
+    pthread_mutex_unlock(&trap_mutex);
 
-            XCloseDisplay(window->display);
-            XSetErrorHandler(prev_error_handler);
+    --locked_displays;
+    XUnlockDisplay(trap->display);
+}
 
-            free(window);
+/**
+ * Checks whether an error has arrived for a trapped request. Errors the
+ * server has not sent yet are only seen by close_error_trap().
+ * 
+ * \param[in] trap Error trap.
+ * \return Whether a trapped request failed.
+ */
+static bool has_trapped_error(error_trap* trap) {
+    pthread_mutex_lock(&trap_mutex);
+    const bool error = trap->error;
+    pthread_mutex_unlock(&trap_mutex);
 
-            return NULL;
+    return error;
+}
+
+/**
+ * Decodes an event sent to a window into its event queue. Events without a
+ * server timestamp of their own are given the latest one seen.
+ * 
+ * \param[in] window Window.
+ * \param[in] event Event.
+ */
+static void handle_event(window* window, XEvent* event) {
+    window_event decoded;
+
+    switch (event->type) {
+    case KeyPress:
+    case KeyRelease:
+        decoded.type = event->type == KeyPress
+            ? WINDOW_EVENT_KEY_PRESS : WINDOW_EVENT_KEY_RELEASE;
+        window->platform->last_time = event->xkey.time;
+        decoded.time = (uint32_t) event->xkey.time;
+        decoded.key.code = event->xkey.keycode;
+        decoded.key.symbol = (unsigned) XLookupKeysym(&event->xkey, 0);
+        decoded.key.modifiers = event->xkey.state;
+        break;
+    case ButtonPress:
+    case ButtonRelease:
+        decoded.type = event->type == ButtonPress
+            ? WINDOW_EVENT_BUTTON_PRESS : WINDOW_EVENT_BUTTON_RELEASE;
+        window->platform->last_time = event->xbutton.time;
+        decoded.time = (uint32_t) event->xbutton.time;
+        decoded.button.button = event->xbutton.button;
+        decoded.button.x = event->xbutton.x;
+        decoded.button.y = event->xbutton.y;
+        decoded.button.modifiers = event->xbutton.state;
+        break;
+    case MotionNotify:
+        decoded.type = WINDOW_EVENT_MOTION;
+        window->platform->last_time = event->xmotion.time;
+        decoded.time = (uint32_t) event->xmotion.time;
+        decoded.motion.x = event->xmotion.x;
+        decoded.motion.y = event->xmotion.y;
+        decoded.motion.modifiers = event->xmotion.state;
+        break;
+    case ConfigureNotify:
+        pthread_mutex_lock(&window->state_mutex);
+
+        // The configure that follows a sync request is the one the next
+        // swap answers, whether or not the size changed.
+        if (window->sync_requested) {
+            window->sync_configured = true;
         }
 
-        int best_framebuffer = 0;
-        int highest_samples = 0;
+        if ((unsigned) event->xconfigure.width == window->width
+            && (unsigned) event->xconfigure.height == window->height) {
+            pthread_mutex_unlock(&window->state_mutex);
+            return;
+        }
 
-        for (int i = 0; i < framebuffer_count; ++i) {
-            int sample_buffers;
-            result = glXGetFBConfigAttrib(window->display, framebuffers[i],
-                GLX_SAMPLE_BUFFERS, &sample_buffers);
-            if (result != Success || error) {
-                fprintf(stderr, "[ERROR] Failed to get framebuffer "
-                    "configuration attribute.\n");
-                continue;
-            }
+        window->width = (unsigned) event->xconfigure.width;
+        window->height = (unsigned) event->xconfigure.height;
+
+        pthread_mutex_unlock(&window->state_mutex);
+
+        decoded.type = WINDOW_EVENT_RESIZE;
+        decoded.resize.width = (unsigned) event->xconfigure.width;
+        decoded.resize.height = (unsigned) event->xconfigure.height;
+        break;
+    case FocusIn:
+    case FocusOut:
+        // Grabs report focus changes the window never actually sees.
+        if (event->xfocus.mode == NotifyGrab
+            || event->xfocus.mode == NotifyUngrab) {
+            return;
+        }
 
-            int samples;
-            result = glXGetFBConfigAttrib(window->display, framebuffers[i],
-                GLX_SAMPLES, &samples);
-            if (result != Success || error) {
-                fprintf(stderr, "[ERROR] Failed to get framebuffer "
-                    "configuration attribute.\n");
-                continue;
-            }
+        decoded.type = event->type == FocusIn
+            ? WINDOW_EVENT_FOCUS_IN : WINDOW_EVENT_FOCUS_OUT;
+        break;
+    case Expose:
+        decoded.type = WINDOW_EVENT_EXPOSE;
+        decoded.expose.x = event->xexpose.x;
+        decoded.expose.y = event->xexpose.y;
+        decoded.expose.width = (unsigned) event->xexpose.width;
+        decoded.expose.height = (unsigned) event->xexpose.height;
+        break;
+    case ClientMessage:
+        if ((Atom) event->xclient.data.l[0]
+            == window->platform->wm_delete_window) {
+            window->quit = true;
+        } else if ((Atom) event->xclient.data.l[0]
+            == window->platform->net_wm_sync_request && window->sync_counter) {
+            pthread_mutex_lock(&window->state_mutex);
+            XSyncIntsToValue(&window->sync_value,
+                (unsigned) event->xclient.data.l[2],
+                (int) event->xclient.data.l[3]);
+            window->sync_requested = true;
+            window->sync_configured = false;
+            pthread_mutex_unlock(&window->state_mutex);
+        }
 
-            if (sample_buffers && samples > highest_samples) {
-                best_framebuffer = i;
-                highest_samples = samples;
-            }
+        return;
+    default:
+        if (window->software
+            && complete_software_present(window->software, event)) {
+            return;
         }
 
-        framebuffer = framebuffers[best_framebuffer];
-        XFree(framebuffers);
+        if (window->timing_source == PRESENT_TIMING_SWAP_EVENT
+            && event->type
+            == window->platform->glx_event_base + GLX_BufferSwapComplete) {
+            const GLXBufferSwapComplete* complete =
+                (const GLXBufferSwapComplete*) event;
 
-        window->visual_info =
-            glXGetVisualFromFBConfig(window->display, framebuffer);
-    }
+            pthread_mutex_lock(&window->state_mutex);
 
-    if (!window->visual_info) {
-        fprintf(stderr, "[ERROR] Failed to get visual information.\n");
+            window->present.time = (uint64_t) complete->ust * 1000;
+            window->present.msc = (uint64_t) complete->msc;
+            window->present.sbc = (uint64_t) complete->sbc;
+            window->presented = true;
 
-        XCloseDisplay(window->display);
-        XSetErrorHandler(prev_error_handler);
+            observe_vblank(&window->vblank, window->present.time,
+                window->present.msc);
 
-        free(window);
+            pthread_mutex_unlock(&window->state_mutex);
+        }
 
-        return NULL;
+        return;
     }
 
-    window->colormap = XCreateColormap(window->display, parent,
-        window->visual_info->visual, AllocNone);
+    // Structure, focus and expose events carry no timestamp of their own, so
+    // they take the latest one the server sent.
+    switch (event->type) {
+    case ConfigureNotify:
+    case FocusIn:
+    case FocusOut:
+    case Expose:
+        decoded.time = (uint32_t) window->platform->last_time;
+        break;
+    default:
+        break;
+    }
 
-    XSetWindowAttributes window_attributes = {
-        0,
-        BlackPixel(window->display, screen),
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        0,
-        window->colormap,
-        0
-    };
+    pthread_mutex_lock(&window->state_mutex);
+    push_event(&window->events, &decoded);
+    pthread_mutex_unlock(&window->state_mutex);
+}
 
-    window->window = XCreateWindow(window->display, parent, 0, 0, width, height,
-        0, window->visual_info->depth, InputOutput, window->visual_info->visual,
-        CWBackPixel | CWColormap, &window_attributes);
-    if (error) {
-        fprintf(stderr, "[ERROR] Failed to create window.\n");
+/**
+ * Drains the event queue of a display in a single pass, routing each event to
+ * the window it belongs to. The display stays locked for the whole pass, so
+ * another thread polling a window on it cannot take an event between the
+ * check and the read, and no window is destroyed while its events are
+ * decoded.
+ * 
+ * \param[in] display Connection to the X server.
+ */
+static void dispatch_events(Display* display) {
+    XLockDisplay(display);
+    ++locked_displays;
+
+    while (XPending(display)) {
+        XEvent event;
+        XNextEvent(display, &event);
+
+        XPointer window = NULL;
+        if (!XFindContext(display, event.xany.window, window_context,
+            &window)) {
+            handle_event((struct window*) window, &event);
+        }
+    }
 
-        XFreeColormap(window->display, window->colormap);
-        XFree(window->visual_info);
-        XCloseDisplay(window->display);
-        XSetErrorHandler(prev_error_handler);
+    --locked_displays;
+    XUnlockDisplay(display);
+}
+
+/**
+ * Checks if an extension is in a space separated extension list.
+ * 
+ * \param[in] extensions Extension list.
+ * \param[in] name Extension name.
+ * \return Whether the extension is in the list.
+ */
+static bool has_extension(const char* extensions, const char* name) {
+    if (!extensions) {
+        return false;
+    }
 
-        free(window);
+    const size_t length = strlen(name);
 
-        return NULL;
+    const char* start = extensions;
+    while ((start = strstr(start, name))) {
+        const bool at_start = start == extensions || start[-1] == ' ';
+        const bool at_end = start[length] == ' ' || start[length] == '\0';
+        if (at_start && at_end) {
+            return true;
+        }
+
+        start += length;
     }
 
-    XStoreName(window->display, window->window, title);
-    if (error) {
-        fprintf(stderr, "[ERROR] Failed to set window title.\n");
+    return false;
+}
 
-        XDestroyWindow(window->display, window->window);
-        XFreeColormap(window->display, window->colormap);
-        XFree(window->visual_info);
-        XCloseDisplay(window->display);
-        XSetErrorHandler(prev_error_handler);
+/**
+ * Builds a string identifying the driver behind a display, used to key the
+ * context version cache. Uses GLX_MESA_query_renderer when available since the
+ * GLX vendor strings alone do not tell Mesa drivers apart.
+ * 
+ * \param[in] platform Platform context.
+ * \param[in] extensions GLX extension list.
+ */
+static void get_driver_key(platform* platform, const char* extensions) {
+    if (has_extension(extensions, "GLX_MESA_query_renderer")) {
+        PFNGLXQUERYRENDERERSTRINGMESAPROC glXQueryRendererStringMESA =
+            (PFNGLXQUERYRENDERERSTRINGMESAPROC) glXGetProcAddress(
+            (const GLubyte*) "glXQueryRendererStringMESA");
+        PFNGLXQUERYRENDERERINTEGERMESAPROC glXQueryRendererIntegerMESA =
+            (PFNGLXQUERYRENDERERINTEGERMESAPROC) glXGetProcAddress(
+            (const GLubyte*) "glXQueryRendererIntegerMESA");
+
+        if (glXQueryRendererStringMESA && glXQueryRendererIntegerMESA) {
+            const char* vendor = glXQueryRendererStringMESA(platform->display,
+                platform->screen, 0, GLX_RENDERER_VENDOR_ID_MESA);
+            const char* device = glXQueryRendererStringMESA(platform->display,
+                platform->screen, 0, GLX_RENDERER_DEVICE_ID_MESA);
+
+            unsigned driver_version[3] = { 0 };
+            glXQueryRendererIntegerMESA(platform->display, platform->screen, 0,
+                GLX_RENDERER_VERSION_MESA, driver_version);
+
+            snprintf(platform->driver_key, MAX_DRIVER_KEY_LENGTH,
+                "%s|%s|%u.%u.%u", vendor ? vendor : "", device ? device : "",
+                driver_version[0], driver_version[1], driver_version[2]);
+
+            return;
+        }
+    }
 
-        free(window);
+    const char* strings[] = {
+        glXQueryServerString(platform->display, platform->screen, GLX_VENDOR),
+        glXQueryServerString(platform->display, platform->screen, GLX_VERSION),
+        glXGetClientString(platform->display, GLX_VENDOR),
+        glXGetClientString(platform->display, GLX_VERSION)
+    };
 
-        return NULL;
+    snprintf(platform->driver_key, MAX_DRIVER_KEY_LENGTH, "%s|%s|%s|%s",
+        strings[0] ? strings[0] : "", strings[1] ? strings[1] : "",
+        strings[2] ? strings[2] : "", strings[3] ? strings[3] : "");
+}
+
+/**
+ * Gets a framebuffer configuration attribute, treating unsupported attributes
+ * as zero.
+ * 
+ * \param[in] display Connection to the X server.
+ * \param[in] config Framebuffer configuration.
+ * \param[in] attribute Attribute.
+ * \return Attribute value.
+ */
+static int get_framebuffer_attribute(Display* display, GLXFBConfig config,
+    int attribute) {
+    int value;
+    if (glXGetFBConfigAttrib(display, config, attribute, &value) != Success) {
+        return 0;
     }
 
-    window->wm_delete_window = XInternAtom(window->display, "WM_DELETE_WINDOW",
-        False);
-    if (error) {
-        fprintf(stderr, "[ERROR] Failed to create atom.\n");
+    return value;
+}
 
-        XDestroyWindow(window->display, window->window);
-        XFreeColormap(window->display, window->colormap);
-        XFree(window->visual_info);
-        XCloseDisplay(window->display);
-        XSetErrorHandler(prev_error_handler);
+/**
+ * Fetches the attributes of every usable framebuffer configuration once into
+ * a compact array so later requests can be scored without going back to GLX.
+ * 
+ * \param[in] platform Platform context.
+ * \return Whether any configuration was found.
+ */
+static bool load_framebuffer_candidates(platform* platform) {
+    const int framebuffer_attributes[] = {
+        GLX_DOUBLEBUFFER, True,
+        GLX_RED_SIZE, 8,
+        GLX_GREEN_SIZE, 8,
+        GLX_BLUE_SIZE, 8,
+        GLX_DRAWABLE_TYPE, GLX_WINDOW_BIT,
+        GLX_RENDER_TYPE, GLX_RGBA_BIT,
+        GLX_X_RENDERABLE, True,
+        None
+    };
 
-        free(window);
+    Display* display = platform->display;
 
-        return NULL;
+    int framebuffer_count;
+    GLXFBConfig* framebuffers = glXChooseFBConfig(display, platform->screen,
+        framebuffer_attributes, &framebuffer_count);
+    if (!framebuffers || framebuffer_count == 0) {
+        if (framebuffers) {
+            XFree(framebuffers);
+        }
+
+        return false;
     }
 
-    result = XSetWMProtocols(window->display, window->window,
-        &window->wm_delete_window, 1);
-    if (!result || error) {
-        fprintf(stderr, "[ERROR] Failed to set window protocol.\n");
+    XVisualInfo visual_template = { 0 };
+    visual_template.screen = platform->screen;
 
-        XDestroyWindow(window->display, window->window);
-        XFreeColormap(window->display, window->colormap);
-        XFree(window->visual_info);
-        XCloseDisplay(window->display);
-        XSetErrorHandler(prev_error_handler);
+    int visual_count = 0;
+    XVisualInfo* visuals = XGetVisualInfo(display, VisualScreenMask,
+        &visual_template, &visual_count);
 
-        free(window);
+    platform->candidates =
+        malloc(framebuffer_count * sizeof(framebuffer_candidate));
+    platform->candidate_count = 0;
 
-        return NULL;
-    }
-    
-    XMapWindow(window->display, window->window);
-    if (error) {
-        fprintf(stderr, "[ERROR] Failed to map window.\n");
+    for (int i = 0; i < framebuffer_count; ++i) {
+        const int visual_id = get_framebuffer_attribute(display,
+            framebuffers[i], GLX_VISUAL_ID);
 
-        XDestroyWindow(window->display, window->window);
-        XFreeColormap(window->display, window->colormap);
-        XFree(window->visual_info);
-        XCloseDisplay(window->display);
-        XSetErrorHandler(prev_error_handler);
+        int visual_depth = 0;
+        for (int j = 0; j < visual_count; ++j) {
+            if (visuals[j].visualid == (VisualID) visual_id) {
+                visual_depth = visuals[j].depth;
+                break;
+            }
+        }
 
-        free(window);
+        if (!visual_depth) {
+            continue;
+        }
 
-        return NULL;
+        framebuffer_candidate* candidate =
+            &platform->candidates[platform->candidate_count++];
+
+        candidate->config = framebuffers[i];
+        candidate->samples = get_framebuffer_attribute(display,
+            framebuffers[i], GLX_SAMPLE_BUFFERS) ? get_framebuffer_attribute(
+            display, framebuffers[i], GLX_SAMPLES) : 0;
+        candidate->depth_bits = get_framebuffer_attribute(display,
+            framebuffers[i], GLX_DEPTH_SIZE);
+        candidate->stencil_bits = get_framebuffer_attribute(display,
+            framebuffers[i], GLX_STENCIL_SIZE);
+        candidate->alpha_bits = get_framebuffer_attribute(display,
+            framebuffers[i], GLX_ALPHA_SIZE);
+        candidate->visual_depth = visual_depth;
+        candidate->extra_buffers = get_framebuffer_attribute(display,
+            framebuffers[i], GLX_AUX_BUFFERS) + (get_framebuffer_attribute(
+            display, framebuffers[i], GLX_ACCUM_RED_SIZE) > 0);
+        candidate->srgb = get_framebuffer_attribute(display, framebuffers[i],
+            GLX_FRAMEBUFFER_SRGB_CAPABLE_ARB) != 0;
     }
 
-    PFNGLXCREATECONTEXTATTRIBSARBPROC glXCreateContextAttribsARB =
-        (PFNGLXCREATECONTEXTATTRIBSARBPROC)
-        glXGetProcAddress((const GLubyte*) "glXCreateContextAttribsARB");
+    if (visuals) {
+        XFree(visuals);
+    }
 
-    if (glXCreateContextAttribsARB) {   
-        const version versions[] = {
-            { 4, 6 },
-            { 4, 5 },
-            { 4, 4 },
-            { 4, 3 },
-            { 4, 2 },
-            { 4, 1 },
-            { 4, 0 },
-            { 3, 3 },
-            { 3, 2 },
-            { 3, 1 },
-            { 3, 0 },
-            { 2, 1 },
-            { 2, 0 },
-            { 1, 5 },
-            { 1, 4 },
-            { 1, 3 },
-            { 1, 2 },
-            { 1, 1 },
-            { 1, 0 }
-        };
+    XFree(framebuffers);
 
-        const int version_count = sizeof(versions) / sizeof(version);
+    return platform->candidate_count > 0;
+}
 
-        XSetErrorHandler(false_error_handler);
+/**
+ * Scores how well a framebuffer configuration fits the requested settings.
+ * Missing requirements cost the most, then multisampling beyond what was
+ * asked for, then visuals other than 24-bit, extra buffers and unrequested
+ * depth, stencil and alpha bits.
+ * 
+ * \param[in] candidate Framebuffer configuration.
+ * \param[in] settings Requested settings.
+ * \return Cost, lower is better.
+ */
+static int score_framebuffer(const framebuffer_candidate* candidate,
+    const framebuffer_settings* settings) {
+    int cost = 0;
 
-        for (int i = 0; i < version_count; ++i) {
-            const int context_attributes[] = {
-                GLX_CONTEXT_MAJOR_VERSION_ARB, versions[i].major,
-                GLX_CONTEXT_MINOR_VERSION_ARB, versions[i].minor,
-                GLX_CONTEXT_PROFILE_MASK_ARB, GLX_CONTEXT_CORE_PROFILE_BIT_ARB,
-                None
-            };
+    if (candidate->samples < settings->samples) {
+        cost += 100000 * (settings->samples - candidate->samples);
+    } else {
+        cost += 1000 * (candidate->samples - settings->samples);
+    }
 
-            window->context = glXCreateContextAttribsARB(window->display,
-                framebuffer, NULL, True, context_attributes);
-            if (window->context) {
-                break;
-            }
-        }
+    if (candidate->depth_bits < settings->depth_bits) {
+        cost += 100000;
+    } else {
+        cost += candidate->depth_bits - settings->depth_bits;
+    }
 
-        XSetErrorHandler(true_error_handler);
-    } else if (((major_version == 1) && (minor_version < 3))
-        || (major_version < 1)) {
-        window->context = glXCreateContext(window->display, window->visual_info,
-            NULL, True);
+    if (candidate->stencil_bits < settings->stencil_bits) {
+        cost += 100000;
     } else {
-        window->context = glXCreateNewContext(window->display, framebuffer,
-            GLX_RGBA_TYPE, NULL, True);
+        cost += candidate->stencil_bits - settings->stencil_bits;
     }
 
-    if (!window->context || error) {
-        fprintf(stderr, "[ERROR] Failed to create context.\n");
+    if (settings->srgb && !candidate->srgb) {
+        cost += 100000;
+    }
 
-        XUnmapWindow(window->display, window->window);
-        XDestroyWindow(window->display, window->window);
-        XFreeColormap(window->display, window->colormap);
-        XFree(window->visual_info);
-        XCloseDisplay(window->display);
-        XSetErrorHandler(prev_error_handler);
+    if (settings->alpha) {
+        if (!candidate->alpha_bits) {
+            cost += 100000;
+        }
+    } else {
+        cost += candidate->alpha_bits;
+
+        if (candidate->visual_depth != 24) {
+            cost += 500;
+        }
+    }
 
-        free(window);
+    cost += 200 * candidate->extra_buffers;
 
-        return NULL;
+    return cost;
+}
+
+/**
+ * Chooses the visual used for a set of framebuffer settings when GLX is older
+ * than 1.3 and has no framebuffer configurations.
+ * 
+ * \param[in] platform Platform context.
+ * \param[in] settings Requested settings.
+ * \return Visual information.
+ */
+static XVisualInfo* choose_legacy_visual(platform* platform,
+    const framebuffer_settings* settings) {
+    int visual_attributes[] = {
+        GLX_RGBA,
+        GLX_DOUBLEBUFFER,
+        GLX_RED_SIZE, 8,
+        GLX_GREEN_SIZE, 8,
+        GLX_BLUE_SIZE, 8,
+        GLX_ALPHA_SIZE, settings->alpha ? 8 : 0,
+        GLX_DEPTH_SIZE, settings->depth_bits,
+        GLX_STENCIL_SIZE, settings->stencil_bits,
+        None
+    };
+
+    return glXChooseVisual(platform->display, platform->screen,
+        visual_attributes);
+}
+
+/**
+ * Chooses the framebuffer configuration for a set of settings. Choices are
+ * memoized on the platform context, so windows asking for the same settings
+ * share the configuration, visual and colormap.
+ * 
+ * \param[in] platform Platform context.
+ * \param[in] settings Requested settings.
+ * \return Framebuffer choice.
+ */
+static const framebuffer_choice* choose_framebuffer(platform* platform,
+    const framebuffer_settings* settings) {
+    for (framebuffer_choice* choice = platform->choices; choice;
+        choice = choice->next) {
+        if (choice->settings.samples == settings->samples
+            && choice->settings.depth_bits == settings->depth_bits
+            && choice->settings.stencil_bits == settings->stencil_bits
+            && choice->settings.srgb == settings->srgb
+            && choice->settings.alpha == settings->alpha) {
+            return choice;
+        }
     }
 
-    result = glXMakeCurrent(window->display, window->window, window->context);
-    if (!result || error) {
-        fprintf(stderr, "[ERROR] Failed to set context.\n");
+    GLXFBConfig config = NULL;
+    XVisualInfo* visual_info = NULL;
 
-        glXDestroyContext(window->display, window->context);
-        XUnmapWindow(window->display, window->window);
-        XDestroyWindow(window->display, window->window);
-        XFreeColormap(window->display, window->colormap);
-        XFree(window->visual_info);
-        XCloseDisplay(window->display);
-        XSetErrorHandler(prev_error_handler);
+    if (platform->candidates) {
+        int best_candidate = 0;
+        int lowest_cost = score_framebuffer(&platform->candidates[0], settings);
 
-        free(window);
+        for (int i = 1; i < platform->candidate_count; ++i) {
+            const int cost =
+                score_framebuffer(&platform->candidates[i], settings);
+            if (cost < lowest_cost) {
+                best_candidate = i;
+                lowest_cost = cost;
+            }
+        }
+
+        config = platform->candidates[best_candidate].config;
+        visual_info = glXGetVisualFromFBConfig(platform->display, config);
+    } else {
+        visual_info = choose_legacy_visual(platform, settings);
+    }
 
+    if (!visual_info) {
+        fprintf(stderr, "[ERROR] Failed to get visual information.\n");
         return NULL;
     }
 
-    XSetErrorHandler(prev_error_handler);
+    framebuffer_choice* choice = malloc(sizeof(framebuffer_choice));
+    memset(choice, 0, sizeof(framebuffer_choice));
 
-    printf("[INFO] Window created.\n");
-    printf("[INFO] OpenGL version: %s\n", glGetString(GL_VERSION));
-    printf("[INFO] OpenGL renderer: %s\n", glGetString(GL_RENDERER));
-    printf("[INFO] OpenGL vendor: %s\n", glGetString(GL_VENDOR));
+    choice->settings = *settings;
+    choice->config = config;
+    choice->visual_info = visual_info;
+    choice->colormap = XCreateColormap(platform->display,
+        RootWindow(platform->display, platform->screen), visual_info->visual,
+        AllocNone);
 
-    return window;
+    choice->next = platform->choices;
+    platform->choices = choice;
+
+    return choice;
 }
 
 /**
- * Destroys a window.
+ * Loads the GLX extension procedures and flags of a platform context, and
+ * the context version cached for its driver.
  * 
- * \param[in] window Window.
+ * \param[in] platform Platform context.
  */
-void destroy_window(window* window) {
-    glXMakeCurrent(window->display, None, NULL);
-    glXDestroyContext(window->display, window->context);
-    XUnmapWindow(window->display, window->window);
-    XDestroyWindow(window->display, window->window);
-    XFreeColormap(window->display, window->colormap);
-    XFree(window->visual_info);
-    XCloseDisplay(window->display);
+static void load_glx_extensions(platform* platform) {
+    platform->glXCreateContextAttribsARB = (PFNGLXCREATECONTEXTATTRIBSARBPROC)
+        glXGetProcAddress((const GLubyte*) "glXCreateContextAttribsARB");
 
-    free(window);
+    const char* extensions =
+        glXQueryExtensionsString(platform->display, platform->screen);
+    if (has_extension(extensions, "GLX_EXT_swap_control")) {
+        platform->glXSwapIntervalEXT = (PFNGLXSWAPINTERVALEXTPROC)
+            glXGetProcAddress((const GLubyte*) "glXSwapIntervalEXT");
+        platform->swap_control_tear =
+            has_extension(extensions, "GLX_EXT_swap_control_tear");
+    }
 
-    printf("[INFO] Window destroyed.\n");
+    if (has_extension(extensions, "GLX_MESA_swap_control")) {
+        platform->glXSwapIntervalMESA = (PFNGLXSWAPINTERVALMESAPROC)
+            glXGetProcAddress((const GLubyte*) "glXSwapIntervalMESA");
+    }
+
+    if (has_extension(extensions, "GLX_MESA_copy_sub_buffer")) {
+        platform->glXCopySubBufferMESA = (PFNGLXCOPYSUBBUFFERMESAPROC)
+            glXGetProcAddress((const GLubyte*) "glXCopySubBufferMESA");
+    }
+
+    platform->buffer_age = has_extension(extensions, "GLX_EXT_buffer_age");
+    platform->no_error =
+        has_extension(extensions, "GLX_ARB_create_context_no_error");
+
+    if (has_extension(extensions, "GLX_OML_sync_control")) {
+        platform->glXGetSyncValuesOML = (PFNGLXGETSYNCVALUESOMLPROC)
+            glXGetProcAddress((const GLubyte*) "glXGetSyncValuesOML");
+        platform->glXGetMscRateOML = (PFNGLXGETMSCRATEOMLPROC)
+            glXGetProcAddress((const GLubyte*) "glXGetMscRateOML");
+    }
+
+    if (has_extension(extensions, "GLX_INTEL_swap_event")) {
+        int glx_error_base;
+        platform->swap_event = glXQueryExtension(platform->display,
+            &glx_error_base, &platform->glx_event_base);
+    }
+
+    get_driver_key(platform, extensions);
+    load_cached_version(platform->driver_key, &platform->context_version);
 }
 
+#ifdef OPENGL_CONTEXT_XCB
+static const char* atom_names[ATOM_COUNT] = {
+    "WM_PROTOCOLS",
+    "WM_DELETE_WINDOW",
+    "_NET_WM_SYNC_REQUEST",
+    "_NET_WM_SYNC_REQUEST_COUNTER"
+};
+
 /**
- * Polls events sent to the window.
+ * Sends the requests to intern every atom the platform context uses without
+ * waiting for any reply.
  * 
- * \param[in] window Window.
- * \return Whether the application should close.
+ * \param[in] platform Platform context.
+ * \param[out] cookies Cookies of ATOM_COUNT requests.
  */
-bool poll_events(window* window) {
-    bool quit = false;
-
-    XEvent event = { 0 };
-    while (XCheckIfEvent(window->display, &event, predicate,
-        (XPointer) &window->window)) {
-        switch (event.type) {
-        case ClientMessage: {
-            if (event.xclient.data.l[0] == window->wm_delete_window) {
-                quit = true;
-            }
-
-            break;
-        } default:
-            break;
-        }
+static void request_atoms(platform* platform,
+    xcb_intern_atom_cookie_t* cookies) {
+    for (int i = 0; i < ATOM_COUNT; ++i) {
+        cookies[i] = xcb_intern_atom(platform->connection, 0,
+            (uint16_t) strlen(atom_names[i]), atom_names[i]);
     }
-
-    return quit;
 }
 
 /**
- * Swaps buffers.
+ * Reads the replies to the requests sent by request_atoms().
+ * 
+ * \param[in] platform Platform context.
+ * \param[in] cookies Cookies of ATOM_COUNT requests.
+ * \return Whether every atom was interned.
+ */
+static bool receive_atoms(platform* platform,
+    const xcb_intern_atom_cookie_t* cookies) {
+    Atom* atoms[ATOM_COUNT] = {
+        &platform->wm_protocols,
+        &platform->wm_delete_window,
+        &platform->net_wm_sync_request,
+        &platform->net_wm_sync_request_counter
+    };
+
+    bool result = true;
+
+    for (int i = 0; i < ATOM_COUNT; ++i) {
+        xcb_generic_error_t* request_error = NULL;
+        xcb_intern_atom_reply_t* reply = xcb_intern_atom_reply(
+            platform->connection, cookies[i], &request_error);
+        if (!reply) {
+            free(request_error);
+            result = false;
+            continue;
+        }
+
+        *atoms[i] = reply->atom;
+        free(reply);
+    }
+
+    return result;
+}
+#endif
+
+/**
+ * Gets the visual and colormap software windows use, which are the screen's
+ * defaults so the server never has to convert what they present.
+ * 
+ * \param[in] platform Platform context.
+ * \return Framebuffer choice.
+ */
+static const framebuffer_choice* choose_software_framebuffer(
+    platform* platform) {
+    if (platform->software_choice) {
+        return platform->software_choice;
+    }
+
+    XVisualInfo visual_template = { 0 };
+    visual_template.visualid = XVisualIDFromVisual(
+        DefaultVisual(platform->display, platform->screen));
+    visual_template.screen = platform->screen;
+
+    int count = 0;
+    XVisualInfo* visual_info = XGetVisualInfo(platform->display,
+        VisualIDMask | VisualScreenMask, &visual_template, &count);
+    if (!visual_info) {
+        fprintf(stderr, "[ERROR] Failed to get visual information.\n");
+        return NULL;
+    }
+
+    framebuffer_choice* choice = malloc(sizeof(framebuffer_choice));
+    memset(choice, 0, sizeof(framebuffer_choice));
+
+    choice->visual_info = visual_info;
+    choice->colormap = DefaultColormap(platform->display, platform->screen);
+
+    platform->software_choice = choice;
+
+    return choice;
+}
+
+/**
+ * Opens the display and loads the framebuffer configurations. Xlib is made
+ * thread safe and the error handler installed before the first display is
+ * opened. Must be called with the platform mutex held.
+ * 
+ * \return New platform context.
+ */
+static platform* open_platform(void) {
+    platform* platform = malloc(sizeof(struct platform));
+    memset(platform, 0, sizeof(struct platform));
+
+    // Render threads swap buffers while the event thread reads the same
+    // connection, so Xlib has to lock it.
+    if (!XInitThreads()) {
+        fprintf(stderr, "[ERROR] Failed to initialize Xlib threads.\n");
+
+        free(platform);
+
+        return NULL;
+    }
+
+    // The handler stays installed for good and passes on the errors no trap
+    // claims, so windows on other threads never swap it out from under each
+    // other.
+    if (!window_context) {
+        window_context = XUniqueContext();
+        previous_error_handler = XSetErrorHandler(trap_error_handler);
+    }
+
+    uint64_t stage = begin_trace();
+    platform->display = XOpenDisplay(NULL);
+    end_trace("XOpenDisplay", stage);
+    if (!platform->display) {
+        fprintf(stderr, "[ERROR] Failed to open display.\n");
+
+        free(platform);
+
+        return NULL;
+    }
+
+    // No other thread can see the display yet, so one range covers every
+    // request made while setting it up.
+    error_trap trap;
+    open_error_trap(&trap, platform->display);
+    begin_trapped_calls(&trap);
+
+#ifdef OPENGL_CONTEXT_XCB
+    platform->connection = XGetXCBConnection(platform->display);
+
+    // The atoms are requested before the GLX queries so their replies arrive
+    // alongside them instead of costing round trips of their own.
+    xcb_intern_atom_cookie_t atom_cookies[ATOM_COUNT];
+    request_atoms(platform, atom_cookies);
+#endif
+
+    // Displays without GLX can still show software windows.
+    stage = begin_trace();
+    platform->has_glx = glXQueryVersion(platform->display,
+        &platform->major_version, &platform->minor_version);
+    end_trace("glXQueryVersion", stage);
+    if (has_trapped_error(&trap)) {
+        end_trapped_calls(&trap);
+        close_error_trap(&trap);
+        XCloseDisplay(platform->display);
+
+        free(platform);
+
+        return NULL;
+    }
+
+    platform->screen = DefaultScreen(platform->display);
+    if (platform->has_glx && (((platform->major_version == 1)
+        && (platform->minor_version >= 3)) || (platform->major_version > 1))) {
+        stage = begin_trace();
+        const bool result = load_framebuffer_candidates(platform);
+        end_trace("load_framebuffer_candidates", stage);
+        if (!result || has_trapped_error(&trap)) {
+            fprintf(stderr,
+                "[ERROR] Failed to choose a framebuffer configuration.\n");
+
+            end_trapped_calls(&trap);
+            close_error_trap(&trap);
+            XCloseDisplay(platform->display);
+
+            free(platform);
+
+            return NULL;
+        }
+    }
+
+    stage = begin_trace();
+#ifdef OPENGL_CONTEXT_XCB
+    const bool atoms = receive_atoms(platform, atom_cookies);
+    end_trace("xcb_intern_atom", stage);
+#else
+    platform->wm_delete_window = XInternAtom(platform->display,
+        "WM_DELETE_WINDOW", False);
+    platform->net_wm_sync_request = XInternAtom(platform->display,
+        "_NET_WM_SYNC_REQUEST", False);
+    platform->net_wm_sync_request_counter = XInternAtom(platform->display,
+        "_NET_WM_SYNC_REQUEST_COUNTER", False);
+    end_trace("XInternAtom", stage);
+    const bool atoms = !has_trapped_error(&trap);
+#endif
+    if (!atoms) {
+        fprintf(stderr, "[ERROR] Failed to create atom.\n");
+
+        end_trapped_calls(&trap);
+        close_error_trap(&trap);
+        free(platform->candidates);
+        XCloseDisplay(platform->display);
+
+        free(platform);
+
+        return NULL;
+    }
+
+    if (platform->has_glx) {
+        stage = begin_trace();
+        load_glx_extensions(platform);
+        end_trace("load_glx_extensions", stage);
+    }
+
+    int sync_event_base, sync_error_base;
+    int sync_major_version, sync_minor_version;
+    platform->has_sync = XSyncQueryExtension(platform->display,
+        &sync_event_base, &sync_error_base) && XSyncInitialize(
+        platform->display, &sync_major_version, &sync_minor_version);
+
+    end_trapped_calls(&trap);
+    close_error_trap(&trap);
+
+    platform->references = 1;
+
+    return platform;
+}
+
+/**
+ * Gets the shared platform context, opening it on first use. Can be called
+ * from any thread.
+ * 
+ * \return Platform context.
+ */
+static platform* acquire_platform(void) {
+    lock_platform();
+
+    if (shared_platform) {
+        ++shared_platform->references;
+    } else {
+        shared_platform = open_platform();
+    }
+
+    platform* platform = shared_platform;
+
+    unlock_platform();
+
+    return platform;
+}
+
+/**
+ * Releases a reference to the shared platform context, closing the display
+ * once the last window is gone.
+ * 
+ * \param[in] platform Platform context.
+ */
+static void release_platform(platform* platform) {
+    lock_platform();
+
+    if (--platform->references) {
+        unlock_platform();
+        return;
+    }
+
+    framebuffer_choice* choice = platform->choices;
+    while (choice) {
+        framebuffer_choice* next = choice->next;
+
+        XFreeColormap(platform->display, choice->colormap);
+        XFree(choice->visual_info);
+        free(choice);
+
+        choice = next;
+    }
+
+    if (platform->software_choice) {
+        XFree(platform->software_choice->visual_info);
+        free(platform->software_choice);
+    }
+
+    free(platform->candidates);
+    XCloseDisplay(platform->display);
+
+    free(platform);
+
+    shared_platform = NULL;
+
+    unlock_platform();
+}
+
+/**
+ * Creates a core profile context for a specific version, with the debug or
+ * no-error flag the window asked for.
+ * 
+ * \param[in] window Window.
+ * \param[in] share_context Context to share objects with.
+ * \param[in] version Context version.
+ * \return New context.
+ */
+static GLXContext create_core_context(window* window,
+    GLXContext share_context, version version) {
+    int context_attributes[] = {
+        GLX_CONTEXT_MAJOR_VERSION_ARB, version.major,
+        GLX_CONTEXT_MINOR_VERSION_ARB, version.minor,
+        GLX_CONTEXT_PROFILE_MASK_ARB, GLX_CONTEXT_CORE_PROFILE_BIT_ARB,
+        None, None,
+        None
+    };
+
+    if (window->errors == GL_ERRORS_DEBUG) {
+        context_attributes[6] = GLX_CONTEXT_FLAGS_ARB;
+        context_attributes[7] = GLX_CONTEXT_DEBUG_BIT_ARB;
+    } else if (window->errors == GL_ERRORS_NONE
+        && window->platform->no_error) {
+        context_attributes[6] = GLX_CONTEXT_OPENGL_NO_ERROR_ARB;
+        context_attributes[7] = True;
+    }
+
+    return window->platform->glXCreateContextAttribsARB(window->display,
+        window->framebuffer->config, share_context, True,
+        context_attributes);
+}
+
+/**
+ * Creates the highest version context the driver supports. The version found
+ * by an earlier probe is tried first. Otherwise a 3.2 core context is created
+ * and its actual version read back, since drivers return the highest
+ * compatible version for it, and the old descending search is only used when
+ * the driver returned exactly what was asked for or has no core profile.
+ * 
+ * \param[in] window Window.
+ * \param[in] share_context Context to share objects with.
+ * \param[in] cached Version found by an earlier probe, or zero.
+ */
+static void create_versioned_context(window* window,
+    GLXContext share_context, version cached) {
+    const version versions[] = {
+        { 4, 6 },
+        { 4, 5 },
+        { 4, 4 },
+        { 4, 3 },
+        { 4, 2 },
+        { 4, 1 },
+        { 4, 0 },
+        { 3, 3 },
+        { 3, 2 },
+        { 3, 1 },
+        { 3, 0 },
+        { 2, 1 },
+        { 2, 0 },
+        { 1, 5 },
+        { 1, 4 },
+        { 1, 3 },
+        { 1, 2 },
+        { 1, 1 },
+        { 1, 0 }
+    };
+
+    const int version_count = sizeof(versions) / sizeof(version);
+    const int probe_index = 8;
+
+    if (cached.major) {
+        window->context = create_core_context(window, share_context, cached);
+        if (window->context) {
+            return;
+        }
+    }
+
+    window->context = create_core_context(window, share_context,
+        versions[probe_index]);
+    if (window->context) {
+        version probed = { 0, 0 };
+        if (glXMakeCurrent(window->display, window->window, window->context)) {
+            parse_version((const char*) glGetString(GL_VERSION), &probed);
+            glXMakeCurrent(window->display, None, NULL);
+        }
+
+        if (probed.major != versions[probe_index].major
+            || probed.minor != versions[probe_index].minor) {
+            return;
+        }
+
+        for (int i = 0; i < probe_index; ++i) {
+            GLXContext context =
+                create_core_context(window, share_context, versions[i]);
+            if (context) {
+                glXDestroyContext(window->display, window->context);
+                window->context = context;
+                return;
+            }
+        }
+
+        return;
+    }
+
+    for (int i = probe_index + 1; i < version_count; ++i) {
+        window->context =
+            create_core_context(window, share_context, versions[i]);
+        if (window->context) {
+            return;
+        }
+    }
+}
+
+/**
+ * Picks the most precise present timing the driver offers for a window and
+ * sets up its vblank model. Drivers can list GLX_OML_sync_control without
+ * being able to report sync values, as under Xvfb, so it is only used once a
+ * query succeeds. Windows presenting through the X Present extension take
+ * their timing from its completion events instead.
+ * 
+ * \param[in] window Window.
+ */
+static void set_up_present_timing(window* window) {
+    reset_vblank_model(&window->vblank);
+    window->timing_source = PRESENT_TIMING_SOFTWARE;
+
+    if (window->headless || window->software) {
+        return;
+    }
+
+#ifdef OPENGL_CONTEXT_WAYLAND
+    if (window->wayland) {
+        return;
+    }
+#endif
+
+#ifdef OPENGL_CONTEXT_PRESENT
+    if (window->chain) {
+        window->timing_source = PRESENT_TIMING_PRESENT_EVENT;
+        return;
+    }
+#endif
+
+    const platform* platform = window->platform;
+
+    int64_t ust, msc, sbc;
+    if (platform->glXGetSyncValuesOML && platform->glXGetSyncValuesOML(
+        window->display, window->window, &ust, &msc, &sbc)) {
+        window->timing_source = PRESENT_TIMING_SYNC_CONTROL;
+        window->present.sbc = (uint64_t) sbc;
+
+        int32_t numerator, denominator;
+        if (platform->glXGetMscRateOML && platform->glXGetMscRateOML(
+            window->display, window->window, &numerator, &denominator)
+            && numerator > 0 && denominator > 0) {
+            set_vblank_period(&window->vblank,
+                (uint64_t) denominator * 1000000000 / (uint64_t) numerator);
+        }
+
+        observe_vblank(&window->vblank, (uint64_t) ust * 1000,
+            (uint64_t) msc);
+    } else if (platform->swap_event) {
+        glXSelectEvent(window->display, window->window,
+            GLX_BUFFER_SWAP_COMPLETE_INTEL_MASK);
+        window->timing_source = PRESENT_TIMING_SWAP_EVENT;
+    }
+}
+
+#ifndef OPENGL_CONTEXT_XCB
+/**
+ * Creates, names and maps the X window of a window one Xlib call at a time.
+ * Nothing is left behind on failure.
+ * 
+ * \param[in] window Window.
+ * \param[in] settings Window settings.
+ * \param[in] trap Error trap for the requests.
+ * \return Whether the X window was created.
+ */
+static bool create_native_window(window* window,
+    const window_settings* settings, error_trap* trap) {
+    const platform* platform = window->platform;
+    const framebuffer_choice* framebuffer = window->framebuffer;
+
+    const Window parent = RootWindow(window->display, platform->screen);
+
+    XSetWindowAttributes window_attributes = {
+        0,
+        BlackPixel(window->display, platform->screen),
+        0,
+        0,
+        0,
+        0,
+        0,
+        0,
+        0,
+        0,
+        WINDOW_EVENT_MASK,
+        0,
+        0,
+        framebuffer->colormap,
+        0
+    };
+
+    uint64_t stage = begin_trace();
+    begin_trapped_calls(trap);
+    window->window = XCreateWindow(window->display, parent, 0, 0,
+        settings->width, settings->height, 0, framebuffer->visual_info->depth,
+        InputOutput, framebuffer->visual_info->visual,
+        CWBackPixel | CWEventMask | CWColormap, &window_attributes);
+    end_trapped_calls(trap);
+    end_trace("XCreateWindow", stage);
+    if (has_trapped_error(trap)) {
+        fprintf(stderr, "[ERROR] Failed to create window.\n");
+        return false;
+    }
+
+    stage = begin_trace();
+    begin_trapped_calls(trap);
+    XStoreName(window->display, window->window, settings->title);
+    end_trapped_calls(trap);
+    end_trace("XStoreName", stage);
+    if (has_trapped_error(trap)) {
+        fprintf(stderr, "[ERROR] Failed to set window title.\n");
+
+        XDestroyWindow(window->display, window->window);
+
+        return false;
+    }
+
+    Atom protocols[] = {
+        platform->wm_delete_window,
+        platform->net_wm_sync_request
+    };
+    int protocol_count = 1;
+
+    if (settings->sync_resize && platform->has_sync) {
+        XSyncValue zero;
+        XSyncIntToValue(&zero, 0);
+
+        begin_trapped_calls(trap);
+        window->sync_counter = XSyncCreateCounter(window->display, zero);
+        XChangeProperty(window->display, window->window,
+            platform->net_wm_sync_request_counter, XA_CARDINAL, 32,
+            PropModeReplace, (const unsigned char*) &window->sync_counter, 1);
+        end_trapped_calls(trap);
+
+        ++protocol_count;
+    } else if (settings->sync_resize) {
+        printf("[INFO] Resizes will not be synchronized; the X server lacks "
+            "the SYNC extension.\n");
+    }
+
+    stage = begin_trace();
+    begin_trapped_calls(trap);
+    const Bool result = XSetWMProtocols(window->display, window->window,
+        protocols, protocol_count);
+    end_trapped_calls(trap);
+    end_trace("XSetWMProtocols", stage);
+    if (!result || has_trapped_error(trap)) {
+        fprintf(stderr, "[ERROR] Failed to set window protocol.\n");
+
+        if (window->sync_counter) {
+            XSyncDestroyCounter(window->display, window->sync_counter);
+        }
+
+        XDestroyWindow(window->display, window->window);
+
+        return false;
+    }
+
+    stage = begin_trace();
+    begin_trapped_calls(trap);
+    XMapWindow(window->display, window->window);
+    end_trapped_calls(trap);
+    end_trace("XMapWindow", stage);
+    if (has_trapped_error(trap)) {
+        fprintf(stderr, "[ERROR] Failed to map window.\n");
+
+        XDestroyWindow(window->display, window->window);
+
+        if (window->sync_counter) {
+            XSyncDestroyCounter(window->display, window->sync_counter);
+        }
+
+        return false;
+    }
+
+    return true;
+}
+#else
+/**
+ * Creates, names and maps the X window of a window. Every request is sent
+ * before any reply is read, so the whole setup costs one round trip, and
+ * each request is checked on its own cookie. Nothing is left behind on
+ * failure.
+ * 
+ * \param[in] window Window.
+ * \param[in] settings Window settings.
+ * \param[in] trap Error trap for the requests sent through Xlib.
+ * \return Whether the X window was created.
+ */
+static bool create_native_window(window* window,
+    const window_settings* settings, error_trap* trap) {
+    const platform* platform = window->platform;
+    const framebuffer_choice* framebuffer = window->framebuffer;
+    xcb_connection_t* connection = platform->connection;
+
+    const uint32_t window_values[] = {
+        (uint32_t) BlackPixel(window->display, platform->screen),
+        WINDOW_EVENT_MASK,
+        (uint32_t) framebuffer->colormap
+    };
+
+    window_request requests[5];
+    int request_count = 0;
+
+    uint64_t stage = begin_trace();
+
+    window->window = xcb_generate_id(connection);
+    requests[request_count++] = (window_request) {
+        xcb_create_window_checked(connection,
+            (uint8_t) framebuffer->visual_info->depth,
+            (xcb_window_t) window->window,
+            (xcb_window_t) RootWindow(window->display, platform->screen), 0,
+            0, (uint16_t) settings->width, (uint16_t) settings->height, 0,
+            XCB_WINDOW_CLASS_INPUT_OUTPUT,
+            (xcb_visualid_t) framebuffer->visual_info->visualid,
+            XCB_CW_BACK_PIXEL | XCB_CW_EVENT_MASK | XCB_CW_COLORMAP,
+            window_values),
+        "create window"
+    };
+
+    requests[request_count++] = (window_request) {
+        xcb_change_property_checked(connection, XCB_PROP_MODE_REPLACE,
+            (xcb_window_t) window->window, XCB_ATOM_WM_NAME, XCB_ATOM_STRING,
+            8, (uint32_t) strlen(settings->title), settings->title),
+        "set window title"
+    };
+
+    uint32_t protocols[] = {
+        (uint32_t) platform->wm_delete_window,
+        (uint32_t) platform->net_wm_sync_request
+    };
+    uint32_t protocol_count = 1;
+
+    if (settings->sync_resize && platform->has_sync) {
+        XSyncValue zero;
+        XSyncIntToValue(&zero, 0);
+
+        // The counter is created through Xlib, which flushes it ahead of the
+        // XCB requests that follow.
+        begin_trapped_calls(trap);
+        window->sync_counter = XSyncCreateCounter(window->display, zero);
+        end_trapped_calls(trap);
+
+        const uint32_t counter = (uint32_t) window->sync_counter;
+        requests[request_count++] = (window_request) {
+            xcb_change_property_checked(connection, XCB_PROP_MODE_REPLACE,
+                (xcb_window_t) window->window,
+                (xcb_atom_t) platform->net_wm_sync_request_counter,
+                XCB_ATOM_CARDINAL, 32, 1, &counter),
+            "set window sync counter"
+        };
+
+        ++protocol_count;
+    } else if (settings->sync_resize) {
+        printf("[INFO] Resizes will not be synchronized; the X server lacks "
+            "the SYNC extension.\n");
+    }
+
+    requests[request_count++] = (window_request) {
+        xcb_change_property_checked(connection, XCB_PROP_MODE_REPLACE,
+            (xcb_window_t) window->window,
+            (xcb_atom_t) platform->wm_protocols, XCB_ATOM_ATOM, 32,
+            protocol_count, protocols),
+        "set window protocol"
+    };
+
+    requests[request_count++] = (window_request) {
+        xcb_map_window_checked(connection, (xcb_window_t) window->window),
+        "map window"
+    };
+
+    end_trace("xcb_create_window_checked", stage);
+
+    // Every cookie is checked, even after a failure, so no error is left
+    // queued on the connection.
+    stage = begin_trace();
+
+    int failed = -1;
+    for (int i = 0; i < request_count; ++i) {
+        xcb_generic_error_t* request_error =
+            xcb_request_check(connection, requests[i].cookie);
+        if (request_error) {
+            if (failed < 0) {
+                failed = i;
+            }
+
+            free(request_error);
+        }
+    }
+
+    end_trace("xcb_request_check", stage);
+
+    if (failed >= 0) {
+        fprintf(stderr, "[ERROR] Failed to %s.\n", requests[failed].failure);
+
+        if (failed > 0) {
+            XDestroyWindow(window->display, window->window);
+        }
+
+        if (window->sync_counter) {
+            XSyncDestroyCounter(window->display, window->sync_counter);
+        }
+
+        return false;
+    }
+
+    return true;
+}
+#endif
+
+#ifdef OPENGL_CONTEXT_PRESENT
+/**
+ * Moves a window's rendering into a pool of pixmaps presented through the X
+ * Present extension and makes its context current on the first of them. The
+ * window keeps swapping buffers if the server cannot present pixmaps.
+ * 
+ * \param[in] window Window.
+ * \param[in] mode Present mode.
+ */
+static void set_up_present_chain(window* window, present_mode mode) {
+    error_trap trap;
+    open_error_trap(&trap, window->display);
+
+    begin_trapped_calls(&trap);
+    present_chain* chain = create_present_chain(window->display,
+        window->window, window->framebuffer->config,
+        window->framebuffer->visual_info->depth, window->width,
+        window->height, mode);
+    end_trapped_calls(&trap);
+
+    if (close_error_trap(&trap) && chain) {
+        destroy_present_chain(chain);
+        chain = NULL;
+    }
+
+    if (chain && !glXMakeCurrent(window->display, get_present_drawable(chain),
+        window->context)) {
+        glXMakeCurrent(window->display, window->window, window->context);
+        destroy_present_chain(chain);
+        chain = NULL;
+    }
+
+    if (!chain) {
+        printf("[INFO] Presenting with buffer swaps instead of the Present "
+            "extension.\n");
+        return;
+    }
+
+    window->chain = chain;
+}
+#endif
+
+/**
+ * Allocates a zeroed window.
+ * 
+ * \return New window.
+ */
+static window* allocate_window(void) {
+    window* window = malloc(sizeof(struct window));
+    memset(window, 0, sizeof(struct window));
+
+    pthread_mutex_init(&window->state_mutex, NULL);
+
+    return window;
+}
+
+/**
+ * Frees a window allocated by allocate_window().
+ * 
+ * \param[in] window Window.
+ */
+static void free_window(window* window) {
+    pthread_mutex_destroy(&window->state_mutex);
+    free(window);
+}
+
+/**
+ * Gets the size of a window as of the last poll. Can be called from any
+ * thread.
+ * 
+ * \param[in] window Window.
+ * \param[out] width Window width.
+ * \param[out] height Window height.
+ */
+static void get_window_size(window* window, unsigned* width,
+    unsigned* height) {
+    pthread_mutex_lock(&window->state_mutex);
+    *width = window->width;
+    *height = window->height;
+    pthread_mutex_unlock(&window->state_mutex);
+}
+
+/**
+ * Gets the size of a window for the thread that swaps. The damage history and
+ * back buffer state are dropped when the size changed since they were
+ * recorded, so only that thread ever touches them.
+ * 
+ * \param[in] window Window.
+ * \param[out] width Window width.
+ * \param[out] height Window height.
+ */
+static void get_swap_size(window* window, unsigned* width,
+    unsigned* height) {
+    get_window_size(window, width, height);
+
+    if (*width != window->damage_width || *height != window->damage_height) {
+        window->damage_width = *width;
+        window->damage_height = *height;
+
+        clear_damage(&window->damage);
+        window->back_buffer_current = false;
+    }
+}
+
+/**
+ * Creates a headless window, which renders offscreen and receives no events.
+ * 
+ * \param[in] settings Window settings.
+ * \return New window.
+ */
+static window* create_headless(const window_settings* settings) {
+    const uint64_t start = begin_trace();
+
+    if (settings->share && !settings->share->headless) {
+        fprintf(stderr, "[ERROR] Headless windows can only share with other "
+            "headless windows.\n");
+        return NULL;
+    }
+
+    window* window = allocate_window();
+
+    window->width = settings->width;
+    window->height = settings->height;
+    window->headless = create_headless_window(settings,
+        settings->share ? settings->share->headless : NULL);
+    if (!window->headless) {
+        free_window(window);
+        return NULL;
+    }
+
+    window->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (window->wake_fd < 0) {
+        fprintf(stderr, "[ERROR] Failed to create wake event.\n");
+
+        destroy_headless_window(window->headless);
+
+        free_window(window);
+
+        return NULL;
+    }
+
+    parse_version((const char*) glGetString(GL_VERSION), &window->version);
+
+    set_up_present_timing(window);
+
+    if (settings->loading != GL_LOADING_NONE) {
+        window->gl = create_gl_dispatch(window, settings->loading);
+        set_current_gl_dispatch(window->gl);
+    }
+
+    if (settings->errors == GL_ERRORS_DEBUG) {
+        window->debug = create_debug_output(window, settings->debug_callback,
+            settings->debug_user_data);
+    }
+
+    end_trace("create_window", start);
+
+    printf("[INFO] Headless window created.\n");
+    printf("[INFO] OpenGL version: %s\n", glGetString(GL_VERSION));
+    printf("[INFO] OpenGL renderer: %s\n", glGetString(GL_RENDERER));
+    printf("[INFO] OpenGL vendor: %s\n", glGetString(GL_VENDOR));
+
+    return window;
+}
+
+#ifdef OPENGL_CONTEXT_WAYLAND
+/**
+ * Creates a native window on the Wayland compositor, which paces its presents
+ * with frame callbacks.
+ * 
+ * \param[in] settings Window settings.
+ * \return New window.
+ */
+static window* create_wayland(const window_settings* settings) {
+    const uint64_t start = begin_trace();
+
+    if (settings->share && !settings->share->wayland) {
+        fprintf(stderr, "[ERROR] Wayland windows can only share with other "
+            "Wayland windows.\n");
+        return NULL;
+    }
+
+    window* window = allocate_window();
+
+    window->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (window->wake_fd < 0) {
+        fprintf(stderr, "[ERROR] Failed to create wake event.\n");
+
+        free_window(window);
+
+        return NULL;
+    }
+
+    window->wayland = create_wayland_window(settings,
+        settings->share ? settings->share->wayland : NULL, &window->events,
+        &window->state_mutex);
+    if (!window->wayland) {
+        close(window->wake_fd);
+
+        free_window(window);
+
+        return NULL;
+    }
+
+    // The compositor's first configure can already have changed the size.
+    get_wayland_window_state(window->wayland, &window->width,
+        &window->height);
+
+    parse_version((const char*) glGetString(GL_VERSION), &window->version);
+
+    set_up_present_timing(window);
+
+    if (settings->loading != GL_LOADING_NONE) {
+        window->gl = create_gl_dispatch(window, settings->loading);
+        set_current_gl_dispatch(window->gl);
+    }
+
+    if (settings->errors == GL_ERRORS_DEBUG) {
+        window->debug = create_debug_output(window, settings->debug_callback,
+            settings->debug_user_data);
+    }
+
+    end_trace("create_window", start);
+
+    printf("[INFO] Wayland window created.\n");
+    printf("[INFO] OpenGL version: %s\n", glGetString(GL_VERSION));
+
+    return window;
+}
+#endif
+
+/**
+ * Creates the software surface of a window. If the X server cannot attach
+ * shared memory, as when it runs on another machine, the surface is created
+ * again without it.
+ * 
+ * \param[in] window Window.
+ * \param[in] width Surface width.
+ * \param[in] height Surface height.
+ * \param[in] shared Whether to try MIT-SHM.
+ * \return New software surface.
+ */
+static software_surface* create_surface(window* window, unsigned width,
+    unsigned height, bool shared) {
+    error_trap trap;
+    open_error_trap(&trap, window->display);
+
+    begin_trapped_calls(&trap);
+    software_surface* surface = create_software_surface(window->display,
+        window->window, window->framebuffer->visual_info, width,
+        height, shared);
+    end_trapped_calls(&trap);
+
+    if (!close_error_trap(&trap) || !surface
+        || !is_software_surface_shared(surface)) {
+        return surface;
+    }
+
+    printf("[INFO] Falling back to XPutImage; the X server could not attach "
+        "shared memory.\n");
+
+    open_error_trap(&trap, window->display);
+    begin_trapped_calls(&trap);
+    destroy_software_surface(surface);
+    end_trapped_calls(&trap);
+    close_error_trap(&trap);
+
+    return create_surface(window, width, height, false);
+}
+
+/**
+ * Creates a software window, which presents a CPU framebuffer and has no
+ * context.
+ * 
+ * \param[in] settings Window settings.
+ * \return New window.
+ */
+static window* create_software(const window_settings* settings) {
+    const uint64_t start = begin_trace();
+
+    uint64_t stage = begin_trace();
+    platform* platform = acquire_platform();
+    end_trace("acquire_platform", stage);
+    if (!platform) {
+        return NULL;
+    }
+
+    error_trap trap;
+    open_error_trap(&trap, platform->display);
+
+    lock_platform();
+    begin_trapped_calls(&trap);
+    const framebuffer_choice* framebuffer =
+        choose_software_framebuffer(platform);
+    end_trapped_calls(&trap);
+    unlock_platform();
+    if (!framebuffer || has_trapped_error(&trap)) {
+        close_error_trap(&trap);
+        release_platform(platform);
+
+        return NULL;
+    }
+
+    window* window = allocate_window();
+
+    window->platform = platform;
+    window->framebuffer = framebuffer;
+    window->display = platform->display;
+    window->width = settings->width;
+    window->height = settings->height;
+
+    if (!create_native_window(window, settings, &trap)) {
+        close_error_trap(&trap);
+        release_platform(platform);
+
+        free_window(window);
+
+        return NULL;
+    }
+
+    if (close_error_trap(&trap)) {
+        fprintf(stderr, "[ERROR] Failed to create window.\n");
+
+        XDestroyWindow(window->display, window->window);
+
+        if (window->sync_counter) {
+            XSyncDestroyCounter(window->display, window->sync_counter);
+        }
+
+        release_platform(platform);
+
+        free_window(window);
+
+        return NULL;
+    }
+
+    // OPENGL_CONTEXT_SHM set to 0 sends every frame with XPutImage.
+    const char* shm = getenv("OPENGL_CONTEXT_SHM");
+
+    stage = begin_trace();
+    window->software = create_surface(window, window->width, window->height,
+        !shm || strcmp(shm, "0"));
+    end_trace("create_surface", stage);
+
+    window->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (!window->software || window->wake_fd < 0) {
+        fprintf(stderr, "[ERROR] Failed to create software window.\n");
+
+        if (window->wake_fd >= 0) {
+            close(window->wake_fd);
+        }
+
+        if (window->software) {
+            destroy_software_surface(window->software);
+        }
+
+        XUnmapWindow(window->display, window->window);
+        XDestroyWindow(window->display, window->window);
+
+        if (window->sync_counter) {
+            XSyncDestroyCounter(window->display, window->sync_counter);
+        }
+
+        release_platform(platform);
+
+        free_window(window);
+
+        return NULL;
+    }
+
+    set_up_present_timing(window);
+
+    XSaveContext(window->display, window->window, window_context,
+        (XPointer) window);
+
+    end_trace("create_window", start);
+
+    printf("[INFO] Software window created.\n");
+    printf("[INFO] Presenting with %s.\n",
+        is_software_surface_shared(window->software)
+        ? "MIT-SHM" : "XPutImage");
+
+    return window;
+}
+
+/**
+ * Creates a window.
+ * 
+ * \param[in] title Window title.
+ * \param[in] width Window width.
+ * \param[in] height Window height.
+ * \return New window.
+ */
+window* create_window(const char* title, unsigned width, unsigned height) {
+    const window_settings settings = {
+        title, width, height, NULL, { 0 }, WINDOW_BACKEND_NATIVE
+    };
+
+    return create_window_with_settings(&settings);
+}
+
+/**
+ * Creates a window. What each setting does is described on window_settings.
+ * 
+ * \param[in] settings Window settings.
+ * \return New window.
+ */
+window* create_window_with_settings(const window_settings* settings) {
+    if (settings->backend == WINDOW_BACKEND_HEADLESS) {
+        return create_headless(settings);
+    }
+
+    if (settings->backend == WINDOW_BACKEND_SOFTWARE) {
+        return create_software(settings);
+    }
+
+#ifdef OPENGL_CONTEXT_WAYLAND
+    // A compositor that cannot be reached leaves native windows on X11,
+    // unless Wayland was asked for by name.
+    if (use_wayland()) {
+        window* window = create_wayland(settings);
+        if (window || requires_wayland()) {
+            return window;
+        }
+
+        printf("[INFO] The window will use X11; it could not be created on "
+            "Wayland.\n");
+    }
+#endif
+
+    bool native_share = settings->share && !settings->share->headless
+        && !settings->share->software;
+#ifdef OPENGL_CONTEXT_WAYLAND
+    native_share = native_share && !settings->share->wayland;
+#endif
+
+    if (settings->share && !native_share) {
+        fprintf(stderr, "[ERROR] Native windows can only share with other "
+            "native windows.\n");
+        return NULL;
+    }
+
+    const uint64_t start = begin_trace();
+
+    uint64_t stage = begin_trace();
+    platform* platform = acquire_platform();
+    end_trace("acquire_platform", stage);
+    if (!platform) {
+        return NULL;
+    }
+
+    if (!platform->has_glx) {
+        fprintf(stderr, "[ERROR] The display does not support GLX.\n");
+
+        release_platform(platform);
+
+        return NULL;
+    }
+
+    error_trap trap;
+    open_error_trap(&trap, platform->display);
+
+    stage = begin_trace();
+    lock_platform();
+    begin_trapped_calls(&trap);
+    const framebuffer_choice* framebuffer =
+        choose_framebuffer(platform, &settings->framebuffer);
+    end_trapped_calls(&trap);
+    unlock_platform();
+    end_trace("choose_framebuffer", stage);
+    if (!framebuffer || has_trapped_error(&trap)) {
+        fprintf(stderr,
+            "[ERROR] Failed to choose a framebuffer configuration.\n");
+
+        close_error_trap(&trap);
+        release_platform(platform);
+
+        return NULL;
+    }
+
+    window* window = allocate_window();
+
+    window->platform = platform;
+    window->framebuffer = framebuffer;
+    window->display = platform->display;
+    window->errors = settings->errors;
+    window->width = settings->width;
+    window->height = settings->height;
+    window->swaps_since_copy = UINT_MAX - 1;
+
+    if (!create_native_window(window, settings, &trap)) {
+        close_error_trap(&trap);
+        release_platform(platform);
+
+        free_window(window);
+
+        return NULL;
+    }
+
+    const GLXContext share_context =
+        settings->share ? settings->share->context : NULL;
+
+    stage = begin_trace();
+
+    if (platform->glXCreateContextAttribsARB) {
+        lock_platform();
+        const version cached = platform->context_version;
+        unlock_platform();
+
+        // Versions the driver lacks fail with errors of their own, which are
+        // expected and kept apart from the window's.
+        error_trap probe_trap;
+        open_error_trap(&probe_trap, window->display);
+        begin_trapped_calls(&probe_trap);
+        create_versioned_context(window, share_context, cached);
+        end_trapped_calls(&probe_trap);
+        close_error_trap(&probe_trap);
+    } else if (((platform->major_version == 1)
+        && (platform->minor_version < 3)) || (platform->major_version < 1)) {
+        begin_trapped_calls(&trap);
+        window->context = glXCreateContext(window->display,
+            framebuffer->visual_info, share_context, True);
+        end_trapped_calls(&trap);
+    } else {
+        begin_trapped_calls(&trap);
+        window->context = glXCreateNewContext(window->display,
+            framebuffer->config, GLX_RGBA_TYPE, share_context, True);
+        end_trapped_calls(&trap);
+    }
+
+    end_trace("create_versioned_context", stage);
+
+    if (settings->errors == GL_ERRORS_NONE && !platform->no_error) {
+        printf("[INFO] Errors will be checked; the driver cannot create "
+            "no-error contexts.\n");
+    }
+
+    if (!window->context || has_trapped_error(&trap)) {
+        fprintf(stderr, "[ERROR] Failed to create context.\n");
+
+        close_error_trap(&trap);
+        XUnmapWindow(window->display, window->window);
+        XDestroyWindow(window->display, window->window);
+
+        if (window->sync_counter) {
+            XSyncDestroyCounter(window->display, window->sync_counter);
+        }
+
+        release_platform(platform);
+
+        free_window(window);
+
+        return NULL;
+    }
+
+    stage = begin_trace();
+    begin_trapped_calls(&trap);
+    const Bool result =
+        glXMakeCurrent(window->display, window->window, window->context);
+    end_trapped_calls(&trap);
+    end_trace("glXMakeCurrent", stage);
+
+    // Closing the trap waits for the errors of every request sent so far,
+    // including ones the checks above were too early to see.
+    if (close_error_trap(&trap) || !result) {
+        fprintf(stderr, "[ERROR] Failed to set context.\n");
+
+        if (result) {
+            glXMakeCurrent(window->display, None, NULL);
+        }
+
+        glXDestroyContext(window->display, window->context);
+        XUnmapWindow(window->display, window->window);
+        XDestroyWindow(window->display, window->window);
+
+        if (window->sync_counter) {
+            XSyncDestroyCounter(window->display, window->sync_counter);
+        }
+
+        release_platform(platform);
+
+        free_window(window);
+
+        return NULL;
+    }
+
+    parse_version((const char*) glGetString(GL_VERSION), &window->version);
+
+    lock_platform();
+
+    const bool version_changed = platform->glXCreateContextAttribsARB
+        && (window->version.major != platform->context_version.major
+        || window->version.minor != platform->context_version.minor);
+    if (version_changed) {
+        platform->context_version = window->version;
+    }
+
+    unlock_platform();
+
+    // The cache file is written outside the lock so other threads creating
+    // windows do not wait on file I/O.
+    if (version_changed) {
+        store_cached_version(platform->driver_key, window->version);
+    }
+
+    window->wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (window->wake_fd < 0) {
+        fprintf(stderr, "[ERROR] Failed to create wake event.\n");
+
+        glXMakeCurrent(window->display, None, NULL);
+        glXDestroyContext(window->display, window->context);
+        XUnmapWindow(window->display, window->window);
+        XDestroyWindow(window->display, window->window);
+
+        if (window->sync_counter) {
+            XSyncDestroyCounter(window->display, window->sync_counter);
+        }
+
+        release_platform(platform);
+
+        free_window(window);
+
+        return NULL;
+    }
+
+#ifdef OPENGL_CONTEXT_PRESENT
+    if (settings->present_mode != PRESENT_MODE_SWAP) {
+        set_up_present_chain(window, settings->present_mode);
+    }
+#endif
+
+    set_up_present_timing(window);
+
+    if (settings->loading != GL_LOADING_NONE) {
+        window->gl = create_gl_dispatch(window, settings->loading);
+        set_current_gl_dispatch(window->gl);
+    }
+
+    if (settings->errors == GL_ERRORS_DEBUG) {
+        window->debug = create_debug_output(window, settings->debug_callback,
+            settings->debug_user_data);
+    }
+
+    XSaveContext(window->display, window->window, window_context,
+        (XPointer) window);
+
+    end_trace("create_window", start);
+
+    printf("[INFO] Window created.\n");
+    printf("[INFO] OpenGL version: %s\n", glGetString(GL_VERSION));
+    printf("[INFO] OpenGL renderer: %s\n", glGetString(GL_RENDERER));
+    printf("[INFO] OpenGL vendor: %s\n", glGetString(GL_VENDOR));
+
+    return window;
+}
+
+/**
+ * Destroys a window.
+ * 
+ * \param[in] window Window.
+ */
+void destroy_window(window* window) {
+    const uint64_t start = begin_trace();
+
+    if (window->gl) {
+        destroy_gl_dispatch(window->gl);
+    }
+
+    if (window->headless) {
+        close(window->wake_fd);
+        destroy_headless_window(window->headless);
+
+        if (window->debug) {
+            destroy_debug_output(window->debug);
+        }
+
+        free_window(window);
+
+        end_trace("destroy_window", start);
+
+        printf("[INFO] Window destroyed.\n");
+
+        return;
+    }
+
+#ifdef OPENGL_CONTEXT_WAYLAND
+    if (window->wayland) {
+        close(window->wake_fd);
+        destroy_wayland_window(window->wayland);
+
+        if (window->debug) {
+            destroy_debug_output(window->debug);
+        }
+
+        free_window(window);
+
+        end_trace("destroy_window", start);
+
+        printf("[INFO] Window destroyed.\n");
+
+        return;
+    }
+#endif
+
+    // Once the context is gone no other thread can route events here.
+    XLockDisplay(window->display);
+    XDeleteContext(window->display, window->window, window_context);
+    XUnlockDisplay(window->display);
+
+    close(window->wake_fd);
+
+    if (window->software) {
+        destroy_software_surface(window->software);
+    } else {
+        if (glXGetCurrentContext() == window->context) {
+            glXMakeCurrent(window->display, None, NULL);
+        }
+
+#ifdef OPENGL_CONTEXT_PRESENT
+        if (window->chain) {
+            destroy_present_chain(window->chain);
+        }
+#endif
+
+        glXDestroyContext(window->display, window->context);
+    }
+    XUnmapWindow(window->display, window->window);
+    XDestroyWindow(window->display, window->window);
+
+    if (window->sync_counter) {
+        XSyncDestroyCounter(window->display, window->sync_counter);
+    }
+
+    release_platform(window->platform);
+
+    if (window->debug) {
+        destroy_debug_output(window->debug);
+    }
+
+    free_window(window);
+
+    end_trace("destroy_window", start);
+
+    printf("[INFO] Window destroyed.\n");
+}
+
+/**
+ * Gets the version of the window's context.
+ * 
+ * \param[in] window Window.
+ * \return Context version.
+ */
+version get_context_version(const window* window) {
+    return window->version;
+}
+
+/**
+ * Makes the window's context current on the calling thread.
+ * 
+ * \param[in] window Window.
+ * \return Whether the context was made current.
+ */
+bool make_current(window* window) {
+    if (window->software) {
+        fprintf(stderr, "[ERROR] Software windows have no context.\n");
+        return false;
+    }
+
+#ifdef OPENGL_CONTEXT_WAYLAND
+    if (window->wayland) {
+        if (!make_wayland_current(window->wayland)) {
+            return false;
+        }
+
+        set_current_gl_dispatch(window->gl);
+
+        return true;
+    }
+#endif
+
+    if (window->headless) {
+        if (!make_headless_current(window->headless)) {
+            return false;
+        }
+    } else {
+        GLXDrawable drawable = window->window;
+
+#ifdef OPENGL_CONTEXT_PRESENT
+        if (window->chain) {
+            drawable = get_present_drawable(window->chain);
+        }
+#endif
+
+        if (!glXMakeCurrent(window->display, drawable, window->context)) {
+            fprintf(stderr, "[ERROR] Failed to set context.\n");
+            return false;
+        }
+    }
+
+    set_current_gl_dispatch(window->gl);
+
+    return true;
+}
+
+/**
+ * Releases the window's context from the calling thread so another thread can
+ * make it current.
+ * 
+ * \param[in] window Window.
+ */
+void release_current(window* window) {
+    set_current_gl_dispatch(NULL);
+
+    if (window->headless) {
+        release_headless_current(window->headless);
+        return;
+    }
+
+#ifdef OPENGL_CONTEXT_WAYLAND
+    if (window->wayland) {
+        release_wayland_current(window->wayland);
+        return;
+    }
+#endif
+
+    if (window->software) {
+        return;
+    }
+
+    glXMakeCurrent(window->display, None, NULL);
+}
+
+#ifdef OPENGL_CONTEXT_WAYLAND
+/**
+ * Takes the size and close request of a Wayland window from its latest
+ * configure.
+ * 
+ * \param[in] window Window.
+ */
+static void sync_wayland_state(window* window) {
+    unsigned width, height;
+    if (get_wayland_window_state(window->wayland, &width, &height)) {
+        window->quit = true;
+    }
+
+    pthread_mutex_lock(&window->state_mutex);
+    window->width = width;
+    window->height = height;
+    pthread_mutex_unlock(&window->state_mutex);
+}
+#endif
+
+/**
+ * Polls events sent to the window. Pending events for other windows on the
+ * same connection are dispatched to them in the same pass, so windows can be
+ * polled on different threads.
+ * 
+ * \param[in] window Window.
+ * \return Whether the application should close.
+ */
+bool poll_events(window* window) {
+    if (window->headless) {
+        return window->quit;
+    }
+
+#ifdef OPENGL_CONTEXT_WAYLAND
+    if (window->wayland) {
+        dispatch_wayland_events(window->wayland, 0, -1);
+        sync_wayland_state(window);
+        return window->quit;
+    }
+#endif
+
+    dispatch_events(window->display);
+
+    return window->quit;
+}
+
+/**
+ * Moves the events decoded by poll_events() and wait_events() into an array,
+ * oldest first. Consecutive motion and resize events are coalesced into the
+ * latest one. Events that do not fit stay queued for the next call.
+ * 
+ * \param[in] window Window.
+ * \param[out] events Array to fill.
+ * \param[in] capacity Size of the array.
+ * \return Number of events written.
+ */
+size_t get_window_events(window* window, window_event* events,
+    size_t capacity) {
+    pthread_mutex_lock(&window->state_mutex);
+    const size_t count = take_events(&window->events, events, capacity);
+    pthread_mutex_unlock(&window->state_mutex);
+
+    return count;
+}
+
+/**
+ * Gets the number of events dropped because the window's event queue was
+ * full. Motion events are given up first and releases are kept.
+ * 
+ * \param[in] window Window.
+ * \return Dropped event count.
+ */
+uint64_t get_dropped_window_events(window* window) {
+    pthread_mutex_lock(&window->state_mutex);
+    const uint64_t count = get_dropped_events(&window->events);
+    pthread_mutex_unlock(&window->state_mutex);
+
+    return count;
+}
+
+/**
+ * Waits for events sent to the window, then polls them. Returns early if
+ * another thread wakes the window.
+ * 
+ * \param[in] window Window.
+ * \param[in] timeout Milliseconds to wait, or a negative value to wait
+ * indefinitely.
+ * \return Whether the application should close.
+ */
+bool wait_events(window* window, int timeout) {
+#ifdef OPENGL_CONTEXT_WAYLAND
+    if (window->wayland) {
+        dispatch_wayland_events(window->wayland, timeout, window->wake_fd);
+        sync_wayland_state(window);
+        return window->quit;
+    }
+#endif
+
+    if (window->headless || !XEventsQueued(window->display, QueuedAfterFlush)) {
+        struct pollfd fds[] = {
+            { window->wake_fd, POLLIN, 0 },
+            { window->headless ? -1 : ConnectionNumber(window->display), POLLIN,
+                0 }
+        };
+
+        if (poll(fds, 2, timeout) > 0 && (fds[0].revents & POLLIN)) {
+            eventfd_t value;
+            eventfd_read(window->wake_fd, &value);
+        }
+    }
+
+    return poll_events(window);
+}
+
+/**
+ * Wakes a window that is waiting for events. Can be called from any thread.
+ * 
+ * \param[in] window Window.
+ */
+void wake_window(window* window) {
+    eventfd_write(window->wake_fd, 1);
+}
+
+/**
+ * Acknowledges a pending resize synchronization request once the frame at the
+ * requested size has been presented, and wakes a thread waiting for events
+ * the swap read off the connection.
+ * 
+ * \param[in] window Window.
+ */
+static void finish_present(window* window) {
+    pthread_mutex_lock(&window->state_mutex);
+
+    const bool configured = window->sync_configured;
+    const XSyncValue value = window->sync_value;
+
+    if (configured) {
+        window->sync_requested = false;
+        window->sync_configured = false;
+    }
+
+    pthread_mutex_unlock(&window->state_mutex);
+
+    // Tell the compositor the frame at the requested size is on its way, so
+    // it can show it and send the next configure.
+    if (configured) {
+        XSyncSetCounter(window->display, window->sync_counter, value);
+        XFlush(window->display);
+    }
+
+    // Xlib reads events into its queue while waiting for replies, so a swap
+    // on another thread can take them after wait_events() found the queue
+    // empty. The socket will not become readable for them again.
+    if (XEventsQueued(window->display, QueuedAlready)) {
+        wake_window(window);
+    }
+}
+
+/**
+ * Counts a present. Under the software model the frame is assumed to reach
+ * the screen at the first vertical blank after the swap.
+ * 
+ * \param[in] window Window.
+ */
+static void record_present(window* window) {
+    ++window->swap_count;
+
+    if (window->timing_source == PRESENT_TIMING_SOFTWARE) {
+        pthread_mutex_lock(&window->state_mutex);
+
+        window->present.time =
+            predict_vblank(&window->vblank, get_time(), &window->present.msc);
+        window->present.sbc = window->swap_count;
+        window->presented = true;
+
+        pthread_mutex_unlock(&window->state_mutex);
+    }
+}
+
+/**
+ * Swaps buffers.
+ * 
+ * \param[in] window Window.
+ */
+void swap_buffer(window* window) {
+    swap_buffer_with_damage(window, NULL, 0);
+}
+
+/**
+ * Gets the age of the back buffer: one if it holds the last presented frame,
+ * n if it holds the frame presented n frames ago, or zero if its contents are
+ * undefined.
+ * 
+ * \param[in] window Window.
+ * \return Buffer age.
+ */
+unsigned get_buffer_age(window* window) {
+    if (window->software) {
+        return get_software_buffer_age(window->software);
+    }
+
+#ifdef OPENGL_CONTEXT_WAYLAND
+    if (window->wayland) {
+        return get_wayland_buffer_age(window->wayland);
+    }
+#endif
+
+#ifdef OPENGL_CONTEXT_PRESENT
+    if (window->chain) {
+        return get_present_buffer_age(window->chain);
+    }
+#endif
+
+    // A resize since the last partial present leaves the back buffer stale.
+    unsigned width, height;
+    get_swap_size(window, &width, &height);
+
+    if (window->headless || window->back_buffer_current) {
+        return 1;
+    }
+
+    if (!window->platform->buffer_age) {
+        return 0;
+    }
+
+    unsigned age = 0;
+    glXQueryDrawable(window->display, window->window, GLX_BACK_BUFFER_AGE_EXT,
+        &age);
+
+    // Partial presents update the front buffer without a swap, so only the
+    // buffer that was front at the time saw them.
+    if (age > window->swaps_since_copy + 1) {
+        return 0;
+    }
+
+    return age;
+}
+
+/**
+ * Gets the region of the back buffer to redraw before presenting new damage.
+ * This is the new damage plus whatever the back buffer missed while older
+ * frames were presented, or the whole framebuffer if its contents are
+ * unknown. Rectangles use OpenGL window coordinates, with the origin at the
+ * bottom left, and can be passed to glScissor().
+ * 
+ * \param[in] window Window.
+ * \param[in] damage Rectangles that change in the next frame.
+ * \param[in] count Number of rectangles.
+ * \return Bounding rectangle of the region to redraw.
+ */
+rect get_repaint_region(window* window, const rect* damage, size_t count) {
+    unsigned width, height;
+    get_swap_size(window, &width, &height);
+
+    const rect bounds = bound_rects(damage, count, width, height);
+
+    return get_stale_region(&window->damage, get_buffer_age(window), bounds,
+        width, height);
+}
+
+/**
+ * Presents a frame that only changed inside the given rectangles. When the
+ * damage covers at most half the window and GLX_MESA_copy_sub_buffer is
+ * available, only the damaged rectangles are copied to the front buffer;
+ * otherwise the buffers are swapped. Partial presents are not synchronized
+ * to the vertical blank. A null damage list means the whole window changed.
+ * 
+ * \param[in] window Window.
+ * \param[in] damage Rectangles that changed, in OpenGL window coordinates.
+ * \param[in] count Number of rectangles.
+ */
+void swap_buffer_with_damage(window* window, const rect* damage,
+    size_t count) {
+    if (window->headless) {
+        swap_headless_buffer(window->headless);
+        record_present(window);
+        return;
+    }
+
+#ifdef OPENGL_CONTEXT_WAYLAND
+    if (window->wayland) {
+        unsigned width, height;
+        get_swap_size(window, &width, &height);
+
+        const rect full = { 0, 0, width, height };
+        const rect bounds =
+            damage ? bound_rects(damage, count, width, height) : full;
+
+        swap_wayland_buffer(window->wayland, damage, count);
+
+        record_damage(&window->damage, bounds);
+        record_present(window);
+
+        return;
+    }
+#endif
+
+    if (window->software) {
+        unsigned width, height;
+        get_software_surface_size(window->software, &width, &height);
+
+        const rect full = { 0, 0, width, height };
+        const rect bounds =
+            damage ? bound_rects(damage, count, width, height) : full;
+
+        // The surface's rows run top down, unlike OpenGL window coordinates.
+        if (bounds.width && bounds.height) {
+            present_software_surface(window->software, bounds.x,
+                (int) height - bounds.y - (int) bounds.height, bounds.width,
+                bounds.height);
+        }
+
+        record_damage(&window->damage, bounds);
+
+        finish_present(window);
+        record_present(window);
+
+        return;
+    }
+
+    unsigned width, height;
+    get_swap_size(window, &width, &height);
+
+    const rect full = { 0, 0, width, height };
+    const rect bounds =
+        damage ? bound_rects(damage, count, width, height) : full;
+
+#ifdef OPENGL_CONTEXT_PRESENT
+    // The next frame renders into another pixmap, sized for the window as of
+    // the last poll.
+    if (window->chain) {
+        const GLXDrawable drawable =
+            swap_present_chain(window->chain, width, height);
+        if (drawable) {
+            glXMakeCurrent(window->display, drawable, window->context);
+        }
+
+        record_damage(&window->damage, bounds);
+
+        finish_present(window);
+        record_present(window);
+
+        return;
+    }
+#endif
+
+    const unsigned long long area = (unsigned long long) width * height;
+    const unsigned long long damaged =
+        (unsigned long long) bounds.width * bounds.height;
+
+    if (window->platform->glXCopySubBufferMESA && damage
+        && damaged * 2 <= area) {
+        for (size_t i = 0; i < count; ++i) {
+            const rect clipped = bound_rects(&damage[i], 1, width, height);
+            if (clipped.width && clipped.height) {
+                window->platform->glXCopySubBufferMESA(window->display,
+                    window->window, clipped.x, clipped.y, (int) clipped.width,
+                    (int) clipped.height);
+            }
+        }
+
+        window->back_buffer_current = true;
+        window->swaps_since_copy = 0;
+    } else {
+        glXSwapBuffers(window->display, window->window);
+
+        window->back_buffer_current = false;
+        if (window->swaps_since_copy < UINT_MAX - 1) {
+            ++window->swaps_since_copy;
+        }
+    }
+
+    record_damage(&window->damage, bounds);
+
+    finish_present(window);
+    record_present(window);
+}
+
+/**
+ * Gets the CPU framebuffer to draw the next frame of a software window into.
+ * It follows the window's size as of the last poll and is presented by
+ * swap_buffer() or swap_buffer_with_damage(), whose rectangles keep their
+ * bottom left origin. Presents do not copy the framebuffer, so this waits
+ * until the display server has finished reading it; get_buffer_age() says
+ * which frame it still holds.
  * 
  * \param[in] window Window.
+ * \param[out] framebuffer Framebuffer.
+ * \return Whether the window has a software framebuffer.
  */
-void swap_buffer(window* window) {
-    glXSwapBuffers(window->display, window->window);
+bool map_software_framebuffer(window* window,
+    software_framebuffer* framebuffer) {
+    if (!window->software) {
+        fprintf(stderr, "[ERROR] Window has no software framebuffer.\n");
+        return false;
+    }
+
+    unsigned window_width, window_height;
+    get_swap_size(window, &window_width, &window_height);
+
+    unsigned width, height;
+    get_software_surface_size(window->software, &width, &height);
+
+    // Surfaces are at least one pixel in each direction.
+    if (width != (window_width ? window_width : 1)
+        || height != (window_height ? window_height : 1)) {
+        software_surface* resized = create_surface(window, window_width,
+            window_height, is_software_surface_shared(window->software));
+        if (!resized) {
+            return false;
+        }
+
+        destroy_software_surface(window->software);
+        window->software = resized;
+
+        get_software_surface_size(window->software, &width, &height);
+    }
+
+    framebuffer->pixels =
+        map_software_surface(window->software, &framebuffer->stride);
+    framebuffer->width = width;
+    framebuffer->height = height;
+    framebuffer->shared = is_software_surface_shared(window->software);
+
+    return true;
+}
+
+/**
+ * Waits until the display server has processed every frame presented on a
+ * software window, with a round trip to the server.
+ * 
+ * \param[in] window Window.
+ * \return Whether the window is a software window.
+ */
+bool finish_software_presents(window* window) {
+    if (!window->software) {
+        fprintf(stderr, "[ERROR] Window has no software framebuffer.\n");
+        return false;
+    }
+
+    XSync(window->display, False);
+
+    return true;
+}
+
+/**
+ * Sets the number of vertical blanks to wait for before a buffer swap. Zero
+ * disables vsync and a negative value requests adaptive vsync.
+ * 
+ * \param[in] window Window.
+ * \param[in] interval Swap interval.
+ * \return Whether the swap interval was set.
+ */
+bool set_swap_interval(window* window, int interval) {
+    if (window->headless || window->software) {
+        return interval == 0;
+    }
+
+#ifdef OPENGL_CONTEXT_WAYLAND
+    // Frame callbacks already let late frames through, as adaptive vsync
+    // does, so negative intervals need nothing extra.
+    if (window->wayland) {
+        set_wayland_swap_interval(window->wayland, interval);
+        return true;
+    }
+#endif
+
+#ifdef OPENGL_CONTEXT_PRESENT
+    if (window->chain) {
+        set_present_interval(window->chain, interval);
+        return true;
+    }
+#endif
+
+    const platform* platform = window->platform;
+
+    if (platform->glXSwapIntervalEXT
+        && (interval >= 0 || platform->swap_control_tear)) {
+        platform->glXSwapIntervalEXT(window->display, window->window,
+            interval);
+        return true;
+    }
+
+    if (platform->glXSwapIntervalMESA && interval >= 0) {
+        return platform->glXSwapIntervalMESA((unsigned) interval) == 0;
+    }
+
+    fprintf(stderr, "[ERROR] Failed to set swap interval.\n");
+
+    return false;
+}
+
+/**
+ * Gets the size of the window's framebuffer as of the last poll.
+ * 
+ * \param[in] window Window.
+ * \param[out] width Framebuffer width.
+ * \param[out] height Framebuffer height.
+ */
+void get_framebuffer_size(const window* window, unsigned* width,
+    unsigned* height) {
+    get_window_size((struct window*) window, width, height);
+}
+
+/**
+ * Gets where the window's present timing comes from: GLX_OML_sync_control,
+ * GLX_INTEL_swap_event, completion events from the X Present extension, or a
+ * software model of a display at the default refresh rate anchored to the
+ * first present.
+ * 
+ * \param[in] window Window.
+ * \return Present timing source.
+ */
+present_timing_source get_present_timing_source(const window* window) {
+    return window->timing_source;
+}
+
+/**
+ * Samples the sync values of a window using GLX_OML_sync_control, recording
+ * any newly completed present and the latest vertical blank.
+ * 
+ * \param[in] window Window.
+ */
+static void sample_sync_values(window* window) {
+    int64_t ust, msc, sbc;
+    if (!window->platform->glXGetSyncValuesOML(window->display,
+        window->window, &ust, &msc, &sbc)) {
+        return;
+    }
+
+    pthread_mutex_lock(&window->state_mutex);
+
+    if ((uint64_t) sbc > window->present.sbc) {
+        window->present.time = (uint64_t) ust * 1000;
+        window->present.msc = (uint64_t) msc;
+        window->present.sbc = (uint64_t) sbc;
+        window->presented = true;
+    }
+
+    observe_vblank(&window->vblank, (uint64_t) ust * 1000, (uint64_t) msc);
+
+    pthread_mutex_unlock(&window->state_mutex);
+}
+
+#ifdef OPENGL_CONTEXT_PRESENT
+/**
+ * Records the most recent present the X Present extension reported as shown,
+ * together with its vertical blank.
+ * 
+ * \param[in] window Window.
+ */
+static void sample_present_completion(window* window) {
+    present_timing timing;
+    if (!get_present_completion(window->chain, &timing)) {
+        return;
+    }
+
+    pthread_mutex_lock(&window->state_mutex);
+
+    if (!window->presented || timing.sbc > window->present.sbc) {
+        window->present = timing;
+        window->presented = true;
+
+        observe_vblank(&window->vblank, timing.time, timing.msc);
+    }
+
+    pthread_mutex_unlock(&window->state_mutex);
+}
+#endif
+
+/**
+ * Gets the timing of the most recently completed present. With
+ * GLX_OML_sync_control the counters are sampled when this is called, so the
+ * time is that of the vertical blank at or just after the present.
+ * 
+ * \param[in] window Window.
+ * \param[out] timing Present timing.
+ * \return Whether any frame has been presented yet.
+ */
+bool get_present_timing(window* window, present_timing* timing) {
+    if (window->timing_source == PRESENT_TIMING_SYNC_CONTROL) {
+        sample_sync_values(window);
+    }
+
+#ifdef OPENGL_CONTEXT_PRESENT
+    if (window->timing_source == PRESENT_TIMING_PRESENT_EVENT) {
+        sample_present_completion(window);
+    }
+#endif
+
+    pthread_mutex_lock(&window->state_mutex);
+    *timing = window->present;
+    const bool presented = window->presented;
+    pthread_mutex_unlock(&window->state_mutex);
+
+    return presented;
+}
+
+/**
+ * Predicts the next vertical blank, for scheduling a frame's work to finish
+ * just before it.
+ * 
+ * \param[in] window Window.
+ * \param[out] msc Media stream counter at that vertical blank, or null.
+ * \return Time of the vertical blank in nanoseconds on the clock used by
+ * get_time().
+ */
+uint64_t predict_next_vblank(window* window, uint64_t* msc) {
+    if (window->timing_source == PRESENT_TIMING_SYNC_CONTROL) {
+        sample_sync_values(window);
+    }
+
+#ifdef OPENGL_CONTEXT_PRESENT
+    if (window->timing_source == PRESENT_TIMING_PRESENT_EVENT) {
+        sample_present_completion(window);
+    }
+#endif
+
+    pthread_mutex_lock(&window->state_mutex);
+    const uint64_t vblank = predict_vblank(&window->vblank, get_time(), msc);
+    pthread_mutex_unlock(&window->state_mutex);
+
+    return vblank;
+}
+
+/**
+ * Gets the refresh period, as reported by the driver or measured from present
+ * timings.
+ * 
+ * \param[in] window Window.
+ * \return Refresh period in nanoseconds.
+ */
+uint64_t get_refresh_period(const window* window) {
+    pthread_mutex_t* mutex = (pthread_mutex_t*) &window->state_mutex;
+
+    pthread_mutex_lock(mutex);
+    const uint64_t period = window->vblank.period;
+    pthread_mutex_unlock(mutex);
+
+    return period;
+}
+
+/**
+ * Gets the framebuffer object that stands in for the default framebuffer. This
+ * is zero for native windows and the offscreen framebuffer for headless ones.
+ * 
+ * \param[in] window Window.
+ * \return Framebuffer object name.
+ */
+unsigned get_default_framebuffer(const window* window) {
+    return window->headless ? get_headless_framebuffer(window->headless) : 0;
+}
+
+/**
+ * Gets the window's OpenGL dispatch table, declared in gl_loader.h.
+ * 
+ * \param[in] window Window.
+ * \return Dispatch table, or null if the window was created without one.
+ */
+const gl_dispatch* get_gl_dispatch(const window* window) {
+    return window->gl;
+}
+
+/**
+ * Gets the number of debug messages dropped because the debug output queue
+ * was full when the driver reported them.
+ * 
+ * \param[in] window Window.
+ * \return Dropped message count, or zero without debug output.
+ */
+uint64_t get_dropped_debug_messages(const window* window) {
+    return window->debug ? get_dropped_messages(window->debug) : 0;
+}
+
+/**
+ * Gets the address of an OpenGL procedure.
+ * 
+ * \param[in] window Window.
+ * \param[in] name Procedure name.
+ * \return Procedure address, or null if it is not available.
+ */
+procedure get_procedure_address(const window* window, const char* name) {
+    if (window->headless) {
+        return get_headless_procedure(name);
+    }
+
+#ifdef OPENGL_CONTEXT_WAYLAND
+    if (window->wayland) {
+        return get_wayland_procedure(name);
+    }
+#endif
+
+    if (window->software) {
+        return NULL;
+    }
+
+    return (procedure) glXGetProcAddress((const GLubyte*) name);
+}
+
+/**
+ * Creates a context that shares objects with the window's context and has
+ * the same version and error mode. It has no window of its own; it renders
+ * into a 1x1 pbuffer or, where the driver allows, no surface at all.
+ * 
+ * \param[in] window Window.
+ * \return New shared context.
+ */
+shared_context* create_shared_context(window* window) {
+    shared_context* context = malloc(sizeof(struct shared_context));
+    memset(context, 0, sizeof(struct shared_context));
+
+    context->window = window;
+
+    if (window->software) {
+        fprintf(stderr, "[ERROR] Software windows have no context to "
+            "share.\n");
+
+        free(context);
+
+        return NULL;
+    }
+
+    if (window->headless) {
+        context->headless = create_headless_context(window->headless);
+        if (!context->headless) {
+            free(context);
+            return NULL;
+        }
+
+        return context;
+    }
+
+#ifdef OPENGL_CONTEXT_WAYLAND
+    if (window->wayland) {
+        context->wayland = create_wayland_context(window->wayland);
+        if (!context->wayland) {
+            free(context);
+            return NULL;
+        }
+
+        return context;
+    }
+#endif
+
+    const platform* platform = window->platform;
+
+    error_trap trap;
+    open_error_trap(&trap, window->display);
+    begin_trapped_calls(&trap);
+
+    if (platform->glXCreateContextAttribsARB) {
+        context->context =
+            create_core_context(window, window->context, window->version);
+    } else if (window->framebuffer->config) {
+        context->context = glXCreateNewContext(window->display,
+            window->framebuffer->config, GLX_RGBA_TYPE, window->context, True);
+    }
+
+    // OpenGL 3.0 and later contexts from GLX_ARB_create_context can be made
+    // current without a drawable, so only older ones need a pbuffer.
+    if (context->context && (!platform->glXCreateContextAttribsARB
+        || window->version.major < 3)) {
+        const int pbuffer_attributes[] = {
+            GLX_PBUFFER_WIDTH, 1,
+            GLX_PBUFFER_HEIGHT, 1,
+            None
+        };
+
+        context->pbuffer = glXCreatePbuffer(window->display,
+            window->framebuffer->config, pbuffer_attributes);
+    }
+
+    end_trapped_calls(&trap);
+
+    if (close_error_trap(&trap) || !context->context) {
+        fprintf(stderr, "[ERROR] Failed to create shared context.\n");
+
+        if (context->pbuffer) {
+            glXDestroyPbuffer(window->display, context->pbuffer);
+        }
+
+        if (context->context) {
+            glXDestroyContext(window->display, context->context);
+        }
+
+        free(context);
+
+        return NULL;
+    }
+
+    return context;
+}
+
+/**
+ * Destroys a shared context. It must not be current on any thread.
+ * 
+ * \param[in] context Shared context.
+ */
+void destroy_shared_context(shared_context* context) {
+#ifdef OPENGL_CONTEXT_WAYLAND
+    if (context->wayland) {
+        destroy_wayland_context(context->wayland);
+        free(context);
+        return;
+    }
+#endif
+
+    if (context->headless) {
+        destroy_headless_context(context->headless);
+    } else {
+        if (context->pbuffer) {
+            glXDestroyPbuffer(context->window->display, context->pbuffer);
+        }
+
+        glXDestroyContext(context->window->display, context->context);
+    }
+
+    free(context);
+}
+
+/**
+ * Makes a shared context current on the calling thread.
+ * 
+ * \param[in] context Shared context.
+ * \return Whether the context was made current.
+ */
+bool make_shared_context_current(shared_context* context) {
+    if (context->headless) {
+        return make_headless_context_current(context->headless);
+    }
+
+#ifdef OPENGL_CONTEXT_WAYLAND
+    if (context->wayland) {
+        return make_wayland_context_current(context->wayland);
+    }
+#endif
+
+    if (!glXMakeContextCurrent(context->window->display, context->pbuffer,
+        context->pbuffer, context->context)) {
+        fprintf(stderr, "[ERROR] Failed to set shared context.\n");
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Releases a shared context from the calling thread.
+ * 
+ * \param[in] context Shared context.
+ */
+void release_shared_context(shared_context* context) {
+    if (context->headless) {
+        release_headless_context(context->headless);
+        return;
+    }
+
+#ifdef OPENGL_CONTEXT_WAYLAND
+    if (context->wayland) {
+        release_wayland_context(context->wayland);
+        return;
+    }
+#endif
+
+    glXMakeContextCurrent(context->window->display, None, None, NULL);
 }
 
 #elif defined(OPENGL_CONTEXT_WINDOWS_PLATFORM)
@@ -7,24 +7,206 @@
  
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
+#include "frame_pacer.h"
+#include "opengl.h"
+#include "profiler.h"
+#include "render_thread.h"
 #include "window.h"
 
+#define MAX_FRAME_EVENTS 64
+#define MAX_PROFILE_RECORDS 65536
+
+/**
+ * Renders a frame on the render thread.
+ * 
+ * \param[in] window Window.
+ * \param[in] messages Messages posted since the previous frame.
+ * \param[in] count Number of messages.
+ * \param[in] user_data Unused.
+ * \return Whether to keep rendering.
+ */
+static bool render(window* window, const render_message* messages,
+    size_t count, void* user_data) {
+    for (size_t i = 0; i < count; ++i) {
+        if (messages[i].type == RENDER_MESSAGE_CLOSE) {
+            return false;
+        }
+
+        if (messages[i].type == RENDER_MESSAGE_RESIZE) {
+            glViewport(0, 0, messages[i].width, messages[i].height);
+        }
+    }
+
+    return true;
+}
+
 /**
  * Entry point for the program.
  * 
+ * \param[in] argc Argument count.
+ * \param[in] argv Arguments. Passing --render-thread swaps buffers on a
+ * separate thread while the main thread waits for events.
  * \return Exit code.
  */
-int main() {
-    window* window = create_window("OpenGL Context", 400, 300);
+int main(int argc, char** argv) {
+    const bool threaded = argc > 1 && !strcmp(argv[1], "--render-thread");
+
+    // OPENGL_CONTEXT_GL_ERRORS set to debug prints the driver's debug output
+    // and set to none skips error checking in the driver.
+    const char* errors = getenv("OPENGL_CONTEXT_GL_ERRORS");
+
+    // Resize synchronization acknowledges the first swap after a configure,
+    // which on a render thread can still be a frame at the old size, so it
+    // is only used when the event thread also renders.
+    const window_settings settings = {
+        .title = "OpenGL Context",
+        .width = 400,
+        .height = 300,
+        .sync_resize = !threaded,
+        .errors = !errors ? GL_ERRORS_DEFAULT
+            : !strcmp(errors, "debug") ? GL_ERRORS_DEBUG
+            : !strcmp(errors, "none") ? GL_ERRORS_NONE : GL_ERRORS_DEFAULT
+    };
+
+    window* window = create_window_with_settings(&settings);
     if (!window) {
         return EXIT_FAILURE;
     }
 
-    bool quit = false;
-    while (!quit) {
-        quit = poll_events(window);
-        swap_buffer(window);
+    // The limiter is a fallback for drivers that ignore the swap interval,
+    // so it sits just above common refresh rates.
+    set_swap_interval(window, 1);
+    frame_pacer* pacer = create_frame_pacer(240);
+
+    if (threaded) {
+        release_current(window);
+
+        render_thread* thread =
+            start_render_thread(window, pacer, render, NULL);
+        if (!thread) {
+            destroy_frame_pacer(pacer);
+            destroy_window(window);
+            return EXIT_FAILURE;
+        }
+
+        // Resizes are coalesced into the latest size and retried until the
+        // queue has room, so the render thread never misses one. Other
+        // events are dropped and counted when it falls behind.
+        render_message resize = { .type = RENDER_MESSAGE_RESIZE };
+        bool resize_pending = false;
+        unsigned long long dropped = 0;
+
+        while (!wait_events(window, resize_pending ? 1 : -1)
+            && is_render_thread_running(thread)) {
+            window_event events[MAX_FRAME_EVENTS];
+            size_t count;
+
+            while ((count = get_window_events(window, events,
+                MAX_FRAME_EVENTS))) {
+                for (size_t i = 0; i < count; ++i) {
+                    if (events[i].type == WINDOW_EVENT_RESIZE) {
+                        resize.width = events[i].resize.width;
+                        resize.height = events[i].resize.height;
+                        resize_pending = true;
+                        continue;
+                    }
+
+                    render_message message = { .type = RENDER_MESSAGE_EVENT };
+                    message.event = events[i];
+
+                    if (!post_render_message(thread, &message)) {
+                        ++dropped;
+                    }
+                }
+            }
+
+            if (resize_pending) {
+                resize_pending = !post_render_message(thread, &resize);
+            }
+        }
+
+        stop_render_thread(thread);
+
+        if (dropped) {
+            printf("[INFO] Dropped %llu events; the render queue was full.\n",
+                dropped);
+        }
+    } else {
+        // OPENGL_CONTEXT_PROFILE set to csv or json profiles each frame's
+        // event polling and swap on the CPU and GPU.
+        const char* profile_format = getenv("OPENGL_CONTEXT_PROFILE");
+        profiler* profiler = NULL;
+        if (profile_format && (!strcmp(profile_format, "csv")
+            || !strcmp(profile_format, "json"))) {
+            profiler = create_profiler(window, MAX_PROFILE_RECORDS);
+        }
+
+        bool quit = false;
+        while (!quit) {
+            begin_frame(pacer);
+
+            if (profiler) {
+                begin_profile_frame(profiler);
+                begin_profile_scope(profiler, "poll_events");
+            }
+
+            quit = poll_events(window);
+
+            window_event events[MAX_FRAME_EVENTS];
+            size_t count;
+
+            while ((count = get_window_events(window, events,
+                MAX_FRAME_EVENTS))) {
+                for (size_t i = 0; i < count; ++i) {
+                    if (events[i].type == WINDOW_EVENT_RESIZE) {
+                        glViewport(0, 0, events[i].resize.width,
+                            events[i].resize.height);
+                    }
+                }
+            }
+
+            if (profiler) {
+                end_profile_scope(profiler);
+                begin_profile_scope(profiler, "swap_buffer");
+            }
+
+            begin_swap(pacer);
+            swap_buffer(window);
+
+            if (profiler) {
+                end_profile_frame(profiler);
+            }
+
+            end_frame(pacer);
+        }
+
+        if (profiler) {
+            const char* path = getenv("OPENGL_CONTEXT_PROFILE_FILE");
+            FILE* stream = path ? fopen(path, "w") : stdout;
+            if (stream) {
+                write_profile(profiler, stream, !strcmp(profile_format,
+                    "json"));
+
+                if (stream != stdout) {
+                    fclose(stream);
+                }
+            } else {
+                fprintf(stderr, "[ERROR] Failed to open profile file.\n");
+            }
+
+            destroy_profiler(profiler);
+        }
+    }
+
+    dump_frame_statistics(pacer, stdout);
+    destroy_frame_pacer(pacer);
+
+    const uint64_t dropped_events = get_dropped_window_events(window);
+    if (dropped_events) {
+        printf("[INFO] Dropped %llu events; the window's event queue was "
+            "full.\n", (unsigned long long) dropped_events);
     }
     
     destroy_window(window);
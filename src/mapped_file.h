@@ -0,0 +1,47 @@
+/**
+ * \file mapped_file.h
+ * \author Isaiah Lateer
+ * 
+ * Header file for the mapped file struct and functions.
+ */
+
+#ifndef OPENGL_CONTEXT_MAPPED_FILE_HEADER
+#define OPENGL_CONTEXT_MAPPED_FILE_HEADER
+
+#include <stddef.h>
+
+typedef struct mapped_file mapped_file;
+
+/**
+ * Maps a whole file into memory read only. The file must be unmapped before
+ * it is replaced.
+ * 
+ * \param[in] path File path.
+ * \return New mapping, or null if the file is missing or empty.
+ */
+mapped_file* map_file(const char* path);
+
+/**
+ * Unmaps a file.
+ * 
+ * \param[in] file Mapping.
+ */
+void unmap_file(mapped_file* file);
+
+/**
+ * Gets the mapped contents of a file.
+ * 
+ * \param[in] file Mapping.
+ * \return File contents.
+ */
+const void* get_mapped_data(const mapped_file* file);
+
+/**
+ * Gets the size of a mapped file.
+ * 
+ * \param[in] file Mapping.
+ * \return Size in bytes.
+ */
+size_t get_mapped_size(const mapped_file* file);
+
+#endif
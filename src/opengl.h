@@ -0,0 +1,23 @@
+/**
+ * \file opengl.h
+ * \author Isaiah Lateer
+ * 
+ * Includes the OpenGL API and extension headers for the current platform.
+ */
+
+#ifndef OPENGL_CONTEXT_OPENGL_HEADER
+#define OPENGL_CONTEXT_OPENGL_HEADER
+
+#include "platform.h"
+
+#ifdef OPENGL_CONTEXT_WINDOWS_PLATFORM
+#include <windows.h>
+
+#include <gl/GL.h>
+#else
+#include <GL/gl.h>
+#endif
+
+#include <GL/glext.h>
+
+#endif
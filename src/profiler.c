@@ -0,0 +1,344 @@
+/**
+ * \file profiler.c
+ * \author Isaiah Lateer
+ * 
+ * Source file for the profiler functions.
+ */
+
+#include "profiler.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "opengl.h"
+#include "timer.h"
+
+#define PROFILE_FRAME_LATENCY 4
+#define MAX_FRAME_SCOPES 64
+#define MAX_SCOPE_DEPTH 16
+
+typedef struct profile_frame {
+    uint64_t frame;
+    profile_record scopes[MAX_FRAME_SCOPES];
+    GLuint queries[MAX_FRAME_SCOPES * 2];
+    GLuint last_query;
+    unsigned count;
+    int64_t gpu_offset;
+    bool pending;
+} profile_frame;
+
+typedef struct profiler {
+    profile_frame frames[PROFILE_FRAME_LATENCY];
+    profile_frame* current;
+    unsigned open_scopes[MAX_SCOPE_DEPTH];
+    unsigned depth;
+    unsigned skipped_depth;
+    uint64_t frame;
+    uint64_t collected;
+    uint64_t dropped;
+    profile_record* records;
+    size_t record_count;
+    size_t max_records;
+    PFNGLGENQUERIESPROC glGenQueries;
+    PFNGLDELETEQUERIESPROC glDeleteQueries;
+    PFNGLQUERYCOUNTERPROC glQueryCounter;
+    PFNGLGETQUERYOBJECTIVPROC glGetQueryObjectiv;
+    PFNGLGETQUERYOBJECTUI64VPROC glGetQueryObjectui64v;
+    PFNGLGETINTEGER64VPROC glGetInteger64v;
+} profiler;
+
+/**
+ * Copies a frame's scopes into the records if all of its timestamps are
+ * ready. Timestamps complete in the order they were issued, so checking the
+ * last one is enough.
+ * 
+ * \param[in] profiler Profiler.
+ * \param[in] frame Frame in flight.
+ * \return Whether the frame was collected.
+ */
+static bool collect_frame(profiler* profiler, profile_frame* frame) {
+    if (frame->count) {
+        GLint available = 0;
+        profiler->glGetQueryObjectiv(frame->last_query,
+            GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available) {
+            return false;
+        }
+    }
+
+    for (unsigned i = 0; i < frame->count; ++i) {
+        profile_record* scope = &frame->scopes[i];
+
+        GLuint64 start, end;
+        profiler->glGetQueryObjectui64v(frame->queries[i * 2],
+            GL_QUERY_RESULT, &start);
+        profiler->glGetQueryObjectui64v(frame->queries[i * 2 + 1],
+            GL_QUERY_RESULT, &end);
+
+        scope->gpu_start = (uint64_t) ((int64_t) start + frame->gpu_offset);
+        scope->gpu_end = (uint64_t) ((int64_t) end + frame->gpu_offset);
+
+        if (profiler->record_count < profiler->max_records) {
+            profiler->records[profiler->record_count++] = *scope;
+        }
+    }
+
+    frame->pending = false;
+    ++profiler->collected;
+
+    return true;
+}
+
+/**
+ * Creates a profiler for a window. The window's context must be current and
+ * support OpenGL 3.3 or ARB_timer_query.
+ * 
+ * \param[in] window Window.
+ * \param[in] max_records Number of scope records to keep before recording
+ * stops.
+ * \return New profiler.
+ */
+profiler* create_profiler(window* window, size_t max_records) {
+    profiler* profiler = malloc(sizeof(struct profiler));
+    memset(profiler, 0, sizeof(struct profiler));
+
+    profiler->glGenQueries = (PFNGLGENQUERIESPROC)
+        get_procedure_address(window, "glGenQueries");
+    profiler->glDeleteQueries = (PFNGLDELETEQUERIESPROC)
+        get_procedure_address(window, "glDeleteQueries");
+    profiler->glQueryCounter = (PFNGLQUERYCOUNTERPROC)
+        get_procedure_address(window, "glQueryCounter");
+    profiler->glGetQueryObjectiv = (PFNGLGETQUERYOBJECTIVPROC)
+        get_procedure_address(window, "glGetQueryObjectiv");
+    profiler->glGetQueryObjectui64v = (PFNGLGETQUERYOBJECTUI64VPROC)
+        get_procedure_address(window, "glGetQueryObjectui64v");
+    profiler->glGetInteger64v = (PFNGLGETINTEGER64VPROC)
+        get_procedure_address(window, "glGetInteger64v");
+
+    if (!profiler->glGenQueries || !profiler->glDeleteQueries
+        || !profiler->glQueryCounter || !profiler->glGetQueryObjectiv
+        || !profiler->glGetQueryObjectui64v || !profiler->glGetInteger64v) {
+        fprintf(stderr, "[ERROR] Failed to load profiler procedures.\n");
+
+        free(profiler);
+
+        return NULL;
+    }
+
+    profiler->records = malloc(max_records * sizeof(profile_record));
+    profiler->max_records = max_records;
+
+    for (unsigned i = 0; i < PROFILE_FRAME_LATENCY; ++i) {
+        profiler->glGenQueries(MAX_FRAME_SCOPES * 2,
+            profiler->frames[i].queries);
+    }
+
+    return profiler;
+}
+
+/**
+ * Destroys a profiler.
+ * 
+ * \param[in] profiler Profiler.
+ */
+void destroy_profiler(profiler* profiler) {
+    for (unsigned i = 0; i < PROFILE_FRAME_LATENCY; ++i) {
+        profiler->glDeleteQueries(MAX_FRAME_SCOPES * 2,
+            profiler->frames[i].queries);
+    }
+
+    free(profiler->records);
+    free(profiler);
+}
+
+/**
+ * Starts a profiled frame, first collecting every earlier frame whose GPU
+ * timestamps are ready. Never waits for the GPU; a frame still in flight
+ * when its slot in the ring is needed again is dropped.
+ * 
+ * \param[in] profiler Profiler.
+ */
+void begin_profile_frame(profiler* profiler) {
+    while (profiler->collected < profiler->frame
+        && collect_frame(profiler,
+        &profiler->frames[profiler->collected % PROFILE_FRAME_LATENCY])) {
+    }
+
+    profile_frame* frame =
+        &profiler->frames[profiler->frame % PROFILE_FRAME_LATENCY];
+
+    if (frame->pending) {
+        frame->pending = false;
+        ++profiler->dropped;
+        ++profiler->collected;
+    }
+
+    frame->frame = profiler->frame++;
+    frame->count = 0;
+
+    // Pair the GPU clock with the CPU clock once per frame so GPU
+    // timestamps can be placed on the CPU timeline.
+    GLint64 gpu_now;
+    profiler->glGetInteger64v(GL_TIMESTAMP, &gpu_now);
+    frame->gpu_offset = (int64_t) get_time() - gpu_now;
+
+    profiler->current = frame;
+    profiler->depth = 0;
+    profiler->skipped_depth = 0;
+}
+
+/**
+ * Ends a profiled frame.
+ * 
+ * \param[in] profiler Profiler.
+ */
+void end_profile_frame(profiler* profiler) {
+    profiler->skipped_depth = 0;
+
+    while (profiler->depth) {
+        end_profile_scope(profiler);
+    }
+
+    profiler->current->pending = true;
+    profiler->current = NULL;
+}
+
+/**
+ * Opens a named scope in the current frame, timing it on both the CPU and the
+ * GPU. Scopes nest. Scopes past the nesting or per-frame limits are skipped,
+ * along with their matching end_profile_scope() calls.
+ * 
+ * \param[in] profiler Profiler.
+ * \param[in] name Scope name. Must outlive the profiler.
+ */
+void begin_profile_scope(profiler* profiler, const char* name) {
+    profile_frame* frame = profiler->current;
+
+    if (!frame) {
+        return;
+    }
+
+    // Once a scope is skipped, the scopes inside it are too, so each end
+    // call still closes the scope its begin call opened.
+    if (profiler->skipped_depth || frame->count == MAX_FRAME_SCOPES
+        || profiler->depth == MAX_SCOPE_DEPTH) {
+        ++profiler->skipped_depth;
+        return;
+    }
+
+    profile_record* scope = &frame->scopes[frame->count];
+    scope->frame = frame->frame;
+    scope->name = name;
+    scope->depth = profiler->depth;
+    scope->cpu_start = get_time();
+
+    frame->last_query = frame->queries[frame->count * 2];
+    profiler->glQueryCounter(frame->last_query, GL_TIMESTAMP);
+
+    profiler->open_scopes[profiler->depth++] = frame->count++;
+}
+
+/**
+ * Closes the innermost open scope.
+ * 
+ * \param[in] profiler Profiler.
+ */
+void end_profile_scope(profiler* profiler) {
+    profile_frame* frame = profiler->current;
+
+    if (!frame) {
+        return;
+    }
+
+    if (profiler->skipped_depth) {
+        --profiler->skipped_depth;
+        return;
+    }
+
+    if (!profiler->depth) {
+        return;
+    }
+
+    const unsigned index = profiler->open_scopes[--profiler->depth];
+
+    frame->last_query = frame->queries[index * 2 + 1];
+    profiler->glQueryCounter(frame->last_query, GL_TIMESTAMP);
+    frame->scopes[index].cpu_end = get_time();
+}
+
+/**
+ * Gets the collected scope records. Times are in nanoseconds on the clock
+ * used by get_time(), with GPU timestamps mapped onto it.
+ * 
+ * \param[in] profiler Profiler.
+ * \param[out] count Number of records.
+ * \return Records in the order their frames were collected.
+ */
+const profile_record* get_profile_records(const profiler* profiler,
+    size_t* count) {
+    *count = profiler->record_count;
+
+    return profiler->records;
+}
+
+/**
+ * Gets the number of frames dropped because their timestamps were not ready
+ * in time.
+ * 
+ * \param[in] profiler Profiler.
+ * \return Number of dropped frames.
+ */
+uint64_t get_dropped_profile_frames(const profiler* profiler) {
+    return profiler->dropped;
+}
+
+/**
+ * Writes the collected records, either as Chrome trace event JSON with CPU
+ * and GPU scopes on separate threads or as CSV with one row per scope.
+ * 
+ * \param[in] profiler Profiler.
+ * \param[in] stream Output stream.
+ * \param[in] json Whether to write JSON.
+ */
+void write_profile(const profiler* profiler, FILE* stream, bool json) {
+    const profile_record* records = profiler->records;
+
+    if (json) {
+        fprintf(stream, "{\"traceEvents\":[");
+
+        for (size_t i = 0; i < profiler->record_count; ++i) {
+            fprintf(stream, "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,"
+                "\"tid\":1,\"ts\":%.3f,\"dur\":%.3f,"
+                "\"args\":{\"frame\":%llu}},", i ? "," : "", records[i].name,
+                records[i].cpu_start / 1e3,
+                (records[i].cpu_end - records[i].cpu_start) / 1e3,
+                (unsigned long long) records[i].frame);
+            fprintf(stream, "\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,"
+                "\"tid\":2,\"ts\":%.3f,\"dur\":%.3f,"
+                "\"args\":{\"frame\":%llu}}", records[i].name,
+                records[i].gpu_start / 1e3,
+                (records[i].gpu_end - records[i].gpu_start) / 1e3,
+                (unsigned long long) records[i].frame);
+        }
+
+        fprintf(stream, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+            "\"tid\":1,\"args\":{\"name\":\"CPU\"}},"
+            "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+            "\"tid\":2,\"args\":{\"name\":\"GPU\"}}\n]}\n",
+            profiler->record_count ? "," : "");
+
+        return;
+    }
+
+    fprintf(stream, "frame,scope,depth,cpu_start_ms,cpu_ms,gpu_start_ms,"
+        "gpu_ms\n");
+
+    for (size_t i = 0; i < profiler->record_count; ++i) {
+        fprintf(stream, "%llu,%s,%u,%.3f,%.3f,%.3f,%.3f\n",
+            (unsigned long long) records[i].frame, records[i].name,
+            records[i].depth, records[i].cpu_start / 1e6,
+            (records[i].cpu_end - records[i].cpu_start) / 1e6,
+            records[i].gpu_start / 1e6,
+            (records[i].gpu_end - records[i].gpu_start) / 1e6);
+    }
+}
@@ -0,0 +1,107 @@
+/**
+ * \file profiler.h
+ * \author Isaiah Lateer
+ * 
+ * Header file for the profiler struct and functions.
+ */
+
+#ifndef OPENGL_CONTEXT_PROFILER_HEADER
+#define OPENGL_CONTEXT_PROFILER_HEADER
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include "window.h"
+
+typedef struct profiler profiler;
+
+typedef struct profile_record {
+    uint64_t frame;
+    const char* name;
+    unsigned depth;
+    uint64_t cpu_start, cpu_end;
+    uint64_t gpu_start, gpu_end;
+} profile_record;
+
+/**
+ * Creates a profiler for a window. The window's context must be current and
+ * support OpenGL 3.3 or ARB_timer_query.
+ * 
+ * \param[in] window Window.
+ * \param[in] max_records Number of scope records to keep before recording
+ * stops.
+ * \return New profiler.
+ */
+profiler* create_profiler(window* window, size_t max_records);
+
+/**
+ * Destroys a profiler.
+ * 
+ * \param[in] profiler Profiler.
+ */
+void destroy_profiler(profiler* profiler);
+
+/**
+ * Starts a profiled frame, first collecting every earlier frame whose GPU
+ * timestamps are ready. Never waits for the GPU; a frame still in flight
+ * when its slot in the ring is needed again is dropped.
+ * 
+ * \param[in] profiler Profiler.
+ */
+void begin_profile_frame(profiler* profiler);
+
+/**
+ * Ends a profiled frame.
+ * 
+ * \param[in] profiler Profiler.
+ */
+void end_profile_frame(profiler* profiler);
+
+/**
+ * Opens a named scope in the current frame, timing it on both the CPU and the
+ * GPU. Scopes nest. Scopes past the nesting or per-frame limits are skipped,
+ * along with their matching end_profile_scope() calls.
+ * 
+ * \param[in] profiler Profiler.
+ * \param[in] name Scope name. Must outlive the profiler.
+ */
+void begin_profile_scope(profiler* profiler, const char* name);
+
+/**
+ * Closes the innermost open scope.
+ * 
+ * \param[in] profiler Profiler.
+ */
+void end_profile_scope(profiler* profiler);
+
+/**
+ * Gets the collected scope records. Times are in nanoseconds on the clock
+ * used by get_time(), with GPU timestamps mapped onto it.
+ * 
+ * \param[in] profiler Profiler.
+ * \param[out] count Number of records.
+ * \return Records in the order their frames were collected.
+ */
+const profile_record* get_profile_records(const profiler* profiler,
+    size_t* count);
+
+/**
+ * Gets the number of frames dropped because their timestamps were not ready
+ * in time.
+ * 
+ * \param[in] profiler Profiler.
+ * \return Number of dropped frames.
+ */
+uint64_t get_dropped_profile_frames(const profiler* profiler);
+
+/**
+ * Writes the collected records, either as Chrome trace event JSON with CPU
+ * and GPU scopes on separate threads or as CSV with one row per scope.
+ * 
+ * \param[in] profiler Profiler.
+ * \param[in] stream Output stream.
+ * \param[in] json Whether to write JSON.
+ */
+void write_profile(const profiler* profiler, FILE* stream, bool json);
+
+#endif
@@ -0,0 +1,694 @@
+/**
+ * \file program_cache.c
+ * \author Isaiah Lateer
+ * 
+ * Source file for the program cache functions.
+ */
+
+#include "program_cache.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mapped_file.h"
+#include "opengl.h"
+#include "trace.h"
+#include "version_cache.h"
+
+#define CACHE_FILE_NAME "opengl_context_programs"
+#define CACHE_MAGIC 0x43504f47
+#define CACHE_FORMAT_VERSION 1
+#define MAX_PATH_LENGTH 1024
+#define MAX_LOG_LENGTH 4096
+#define HASH_OFFSET 0xcbf29ce484222325
+#define HASH_PRIME 0x100000001b3
+
+typedef struct cache_header {
+    uint32_t magic;
+    uint32_t format_version;
+    uint64_t driver;
+    uint32_t entry_count;
+    uint32_t reserved;
+} cache_header;
+
+typedef struct cache_entry {
+    uint64_t key;
+    uint32_t format;
+    uint32_t size;
+    uint64_t offset;
+} cache_entry;
+
+typedef struct pending_program {
+    uint64_t key;
+    uint32_t format;
+    uint32_t size;
+    void* binary;
+} pending_program;
+
+typedef struct program_cache {
+    window* window;
+    char path[MAX_PATH_LENGTH];
+    uint64_t driver;
+    bool binaries;
+    bool invalidated;
+    mapped_file* file;
+    const cache_entry* entries;
+    size_t entry_count;
+    pending_program* pending;
+    size_t pending_count;
+    size_t pending_capacity;
+    program_cache_statistics statistics;
+    PFNGLCREATESHADERPROC glCreateShader;
+    PFNGLSHADERSOURCEPROC glShaderSource;
+    PFNGLCOMPILESHADERPROC glCompileShader;
+    PFNGLGETSHADERIVPROC glGetShaderiv;
+    PFNGLGETSHADERINFOLOGPROC glGetShaderInfoLog;
+    PFNGLDELETESHADERPROC glDeleteShader;
+    PFNGLCREATEPROGRAMPROC glCreateProgram;
+    PFNGLATTACHSHADERPROC glAttachShader;
+    PFNGLDETACHSHADERPROC glDetachShader;
+    PFNGLLINKPROGRAMPROC glLinkProgram;
+    PFNGLGETPROGRAMIVPROC glGetProgramiv;
+    PFNGLGETPROGRAMINFOLOGPROC glGetProgramInfoLog;
+    PFNGLDELETEPROGRAMPROC glDeleteProgram;
+    PFNGLPROGRAMPARAMETERIPROC glProgramParameteri;
+    PFNGLGETPROGRAMBINARYPROC glGetProgramBinary;
+    PFNGLPROGRAMBINARYPROC glProgramBinary;
+} program_cache;
+
+/**
+ * Continues an FNV-1a hash over a block of memory.
+ * 
+ * \param[in] hash Hash so far.
+ * \param[in] data Data.
+ * \param[in] size Data size.
+ * \return Hash including the data.
+ */
+static uint64_t hash_bytes(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* bytes = data;
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * HASH_PRIME;
+    }
+
+    return hash;
+}
+
+/**
+ * Continues an FNV-1a hash over a string and its terminator, so adjacent
+ * strings cannot run together.
+ * 
+ * \param[in] hash Hash so far.
+ * \param[in] string String, or null.
+ * \return Hash including the string.
+ */
+static uint64_t hash_string(uint64_t hash, const char* string) {
+    return string ? hash_bytes(hash, string, strlen(string) + 1)
+        : hash_bytes(hash, "", 1);
+}
+
+/**
+ * Hashes the strings that identify the driver behind the current context.
+ * Binaries from any other driver, or another version of the same one, are
+ * not expected to load.
+ * 
+ * \return Driver hash.
+ */
+static uint64_t hash_driver(void) {
+    uint64_t hash = HASH_OFFSET;
+    hash = hash_string(hash, (const char*) glGetString(GL_VENDOR));
+    hash = hash_string(hash, (const char*) glGetString(GL_RENDERER));
+    hash = hash_string(hash, (const char*) glGetString(GL_VERSION));
+    hash = hash_string(hash,
+        (const char*) glGetString(GL_SHADING_LANGUAGE_VERSION));
+
+    return hash;
+}
+
+/**
+ * Hashes a program's shader stages together with the driver.
+ * 
+ * \param[in] cache Program cache.
+ * \param[in] shaders Shader stages.
+ * \param[in] count Number of shader stages.
+ * \return Cache key.
+ */
+static uint64_t hash_program(const program_cache* cache,
+    const shader_source* shaders, size_t count) {
+    uint64_t hash = cache->driver;
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t type = shaders[i].type;
+        hash = hash_bytes(hash, &type, sizeof(type));
+        hash = hash_string(hash, shaders[i].source);
+    }
+
+    return hash;
+}
+
+/**
+ * Maps the cache file and checks that it was written for the current driver
+ * and that its entry table fits in it. A file that fails either check is
+ * unmapped and replaced on the next save.
+ * 
+ * \param[in] cache Program cache.
+ */
+static void open_cache_file(program_cache* cache) {
+    cache->file = map_file(cache->path);
+    if (!cache->file) {
+        return;
+    }
+
+    const size_t size = get_mapped_size(cache->file);
+    const cache_header* header = get_mapped_data(cache->file);
+
+    bool valid = size >= sizeof(cache_header)
+        && header->magic == CACHE_MAGIC
+        && header->format_version == CACHE_FORMAT_VERSION
+        && header->entry_count <= (size - sizeof(cache_header))
+        / sizeof(cache_entry);
+
+    if (valid && header->driver != cache->driver) {
+        printf("[INFO] Program cache invalidated; the driver changed.\n");
+        valid = false;
+    }
+
+    if (!valid) {
+        unmap_file(cache->file);
+        cache->file = NULL;
+        cache->invalidated = true;
+        return;
+    }
+
+    cache->entries = (const cache_entry*) (header + 1);
+    cache->entry_count = header->entry_count;
+}
+
+/**
+ * Checks that a cached entry's binary lies inside the mapped file.
+ * 
+ * \param[in] cache Program cache.
+ * \param[in] entry Cached entry.
+ * \return Whether the binary is in bounds.
+ */
+static bool is_entry_valid(const program_cache* cache,
+    const cache_entry* entry) {
+    const size_t size = get_mapped_size(cache->file);
+    return entry->offset <= size && entry->size <= size - entry->offset;
+}
+
+/**
+ * Finds a program's binary, preferring one linked since the cache was opened
+ * over one in the file.
+ * 
+ * \param[in] cache Program cache.
+ * \param[in] key Cache key.
+ * \param[out] format Binary format.
+ * \param[out] binary Binary data.
+ * \param[out] size Binary size.
+ * \return Whether a binary was found.
+ */
+static bool find_binary(const program_cache* cache, uint64_t key,
+    GLenum* format, const void** binary, GLsizei* size) {
+    for (size_t i = 0; i < cache->pending_count; ++i) {
+        if (cache->pending[i].key == key) {
+            *format = cache->pending[i].format;
+            *binary = cache->pending[i].binary;
+            *size = (GLsizei) cache->pending[i].size;
+            return true;
+        }
+    }
+
+    size_t low = 0;
+    size_t high = cache->entry_count;
+    while (low < high) {
+        const size_t middle = low + (high - low) / 2;
+        const cache_entry* entry = &cache->entries[middle];
+
+        if (entry->key < key) {
+            low = middle + 1;
+        } else if (entry->key > key) {
+            high = middle;
+        } else {
+            if (!is_entry_valid(cache, entry)) {
+                return false;
+            }
+
+            *format = entry->format;
+            *binary = (const char*) get_mapped_data(cache->file)
+                + entry->offset;
+            *size = (GLsizei) entry->size;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Compiles a shader stage, printing the log if it fails.
+ * 
+ * \param[in] cache Program cache.
+ * \param[in] shader Shader stage.
+ * \return Shader name, or zero on failure.
+ */
+static GLuint compile_shader(program_cache* cache,
+    const shader_source* shader) {
+    const GLuint name = cache->glCreateShader(shader->type);
+    if (!name) {
+        fprintf(stderr, "[ERROR] Failed to create shader.\n");
+        return 0;
+    }
+
+    cache->glShaderSource(name, 1, &shader->source, NULL);
+    cache->glCompileShader(name);
+
+    GLint compiled = GL_FALSE;
+    cache->glGetShaderiv(name, GL_COMPILE_STATUS, &compiled);
+    if (!compiled) {
+        char log[MAX_LOG_LENGTH] = { 0 };
+        cache->glGetShaderInfoLog(name, sizeof(log), NULL, log);
+        fprintf(stderr, "[ERROR] Failed to compile shader.\n%s\n", log);
+
+        cache->glDeleteShader(name);
+
+        return 0;
+    }
+
+    return name;
+}
+
+/**
+ * Compiles and links a program, asking the driver to keep its binary
+ * retrievable when binaries are cached.
+ * 
+ * \param[in] cache Program cache.
+ * \param[in] shaders Shader stages.
+ * \param[in] count Number of shader stages.
+ * \return Program name, or zero on failure.
+ */
+static GLuint link_program(program_cache* cache, const shader_source* shaders,
+    size_t count) {
+    const GLuint program = cache->glCreateProgram();
+    if (!program) {
+        fprintf(stderr, "[ERROR] Failed to create program.\n");
+        return 0;
+    }
+
+    GLuint* names = malloc(count * sizeof(GLuint));
+
+    size_t compiled = 0;
+    for (; compiled < count; ++compiled) {
+        names[compiled] = compile_shader(cache, &shaders[compiled]);
+        if (!names[compiled]) {
+            break;
+        }
+
+        cache->glAttachShader(program, names[compiled]);
+    }
+
+    GLint linked = GL_FALSE;
+    if (compiled == count) {
+        if (cache->binaries) {
+            cache->glProgramParameteri(program,
+                GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
+
+        cache->glLinkProgram(program);
+
+        cache->glGetProgramiv(program, GL_LINK_STATUS, &linked);
+        if (!linked) {
+            char log[MAX_LOG_LENGTH] = { 0 };
+            cache->glGetProgramInfoLog(program, sizeof(log), NULL, log);
+            fprintf(stderr, "[ERROR] Failed to link program.\n%s\n", log);
+        }
+    }
+
+    for (size_t i = 0; i < compiled; ++i) {
+        cache->glDetachShader(program, names[i]);
+        cache->glDeleteShader(names[i]);
+    }
+
+    free(names);
+
+    if (!linked) {
+        cache->glDeleteProgram(program);
+        return 0;
+    }
+
+    return program;
+}
+
+/**
+ * Reads back a linked program's binary and queues it to be saved.
+ * 
+ * \param[in] cache Program cache.
+ * \param[in] key Cache key.
+ * \param[in] program Program name.
+ */
+static void queue_binary(program_cache* cache, uint64_t key, GLuint program) {
+    GLint length = 0;
+    cache->glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return;
+    }
+
+    void* binary = malloc((size_t) length);
+
+    GLenum format = 0;
+    cache->glGetProgramBinary(program, length, &length, &format, binary);
+    if (length <= 0) {
+        free(binary);
+        return;
+    }
+
+    if (cache->pending_count == cache->pending_capacity) {
+        cache->pending_capacity =
+            cache->pending_capacity ? cache->pending_capacity * 2 : 16;
+        cache->pending = realloc(cache->pending,
+            cache->pending_capacity * sizeof(pending_program));
+    }
+
+    pending_program* pending = &cache->pending[cache->pending_count++];
+    pending->key = key;
+    pending->format = format;
+    pending->size = (uint32_t) length;
+    pending->binary = binary;
+}
+
+/**
+ * Orders queued programs by key.
+ * 
+ * \param[in] a First program.
+ * \param[in] b Second program.
+ * \return Comparison result.
+ */
+static int compare_pending(const void* a, const void* b) {
+    const uint64_t key_a = ((const pending_program*) a)->key;
+    const uint64_t key_b = ((const pending_program*) b)->key;
+
+    return (key_a > key_b) - (key_a < key_b);
+}
+
+/**
+ * Opens a program binary cache for a window's context, which must be current.
+ * Entries are keyed by a hash of the shader sources together with the
+ * context's vendor, renderer and version strings, and the whole cache is
+ * discarded when those strings change. Contexts older than OpenGL 4.1 or
+ * without binary formats compile every program.
+ * 
+ * \param[in] window Window.
+ * \param[in] path Cache file, or null for one in the user's cache directory.
+ * \return New program cache.
+ */
+program_cache* create_program_cache(window* window, const char* path) {
+    program_cache* cache = malloc(sizeof(struct program_cache));
+    memset(cache, 0, sizeof(struct program_cache));
+
+    cache->window = window;
+
+    if (path) {
+        snprintf(cache->path, MAX_PATH_LENGTH, "%s", path);
+    } else if (!get_cache_path(CACHE_FILE_NAME, cache->path,
+        MAX_PATH_LENGTH)) {
+        cache->path[0] = '\0';
+    }
+
+    cache->glCreateShader = (PFNGLCREATESHADERPROC)
+        get_procedure_address(window, "glCreateShader");
+    cache->glShaderSource = (PFNGLSHADERSOURCEPROC)
+        get_procedure_address(window, "glShaderSource");
+    cache->glCompileShader = (PFNGLCOMPILESHADERPROC)
+        get_procedure_address(window, "glCompileShader");
+    cache->glGetShaderiv = (PFNGLGETSHADERIVPROC)
+        get_procedure_address(window, "glGetShaderiv");
+    cache->glGetShaderInfoLog = (PFNGLGETSHADERINFOLOGPROC)
+        get_procedure_address(window, "glGetShaderInfoLog");
+    cache->glDeleteShader = (PFNGLDELETESHADERPROC)
+        get_procedure_address(window, "glDeleteShader");
+    cache->glCreateProgram = (PFNGLCREATEPROGRAMPROC)
+        get_procedure_address(window, "glCreateProgram");
+    cache->glAttachShader = (PFNGLATTACHSHADERPROC)
+        get_procedure_address(window, "glAttachShader");
+    cache->glDetachShader = (PFNGLDETACHSHADERPROC)
+        get_procedure_address(window, "glDetachShader");
+    cache->glLinkProgram = (PFNGLLINKPROGRAMPROC)
+        get_procedure_address(window, "glLinkProgram");
+    cache->glGetProgramiv = (PFNGLGETPROGRAMIVPROC)
+        get_procedure_address(window, "glGetProgramiv");
+    cache->glGetProgramInfoLog = (PFNGLGETPROGRAMINFOLOGPROC)
+        get_procedure_address(window, "glGetProgramInfoLog");
+    cache->glDeleteProgram = (PFNGLDELETEPROGRAMPROC)
+        get_procedure_address(window, "glDeleteProgram");
+    cache->glProgramParameteri = (PFNGLPROGRAMPARAMETERIPROC)
+        get_procedure_address(window, "glProgramParameteri");
+    cache->glGetProgramBinary = (PFNGLGETPROGRAMBINARYPROC)
+        get_procedure_address(window, "glGetProgramBinary");
+    cache->glProgramBinary = (PFNGLPROGRAMBINARYPROC)
+        get_procedure_address(window, "glProgramBinary");
+
+    if (!cache->glCreateShader || !cache->glCreateProgram) {
+        fprintf(stderr, "[ERROR] Failed to load shader functions.\n");
+
+        free(cache);
+
+        return NULL;
+    }
+
+    if (!cache->path[0]) {
+        printf("[INFO] Programs will not be cached; no cache directory is "
+            "available.\n");
+        return cache;
+    }
+
+    GLint format_count = 0;
+
+    const version version = get_context_version(window);
+    if (version.major > 4 || (version.major == 4 && version.minor >= 1)) {
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+    }
+
+    if (format_count <= 0) {
+        printf("[INFO] Programs will not be cached; the context has no "
+            "program binary formats.\n");
+        return cache;
+    }
+
+    cache->binaries = true;
+
+    const uint64_t stage = begin_trace();
+
+    cache->driver = hash_driver();
+    open_cache_file(cache);
+
+    end_trace("open_cache_file", stage);
+
+    return cache;
+}
+
+/**
+ * Saves newly linked programs, then destroys a program cache.
+ * 
+ * \param[in] cache Program cache.
+ */
+void destroy_program_cache(program_cache* cache) {
+    save_program_cache(cache);
+
+    for (size_t i = 0; i < cache->pending_count; ++i) {
+        free(cache->pending[i].binary);
+    }
+
+    free(cache->pending);
+
+    if (cache->file) {
+        unmap_file(cache->file);
+    }
+
+    free(cache);
+}
+
+/**
+ * Gets a linked program for a set of shaders. The program is loaded from its
+ * cached binary when there is one the driver accepts, and otherwise compiled,
+ * linked and queued to be saved. Compile and link errors are printed.
+ * 
+ * \param[in] cache Program cache.
+ * \param[in] shaders Shader stages.
+ * \param[in] count Number of shader stages.
+ * \return Program name, or zero on failure.
+ */
+unsigned get_cached_program(program_cache* cache, const shader_source* shaders,
+    size_t count) {
+    const uint64_t key =
+        cache->binaries ? hash_program(cache, shaders, count) : 0;
+
+    GLenum format;
+    const void* binary;
+    GLsizei size;
+    if (cache->binaries && find_binary(cache, key, &format, &binary, &size)) {
+        const GLuint program = cache->glCreateProgram();
+        cache->glProgramBinary(program, format, binary, size);
+
+        GLint linked = GL_FALSE;
+        cache->glGetProgramiv(program, GL_LINK_STATUS, &linked);
+        if (linked) {
+            ++cache->statistics.hits;
+            return program;
+        }
+
+        // The driver may refuse a binary its strings claim it wrote, for
+        // example after an update that kept the version string.
+        cache->glDeleteProgram(program);
+        ++cache->statistics.rejected;
+    }
+
+    ++cache->statistics.misses;
+
+    const GLuint program = link_program(cache, shaders, count);
+    if (program && cache->binaries) {
+        queue_binary(cache, key, program);
+    }
+
+    return program;
+}
+
+/**
+ * Writes the cache file with every program linked since it was opened. The
+ * new file is written beside the old one and renamed over it, so other
+ * processes never map a partial cache.
+ * 
+ * \param[in] cache Program cache.
+ * \return Whether the cache was written or had nothing new.
+ */
+bool save_program_cache(program_cache* cache) {
+    if (!cache->binaries || (!cache->pending_count && !cache->invalidated)) {
+        return true;
+    }
+
+    const uint64_t stage = begin_trace();
+
+    qsort(cache->pending, cache->pending_count, sizeof(pending_program),
+        compare_pending);
+
+    // Entries are merged in key order so lookups can binary search the
+    // table, and a queued program replaces a cached one with the same key.
+    cache_entry* entries = malloc((cache->entry_count + cache->pending_count)
+        * sizeof(cache_entry));
+    const void** binaries = malloc((cache->entry_count + cache->pending_count)
+        * sizeof(const void*));
+    size_t entry_count = 0;
+
+    size_t cached = 0;
+    size_t pending = 0;
+    while (cached < cache->entry_count || pending < cache->pending_count) {
+        const cache_entry* entry =
+            cached < cache->entry_count ? &cache->entries[cached] : NULL;
+        const pending_program* program = pending < cache->pending_count
+            ? &cache->pending[pending] : NULL;
+
+        if (entry && (!program || entry->key < program->key)) {
+            if (is_entry_valid(cache, entry)) {
+                entries[entry_count] = *entry;
+                binaries[entry_count++] =
+                    (const char*) get_mapped_data(cache->file) + entry->offset;
+            }
+
+            ++cached;
+            continue;
+        }
+
+        if (entry && entry->key == program->key) {
+            ++cached;
+        }
+
+        entries[entry_count].key = program->key;
+        entries[entry_count].format = program->format;
+        entries[entry_count].size = program->size;
+        binaries[entry_count++] = program->binary;
+
+        ++pending;
+    }
+
+    const cache_header header = {
+        CACHE_MAGIC,
+        CACHE_FORMAT_VERSION,
+        cache->driver,
+        (uint32_t) entry_count,
+        0
+    };
+
+    uint64_t offset = sizeof(cache_header) + entry_count * sizeof(cache_entry);
+    for (size_t i = 0; i < entry_count; ++i) {
+        entries[i].offset = offset;
+        offset += entries[i].size;
+    }
+
+    char temporary_path[MAX_PATH_LENGTH + 32];
+    FILE* file = open_temporary_file(cache->path, temporary_path,
+        sizeof(temporary_path));
+    const bool created = file != NULL;
+    bool written = created;
+    if (file) {
+        written = fwrite(&header, sizeof(header), 1, file) == 1
+            && fwrite(entries, sizeof(cache_entry), entry_count, file)
+            == entry_count;
+
+        for (size_t i = 0; written && i < entry_count; ++i) {
+            written = fwrite(binaries[i], 1, entries[i].size, file)
+                == entries[i].size;
+        }
+
+        written = !fclose(file) && written;
+    }
+
+    free(binaries);
+    free(entries);
+
+    if (!written) {
+        fprintf(stderr, "[ERROR] Failed to write program cache.\n");
+
+        if (created) {
+            remove(temporary_path);
+        }
+
+        end_trace("save_program_cache", stage);
+        return false;
+    }
+
+    if (cache->file) {
+        unmap_file(cache->file);
+        cache->file = NULL;
+        cache->entries = NULL;
+        cache->entry_count = 0;
+    }
+
+    const bool renamed = replace_file(temporary_path, cache->path);
+    if (!renamed) {
+        fprintf(stderr, "[ERROR] Failed to write program cache.\n");
+        remove(temporary_path);
+    }
+
+    for (size_t i = 0; i < cache->pending_count; ++i) {
+        free(cache->pending[i].binary);
+    }
+
+    cache->pending_count = 0;
+    cache->invalidated = false;
+
+    open_cache_file(cache);
+
+    end_trace("save_program_cache", stage);
+
+    return renamed;
+}
+
+/**
+ * Gets how many programs came from the cache, how many were compiled and how
+ * many cached binaries the driver rejected.
+ * 
+ * \param[in] cache Program cache.
+ * \return Statistics.
+ */
+program_cache_statistics get_program_cache_statistics(
+    const program_cache* cache) {
+    return cache->statistics;
+}
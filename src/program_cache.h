@@ -0,0 +1,83 @@
+/**
+ * \file program_cache.h
+ * \author Isaiah Lateer
+ * 
+ * Header file for the program cache struct and functions.
+ */
+
+#ifndef OPENGL_CONTEXT_PROGRAM_CACHE_HEADER
+#define OPENGL_CONTEXT_PROGRAM_CACHE_HEADER
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "window.h"
+
+typedef struct program_cache program_cache;
+
+typedef struct shader_source {
+    unsigned type;
+    const char* source;
+} shader_source;
+
+typedef struct program_cache_statistics {
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t rejected;
+} program_cache_statistics;
+
+/**
+ * Opens a program binary cache for a window's context, which must be current.
+ * Entries are keyed by a hash of the shader sources together with the
+ * context's vendor, renderer and version strings, and the whole cache is
+ * discarded when those strings change. Contexts older than OpenGL 4.1 or
+ * without binary formats compile every program.
+ * 
+ * \param[in] window Window.
+ * \param[in] path Cache file, or null for one in the user's cache directory.
+ * \return New program cache.
+ */
+program_cache* create_program_cache(window* window, const char* path);
+
+/**
+ * Saves newly linked programs, then destroys a program cache.
+ * 
+ * \param[in] cache Program cache.
+ */
+void destroy_program_cache(program_cache* cache);
+
+/**
+ * Gets a linked program for a set of shaders. The program is loaded from its
+ * cached binary when there is one the driver accepts, and otherwise compiled,
+ * linked and queued to be saved. Compile and link errors are printed.
+ * 
+ * \param[in] cache Program cache.
+ * \param[in] shaders Shader stages.
+ * \param[in] count Number of shader stages.
+ * \return Program name, or zero on failure.
+ */
+unsigned get_cached_program(program_cache* cache, const shader_source* shaders,
+    size_t count);
+
+/**
+ * Writes the cache file with every program linked since it was opened. The
+ * new file is written beside the old one and renamed over it, so other
+ * processes never map a partial cache.
+ * 
+ * \param[in] cache Program cache.
+ * \return Whether the cache was written or had nothing new.
+ */
+bool save_program_cache(program_cache* cache);
+
+/**
+ * Gets how many programs came from the cache, how many were compiled and how
+ * many cached binaries the driver rejected.
+ * 
+ * \param[in] cache Program cache.
+ * \return Statistics.
+ */
+program_cache_statistics get_program_cache_statistics(
+    const program_cache* cache);
+
+#endif
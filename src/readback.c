@@ -0,0 +1,230 @@
+/**
+ * \file readback.c
+ * \author Isaiah Lateer
+ * 
+ * Source file for the readback functions.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "opengl.h"
+#include "window.h"
+
+#define READBACK_TIMEOUT 1000000000
+
+typedef struct readback_slot {
+    GLuint buffer;
+    GLsync fence;
+    uint64_t frame;
+} readback_slot;
+
+typedef struct readback {
+    window* window;
+    unsigned width, height;
+    unsigned depth;
+    readback_callback callback;
+    void* user_data;
+    uint64_t frame;
+    uint64_t delivered;
+    readback_slot* slots;
+    PFNGLGENBUFFERSPROC glGenBuffers;
+    PFNGLDELETEBUFFERSPROC glDeleteBuffers;
+    PFNGLBINDBUFFERPROC glBindBuffer;
+    PFNGLBUFFERDATAPROC glBufferData;
+    PFNGLMAPBUFFERRANGEPROC glMapBufferRange;
+    PFNGLUNMAPBUFFERPROC glUnmapBuffer;
+    PFNGLBINDFRAMEBUFFERPROC glBindFramebuffer;
+    PFNGLFENCESYNCPROC glFenceSync;
+    PFNGLCLIENTWAITSYNCPROC glClientWaitSync;
+    PFNGLDELETESYNCPROC glDeleteSync;
+} readback;
+
+/**
+ * Maps a finished pixel buffer, hands it to the callback and releases the
+ * slot.
+ * 
+ * \param[in] readback Readback ring.
+ * \param[in] slot Slot to deliver.
+ */
+static void deliver_slot(readback* readback, readback_slot* slot) {
+    const GLsizeiptr size = (GLsizeiptr) readback->width * readback->height * 4;
+
+    readback->glBindBuffer(GL_PIXEL_PACK_BUFFER, slot->buffer);
+
+    const void* pixels = readback->glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0,
+        size, GL_MAP_READ_BIT);
+    if (pixels) {
+        readback->callback(pixels, readback->width, readback->height,
+            slot->frame, readback->user_data);
+        readback->glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    } else {
+        fprintf(stderr, "[ERROR] Failed to map pixel buffer.\n");
+    }
+
+    readback->glDeleteSync(slot->fence);
+    slot->fence = NULL;
+
+    ++readback->delivered;
+}
+
+/**
+ * Delivers frames in capture order until one is still being copied.
+ * 
+ * \param[in] readback Readback ring.
+ * \param[in] wait Whether to block on the oldest frame instead of stopping.
+ */
+static void deliver_finished(readback* readback, bool wait) {
+    while (readback->delivered < readback->frame) {
+        readback_slot* slot =
+            &readback->slots[readback->delivered % readback->depth];
+
+        const GLenum status = readback->glClientWaitSync(slot->fence,
+            GL_SYNC_FLUSH_COMMANDS_BIT, wait ? READBACK_TIMEOUT : 0);
+        if (status == GL_TIMEOUT_EXPIRED) {
+            return;
+        }
+
+        if (status == GL_WAIT_FAILED) {
+            fprintf(stderr, "[ERROR] Failed to wait for pixel buffer.\n");
+        }
+
+        deliver_slot(readback, slot);
+
+        wait = false;
+    }
+}
+
+/**
+ * Creates a readback ring for a window. The window's context must be current
+ * and support OpenGL 3.2 or ARB_sync.
+ * 
+ * \param[in] window Window.
+ * \param[in] width Capture width.
+ * \param[in] height Capture height.
+ * \param[in] depth Number of frames in flight, at least two.
+ * \param[in] callback Called with each captured frame.
+ * \param[in] user_data User data passed to the callback.
+ * \return New readback ring.
+ */
+readback* create_readback(window* window, unsigned width, unsigned height,
+    unsigned depth, readback_callback callback, void* user_data) {
+    if (depth < 2) {
+        fprintf(stderr, "[ERROR] Readback depth must be at least two.\n");
+        return NULL;
+    }
+
+    readback* readback = malloc(sizeof(struct readback));
+    memset(readback, 0, sizeof(struct readback));
+
+    readback->window = window;
+    readback->width = width;
+    readback->height = height;
+    readback->depth = depth;
+    readback->callback = callback;
+    readback->user_data = user_data;
+
+    readback->glGenBuffers = (PFNGLGENBUFFERSPROC)
+        get_procedure_address(window, "glGenBuffers");
+    readback->glDeleteBuffers = (PFNGLDELETEBUFFERSPROC)
+        get_procedure_address(window, "glDeleteBuffers");
+    readback->glBindBuffer = (PFNGLBINDBUFFERPROC)
+        get_procedure_address(window, "glBindBuffer");
+    readback->glBufferData = (PFNGLBUFFERDATAPROC)
+        get_procedure_address(window, "glBufferData");
+    readback->glMapBufferRange = (PFNGLMAPBUFFERRANGEPROC)
+        get_procedure_address(window, "glMapBufferRange");
+    readback->glUnmapBuffer = (PFNGLUNMAPBUFFERPROC)
+        get_procedure_address(window, "glUnmapBuffer");
+    readback->glBindFramebuffer = (PFNGLBINDFRAMEBUFFERPROC)
+        get_procedure_address(window, "glBindFramebuffer");
+    readback->glFenceSync = (PFNGLFENCESYNCPROC)
+        get_procedure_address(window, "glFenceSync");
+    readback->glClientWaitSync = (PFNGLCLIENTWAITSYNCPROC)
+        get_procedure_address(window, "glClientWaitSync");
+    readback->glDeleteSync = (PFNGLDELETESYNCPROC)
+        get_procedure_address(window, "glDeleteSync");
+
+    if (!readback->glGenBuffers || !readback->glDeleteBuffers
+        || !readback->glBindBuffer || !readback->glBufferData
+        || !readback->glMapBufferRange || !readback->glUnmapBuffer
+        || !readback->glBindFramebuffer || !readback->glFenceSync
+        || !readback->glClientWaitSync || !readback->glDeleteSync) {
+        fprintf(stderr, "[ERROR] Failed to load readback procedures.\n");
+
+        free(readback);
+
+        return NULL;
+    }
+
+    readback->slots = malloc(depth * sizeof(readback_slot));
+    memset(readback->slots, 0, depth * sizeof(readback_slot));
+
+    const GLsizeiptr size = (GLsizeiptr) width * height * 4;
+
+    for (unsigned i = 0; i < depth; ++i) {
+        readback->glGenBuffers(1, &readback->slots[i].buffer);
+        readback->glBindBuffer(GL_PIXEL_PACK_BUFFER,
+            readback->slots[i].buffer);
+        readback->glBufferData(GL_PIXEL_PACK_BUFFER, size, NULL,
+            GL_STREAM_READ);
+    }
+
+    readback->glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    return readback;
+}
+
+/**
+ * Delivers every frame still in flight, then destroys a readback ring.
+ * 
+ * \param[in] readback Readback ring.
+ */
+void destroy_readback(readback* readback) {
+    while (readback->delivered < readback->frame) {
+        deliver_finished(readback, true);
+    }
+
+    readback->glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    for (unsigned i = 0; i < readback->depth; ++i) {
+        readback->glDeleteBuffers(1, &readback->slots[i].buffer);
+    }
+
+    free(readback->slots);
+    free(readback);
+}
+
+/**
+ * Queues a copy of the window's default framebuffer into the next pixel
+ * buffer and delivers every earlier frame whose copy has finished. Only
+ * blocks when the ring is full. Call after rendering and before swapping.
+ * Leaves the pixel pack buffer unbound and the window's default framebuffer
+ * bound for reading.
+ * 
+ * \param[in] readback Readback ring.
+ */
+void capture_frame(readback* readback) {
+    // A wait can time out on a slow GPU, and the oldest slot must not be
+    // reused before its frame is delivered.
+    while (readback->frame - readback->delivered == readback->depth) {
+        deliver_finished(readback, true);
+    }
+
+    readback_slot* slot = &readback->slots[readback->frame % readback->depth];
+
+    readback->glBindFramebuffer(GL_READ_FRAMEBUFFER,
+        get_default_framebuffer(readback->window));
+    readback->glBindBuffer(GL_PIXEL_PACK_BUFFER, slot->buffer);
+
+    glReadPixels(0, 0, readback->width, readback->height, GL_BGRA,
+        GL_UNSIGNED_BYTE, NULL);
+
+    slot->fence = readback->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot->frame = readback->frame++;
+
+    deliver_finished(readback, false);
+
+    readback->glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
@@ -0,0 +1,192 @@
+/**
+ * \file render_thread.c
+ * \author Isaiah Lateer
+ * 
+ * Source file for the render thread functions.
+ */
+
+#include "render_thread.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "thread.h"
+
+#define CACHE_LINE_SIZE 64
+
+typedef struct render_thread {
+    window* window;
+    frame_pacer* pacer;
+    render_function render;
+    void* user_data;
+    thread* thread;
+    atomic_bool running;
+    atomic_bool stopping;
+
+    // The producer only writes the tail and the consumer only writes the
+    // head, so each sits on its own cache line.
+    _Alignas(CACHE_LINE_SIZE) atomic_size_t head;
+    _Alignas(CACHE_LINE_SIZE) atomic_size_t tail;
+    render_message messages[RENDER_QUEUE_CAPACITY];
+} render_thread;
+
+/**
+ * Takes every message posted so far off the queue.
+ * 
+ * \param[in] thread Render thread.
+ * \param[out] messages Array of at least RENDER_QUEUE_CAPACITY messages.
+ * \return Number of messages taken.
+ */
+static size_t take_render_messages(render_thread* thread,
+    render_message* messages) {
+    const size_t head =
+        atomic_load_explicit(&thread->head, memory_order_relaxed);
+    const size_t tail =
+        atomic_load_explicit(&thread->tail, memory_order_acquire);
+
+    for (size_t i = head; i != tail; ++i) {
+        messages[i - head] = thread->messages[i % RENDER_QUEUE_CAPACITY];
+    }
+
+    atomic_store_explicit(&thread->head, tail, memory_order_release);
+
+    return tail - head;
+}
+
+/**
+ * Makes the window's context current and renders until stopped. Wakes the
+ * window on exit so an event thread waiting on it notices.
+ * 
+ * \param[in] data Render thread.
+ */
+static void run_render_thread(void* data) {
+    render_thread* thread = data;
+
+    if (!make_current(thread->window)) {
+        atomic_store(&thread->running, false);
+        wake_window(thread->window);
+        return;
+    }
+
+    render_message messages[RENDER_QUEUE_CAPACITY];
+
+    while (!atomic_load_explicit(&thread->stopping, memory_order_relaxed)) {
+        if (thread->pacer) {
+            begin_frame(thread->pacer);
+        }
+
+        const size_t count = take_render_messages(thread, messages);
+
+        if (!thread->render(thread->window, messages, count,
+            thread->user_data)) {
+            break;
+        }
+
+        if (thread->pacer) {
+            begin_swap(thread->pacer);
+        }
+
+        swap_buffer(thread->window);
+
+        if (thread->pacer) {
+            end_frame(thread->pacer);
+        }
+    }
+
+    release_current(thread->window);
+
+    atomic_store(&thread->running, false);
+    wake_window(thread->window);
+}
+
+/**
+ * Starts a thread that makes the window's context current and renders frames
+ * until it is stopped. The window's context must not be current on any other
+ * thread. The frame pacer, if given, is only used by the render thread until
+ * it is stopped.
+ * 
+ * \param[in] window Window.
+ * \param[in] pacer Frame pacer, or null.
+ * \param[in] render Called once per frame.
+ * \param[in] user_data User data passed to the render function.
+ * \return New render thread.
+ */
+render_thread* start_render_thread(window* window, frame_pacer* pacer,
+    render_function render, void* user_data) {
+    render_thread* thread = malloc(sizeof(struct render_thread));
+    memset(thread, 0, sizeof(struct render_thread));
+
+    thread->window = window;
+    thread->pacer = pacer;
+    thread->render = render;
+    thread->user_data = user_data;
+
+    atomic_init(&thread->running, true);
+    atomic_init(&thread->stopping, false);
+    atomic_init(&thread->head, 0);
+    atomic_init(&thread->tail, 0);
+
+    thread->thread = create_thread(run_render_thread, thread);
+    if (!thread->thread) {
+        free(thread);
+        return NULL;
+    }
+
+    return thread;
+}
+
+/**
+ * Stops a render thread, waits for it to release the window's context, then
+ * destroys it.
+ * 
+ * \param[in] thread Render thread.
+ */
+void stop_render_thread(render_thread* thread) {
+    // The stopping flag ends the thread even if a full queue drops the
+    // close message.
+    const render_message message = { .type = RENDER_MESSAGE_CLOSE };
+    post_render_message(thread, &message);
+
+    atomic_store(&thread->stopping, true);
+
+    join_thread(thread->thread);
+
+    free(thread);
+}
+
+/**
+ * Posts a message to the render thread without blocking. Must only be called
+ * from one thread at a time.
+ * 
+ * \param[in] thread Render thread.
+ * \param[in] message Message.
+ * \return Whether there was room for the message.
+ */
+bool post_render_message(render_thread* thread,
+    const render_message* message) {
+    const size_t tail =
+        atomic_load_explicit(&thread->tail, memory_order_relaxed);
+    const size_t head =
+        atomic_load_explicit(&thread->head, memory_order_acquire);
+
+    if (tail - head == RENDER_QUEUE_CAPACITY) {
+        return false;
+    }
+
+    thread->messages[tail % RENDER_QUEUE_CAPACITY] = *message;
+
+    atomic_store_explicit(&thread->tail, tail + 1, memory_order_release);
+
+    return true;
+}
+
+/**
+ * Checks whether the render thread is still rendering.
+ * 
+ * \param[in] thread Render thread.
+ * \return Whether the render thread is running.
+ */
+bool is_render_thread_running(const render_thread* thread) {
+    return atomic_load(&thread->running);
+}
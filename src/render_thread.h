@@ -0,0 +1,87 @@
+/**
+ * \file render_thread.h
+ * \author Isaiah Lateer
+ * 
+ * Header file for the render thread struct and functions.
+ */
+
+#ifndef OPENGL_CONTEXT_RENDER_THREAD_HEADER
+#define OPENGL_CONTEXT_RENDER_THREAD_HEADER
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "frame_pacer.h"
+#include "window.h"
+
+#define RENDER_QUEUE_CAPACITY 256
+
+typedef struct render_thread render_thread;
+
+typedef enum render_message_type {
+    RENDER_MESSAGE_CLOSE,
+    RENDER_MESSAGE_RESIZE,
+    RENDER_MESSAGE_EVENT
+} render_message_type;
+
+typedef struct render_message {
+    render_message_type type;
+    unsigned width, height;
+    window_event event;
+} render_message;
+
+/**
+ * Renders a frame on the render thread. The buffers are swapped after it
+ * returns.
+ * 
+ * \param[in] window Window.
+ * \param[in] messages Messages posted since the previous frame, oldest first.
+ * \param[in] count Number of messages.
+ * \param[in] user_data User data given to start_render_thread().
+ * \return Whether to keep rendering.
+ */
+typedef bool (*render_function)(window* window,
+    const render_message* messages, size_t count, void* user_data);
+
+/**
+ * Starts a thread that makes the window's context current and renders frames
+ * until it is stopped. The window's context must not be current on any other
+ * thread. The frame pacer, if given, is only used by the render thread until
+ * it is stopped.
+ * 
+ * \param[in] window Window.
+ * \param[in] pacer Frame pacer, or null.
+ * \param[in] render Called once per frame.
+ * \param[in] user_data User data passed to the render function.
+ * \return New render thread.
+ */
+render_thread* start_render_thread(window* window, frame_pacer* pacer,
+    render_function render, void* user_data);
+
+/**
+ * Stops a render thread, waits for it to release the window's context, then
+ * destroys it.
+ * 
+ * \param[in] thread Render thread.
+ */
+void stop_render_thread(render_thread* thread);
+
+/**
+ * Posts a message to the render thread without blocking. Must only be called
+ * from one thread at a time.
+ * 
+ * \param[in] thread Render thread.
+ * \param[in] message Message.
+ * \return Whether there was room for the message.
+ */
+bool post_render_message(render_thread* thread, const render_message* message);
+
+/**
+ * Checks whether the render thread is still rendering.
+ * 
+ * \param[in] thread Render thread.
+ * \return Whether the render thread is running.
+ */
+bool is_render_thread_running(const render_thread* thread);
+
+#endif
@@ -0,0 +1,50 @@
+/**
+ * \file shared_context.h
+ * \author Isaiah Lateer
+ *
+ * Header file for the shared context struct and functions. Implemented by
+ * each window backend and used by the context pool.
+ */
+
+#ifndef OPENGL_CONTEXT_SHARED_CONTEXT_HEADER
+#define OPENGL_CONTEXT_SHARED_CONTEXT_HEADER
+
+#include <stdbool.h>
+
+#include "window.h"
+
+typedef struct shared_context shared_context;
+
+/**
+ * Creates a context that shares objects with the window's context and has
+ * the same version and error mode. It has no window of its own; it renders
+ * into a 1x1 pbuffer or, where the driver allows, no surface at all.
+ *
+ * \param[in] window Window.
+ * \return New shared context.
+ */
+shared_context* create_shared_context(window* window);
+
+/**
+ * Destroys a shared context. It must not be current on any thread.
+ *
+ * \param[in] context Shared context.
+ */
+void destroy_shared_context(shared_context* context);
+
+/**
+ * Makes a shared context current on the calling thread.
+ *
+ * \param[in] context Shared context.
+ * \return Whether the context was made current.
+ */
+bool make_shared_context_current(shared_context* context);
+
+/**
+ * Releases a shared context from the calling thread.
+ *
+ * \param[in] context Shared context.
+ */
+void release_shared_context(shared_context* context);
+
+#endif
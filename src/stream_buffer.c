@@ -0,0 +1,320 @@
+/**
+ * \file stream_buffer.c
+ * \author Isaiah Lateer
+ * 
+ * Source file for the stream buffer functions.
+ */
+
+#include "stream_buffer.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "opengl.h"
+
+#define STREAM_TIMEOUT 1000000000
+
+typedef struct stream_buffer {
+    GLenum target;
+    GLuint buffer;
+    size_t frame_size;
+    unsigned frames;
+    unsigned frame;
+    size_t used;
+    size_t cursor;
+    bool persistent;
+    bool frame_ready;
+    unsigned char* mapping;
+    GLsync* fences;
+    PFNGLGENBUFFERSPROC glGenBuffers;
+    PFNGLDELETEBUFFERSPROC glDeleteBuffers;
+    PFNGLBINDBUFFERPROC glBindBuffer;
+    PFNGLBUFFERDATAPROC glBufferData;
+    PFNGLBUFFERSTORAGEPROC glBufferStorage;
+    PFNGLMAPBUFFERRANGEPROC glMapBufferRange;
+    PFNGLUNMAPBUFFERPROC glUnmapBuffer;
+    PFNGLFENCESYNCPROC glFenceSync;
+    PFNGLCLIENTWAITSYNCPROC glClientWaitSync;
+    PFNGLDELETESYNCPROC glDeleteSync;
+} stream_buffer;
+
+/**
+ * Waits for the GPU to finish reading the current frame's region from the
+ * last time it was used. Timeouts only mean the GPU is slow, so the wait goes
+ * on until the fence signals or the wait fails.
+ * 
+ * \param[in] stream Stream buffer.
+ * \return Whether the region is free to write.
+ */
+static bool wait_for_region(stream_buffer* stream) {
+    GLsync* fence = &stream->fences[stream->frame];
+    if (!*fence) {
+        return true;
+    }
+
+    GLenum status;
+    do {
+        status = stream->glClientWaitSync(*fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+            STREAM_TIMEOUT);
+    } while (status == GL_TIMEOUT_EXPIRED);
+
+    if (status == GL_WAIT_FAILED) {
+        fprintf(stderr, "[ERROR] Failed to wait for stream buffer.\n");
+        return false;
+    }
+
+    stream->glDeleteSync(*fence);
+    *fence = NULL;
+
+    return true;
+}
+
+/**
+ * Creates a buffer for streaming data the GPU reads once, such as dynamic
+ * geometry. On OpenGL 4.4 and later it is mapped once, persistently and
+ * coherently, and split into one region per frame in flight, each guarded by
+ * a fence. Older contexts map unsynchronized ranges and orphan the buffer
+ * when it fills. The window's context must be current and support OpenGL 3.2
+ * or ARB_sync.
+ * 
+ * \param[in] window Window.
+ * \param[in] target Buffer target used to bind the buffer, such as
+ * GL_ARRAY_BUFFER.
+ * \param[in] frame_size Bytes that can be streamed per frame.
+ * \param[in] frames Number of frames in flight, at least one.
+ * \return New stream buffer.
+ */
+stream_buffer* create_stream_buffer(window* window, unsigned target,
+    size_t frame_size, unsigned frames) {
+    if (!frame_size || !frames) {
+        fprintf(stderr, "[ERROR] Stream buffer must not be empty.\n");
+        return NULL;
+    }
+
+    stream_buffer* stream = malloc(sizeof(struct stream_buffer));
+    memset(stream, 0, sizeof(struct stream_buffer));
+
+    stream->target = target;
+    stream->frame_size = frame_size;
+    stream->frames = frames;
+
+    stream->glGenBuffers = (PFNGLGENBUFFERSPROC)
+        get_procedure_address(window, "glGenBuffers");
+    stream->glDeleteBuffers = (PFNGLDELETEBUFFERSPROC)
+        get_procedure_address(window, "glDeleteBuffers");
+    stream->glBindBuffer = (PFNGLBINDBUFFERPROC)
+        get_procedure_address(window, "glBindBuffer");
+    stream->glBufferData = (PFNGLBUFFERDATAPROC)
+        get_procedure_address(window, "glBufferData");
+    stream->glMapBufferRange = (PFNGLMAPBUFFERRANGEPROC)
+        get_procedure_address(window, "glMapBufferRange");
+    stream->glUnmapBuffer = (PFNGLUNMAPBUFFERPROC)
+        get_procedure_address(window, "glUnmapBuffer");
+    stream->glFenceSync = (PFNGLFENCESYNCPROC)
+        get_procedure_address(window, "glFenceSync");
+    stream->glClientWaitSync = (PFNGLCLIENTWAITSYNCPROC)
+        get_procedure_address(window, "glClientWaitSync");
+    stream->glDeleteSync = (PFNGLDELETESYNCPROC)
+        get_procedure_address(window, "glDeleteSync");
+
+    if (!stream->glGenBuffers || !stream->glDeleteBuffers
+        || !stream->glBindBuffer || !stream->glBufferData
+        || !stream->glMapBufferRange || !stream->glUnmapBuffer
+        || !stream->glFenceSync || !stream->glClientWaitSync
+        || !stream->glDeleteSync) {
+        fprintf(stderr, "[ERROR] Failed to load stream buffer procedures.\n");
+
+        free(stream);
+
+        return NULL;
+    }
+
+    const version version = get_context_version(window);
+    if (version.major > 4 || (version.major == 4 && version.minor >= 4)) {
+        stream->glBufferStorage = (PFNGLBUFFERSTORAGEPROC)
+            get_procedure_address(window, "glBufferStorage");
+        stream->persistent = stream->glBufferStorage != NULL;
+    }
+
+    const GLsizeiptr size = (GLsizeiptr) (frame_size * frames);
+
+    stream->glGenBuffers(1, &stream->buffer);
+    stream->glBindBuffer(target, stream->buffer);
+
+    if (stream->persistent) {
+        const GLbitfield flags =
+            GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+        stream->glBufferStorage(target, size, NULL, flags);
+        stream->mapping = stream->glMapBufferRange(target, 0, size, flags);
+        if (!stream->mapping) {
+            fprintf(stderr, "[ERROR] Failed to map stream buffer.\n");
+
+            stream->glBindBuffer(target, 0);
+            stream->glDeleteBuffers(1, &stream->buffer);
+
+            free(stream);
+
+            return NULL;
+        }
+    } else {
+        stream->glBufferData(target, size, NULL, GL_STREAM_DRAW);
+    }
+
+    stream->glBindBuffer(target, 0);
+
+    stream->fences = malloc(frames * sizeof(GLsync));
+    memset(stream->fences, 0, frames * sizeof(GLsync));
+
+    return stream;
+}
+
+/**
+ * Destroys a stream buffer.
+ * 
+ * \param[in] stream Stream buffer.
+ */
+void destroy_stream_buffer(stream_buffer* stream) {
+    for (unsigned i = 0; i < stream->frames; ++i) {
+        if (stream->fences[i]) {
+            stream->glDeleteSync(stream->fences[i]);
+        }
+    }
+
+    // Deleting a buffer unmaps it.
+    stream->glDeleteBuffers(1, &stream->buffer);
+
+    free(stream->fences);
+    free(stream);
+}
+
+/**
+ * Reserves space in the current frame's region and returns where to write
+ * it. The first reservation of a frame waits for the GPU to finish with the
+ * region if it is still in use. Without persistent mapping this leaves the
+ * buffer bound to its target.
+ * 
+ * \param[in] stream Stream buffer.
+ * \param[in] size Bytes to reserve.
+ * \param[in] alignment Alignment of the offset, or zero for none.
+ * \param[out] offset Offset of the reserved space in the buffer.
+ * \return Pointer to write to, or null if the frame's region is full or the
+ * wait for it failed.
+ */
+void* map_stream_buffer(stream_buffer* stream, size_t size, size_t alignment,
+    size_t* offset) {
+    if (!alignment) {
+        alignment = 1;
+    }
+
+    if (stream->persistent) {
+        // Offsets are aligned within the whole buffer, since frame regions
+        // need not start on a multiple of the alignment.
+        const size_t base = stream->frame * stream->frame_size;
+        const size_t start = (base + stream->used + alignment - 1)
+            / alignment * alignment - base;
+        if (start > stream->frame_size || size > stream->frame_size - start) {
+            return NULL;
+        }
+
+        if (!stream->frame_ready) {
+            if (!wait_for_region(stream)) {
+                return NULL;
+            }
+
+            stream->frame_ready = true;
+        }
+
+        stream->used = start + size;
+        *offset = base + start;
+
+        return stream->mapping + *offset;
+    }
+
+    // Without persistent mapping the frame regions only cap how much a
+    // frame can stream; writes go wherever the cursor is and the buffer is
+    // orphaned when it fills, so the driver handles synchronization.
+    if (size > stream->frame_size - stream->used) {
+        return NULL;
+    }
+
+    const size_t capacity = stream->frame_size * stream->frames;
+
+    size_t start = (stream->cursor + alignment - 1) / alignment * alignment;
+    GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT
+        | GL_MAP_INVALIDATE_RANGE_BIT;
+
+    stream->glBindBuffer(stream->target, stream->buffer);
+
+    if (start > capacity || size > capacity - start) {
+        stream->glBufferData(stream->target, (GLsizeiptr) capacity, NULL,
+            GL_STREAM_DRAW);
+        start = 0;
+        flags = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT;
+    }
+
+    void* pointer = stream->glMapBufferRange(stream->target,
+        (GLintptr) start, (GLsizeiptr) size, flags);
+    if (!pointer) {
+        fprintf(stderr, "[ERROR] Failed to map stream buffer.\n");
+        return NULL;
+    }
+
+    stream->used += size;
+    stream->cursor = start + size;
+    *offset = start;
+
+    return pointer;
+}
+
+/**
+ * Finishes writing the space reserved by map_stream_buffer(). Must be called
+ * before drawing from it.
+ * 
+ * \param[in] stream Stream buffer.
+ */
+void unmap_stream_buffer(stream_buffer* stream) {
+    if (!stream->persistent) {
+        stream->glUnmapBuffer(stream->target);
+    }
+}
+
+/**
+ * Fences the commands that read the current frame's region and moves on to
+ * the next one. Call once per frame after the last draw that uses the
+ * buffer.
+ * 
+ * \param[in] stream Stream buffer.
+ */
+void end_stream_frame(stream_buffer* stream) {
+    if (stream->persistent && stream->frame_ready) {
+        stream->fences[stream->frame] =
+            stream->glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        stream->frame = (stream->frame + 1) % stream->frames;
+    }
+
+    stream->used = 0;
+    stream->frame_ready = false;
+}
+
+/**
+ * Gets the name of the buffer object to bind for drawing.
+ * 
+ * \param[in] stream Stream buffer.
+ * \return Buffer object name.
+ */
+unsigned get_stream_buffer_name(const stream_buffer* stream) {
+    return stream->buffer;
+}
+
+/**
+ * Checks whether the buffer is persistently mapped or falls back to
+ * orphaning.
+ * 
+ * \param[in] stream Stream buffer.
+ * \return Whether the buffer is persistently mapped.
+ */
+bool is_stream_buffer_persistent(const stream_buffer* stream) {
+    return stream->persistent;
+}
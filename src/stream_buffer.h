@@ -0,0 +1,93 @@
+/**
+ * \file stream_buffer.h
+ * \author Isaiah Lateer
+ * 
+ * Header file for the stream buffer struct and functions.
+ */
+
+#ifndef OPENGL_CONTEXT_STREAM_BUFFER_HEADER
+#define OPENGL_CONTEXT_STREAM_BUFFER_HEADER
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "window.h"
+
+typedef struct stream_buffer stream_buffer;
+
+/**
+ * Creates a buffer for streaming data the GPU reads once, such as dynamic
+ * geometry. On OpenGL 4.4 and later it is mapped once, persistently and
+ * coherently, and split into one region per frame in flight, each guarded by
+ * a fence. Older contexts map unsynchronized ranges and orphan the buffer
+ * when it fills. The window's context must be current and support OpenGL 3.2
+ * or ARB_sync.
+ * 
+ * \param[in] window Window.
+ * \param[in] target Buffer target used to bind the buffer, such as
+ * GL_ARRAY_BUFFER.
+ * \param[in] frame_size Bytes that can be streamed per frame.
+ * \param[in] frames Number of frames in flight, at least one.
+ * \return New stream buffer.
+ */
+stream_buffer* create_stream_buffer(window* window, unsigned target,
+    size_t frame_size, unsigned frames);
+
+/**
+ * Destroys a stream buffer.
+ * 
+ * \param[in] stream Stream buffer.
+ */
+void destroy_stream_buffer(stream_buffer* stream);
+
+/**
+ * Reserves space in the current frame's region and returns where to write
+ * it. The first reservation of a frame waits for the GPU to finish with the
+ * region if it is still in use. Without persistent mapping this leaves the
+ * buffer bound to its target.
+ * 
+ * \param[in] stream Stream buffer.
+ * \param[in] size Bytes to reserve.
+ * \param[in] alignment Alignment of the offset, or zero for none.
+ * \param[out] offset Offset of the reserved space in the buffer.
+ * \return Pointer to write to, or null if the frame's region is full or the
+ * wait for it failed.
+ */
+void* map_stream_buffer(stream_buffer* stream, size_t size, size_t alignment,
+    size_t* offset);
+
+/**
+ * Finishes writing the space reserved by map_stream_buffer(). Must be called
+ * before drawing from it.
+ * 
+ * \param[in] stream Stream buffer.
+ */
+void unmap_stream_buffer(stream_buffer* stream);
+
+/**
+ * Fences the commands that read the current frame's region and moves on to
+ * the next one. Call once per frame after the last draw that uses the
+ * buffer.
+ * 
+ * \param[in] stream Stream buffer.
+ */
+void end_stream_frame(stream_buffer* stream);
+
+/**
+ * Gets the name of the buffer object to bind for drawing.
+ * 
+ * \param[in] stream Stream buffer.
+ * \return Buffer object name.
+ */
+unsigned get_stream_buffer_name(const stream_buffer* stream);
+
+/**
+ * Checks whether the buffer is persistently mapped or falls back to
+ * orphaning.
+ * 
+ * \param[in] stream Stream buffer.
+ * \return Whether the buffer is persistently mapped.
+ */
+bool is_stream_buffer_persistent(const stream_buffer* stream);
+
+#endif
@@ -0,0 +1,94 @@
+/**
+ * \file thread.h
+ * \author Isaiah Lateer
+ * 
+ * Header file for the thread struct and functions.
+ */
+
+#ifndef OPENGL_CONTEXT_THREAD_HEADER
+#define OPENGL_CONTEXT_THREAD_HEADER
+
+typedef struct thread thread;
+
+typedef struct mutex mutex;
+
+typedef struct condition condition;
+
+typedef void (*thread_function)(void* data);
+
+/**
+ * Starts a thread.
+ * 
+ * \param[in] function Function the thread runs.
+ * \param[in] data Data passed to the function.
+ * \return New thread.
+ */
+thread* create_thread(thread_function function, void* data);
+
+/**
+ * Waits for a thread to finish, then destroys it.
+ * 
+ * \param[in] thread Thread.
+ */
+void join_thread(thread* thread);
+
+/**
+ * Creates a mutex.
+ * 
+ * \return New mutex.
+ */
+mutex* create_mutex(void);
+
+/**
+ * Destroys a mutex. It must not be locked.
+ * 
+ * \param[in] mutex Mutex.
+ */
+void destroy_mutex(mutex* mutex);
+
+/**
+ * Locks a mutex, waiting for another thread to unlock it if needed.
+ * 
+ * \param[in] mutex Mutex.
+ */
+void lock_mutex(mutex* mutex);
+
+/**
+ * Unlocks a mutex locked by the calling thread.
+ * 
+ * \param[in] mutex Mutex.
+ */
+void unlock_mutex(mutex* mutex);
+
+/**
+ * Creates a condition variable.
+ * 
+ * \return New condition variable.
+ */
+condition* create_condition(void);
+
+/**
+ * Destroys a condition variable. No thread may be waiting on it.
+ * 
+ * \param[in] condition Condition variable.
+ */
+void destroy_condition(condition* condition);
+
+/**
+ * Unlocks a mutex and waits for the condition variable to be signalled, then
+ * locks the mutex again. Can wake without a signal, so callers recheck their
+ * condition in a loop.
+ * 
+ * \param[in] condition Condition variable.
+ * \param[in] mutex Mutex locked by the calling thread.
+ */
+void wait_condition(condition* condition, mutex* mutex);
+
+/**
+ * Wakes one thread waiting on a condition variable.
+ * 
+ * \param[in] condition Condition variable.
+ */
+void signal_condition(condition* condition);
+
+#endif
@@ -0,0 +1,28 @@
+/**
+ * \file timer.h
+ * \author Isaiah Lateer
+ * 
+ * Header file for the timer functions.
+ */
+
+#ifndef OPENGL_CONTEXT_TIMER_HEADER
+#define OPENGL_CONTEXT_TIMER_HEADER
+
+#include <stdint.h>
+
+/**
+ * Gets the current time from a monotonic clock.
+ * 
+ * \return Time in nanoseconds.
+ */
+uint64_t get_time(void);
+
+/**
+ * Sleeps until the monotonic clock reaches the given time. Returns immediately
+ * if the time has already passed.
+ * 
+ * \param[in] time Time in nanoseconds.
+ */
+void sleep_until(uint64_t time);
+
+#endif
@@ -0,0 +1,204 @@
+/**
+ * \file trace.c
+ * \author Isaiah Lateer
+ * 
+ * Source file for the trace functions.
+ */
+
+#include "trace.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "timer.h"
+
+#define MAX_EVENTS 4096
+#define MAX_STAGES 64
+
+typedef enum trace_state {
+    TRACE_UNINITIALIZED,
+    TRACE_DISABLED,
+    TRACE_ENABLED
+} trace_state;
+
+static trace_event events[MAX_EVENTS];
+static atomic_size_t event_count = 0;
+static atomic_int state = TRACE_UNINITIALIZED;
+static bool json_output = false;
+
+/**
+ * Writes the trace to the file named by the environment on exit.
+ */
+static void write_trace_on_exit(void) {
+    const char* path = getenv("OPENGL_CONTEXT_TRACE_FILE");
+
+    FILE* stream = path && *path ? fopen(path, "w") : stderr;
+    if (!stream) {
+        fprintf(stderr, "[ERROR] Failed to open trace file.\n");
+        return;
+    }
+
+    write_trace(stream, json_output);
+
+    if (stream != stderr) {
+        fclose(stream);
+    }
+}
+
+/**
+ * Checks if tracing is enabled. Tracing is enabled by setting the
+ * OPENGL_CONTEXT_TRACE environment variable to "text" or "json", in which case
+ * the trace is written on exit to OPENGL_CONTEXT_TRACE_FILE, or to stderr if
+ * no file is given.
+ * 
+ * \return Whether tracing is enabled.
+ */
+bool is_tracing(void) {
+    int current = atomic_load_explicit(&state, memory_order_relaxed);
+    if (current != TRACE_UNINITIALIZED) {
+        return current == TRACE_ENABLED;
+    }
+
+    const char* format = getenv("OPENGL_CONTEXT_TRACE");
+    const bool enabled = format
+        && (!strcmp(format, "text") || !strcmp(format, "json"));
+
+    int expected = TRACE_UNINITIALIZED;
+    if (atomic_compare_exchange_strong(&state, &expected,
+        enabled ? TRACE_ENABLED : TRACE_DISABLED) && enabled) {
+        json_output = !strcmp(format, "json");
+        atexit(write_trace_on_exit);
+    }
+
+    return atomic_load(&state) == TRACE_ENABLED;
+}
+
+/**
+ * Enables or disables tracing, overriding the environment.
+ * 
+ * \param[in] enabled Whether to trace.
+ */
+void set_tracing(bool enabled) {
+    atomic_store(&state, enabled ? TRACE_ENABLED : TRACE_DISABLED);
+}
+
+/**
+ * Starts timing a traced stage.
+ * 
+ * \return Stage start time, or zero if tracing is disabled.
+ */
+uint64_t begin_trace(void) {
+    return is_tracing() ? get_time() : 0;
+}
+
+/**
+ * Records a traced stage. Does nothing if tracing is disabled or the event
+ * buffer is full.
+ * 
+ * \param[in] name Stage name, the function or call the stage times. Must
+ * outlive the trace.
+ * \param[in] start Stage start time from begin_trace().
+ */
+void end_trace(const char* name, uint64_t start) {
+    if (!start || !is_tracing()) {
+        return;
+    }
+
+    const uint64_t end = get_time();
+
+    const size_t index = atomic_fetch_add(&event_count, 1);
+    if (index >= MAX_EVENTS) {
+        atomic_store(&event_count, MAX_EVENTS);
+        return;
+    }
+
+    events[index].name = name;
+    events[index].start = start;
+    events[index].duration = end - start;
+}
+
+/**
+ * Gets the recorded trace events.
+ * 
+ * \param[out] count Number of events.
+ * \return Events in the order they ended.
+ */
+const trace_event* get_trace_events(size_t* count) {
+    *count = atomic_load(&event_count);
+    return events;
+}
+
+/**
+ * Discards the recorded trace events.
+ */
+void clear_trace_events(void) {
+    atomic_store(&event_count, 0);
+}
+
+/**
+ * Writes the recorded trace events, either as Chrome trace event JSON or as a
+ * text summary of each stage.
+ * 
+ * \param[in] stream Output stream.
+ * \param[in] json Whether to write JSON.
+ */
+void write_trace(FILE* stream, bool json) {
+    size_t count = atomic_load(&event_count);
+
+    if (json) {
+        fprintf(stream, "{\"traceEvents\":[");
+
+        for (size_t i = 0; i < count; ++i) {
+            fprintf(stream, "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,"
+                "\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}", i ? "," : "",
+                events[i].name, events[i].start / 1e3,
+                events[i].duration / 1e3);
+        }
+
+        fprintf(stream, "\n]}\n");
+
+        return;
+    }
+
+    struct {
+        const char* name;
+        uint64_t count;
+        uint64_t total;
+        uint64_t max;
+    } stages[MAX_STAGES];
+    int stage_count = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        int stage = 0;
+        while (stage < stage_count && strcmp(stages[stage].name,
+            events[i].name)) {
+            ++stage;
+        }
+
+        if (stage == stage_count) {
+            if (stage_count == MAX_STAGES) {
+                continue;
+            }
+
+            stages[stage].name = events[i].name;
+            stages[stage].count = 0;
+            stages[stage].total = 0;
+            stages[stage].max = 0;
+            ++stage_count;
+        }
+
+        ++stages[stage].count;
+        stages[stage].total += events[i].duration;
+        if (events[i].duration > stages[stage].max) {
+            stages[stage].max = events[i].duration;
+        }
+    }
+
+    for (int i = 0; i < stage_count; ++i) {
+        fprintf(stream, "[INFO] %-28s %6llu calls, mean %9.3f ms, "
+            "max %9.3f ms\n", stages[i].name,
+            (unsigned long long) stages[i].count,
+            stages[i].total / 1e6 / stages[i].count, stages[i].max / 1e6);
+    }
+}
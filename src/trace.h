@@ -0,0 +1,78 @@
+/**
+ * \file trace.h
+ * \author Isaiah Lateer
+ * 
+ * Header file for the trace event struct and functions.
+ */
+
+#ifndef OPENGL_CONTEXT_TRACE_HEADER
+#define OPENGL_CONTEXT_TRACE_HEADER
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+typedef struct trace_event {
+    const char* name;
+    uint64_t start;
+    uint64_t duration;
+} trace_event;
+
+/**
+ * Checks if tracing is enabled. Tracing is enabled by setting the
+ * OPENGL_CONTEXT_TRACE environment variable to "text" or "json", in which case
+ * the trace is written on exit to OPENGL_CONTEXT_TRACE_FILE, or to stderr if
+ * no file is given.
+ * 
+ * \return Whether tracing is enabled.
+ */
+bool is_tracing(void);
+
+/**
+ * Enables or disables tracing, overriding the environment.
+ * 
+ * \param[in] enabled Whether to trace.
+ */
+void set_tracing(bool enabled);
+
+/**
+ * Starts timing a traced stage.
+ * 
+ * \return Stage start time, or zero if tracing is disabled.
+ */
+uint64_t begin_trace(void);
+
+/**
+ * Records a traced stage. Does nothing if tracing is disabled or the event
+ * buffer is full.
+ * 
+ * \param[in] name Stage name, the function or call the stage times. Must
+ * outlive the trace.
+ * \param[in] start Stage start time from begin_trace().
+ */
+void end_trace(const char* name, uint64_t start);
+
+/**
+ * Gets the recorded trace events.
+ * 
+ * \param[out] count Number of events.
+ * \return Events in the order they ended.
+ */
+const trace_event* get_trace_events(size_t* count);
+
+/**
+ * Discards the recorded trace events.
+ */
+void clear_trace_events(void);
+
+/**
+ * Writes the recorded trace events, either as Chrome trace event JSON or as a
+ * text summary of each stage.
+ * 
+ * \param[in] stream Output stream.
+ * \param[in] json Whether to write JSON.
+ */
+void write_trace(FILE* stream, bool json);
+
+#endif
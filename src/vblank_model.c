@@ -0,0 +1,90 @@
+/**
+ * \file vblank_model.c
+ * \author Isaiah Lateer
+ * 
+ * Source file for the vblank model functions.
+ */
+
+#include "vblank_model.h"
+
+/**
+ * Resets a vblank model to the default refresh period with no anchor.
+ * 
+ * \param[in] model Vblank model.
+ */
+void reset_vblank_model(vblank_model* model) {
+    model->period = DEFAULT_REFRESH_PERIOD;
+    model->time = 0;
+    model->msc = 0;
+    model->anchored = false;
+    model->measured = false;
+}
+
+/**
+ * Sets the refresh period reported by the driver.
+ * 
+ * \param[in] model Vblank model.
+ * \param[in] period Refresh period in nanoseconds.
+ */
+void set_vblank_period(vblank_model* model, uint64_t period) {
+    if (period) {
+        model->period = period;
+        model->measured = true;
+    }
+}
+
+/**
+ * Anchors the model to an observed vblank. Unless the driver reported the
+ * refresh period, it is measured from the distance to the previous anchor.
+ * 
+ * \param[in] model Vblank model.
+ * \param[in] time Time of the vblank in nanoseconds.
+ * \param[in] msc Vblank counter at that time.
+ */
+void observe_vblank(vblank_model* model, uint64_t time, uint64_t msc) {
+    if (model->anchored && !model->measured && msc > model->msc
+        && time > model->time) {
+        const uint64_t period = (time - model->time) / (msc - model->msc);
+
+        // Averaging over a few samples smooths out timestamp jitter without
+        // lagging far behind a mode change.
+        model->period = (model->period * 3 + period) / 4;
+    }
+
+    model->time = time;
+    model->msc = msc;
+    model->anchored = true;
+}
+
+/**
+ * Gets the first vblank after a time, anchoring the model there if it has no
+ * anchor yet.
+ * 
+ * \param[in] model Vblank model.
+ * \param[in] now Time in nanoseconds.
+ * \param[out] msc Vblank counter at the predicted vblank, or null.
+ * \return Time of the vblank in nanoseconds.
+ */
+uint64_t predict_vblank(vblank_model* model, uint64_t now, uint64_t* msc) {
+    if (!model->anchored) {
+        model->time = now;
+        model->msc = 0;
+        model->anchored = true;
+    }
+
+    if (now < model->time) {
+        if (msc) {
+            *msc = model->msc;
+        }
+
+        return model->time;
+    }
+
+    const uint64_t count = (now - model->time) / model->period + 1;
+
+    if (msc) {
+        *msc = model->msc + count;
+    }
+
+    return model->time + count * model->period;
+}
@@ -0,0 +1,62 @@
+/**
+ * \file vblank_model.h
+ * \author Isaiah Lateer
+ * 
+ * Header file for the vblank model struct and functions. Used by the platform
+ * window implementations to predict vertical blanks from sparse samples, or
+ * from nothing at all when the driver reports no timing.
+ */
+
+#ifndef OPENGL_CONTEXT_VBLANK_MODEL_HEADER
+#define OPENGL_CONTEXT_VBLANK_MODEL_HEADER
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define DEFAULT_REFRESH_PERIOD 16666667
+
+typedef struct vblank_model {
+    uint64_t period;
+    uint64_t time;
+    uint64_t msc;
+    bool anchored;
+    bool measured;
+} vblank_model;
+
+/**
+ * Resets a vblank model to the default refresh period with no anchor.
+ * 
+ * \param[in] model Vblank model.
+ */
+void reset_vblank_model(vblank_model* model);
+
+/**
+ * Sets the refresh period reported by the driver.
+ * 
+ * \param[in] model Vblank model.
+ * \param[in] period Refresh period in nanoseconds.
+ */
+void set_vblank_period(vblank_model* model, uint64_t period);
+
+/**
+ * Anchors the model to an observed vblank. Unless the driver reported the
+ * refresh period, it is measured from the distance to the previous anchor.
+ * 
+ * \param[in] model Vblank model.
+ * \param[in] time Time of the vblank in nanoseconds.
+ * \param[in] msc Vblank counter at that time.
+ */
+void observe_vblank(vblank_model* model, uint64_t time, uint64_t msc);
+
+/**
+ * Gets the first vblank after a time, anchoring the model there if it has no
+ * anchor yet.
+ * 
+ * \param[in] model Vblank model.
+ * \param[in] now Time in nanoseconds.
+ * \param[out] msc Vblank counter at the predicted vblank, or null.
+ * \return Time of the vblank in nanoseconds.
+ */
+uint64_t predict_vblank(vblank_model* model, uint64_t now, uint64_t* msc);
+
+#endif
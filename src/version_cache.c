@@ -0,0 +1,240 @@
+/**
+ * \file version_cache.c
+ * \author Isaiah Lateer
+ * 
+ * Source file for the context version cache functions.
+ */
+
+#define _XOPEN_SOURCE 700
+
+#include "version_cache.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "platform.h"
+
+#ifdef OPENGL_CONTEXT_WINDOWS_PLATFORM
+#include <windows.h>
+#else
+#include <errno.h>
+#include <unistd.h>
+
+#include <sys/stat.h>
+#endif
+
+#define MAX_PATH_LENGTH 1024
+#define MAX_LINE_LENGTH 512
+#define MAX_ENTRIES 32
+#define CACHE_FILE_NAME "opengl_context_versions"
+
+/**
+ * Gets the path of a file in the user's cache directory, creating the
+ * directory if it does not exist yet, as on a fresh account.
+ * 
+ * \param[in] name File name.
+ * \param[out] path Path buffer.
+ * \param[in] size Path buffer size.
+ * \return Whether a cache location is available.
+ */
+bool get_cache_path(const char* name, char* path, size_t size) {
+#ifdef OPENGL_CONTEXT_WINDOWS_PLATFORM
+    const char* directory = getenv("LOCALAPPDATA");
+    const char* separator = "\\";
+#else
+    const char* directory = getenv("XDG_CACHE_HOME");
+    const char* separator = "/";
+
+    if (!directory || !*directory) {
+        directory = getenv("HOME");
+        separator = "/.cache/";
+    }
+#endif
+
+    if (!directory || !*directory) {
+        return false;
+    }
+
+    const int length =
+        snprintf(path, size, "%s%s%s", directory, separator, name);
+    if (length <= 0 || (size_t) length >= size) {
+        return false;
+    }
+
+#ifdef OPENGL_CONTEXT_LINUX_PLATFORM
+    char* file_name = strrchr(path, '/');
+    *file_name = '\0';
+
+    const bool created = !mkdir(path, 0700) || errno == EEXIST;
+    if (!created) {
+        printf("[INFO] Nothing will be cached; %s could not be created.\n",
+            path);
+    }
+
+    *file_name = '/';
+
+    return created;
+#else
+    return true;
+#endif
+}
+
+/**
+ * Creates a file beside another with a name no other process or thread is
+ * using, for writing a replacement that is then renamed over the original.
+ * 
+ * \param[in] path Path of the file to replace.
+ * \param[out] temporary_path Path of the new file.
+ * \param[in] size Temporary path buffer size.
+ * \return New file, open for binary writing, or null on failure.
+ */
+FILE* open_temporary_file(const char* path, char* temporary_path,
+    size_t size) {
+#ifdef OPENGL_CONTEXT_WINDOWS_PLATFORM
+    const int length = snprintf(temporary_path, size, "%s.%lu.%lu.tmp", path,
+        (unsigned long) GetCurrentProcessId(),
+        (unsigned long) GetCurrentThreadId());
+    if (length <= 0 || (size_t) length >= size) {
+        return NULL;
+    }
+
+    return fopen(temporary_path, "wbx");
+#else
+    const int length = snprintf(temporary_path, size, "%s.XXXXXX", path);
+    if (length <= 0 || (size_t) length >= size) {
+        return NULL;
+    }
+
+    const int descriptor = mkstemp(temporary_path);
+    if (descriptor < 0) {
+        return NULL;
+    }
+
+    FILE* file = fdopen(descriptor, "wb");
+    if (!file) {
+        close(descriptor);
+        remove(temporary_path);
+    }
+
+    return file;
+#endif
+}
+
+/**
+ * Moves a file over another in one step, so a crash leaves either the old
+ * file or the new one. Uses MoveFileExA() on Windows, where rename() cannot
+ * replace an existing file.
+ * 
+ * \param[in] source Path of the new file.
+ * \param[in] destination Path of the file to replace.
+ * \return Whether the file was replaced.
+ */
+bool replace_file(const char* source, const char* destination) {
+#ifdef OPENGL_CONTEXT_WINDOWS_PLATFORM
+    return MoveFileExA(source, destination, MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+    return !rename(source, destination);
+#endif
+}
+
+/**
+ * Parses the leading "major.minor" of an OpenGL version string.
+ * 
+ * \param[in] string Version string.
+ * \param[out] version Parsed version.
+ * \return Whether the string could be parsed.
+ */
+bool parse_version(const char* string, version* version) {
+    return string
+        && sscanf(string, "%d.%d", &version->major, &version->minor) == 2;
+}
+
+/**
+ * Loads the context version cached for a driver.
+ * 
+ * \param[in] key String identifying the driver.
+ * \param[out] version Cached version.
+ * \return Whether a version was cached for the driver.
+ */
+bool load_cached_version(const char* key, version* version) {
+    char path[MAX_PATH_LENGTH];
+    if (!get_cache_path(CACHE_FILE_NAME, path, sizeof(path))) {
+        return false;
+    }
+
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        return false;
+    }
+
+    bool found = false;
+
+    char line[MAX_LINE_LENGTH];
+    while (!found && fgets(line, sizeof(line), file)) {
+        line[strcspn(line, "\n")] = '\0';
+
+        int offset = 0;
+        struct version entry;
+        if (sscanf(line, "%d.%d %n", &entry.major, &entry.minor, &offset) == 2
+            && offset && !strcmp(line + offset, key)) {
+            *version = entry;
+            found = true;
+        }
+    }
+
+    fclose(file);
+
+    return found;
+}
+
+/**
+ * Stores the context version for a driver so later launches can skip the
+ * version probe.
+ * 
+ * \param[in] key String identifying the driver.
+ * \param[in] version Version.
+ */
+void store_cached_version(const char* key, version version) {
+    char path[MAX_PATH_LENGTH];
+    if (!get_cache_path(CACHE_FILE_NAME, path, sizeof(path))) {
+        return;
+    }
+
+    char entries[MAX_ENTRIES][MAX_LINE_LENGTH];
+    int entry_count = 0;
+
+    FILE* file = fopen(path, "r");
+    if (file) {
+        char line[MAX_LINE_LENGTH];
+        while (entry_count < MAX_ENTRIES - 1
+            && fgets(line, sizeof(line), file)) {
+            line[strcspn(line, "\n")] = '\0';
+
+            const char* entry_key = strchr(line, ' ');
+            if (entry_key && strcmp(entry_key + 1, key)) {
+                strcpy(entries[entry_count++], line);
+            }
+        }
+
+        fclose(file);
+    }
+
+    char temporary_path[MAX_PATH_LENGTH + 32];
+    file = open_temporary_file(path, temporary_path, sizeof(temporary_path));
+    if (!file) {
+        return;
+    }
+
+    fprintf(file, "%d.%d %s\n", version.major, version.minor, key);
+    for (int i = 0; i < entry_count; ++i) {
+        fprintf(file, "%s\n", entries[i]);
+    }
+
+    fclose(file);
+
+    if (!replace_file(temporary_path, path)) {
+        fprintf(stderr, "[ERROR] Failed to write version cache.\n");
+        remove(temporary_path);
+    }
+}
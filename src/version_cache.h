@@ -0,0 +1,78 @@
+/**
+ * \file version_cache.h
+ * \author Isaiah Lateer
+ * 
+ * Header file for the context version cache functions.
+ */
+
+#ifndef OPENGL_CONTEXT_VERSION_CACHE_HEADER
+#define OPENGL_CONTEXT_VERSION_CACHE_HEADER
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+#include "version.h"
+
+/**
+ * Gets the path of a file in the user's cache directory, creating the
+ * directory if it does not exist yet, as on a fresh account.
+ * 
+ * \param[in] name File name.
+ * \param[out] path Path buffer.
+ * \param[in] size Path buffer size.
+ * \return Whether a cache location is available.
+ */
+bool get_cache_path(const char* name, char* path, size_t size);
+
+/**
+ * Creates a file beside another with a name no other process or thread is
+ * using, for writing a replacement that is then renamed over the original.
+ * 
+ * \param[in] path Path of the file to replace.
+ * \param[out] temporary_path Path of the new file.
+ * \param[in] size Temporary path buffer size.
+ * \return New file, open for binary writing, or null on failure.
+ */
+FILE* open_temporary_file(const char* path, char* temporary_path,
+    size_t size);
+
+/**
+ * Moves a file over another in one step, so a crash leaves either the old
+ * file or the new one. Uses MoveFileExA() on Windows, where rename() cannot
+ * replace an existing file.
+ * 
+ * \param[in] source Path of the new file.
+ * \param[in] destination Path of the file to replace.
+ * \return Whether the file was replaced.
+ */
+bool replace_file(const char* source, const char* destination);
+
+/**
+ * Parses the leading "major.minor" of an OpenGL version string.
+ * 
+ * \param[in] string Version string.
+ * \param[out] version Parsed version.
+ * \return Whether the string could be parsed.
+ */
+bool parse_version(const char* string, version* version);
+
+/**
+ * Loads the context version cached for a driver.
+ * 
+ * \param[in] key String identifying the driver.
+ * \param[out] version Cached version.
+ * \return Whether a version was cached for the driver.
+ */
+bool load_cached_version(const char* key, version* version);
+
+/**
+ * Stores the context version for a driver so later launches can skip the
+ * version probe.
+ * 
+ * \param[in] key String identifying the driver.
+ * \param[in] version Version.
+ */
+void store_cached_version(const char* key, version version);
+
+#endif
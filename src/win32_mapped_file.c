@@ -0,0 +1,94 @@
+/**
+ * \file win32_mapped_file.c
+ * \author Isaiah Lateer
+ * 
+ * Source file for the mapped file functions.
+ */
+
+#include "platform.h"
+
+#ifdef OPENGL_CONTEXT_WINDOWS_PLATFORM
+
+#include "mapped_file.h"
+
+#include <stdlib.h>
+
+#include <windows.h>
+
+typedef struct mapped_file {
+    const void* data;
+    size_t size;
+} mapped_file;
+
+/**
+ * Maps a whole file into memory read only. The file must be unmapped before
+ * it is replaced.
+ * 
+ * \param[in] path File path.
+ * \return New mapping, or null if the file is missing or empty.
+ */
+mapped_file* map_file(const char* path) {
+    HANDLE handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return NULL;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(handle, &size) || size.QuadPart <= 0) {
+        CloseHandle(handle);
+        return NULL;
+    }
+
+    HANDLE mapping = CreateFileMappingA(handle, NULL, PAGE_READONLY, 0, 0,
+        NULL);
+    CloseHandle(handle);
+    if (!mapping) {
+        return NULL;
+    }
+
+    const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!data) {
+        return NULL;
+    }
+
+    mapped_file* file = malloc(sizeof(struct mapped_file));
+    file->data = data;
+    file->size = (size_t) size.QuadPart;
+
+    return file;
+}
+
+/**
+ * Unmaps a file.
+ * 
+ * \param[in] file Mapping.
+ */
+void unmap_file(mapped_file* file) {
+    UnmapViewOfFile(file->data);
+
+    free(file);
+}
+
+/**
+ * Gets the mapped contents of a file.
+ * 
+ * \param[in] file Mapping.
+ * \return File contents.
+ */
+const void* get_mapped_data(const mapped_file* file) {
+    return file->data;
+}
+
+/**
+ * Gets the size of a mapped file.
+ * 
+ * \param[in] file Mapping.
+ * \return Size in bytes.
+ */
+size_t get_mapped_size(const mapped_file* file) {
+    return file->size;
+}
+
+#endif
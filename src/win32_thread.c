@@ -0,0 +1,163 @@
+/**
+ * \file win32_thread.c
+ * \author Isaiah Lateer
+ * 
+ * Source file for the thread functions.
+ */
+
+#include "platform.h"
+
+#ifdef OPENGL_CONTEXT_WINDOWS_PLATFORM
+
+#include "thread.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <windows.h>
+
+typedef struct thread {
+    HANDLE handle;
+    thread_function function;
+    void* data;
+} thread;
+
+typedef struct mutex {
+    SRWLOCK handle;
+} mutex;
+
+typedef struct condition {
+    CONDITION_VARIABLE handle;
+} condition;
+
+/**
+ * Runs a thread's function.
+ * 
+ * \param[in] data Thread.
+ * \return Zero.
+ */
+static DWORD WINAPI run_thread(LPVOID data) {
+    thread* thread = data;
+    thread->function(thread->data);
+
+    return 0;
+}
+
+/**
+ * Starts a thread.
+ * 
+ * \param[in] function Function the thread runs.
+ * \param[in] data Data passed to the function.
+ * \return New thread.
+ */
+thread* create_thread(thread_function function, void* data) {
+    thread* thread = malloc(sizeof(struct thread));
+    thread->function = function;
+    thread->data = data;
+
+    thread->handle = CreateThread(NULL, 0, run_thread, thread, 0, NULL);
+    if (!thread->handle) {
+        fprintf(stderr, "[ERROR] Failed to create thread.\n");
+
+        free(thread);
+
+        return NULL;
+    }
+
+    return thread;
+}
+
+/**
+ * Waits for a thread to finish, then destroys it.
+ * 
+ * \param[in] thread Thread.
+ */
+void join_thread(thread* thread) {
+    WaitForSingleObject(thread->handle, INFINITE);
+    CloseHandle(thread->handle);
+
+    free(thread);
+}
+
+/**
+ * Creates a mutex.
+ * 
+ * \return New mutex.
+ */
+mutex* create_mutex(void) {
+    mutex* mutex = malloc(sizeof(struct mutex));
+    InitializeSRWLock(&mutex->handle);
+
+    return mutex;
+}
+
+/**
+ * Destroys a mutex. It must not be locked.
+ * 
+ * \param[in] mutex Mutex.
+ */
+void destroy_mutex(mutex* mutex) {
+    free(mutex);
+}
+
+/**
+ * Locks a mutex, waiting for another thread to unlock it if needed.
+ * 
+ * \param[in] mutex Mutex.
+ */
+void lock_mutex(mutex* mutex) {
+    AcquireSRWLockExclusive(&mutex->handle);
+}
+
+/**
+ * Unlocks a mutex locked by the calling thread.
+ * 
+ * \param[in] mutex Mutex.
+ */
+void unlock_mutex(mutex* mutex) {
+    ReleaseSRWLockExclusive(&mutex->handle);
+}
+
+/**
+ * Creates a condition variable.
+ * 
+ * \return New condition variable.
+ */
+condition* create_condition(void) {
+    condition* condition = malloc(sizeof(struct condition));
+    InitializeConditionVariable(&condition->handle);
+
+    return condition;
+}
+
+/**
+ * Destroys a condition variable. No thread may be waiting on it.
+ * 
+ * \param[in] condition Condition variable.
+ */
+void destroy_condition(condition* condition) {
+    free(condition);
+}
+
+/**
+ * Unlocks a mutex and waits for the condition variable to be signalled, then
+ * locks the mutex again. Can wake without a signal, so callers recheck their
+ * condition in a loop.
+ * 
+ * \param[in] condition Condition variable.
+ * \param[in] mutex Mutex locked by the calling thread.
+ */
+void wait_condition(condition* condition, mutex* mutex) {
+    SleepConditionVariableSRW(&condition->handle, &mutex->handle, INFINITE, 0);
+}
+
+/**
+ * Wakes one thread waiting on a condition variable.
+ * 
+ * \param[in] condition Condition variable.
+ */
+void signal_condition(condition* condition) {
+    WakeConditionVariable(&condition->handle);
+}
+
+#endif
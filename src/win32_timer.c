@@ -0,0 +1,73 @@
+/**
+ * \file win32_timer.c
+ * \author Isaiah Lateer
+ * 
+ * Source file for the timer functions.
+ */
+
+#include "platform.h"
+
+#ifdef OPENGL_CONTEXT_WINDOWS_PLATFORM
+
+#include "timer.h"
+
+#include <windows.h>
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+/**
+ * Gets the current time from a monotonic clock.
+ * 
+ * \return Time in nanoseconds.
+ */
+uint64_t get_time(void) {
+    static LARGE_INTEGER frequency = { 0 };
+    if (!frequency.QuadPart) {
+        QueryPerformanceFrequency(&frequency);
+    }
+
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+
+    const uint64_t seconds = counter.QuadPart / frequency.QuadPart;
+    const uint64_t remainder = counter.QuadPart % frequency.QuadPart;
+
+    return seconds * 1000000000
+        + remainder * 1000000000 / frequency.QuadPart;
+}
+
+/**
+ * Sleeps until the monotonic clock reaches the given time. Returns immediately
+ * if the time has already passed.
+ * 
+ * \param[in] time Time in nanoseconds.
+ */
+void sleep_until(uint64_t time) {
+    static HANDLE timer = NULL;
+    if (!timer) {
+        timer = CreateWaitableTimerEx(NULL, NULL,
+            CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+        if (!timer) {
+            timer = CreateWaitableTimerEx(NULL, NULL, 0, TIMER_ALL_ACCESS);
+        }
+    }
+
+    const uint64_t now = get_time();
+    if (time <= now) {
+        return;
+    }
+
+    LARGE_INTEGER due_time;
+    due_time.QuadPart = -(LONGLONG) ((time - now) / 100);
+
+    if (!timer || !SetWaitableTimer(timer, &due_time, 0, NULL, NULL, FALSE)) {
+        Sleep((DWORD) ((time - now) / 1000000));
+        return;
+    }
+
+    WaitForSingleObject(timer, INFINITE);
+}
+
+#endif
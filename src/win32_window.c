@@ -14,49 +14,236 @@
 #include <stdio.h>
 
 #include <windows.h>
+#include <windowsx.h>
 
 #include <gl/GL.h>
 #include <GL/glext.h>
 #include <GL/wglext.h>
 
+#include "debug_output.h"
+#include "event_queue.h"
+#include "gl_loader.h"
+#include "shared_context.h"
+#include "timer.h"
+#include "trace.h"
 #include "version.h"
+#include "version_cache.h"
+#include "vblank_model.h"
 
 #define CLASS_NAME TEXT("window_class")
+#define MAX_DRIVER_KEY_LENGTH 256
 
 typedef struct window {
     HINSTANCE instance;
     HWND window;
     HDC device_context;
     HGLRC rendering_context;
+    gl_errors errors;
+    bool no_error;
+    version version;
+    SRWLOCK size_lock;
+    unsigned width, height;
+    event_queue events;
+    present_timing present;
+    bool presented;
+    vblank_model vblank;
+    gl_dispatch* gl;
+    debug_output* debug;
+    HANDLE wake_event;
+    PFNWGLCREATECONTEXTATTRIBSARBPROC wglCreateContextAttribsARB;
+    PFNWGLSWAPINTERVALEXTPROC wglSwapIntervalEXT;
     bool quit;
 } window;
 
+typedef struct shared_context {
+    window* window;
+    HGLRC rendering_context;
+} shared_context;
+
+static char driver_key[MAX_DRIVER_KEY_LENGTH];
+static version context_version = { 0, 0 };
+
 /**
- * Handles messages sent to the window.
+ * Gets the keyboard modifier state in the same form as the mouse message
+ * modifier flags.
+ * 
+ * \return Modifier flags.
+ */
+static unsigned get_key_modifiers(void) {
+    unsigned modifiers = 0;
+
+    if (GetKeyState(VK_SHIFT) < 0) {
+        modifiers |= MK_SHIFT;
+    }
+
+    if (GetKeyState(VK_CONTROL) < 0) {
+        modifiers |= MK_CONTROL;
+    }
+
+    return modifiers;
+}
+
+/**
+ * Decodes a mouse button message. Buttons are numbered like X11 buttons, with
+ * the wheel reported as buttons 4 and 5.
  * 
- * \param[in] window Window.
+ * \param[in] message Message.
+ * \param[in] wparam Additional message information.
+ * \param[in] lparam Additional message information.
+ * \param[out] event Decoded event.
+ */
+static void decode_button(UINT message, WPARAM wparam, LPARAM lparam,
+    window_event* event) {
+    switch (message) {
+    case WM_LBUTTONDOWN:
+    case WM_LBUTTONUP:
+        event->button.button = 1;
+        break;
+    case WM_MBUTTONDOWN:
+    case WM_MBUTTONUP:
+        event->button.button = 2;
+        break;
+    case WM_RBUTTONDOWN:
+    case WM_RBUTTONUP:
+        event->button.button = 3;
+        break;
+    default:
+        event->button.button =
+            GET_XBUTTON_WPARAM(wparam) == XBUTTON1 ? 8 : 9;
+        break;
+    }
+
+    event->button.x = GET_X_LPARAM(lparam);
+    event->button.y = GET_Y_LPARAM(lparam);
+    event->button.modifiers = GET_KEYSTATE_WPARAM(wparam);
+}
+
+/**
+ * Handles messages sent to the window, decoding input and state changes into
+ * the window's event queue.
+ * 
+ * \param[in] handle Window handle.
  * \param[in] message Message.
  * \param[in] wparam Additional message information.
  * \param[in] lparam Additional message information.
  * \return Message dependent resulting value.
  */
-static LRESULT CALLBACK window_procedure(HWND window, UINT message,
+static LRESULT CALLBACK window_procedure(HWND handle, UINT message,
     WPARAM wparam, LPARAM lparam) {
-    LRESULT result = 0;
+    window* window = (struct window*) GetWindowLongPtr(handle, GWLP_USERDATA);
+    if (!window) {
+        return DefWindowProc(handle, message, wparam, lparam);
+    }
 
-    LONG_PTR user_data = GetWindowLongPtr(window, GWLP_USERDATA);
-    bool* quit = (bool*) user_data;
+    window_event event;
+    event.time = (uint32_t) GetMessageTime();
 
     switch (message) {
     case WM_CLOSE:
-        *quit = true;
-        break;
-    default:
-        result = DefWindowProc(window, message, wparam, lparam);
-        break;
+        window->quit = true;
+        return 0;
+    case WM_KEYDOWN:
+    case WM_SYSKEYDOWN:
+    case WM_KEYUP:
+    case WM_SYSKEYUP:
+        event.type = message == WM_KEYDOWN || message == WM_SYSKEYDOWN
+            ? WINDOW_EVENT_KEY_PRESS : WINDOW_EVENT_KEY_RELEASE;
+        event.key.code = (unsigned) (lparam >> 16) & 0x1FF;
+        event.key.symbol = (unsigned) wparam;
+        event.key.modifiers = get_key_modifiers();
+        push_event(&window->events, &event);
+
+        // System keys still need default handling for shortcuts like Alt+F4.
+        if (message == WM_SYSKEYDOWN || message == WM_SYSKEYUP) {
+            return DefWindowProc(handle, message, wparam, lparam);
+        }
+
+        return 0;
+    case WM_LBUTTONDOWN:
+    case WM_MBUTTONDOWN:
+    case WM_RBUTTONDOWN:
+    case WM_XBUTTONDOWN:
+        event.type = WINDOW_EVENT_BUTTON_PRESS;
+        decode_button(message, wparam, lparam, &event);
+        push_event(&window->events, &event);
+        return message == WM_XBUTTONDOWN;
+    case WM_LBUTTONUP:
+    case WM_MBUTTONUP:
+    case WM_RBUTTONUP:
+    case WM_XBUTTONUP:
+        event.type = WINDOW_EVENT_BUTTON_RELEASE;
+        decode_button(message, wparam, lparam, &event);
+        push_event(&window->events, &event);
+        return message == WM_XBUTTONUP;
+    case WM_MOUSEWHEEL: {
+        POINT point = { GET_X_LPARAM(lparam), GET_Y_LPARAM(lparam) };
+        ScreenToClient(handle, &point);
+
+        event.button.button = GET_WHEEL_DELTA_WPARAM(wparam) > 0 ? 4 : 5;
+        event.button.x = point.x;
+        event.button.y = point.y;
+        event.button.modifiers = GET_KEYSTATE_WPARAM(wparam);
+
+        event.type = WINDOW_EVENT_BUTTON_PRESS;
+        push_event(&window->events, &event);
+        event.type = WINDOW_EVENT_BUTTON_RELEASE;
+        push_event(&window->events, &event);
+
+        return 0;
+    } case WM_MOUSEMOVE:
+        event.type = WINDOW_EVENT_MOTION;
+        event.motion.x = GET_X_LPARAM(lparam);
+        event.motion.y = GET_Y_LPARAM(lparam);
+        event.motion.modifiers = (unsigned) wparam;
+        push_event(&window->events, &event);
+        return 0;
+    case WM_SIZE: {
+        if (wparam == SIZE_MINIMIZED) {
+            return 0;
+        }
+
+        // A render thread reads the size through get_framebuffer_size().
+        AcquireSRWLockExclusive(&window->size_lock);
+
+        const bool resized = LOWORD(lparam) != window->width
+            || HIWORD(lparam) != window->height;
+        window->width = LOWORD(lparam);
+        window->height = HIWORD(lparam);
+
+        ReleaseSRWLockExclusive(&window->size_lock);
+
+        if (resized) {
+            event.type = WINDOW_EVENT_RESIZE;
+            event.resize.width = LOWORD(lparam);
+            event.resize.height = HIWORD(lparam);
+            push_event(&window->events, &event);
+        }
+
+        return 0;
+    } case WM_SETFOCUS:
+    case WM_KILLFOCUS:
+        event.type = message == WM_SETFOCUS
+            ? WINDOW_EVENT_FOCUS_IN : WINDOW_EVENT_FOCUS_OUT;
+        push_event(&window->events, &event);
+        return 0;
+    case WM_PAINT: {
+        PAINTSTRUCT paint;
+        BeginPaint(handle, &paint);
+        EndPaint(handle, &paint);
+
+        event.type = WINDOW_EVENT_EXPOSE;
+        event.expose.x = paint.rcPaint.left;
+        event.expose.y = paint.rcPaint.top;
+        event.expose.width =
+            (unsigned) (paint.rcPaint.right - paint.rcPaint.left);
+        event.expose.height =
+            (unsigned) (paint.rcPaint.bottom - paint.rcPaint.top);
+        push_event(&window->events, &event);
+
+        return 0;
+    } default:
+        return DefWindowProc(handle, message, wparam, lparam);
     }
-    
-    return result;
 }
 
 /**
@@ -75,6 +262,155 @@ static PROC get_procedure(const char* name) {
     return procedure;
 }
 
+/**
+ * Checks if an extension is in a space separated extension list.
+ * 
+ * \param[in] extensions Extension list.
+ * \param[in] name Extension name.
+ * \return Whether the extension is in the list.
+ */
+static bool has_extension(const char* extensions, const char* name) {
+    if (!extensions) {
+        return false;
+    }
+
+    const size_t length = strlen(name);
+
+    const char* start = extensions;
+    while ((start = strstr(start, name))) {
+        const bool at_start = start == extensions || start[-1] == ' ';
+        const bool at_end = start[length] == ' ' || start[length] == '\0';
+        if (at_start && at_end) {
+            return true;
+        }
+
+        start += length;
+    }
+
+    return false;
+}
+
+/**
+ * Creates a core profile context for a specific version, with the debug or
+ * no-error flag the window asked for.
+ * 
+ * \param[in] window Window.
+ * \param[in] wglCreateContextAttribsARB Context creation procedure.
+ * \param[in] share_context Context to share objects with.
+ * \param[in] version Context version.
+ * \return New context.
+ */
+static HGLRC create_core_context(window* window,
+    PFNWGLCREATECONTEXTATTRIBSARBPROC wglCreateContextAttribsARB,
+    HGLRC share_context, version version) {
+    int context_attributes[] = {
+        WGL_CONTEXT_MAJOR_VERSION_ARB, version.major,
+        WGL_CONTEXT_MINOR_VERSION_ARB, version.minor,
+        WGL_CONTEXT_PROFILE_MASK_ARB, WGL_CONTEXT_CORE_PROFILE_BIT_ARB,
+        0, 0,
+        0
+    };
+
+    if (window->errors == GL_ERRORS_DEBUG) {
+        context_attributes[6] = WGL_CONTEXT_FLAGS_ARB;
+        context_attributes[7] = WGL_CONTEXT_DEBUG_BIT_ARB;
+    } else if (window->errors == GL_ERRORS_NONE && window->no_error) {
+        context_attributes[6] = WGL_CONTEXT_OPENGL_NO_ERROR_ARB;
+        context_attributes[7] = TRUE;
+    }
+
+    return wglCreateContextAttribsARB(window->device_context, share_context,
+        context_attributes);
+}
+
+/**
+ * Creates the highest version context the driver supports. The version found
+ * by an earlier probe is tried first. Otherwise a 3.2 core context is created
+ * and its actual version read back, since drivers return the highest
+ * compatible version for it, and the old descending search is only used when
+ * the driver returned exactly what was asked for or has no core profile.
+ * 
+ * \param[in] window Window.
+ * \param[in] wglCreateContextAttribsARB Context creation procedure.
+ * \param[in] share_context Context to share objects with.
+ */
+static void create_versioned_context(window* window,
+    PFNWGLCREATECONTEXTATTRIBSARBPROC wglCreateContextAttribsARB,
+    HGLRC share_context) {
+    const version versions[] = {
+        { 4, 6 },
+        { 4, 5 },
+        { 4, 4 },
+        { 4, 3 },
+        { 4, 2 },
+        { 4, 1 },
+        { 4, 0 },
+        { 3, 3 },
+        { 3, 2 },
+        { 3, 1 },
+        { 3, 0 },
+        { 2, 1 },
+        { 2, 0 },
+        { 1, 5 },
+        { 1, 4 },
+        { 1, 3 },
+        { 1, 2 },
+        { 1, 1 },
+        { 1, 0 }
+    };
+
+    const int version_count = sizeof(versions) / sizeof(version);
+    const int probe_index = 8;
+
+    if (context_version.major) {
+        window->rendering_context = create_core_context(window,
+            wglCreateContextAttribsARB, share_context, context_version);
+        if (window->rendering_context) {
+            return;
+        }
+    }
+
+    window->rendering_context = create_core_context(window,
+        wglCreateContextAttribsARB, share_context, versions[probe_index]);
+    if (window->rendering_context) {
+        HDC previous_device_context = wglGetCurrentDC();
+        HGLRC previous_rendering_context = wglGetCurrentContext();
+
+        version probed = { 0, 0 };
+        if (wglMakeCurrent(window->device_context,
+            window->rendering_context)) {
+            parse_version((const char*) glGetString(GL_VERSION), &probed);
+            wglMakeCurrent(previous_device_context,
+                previous_rendering_context);
+        }
+
+        if (probed.major != versions[probe_index].major
+            || probed.minor != versions[probe_index].minor) {
+            return;
+        }
+
+        for (int i = 0; i < probe_index; ++i) {
+            HGLRC rendering_context = create_core_context(window,
+                wglCreateContextAttribsARB, share_context, versions[i]);
+            if (rendering_context) {
+                wglDeleteContext(window->rendering_context);
+                window->rendering_context = rendering_context;
+                return;
+            }
+        }
+
+        return;
+    }
+
+    for (int i = probe_index + 1; i < version_count; ++i) {
+        window->rendering_context = create_core_context(window,
+            wglCreateContextAttribsARB, share_context, versions[i]);
+        if (window->rendering_context) {
+            return;
+        }
+    }
+}
+
 /**
  * Creates a window.
  * 
@@ -84,6 +420,33 @@ static PROC get_procedure(const char* name) {
  * \return New window.
  */
 window* create_window(const char* title, unsigned width, unsigned height) {
+    const window_settings settings = {
+        title, width, height, NULL, { 0 }, WINDOW_BACKEND_NATIVE
+    };
+
+    return create_window_with_settings(&settings);
+}
+
+/**
+ * Creates a window. What each setting does is described on window_settings.
+ * 
+ * \param[in] settings Window settings.
+ * \return New window.
+ */
+window* create_window_with_settings(const window_settings* settings) {
+    if (settings->backend != WINDOW_BACKEND_NATIVE) {
+        fprintf(stderr, "[ERROR] Window backend not supported.\n");
+        return NULL;
+    }
+
+    const uint64_t start = begin_trace();
+
+    const char* title = settings->title;
+    const unsigned width = settings->width;
+    const unsigned height = settings->height;
+    const HGLRC share_context =
+        settings->share ? settings->share->rendering_context : NULL;
+
 #if defined(UNICODE) || defined(_UNICODE)
     const size_t dummy_char_count = strlen(title) + 1;
     wchar_t* dummy_wtitle = malloc(dummy_char_count * sizeof(wchar_t));
@@ -211,6 +574,8 @@ window* create_window(const char* title, unsigned width, unsigned height) {
     window* window = malloc(sizeof(struct window));
     memset(window, 0, sizeof(struct window));
 
+    InitializeSRWLock(&window->size_lock);
+
     window->instance = GetModuleHandle(NULL);
     if (!window->instance) {
         fprintf(stderr, "[ERROR] Failed to get module handle.\n");
@@ -383,6 +748,12 @@ window* create_window(const char* title, unsigned width, unsigned height) {
         }
 
         window->rendering_context = wglCreateContext(window->device_context);
+        if (window->rendering_context && share_context
+            && !wglShareLists(share_context, window->rendering_context)) {
+            wglDeleteContext(window->rendering_context);
+            window->rendering_context = NULL;
+        }
+
         if (!window->rendering_context) {
             fprintf(stderr, "[ERROR] Failed to create rendering context.\n");
 
@@ -410,13 +781,20 @@ window* create_window(const char* title, unsigned width, unsigned height) {
             return NULL;
         }
     } else {
+        const framebuffer_settings* framebuffer = &settings->framebuffer;
+
         const int pixel_attributes[] = {
             WGL_DRAW_TO_WINDOW_ARB, GL_TRUE,
             WGL_SUPPORT_OPENGL_ARB, GL_TRUE,
             WGL_DOUBLE_BUFFER_ARB, GL_TRUE,
             WGL_PIXEL_TYPE_ARB, WGL_TYPE_RGBA_ARB,
             WGL_COLOR_BITS_ARB, 24,
-            WGL_ALPHA_BITS_ARB, 8,
+            WGL_ALPHA_BITS_ARB, framebuffer->alpha ? 8 : 0,
+            WGL_DEPTH_BITS_ARB, framebuffer->depth_bits,
+            WGL_STENCIL_BITS_ARB, framebuffer->stencil_bits,
+            WGL_SAMPLE_BUFFERS_ARB, framebuffer->samples > 0,
+            WGL_SAMPLES_ARB, framebuffer->samples,
+            framebuffer->srgb ? WGL_FRAMEBUFFER_SRGB_CAPABLE_ARB : 0, GL_TRUE,
             0
         };
     
@@ -508,46 +886,33 @@ window* create_window(const char* title, unsigned width, unsigned height) {
             return NULL;
         }
 
-        const version versions[] = {
-            { 4, 6 },
-            { 4, 5 },
-            { 4, 4 },
-            { 4, 3 },
-            { 4, 2 },
-            { 4, 1 },
-            { 4, 0 },
-            { 3, 3 },
-            { 3, 2 },
-            { 3, 1 },
-            { 3, 0 },
-            { 2, 1 },
-            { 2, 0 },
-            { 1, 5 },
-            { 1, 4 },
-            { 1, 3 },
-            { 1, 2 },
-            { 1, 1 },
-            { 1, 0 }
-        };
+        if (!context_version.major) {
+            snprintf(driver_key, MAX_DRIVER_KEY_LENGTH, "%s|%s|%s",
+                (const char*) glGetString(GL_VENDOR),
+                (const char*) glGetString(GL_RENDERER),
+                (const char*) glGetString(GL_VERSION));
+            load_cached_version(driver_key, &context_version);
+        }
 
-        const int version_count = sizeof(versions) / sizeof(version);
+        PFNWGLGETEXTENSIONSSTRINGARBPROC wglGetExtensionsStringARB =
+            (PFNWGLGETEXTENSIONSSTRINGARBPROC)
+            get_procedure("wglGetExtensionsStringARB");
 
-        for (int i = 0; i < version_count; ++i) {
-            const int context_attributes[] = {
-                WGL_CONTEXT_MAJOR_VERSION_ARB, versions[i].major,
-                WGL_CONTEXT_MINOR_VERSION_ARB, versions[i].minor,
-                WGL_CONTEXT_PROFILE_MASK_ARB, WGL_CONTEXT_CORE_PROFILE_BIT_ARB,
-                0
-            };
-    
-            window->rendering_context =
-                wglCreateContextAttribsARB(window->device_context, NULL,
-                context_attributes);
-            if (window->rendering_context) {
-                break;
-            }
+        window->errors = settings->errors;
+        window->no_error = wglGetExtensionsStringARB && has_extension(
+            wglGetExtensionsStringARB(dummy_device_context),
+            "WGL_ARB_create_context_no_error");
+
+        if (settings->errors == GL_ERRORS_NONE && !window->no_error) {
+            printf("[INFO] Errors will be checked; the driver cannot create "
+                "no-error contexts.\n");
         }
 
+        const uint64_t stage = begin_trace();
+        create_versioned_context(window, wglCreateContextAttribsARB,
+            share_context);
+        end_trace("create_versioned_context", stage);
+
         wglMakeCurrent(NULL, NULL);
         wglDeleteContext(dummy_rendering_context);
         ReleaseDC(dummy_window, dummy_device_context);
@@ -581,9 +946,56 @@ window* create_window(const char* title, unsigned width, unsigned height) {
         }
     }
 
-    SetWindowLongPtr(window->window, GWLP_USERDATA, (LONG_PTR) &window->quit);
+    parse_version((const char*) glGetString(GL_VERSION), &window->version);
+
+    if (wglCreateContextAttribsARB
+        && (window->version.major != context_version.major
+        || window->version.minor != context_version.minor)) {
+        context_version = window->version;
+        store_cached_version(driver_key, window->version);
+    }
+
+    window->wake_event = CreateEvent(NULL, FALSE, FALSE, NULL);
+    if (!window->wake_event) {
+        fprintf(stderr, "[ERROR] Failed to create wake event.\n");
+
+        wglMakeCurrent(NULL, NULL);
+        wglDeleteContext(window->rendering_context);
+        ReleaseDC(window->window, window->device_context);
+        DestroyWindow(window->window);
+        UnregisterClass(CLASS_NAME, window->instance);
+
+        free(window);
+
+        return NULL;
+    }
+
+    window->wglCreateContextAttribsARB = wglCreateContextAttribsARB;
+    window->wglSwapIntervalEXT =
+        (PFNWGLSWAPINTERVALEXTPROC) get_procedure("wglSwapIntervalEXT");
+
+    AcquireSRWLockExclusive(&window->size_lock);
+    window->width = width;
+    window->height = height;
+    ReleaseSRWLockExclusive(&window->size_lock);
+
+    reset_vblank_model(&window->vblank);
+
+    if (settings->loading != GL_LOADING_NONE) {
+        window->gl = create_gl_dispatch(window, settings->loading);
+        set_current_gl_dispatch(window->gl);
+    }
+
+    if (settings->errors == GL_ERRORS_DEBUG) {
+        window->debug = create_debug_output(window, settings->debug_callback,
+            settings->debug_user_data);
+    }
+
+    SetWindowLongPtr(window->window, GWLP_USERDATA, (LONG_PTR) window);
     ShowWindow(window->window, SW_SHOW);
 
+    end_trace("create_window", start);
+
     printf("[INFO] Window created.\n");
     printf("[INFO] OpenGL version: %s\n", glGetString(GL_VERSION));
     printf("[INFO] OpenGL renderer: %s\n", glGetString(GL_RENDERER));
@@ -598,17 +1010,68 @@ window* create_window(const char* title, unsigned width, unsigned height) {
  * \param[in] window Window.
  */
 void destroy_window(window* window) {
-    wglMakeCurrent(NULL, NULL);
+    if (window->gl) {
+        destroy_gl_dispatch(window->gl);
+    }
+
+    CloseHandle(window->wake_event);
+
+    if (wglGetCurrentContext() == window->rendering_context) {
+        wglMakeCurrent(NULL, NULL);
+    }
+
     wglDeleteContext(window->rendering_context);
     ReleaseDC(window->window, window->device_context);
     DestroyWindow(window->window);
     UnregisterClass(CLASS_NAME, window->instance);
 
+    if (window->debug) {
+        destroy_debug_output(window->debug);
+    }
+
     free(window);
 
     printf("[INFO] Window destroyed.\n");
 }
 
+/**
+ * Gets the version of the window's context.
+ * 
+ * \param[in] window Window.
+ * \return Context version.
+ */
+version get_context_version(const window* window) {
+    return window->version;
+}
+
+/**
+ * Makes the window's context current on the calling thread.
+ * 
+ * \param[in] window Window.
+ * \return Whether the context was made current.
+ */
+bool make_current(window* window) {
+    if (!wglMakeCurrent(window->device_context, window->rendering_context)) {
+        fprintf(stderr, "[ERROR] Failed to set rendering context.\n");
+        return false;
+    }
+
+    set_current_gl_dispatch(window->gl);
+
+    return true;
+}
+
+/**
+ * Releases the window's context from the calling thread so another thread can
+ * make it current.
+ * 
+ * \param[in] window Window.
+ */
+void release_current(window* window) {
+    set_current_gl_dispatch(NULL);
+    wglMakeCurrent(NULL, NULL);
+}
+
 /**
  * Polls events sent to the window.
  * 
@@ -625,6 +1088,58 @@ bool poll_events(window* window) {
     return window->quit;
 }
 
+/**
+ * Moves the events decoded by poll_events() and wait_events() into an array,
+ * oldest first. Consecutive motion and resize events are coalesced into the
+ * latest one. Events that do not fit stay queued for the next call.
+ * 
+ * \param[in] window Window.
+ * \param[out] events Array to fill.
+ * \param[in] capacity Size of the array.
+ * \return Number of events written.
+ */
+size_t get_window_events(window* window, window_event* events,
+    size_t capacity) {
+    return take_events(&window->events, events, capacity);
+}
+
+/**
+ * Gets the number of events dropped because the window's event queue was
+ * full. Motion events are given up first and releases are kept.
+ * 
+ * \param[in] window Window.
+ * \return Dropped event count.
+ */
+uint64_t get_dropped_window_events(window* window) {
+    return get_dropped_events(&window->events);
+}
+
+/**
+ * Waits for events sent to the window, then polls them. Returns early if
+ * another thread wakes the window.
+ * 
+ * \param[in] window Window.
+ * \param[in] timeout Milliseconds to wait, or a negative value to wait
+ * indefinitely.
+ * \return Whether the application should close.
+ */
+bool wait_events(window* window, int timeout) {
+    MsgWaitForMultipleObjectsEx(1, &window->wake_event,
+        timeout < 0 ? INFINITE : (DWORD) timeout, QS_ALLINPUT,
+        MWMO_INPUTAVAILABLE);
+
+    return poll_events(window);
+}
+
+/**
+ * Wakes a window that is waiting for events. Can be called from any thread.
+ * 
+ * \param[in] window Window.
+ */
+void wake_window(window* window) {
+    SetEvent(window->wake_event);
+}
+
 /**
  * Swaps buffers.
  * 
@@ -632,6 +1147,283 @@ bool poll_events(window* window) {
  */
 void swap_buffer(window* window) {
     SwapBuffers(window->device_context);
+
+    // Frames are assumed to reach the screen at the first vertical blank
+    // after the swap.
+    window->present.time =
+        predict_vblank(&window->vblank, get_time(), &window->present.msc);
+    ++window->present.sbc;
+    window->presented = true;
+}
+
+/**
+ * Gets the size of the window's framebuffer as of the last poll.
+ * 
+ * \param[in] window Window.
+ * \param[out] width Framebuffer width.
+ * \param[out] height Framebuffer height.
+ */
+void get_framebuffer_size(const window* window, unsigned* width,
+    unsigned* height) {
+    SRWLOCK* size_lock = (SRWLOCK*) &window->size_lock;
+
+    AcquireSRWLockShared(size_lock);
+    *width = window->width;
+    *height = window->height;
+    ReleaseSRWLockShared(size_lock);
+}
+
+/**
+ * Gets the age of the back buffer. WGL has no way to query it, so the
+ * contents are always treated as undefined.
+ * 
+ * \param[in] window Window.
+ * \return Zero.
+ */
+unsigned get_buffer_age(window* window) {
+    return 0;
+}
+
+/**
+ * Gets the region of the back buffer to redraw before presenting new damage.
+ * Since buffer ages are unknown, this is always the whole framebuffer.
+ * 
+ * \param[in] window Window.
+ * \param[in] damage Rectangles that change in the next frame.
+ * \param[in] count Number of rectangles.
+ * \return Bounding rectangle of the region to redraw.
+ */
+rect get_repaint_region(window* window, const rect* damage, size_t count) {
+    unsigned width, height;
+    get_framebuffer_size(window, &width, &height);
+
+    const rect full = { 0, 0, width, height };
+    return full;
+}
+
+/**
+ * Presents a frame. WGL has no partial present, so the buffers are always
+ * swapped.
+ * 
+ * \param[in] window Window.
+ * \param[in] damage Rectangles that changed, in OpenGL window coordinates.
+ * \param[in] count Number of rectangles.
+ */
+void swap_buffer_with_damage(window* window, const rect* damage,
+    size_t count) {
+    swap_buffer(window);
+}
+
+/**
+ * Gets where the window's present timing comes from. WGL reports none, so
+ * this is always a software model of a display at the default refresh rate
+ * anchored to the first present.
+ * 
+ * \param[in] window Window.
+ * \return Present timing source.
+ */
+present_timing_source get_present_timing_source(const window* window) {
+    return PRESENT_TIMING_SOFTWARE;
+}
+
+/**
+ * Gets the timing of the most recently completed present.
+ * 
+ * \param[in] window Window.
+ * \param[out] timing Present timing.
+ * \return Whether any frame has been presented yet.
+ */
+bool get_present_timing(window* window, present_timing* timing) {
+    *timing = window->present;
+
+    return window->presented;
+}
+
+/**
+ * Predicts the next vertical blank, for scheduling a frame's work to finish
+ * just before it.
+ * 
+ * \param[in] window Window.
+ * \param[out] msc Media stream counter at that vertical blank, or null.
+ * \return Time of the vertical blank in nanoseconds on the clock used by
+ * get_time().
+ */
+uint64_t predict_next_vblank(window* window, uint64_t* msc) {
+    return predict_vblank(&window->vblank, get_time(), msc);
+}
+
+/**
+ * Gets the refresh period of the software model.
+ * 
+ * \param[in] window Window.
+ * \return Refresh period in nanoseconds.
+ */
+uint64_t get_refresh_period(const window* window) {
+    return window->vblank.period;
+}
+
+/**
+ * Gets the framebuffer object that stands in for the default framebuffer. This
+ * is zero for native windows and the offscreen framebuffer for headless ones.
+ * 
+ * \param[in] window Window.
+ * \return Framebuffer object name.
+ */
+unsigned get_default_framebuffer(const window* window) {
+    return 0;
+}
+
+/**
+ * Gets the window's OpenGL dispatch table, declared in gl_loader.h.
+ * 
+ * \param[in] window Window.
+ * \return Dispatch table, or null if the window was created without one.
+ */
+const gl_dispatch* get_gl_dispatch(const window* window) {
+    return window->gl;
+}
+
+/**
+ * Gets the number of debug messages dropped because the debug output queue
+ * was full when the driver reported them.
+ * 
+ * \param[in] window Window.
+ * \return Dropped message count, or zero without debug output.
+ */
+uint64_t get_dropped_debug_messages(const window* window) {
+    return window->debug ? get_dropped_messages(window->debug) : 0;
+}
+
+/**
+ * Gets the address of an OpenGL procedure.
+ * 
+ * \param[in] window Window.
+ * \param[in] name Procedure name.
+ * \return Procedure address, or null if it is not available.
+ */
+procedure get_procedure_address(const window* window, const char* name) {
+    PROC address = get_procedure(name);
+    if (!address) {
+        address = GetProcAddress(GetModuleHandle(TEXT("opengl32.dll")), name);
+    }
+
+    return (procedure) address;
+}
+
+/**
+ * Gets the CPU framebuffer of a software window. Software windows are only
+ * implemented on Linux, so no Win32 window has one.
+ * 
+ * \param[in] window Window.
+ * \param[out] framebuffer Framebuffer.
+ * \return Whether the window has a software framebuffer.
+ */
+bool map_software_framebuffer(window* window,
+    software_framebuffer* framebuffer) {
+    fprintf(stderr, "[ERROR] Window has no software framebuffer.\n");
+    return false;
+}
+
+/**
+ * Waits until the display server has processed every frame presented on a
+ * software window. No Win32 window is a software window.
+ * 
+ * \param[in] window Window.
+ * \return Whether the window is a software window.
+ */
+bool finish_software_presents(window* window) {
+    fprintf(stderr, "[ERROR] Window has no software framebuffer.\n");
+    return false;
+}
+
+/**
+ * Sets the number of vertical blanks to wait for before a buffer swap. Zero
+ * disables vsync and a negative value requests adaptive vsync.
+ * 
+ * \param[in] window Window.
+ * \param[in] interval Swap interval.
+ * \return Whether the swap interval was set.
+ */
+bool set_swap_interval(window* window, int interval) {
+    if (!window->wglSwapIntervalEXT
+        || !window->wglSwapIntervalEXT(interval)) {
+        fprintf(stderr, "[ERROR] Failed to set swap interval.\n");
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Creates a context that shares objects with the window's context and has
+ * the same version and error mode. It has no window of its own; it is made
+ * current with the window's device context but never draws to it.
+ * 
+ * \param[in] window Window.
+ * \return New shared context.
+ */
+shared_context* create_shared_context(window* window) {
+    shared_context* context = malloc(sizeof(struct shared_context));
+    context->window = window;
+
+    if (window->wglCreateContextAttribsARB) {
+        context->rendering_context = create_core_context(window,
+            window->wglCreateContextAttribsARB, window->rendering_context,
+            window->version);
+    } else {
+        context->rendering_context = wglCreateContext(window->device_context);
+        if (context->rendering_context && !wglShareLists(
+            window->rendering_context, context->rendering_context)) {
+            wglDeleteContext(context->rendering_context);
+            context->rendering_context = NULL;
+        }
+    }
+
+    if (!context->rendering_context) {
+        fprintf(stderr, "[ERROR] Failed to create shared context.\n");
+
+        free(context);
+
+        return NULL;
+    }
+
+    return context;
+}
+
+/**
+ * Destroys a shared context. It must not be current on any thread.
+ * 
+ * \param[in] context Shared context.
+ */
+void destroy_shared_context(shared_context* context) {
+    wglDeleteContext(context->rendering_context);
+
+    free(context);
+}
+
+/**
+ * Makes a shared context current on the calling thread.
+ * 
+ * \param[in] context Shared context.
+ * \return Whether the context was made current.
+ */
+bool make_shared_context_current(shared_context* context) {
+    if (!wglMakeCurrent(context->window->device_context,
+        context->rendering_context)) {
+        fprintf(stderr, "[ERROR] Failed to set shared context.\n");
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Releases a shared context from the calling thread.
+ * 
+ * \param[in] context Shared context.
+ */
+void release_shared_context(shared_context* context) {
+    wglMakeCurrent(NULL, NULL);
 }
 
 #endif
@@ -9,9 +9,243 @@
 #define OPENGL_CONTEXT_WINDOW_HEADER
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "version.h"
 
 typedef struct window window;
 
+typedef struct readback readback;
+
+typedef struct context_pool context_pool;
+
+typedef struct pooled_context pooled_context;
+
+typedef struct upload_fence upload_fence;
+
+typedef struct gl_dispatch gl_dispatch;
+
+typedef void (*procedure)(void);
+
+typedef enum window_backend {
+    WINDOW_BACKEND_NATIVE,
+    WINDOW_BACKEND_HEADLESS,
+    WINDOW_BACKEND_SOFTWARE
+} window_backend;
+
+typedef enum gl_loading {
+    GL_LOADING_NONE,
+    GL_LOADING_LAZY,
+    GL_LOADING_BULK
+} gl_loading;
+
+typedef enum gl_errors {
+    GL_ERRORS_DEFAULT,
+    GL_ERRORS_DEBUG,
+    GL_ERRORS_NONE
+} gl_errors;
+
+#define DEBUG_MESSAGE_LENGTH 512
+
+/**
+ * Message from the driver's debug output. The source, type and severity are
+ * the GL_DEBUG_SOURCE_*, GL_DEBUG_TYPE_* and GL_DEBUG_SEVERITY_* values. The
+ * time is when the driver reported it, on the clock used by get_time(), and
+ * text longer than the buffer is truncated.
+ */
+typedef struct debug_message {
+    unsigned source;
+    unsigned type;
+    unsigned id;
+    unsigned severity;
+    uint64_t time;
+    char text[DEBUG_MESSAGE_LENGTH];
+} debug_message;
+
+/**
+ * Receives a debug message on the thread that drains the window's debug
+ * output, never on the thread that made the failing call.
+ * 
+ * \param[in] message Message.
+ * \param[in] user_data User data given in the window settings.
+ */
+typedef void (*debug_callback)(const debug_message* message, void* user_data);
+
+typedef struct framebuffer_settings {
+    int samples;
+    int depth_bits;
+    int stencil_bits;
+    bool srgb;
+    bool alpha;
+} framebuffer_settings;
+
+/**
+ * Receives a captured frame. The pixels are tightly packed BGRA rows, bottom
+ * row first, and are only valid until the callback returns.
+ * 
+ * \param[in] pixels Mapped pixel data.
+ * \param[in] width Frame width.
+ * \param[in] height Frame height.
+ * \param[in] frame Index of the captured frame.
+ * \param[in] user_data User data given to create_readback().
+ */
+typedef void (*readback_callback)(const void* pixels, unsigned width,
+    unsigned height, uint64_t frame, void* user_data);
+
+typedef enum present_timing_source {
+    PRESENT_TIMING_SYNC_CONTROL,
+    PRESENT_TIMING_SWAP_EVENT,
+    PRESENT_TIMING_SOFTWARE,
+    PRESENT_TIMING_PRESENT_EVENT
+} present_timing_source;
+
+typedef enum present_mode {
+    PRESENT_MODE_SWAP,
+    PRESENT_MODE_FIFO,
+    PRESENT_MODE_MAILBOX,
+    PRESENT_MODE_IMMEDIATE
+} present_mode;
+
+/**
+ * When a frame reached the screen. The time is in nanoseconds on the clock
+ * used by get_time(), the media stream counter counts vertical blanks and the
+ * swap buffer counter counts presented frames.
+ */
+typedef struct present_timing {
+    uint64_t time;
+    uint64_t msc;
+    uint64_t sbc;
+} present_timing;
+
+typedef struct rect {
+    int x, y;
+    unsigned width, height;
+} rect;
+
+/**
+ * CPU framebuffer of a software window. Pixels are 32-bit 0xAARRGGBB values
+ * with the top row first and rows stride bytes apart. Shared is set when
+ * presents go through MIT-SHM rather than being copied to the server.
+ */
+typedef struct software_framebuffer {
+    uint32_t* pixels;
+    unsigned width, height;
+    size_t stride;
+    bool shared;
+} software_framebuffer;
+
+typedef enum window_event_type {
+    WINDOW_EVENT_KEY_PRESS,
+    WINDOW_EVENT_KEY_RELEASE,
+    WINDOW_EVENT_BUTTON_PRESS,
+    WINDOW_EVENT_BUTTON_RELEASE,
+    WINDOW_EVENT_MOTION,
+    WINDOW_EVENT_RESIZE,
+    WINDOW_EVENT_FOCUS_IN,
+    WINDOW_EVENT_FOCUS_OUT,
+    WINDOW_EVENT_EXPOSE
+} window_event_type;
+
+/**
+ * Input or window state change. Times are the display server's timestamps in
+ * milliseconds. Key codes are platform scan codes and key symbols are X
+ * keysyms or Win32 virtual keys. Modifiers are the platform's modifier and
+ * button state at the time of the event.
+ */
+typedef struct window_event {
+    window_event_type type;
+    uint32_t time;
+    union {
+        struct {
+            unsigned code;
+            unsigned symbol;
+            unsigned modifiers;
+        } key;
+        struct {
+            unsigned button;
+            int x, y;
+            unsigned modifiers;
+        } button;
+        struct {
+            int x, y;
+            unsigned modifiers;
+        } motion;
+        struct {
+            unsigned width, height;
+        } resize;
+        struct {
+            int x, y;
+            unsigned width, height;
+        } expose;
+    };
+} window_event;
+
+/**
+ * Settings for create_window_with_settings().
+ */
+typedef struct window_settings {
+    const char* title;
+    unsigned width, height;
+
+    /**
+     * Window whose context the new window's context shares objects with. It
+     * must have the same backend.
+     */
+    window* share;
+
+    /**
+     * Minimum framebuffer; the cheapest framebuffer that meets it is used.
+     */
+    framebuffer_settings framebuffer;
+
+    /**
+     * Headless windows render into an offscreen framebuffer and need no
+     * display server. Software windows have no context and present a CPU
+     * framebuffer instead, so they work without an OpenGL driver. When built
+     * with OPENGL_CONTEXT_WAYLAND, native windows are created on the Wayland
+     * compositor if WAYLAND_DISPLAY is set, unless OPENGL_CONTEXT_PLATFORM is
+     * x11, and fall back to X11 if the compositor cannot be reached, unless
+     * it is wayland; their swaps are paced by frame callbacks.
+     */
+    window_backend backend;
+
+    /**
+     * Takes part in the _NET_WM_SYNC_REQUEST protocol where the display
+     * server supports it, so during an interactive resize the compositor
+     * waits for each frame at the new size instead of sending configures
+     * faster than they can be drawn. Has no effect on Wayland.
+     */
+    bool sync_resize;
+
+    /**
+     * Modes other than PRESENT_MODE_SWAP render into a pool of pixmaps
+     * presented through the X Present extension, when built with
+     * OPENGL_CONTEXT_PRESENT: FIFO shows every frame at its own vertical
+     * blank, mailbox replaces a queued frame with a newer one, and immediate
+     * presents without waiting and may tear. Elsewhere, Wayland included,
+     * they fall back to buffer swaps.
+     */
+    present_mode present_mode;
+
+    /**
+     * Unless GL_LOADING_NONE, the window gets its own OpenGL dispatch table,
+     * resolved up front or on first use.
+     */
+    gl_loading loading;
+
+    /**
+     * GL_ERRORS_DEBUG requests a debug context and routes its debug output to
+     * the debug callback, or to stderr without one. GL_ERRORS_NONE requests a
+     * KHR_no_error context, where errors are undefined behavior instead of
+     * being checked; it can only share with other no-error contexts.
+     */
+    gl_errors errors;
+
+    debug_callback debug_callback;
+    void* debug_user_data;
+} window_settings;
+
 /**
  * Creates a window.
  * 
@@ -22,6 +256,14 @@ typedef struct window window;
  */
 window* create_window(const char* title, unsigned width, unsigned height);
 
+/**
+ * Creates a window. What each setting does is described on window_settings.
+ * 
+ * \param[in] settings Window settings.
+ * \return New window.
+ */
+window* create_window_with_settings(const window_settings* settings);
+
 /**
  * Destroys a window.
  * 
@@ -30,13 +272,79 @@ window* create_window(const char* title, unsigned width, unsigned height);
 void destroy_window(window* window);
 
 /**
- * Polls events sent to the window.
+ * Gets the version of the window's context.
+ * 
+ * \param[in] window Window.
+ * \return Context version.
+ */
+version get_context_version(const window* window);
+
+/**
+ * Makes the window's context current on the calling thread.
+ * 
+ * \param[in] window Window.
+ * \return Whether the context was made current.
+ */
+bool make_current(window* window);
+
+/**
+ * Releases the window's context from the calling thread so another thread can
+ * make it current.
+ * 
+ * \param[in] window Window.
+ */
+void release_current(window* window);
+
+/**
+ * Polls events sent to the window. Pending events for other windows on the
+ * same connection are dispatched to them in the same pass, so windows can be
+ * polled on different threads.
  * 
  * \param[in] window Window.
  * \return Whether the application should close.
  */
 bool poll_events(window* window);
 
+/**
+ * Moves the events decoded by poll_events() and wait_events() into an array,
+ * oldest first. Consecutive motion and resize events are coalesced into the
+ * latest one. Events that do not fit stay queued for the next call.
+ * 
+ * \param[in] window Window.
+ * \param[out] events Array to fill.
+ * \param[in] capacity Size of the array.
+ * \return Number of events written.
+ */
+size_t get_window_events(window* window, window_event* events,
+    size_t capacity);
+
+/**
+ * Gets the number of events dropped because the window's event queue was
+ * full. Motion events are given up first and releases are kept.
+ * 
+ * \param[in] window Window.
+ * \return Dropped event count.
+ */
+uint64_t get_dropped_window_events(window* window);
+
+/**
+ * Waits for events sent to the window, then polls them. Returns early if
+ * another thread wakes the window.
+ * 
+ * \param[in] window Window.
+ * \param[in] timeout Milliseconds to wait, or a negative value to wait
+ * indefinitely.
+ * \return Whether the application should close.
+ */
+bool wait_events(window* window, int timeout);
+
+/**
+ * Wakes a window that is waiting for events. Can be called from any thread.
+ * 
+ * \param[in] window Window.
+ */
+void wake_window(window* window);
+
 /**
  * Swaps buffers.
  * 
@@ -44,4 +352,255 @@ bool poll_events(window* window);
  */
 void swap_buffer(window* window);
 
+/**
+ * Gets the size of the window's framebuffer as of the last poll. This changes
+ * when a resize event is decoded.
+ * 
+ * \param[in] window Window.
+ * \param[out] width Framebuffer width.
+ * \param[out] height Framebuffer height.
+ */
+void get_framebuffer_size(const window* window, unsigned* width,
+    unsigned* height);
+
+/**
+ * Gets the age of the back buffer: one if it holds the last presented frame,
+ * n if it holds the frame presented n frames ago, or zero if its contents are
+ * undefined.
+ * 
+ * \param[in] window Window.
+ * \return Buffer age.
+ */
+unsigned get_buffer_age(window* window);
+
+/**
+ * Gets the region of the back buffer to redraw before presenting new damage.
+ * This is the new damage plus whatever the back buffer missed while older
+ * frames were presented, or the whole framebuffer if its contents are
+ * unknown. Rectangles use OpenGL window coordinates, with the origin at the
+ * bottom left, and can be passed to glScissor().
+ * 
+ * \param[in] window Window.
+ * \param[in] damage Rectangles that change in the next frame.
+ * \param[in] count Number of rectangles.
+ * \return Bounding rectangle of the region to redraw.
+ */
+rect get_repaint_region(window* window, const rect* damage, size_t count);
+
+/**
+ * Presents a frame that only changed inside the given rectangles, using a
+ * partial present where the platform supports one. Partial presents are not
+ * synchronized to the vertical blank. A null damage list means the whole
+ * window changed.
+ * 
+ * \param[in] window Window.
+ * \param[in] damage Rectangles that changed, in OpenGL window coordinates.
+ * \param[in] count Number of rectangles.
+ */
+void swap_buffer_with_damage(window* window, const rect* damage,
+    size_t count);
+
+/**
+ * Gets where the window's present timing comes from: GLX_OML_sync_control,
+ * GLX_INTEL_swap_event, completion events from the X Present extension, or a
+ * software model of a display at the default refresh rate anchored to the
+ * first present.
+ * 
+ * \param[in] window Window.
+ * \return Present timing source.
+ */
+present_timing_source get_present_timing_source(const window* window);
+
+/**
+ * Gets the timing of the most recently completed present. With
+ * GLX_OML_sync_control the counters are sampled when this is called, so the
+ * time is that of the vertical blank at or just after the present.
+ * 
+ * \param[in] window Window.
+ * \param[out] timing Present timing.
+ * \return Whether any frame has been presented yet.
+ */
+bool get_present_timing(window* window, present_timing* timing);
+
+/**
+ * Predicts the next vertical blank, for scheduling a frame's work to finish
+ * just before it.
+ * 
+ * \param[in] window Window.
+ * \param[out] msc Media stream counter at that vertical blank, or null.
+ * \return Time of the vertical blank in nanoseconds on the clock used by
+ * get_time().
+ */
+uint64_t predict_next_vblank(window* window, uint64_t* msc);
+
+/**
+ * Gets the refresh period, as reported by the driver or measured from present
+ * timings.
+ * 
+ * \param[in] window Window.
+ * \return Refresh period in nanoseconds.
+ */
+uint64_t get_refresh_period(const window* window);
+
+/**
+ * Gets the framebuffer object that stands in for the default framebuffer. This
+ * is zero for native windows and the offscreen framebuffer for headless ones.
+ * 
+ * \param[in] window Window.
+ * \return Framebuffer object name.
+ */
+unsigned get_default_framebuffer(const window* window);
+
+/**
+ * Gets the window's OpenGL dispatch table, declared in gl_loader.h.
+ * 
+ * \param[in] window Window.
+ * \return Dispatch table, or null if the window was created without one.
+ */
+const gl_dispatch* get_gl_dispatch(const window* window);
+
+/**
+ * Gets the number of debug messages dropped because the debug output queue
+ * was full when the driver reported them.
+ * 
+ * \param[in] window Window.
+ * \return Dropped message count, or zero without debug output.
+ */
+uint64_t get_dropped_debug_messages(const window* window);
+
+/**
+ * Gets the address of an OpenGL procedure.
+ * 
+ * \param[in] window Window.
+ * \param[in] name Procedure name.
+ * \return Procedure address, or null if it is not available.
+ */
+procedure get_procedure_address(const window* window, const char* name);
+
+/**
+ * Gets the CPU framebuffer to draw the next frame of a software window into.
+ * It follows the window's size as of the last poll and is presented by
+ * swap_buffer() or swap_buffer_with_damage(), whose rectangles keep their
+ * bottom left origin. Presents do not copy the framebuffer, so this waits
+ * until the display server has finished reading it; get_buffer_age() says
+ * which frame it still holds.
+ * 
+ * \param[in] window Window.
+ * \param[out] framebuffer Framebuffer.
+ * \return Whether the window has a software framebuffer.
+ */
+bool map_software_framebuffer(window* window,
+    software_framebuffer* framebuffer);
+
+/**
+ * Waits until the display server has processed every frame presented on a
+ * software window, with a round trip to the server.
+ * 
+ * \param[in] window Window.
+ * \return Whether the window is a software window.
+ */
+bool finish_software_presents(window* window);
+
+/**
+ * Sets the number of vertical blanks to wait for before a buffer swap. Zero
+ * disables vsync and a negative value requests adaptive vsync.
+ * 
+ * \param[in] window Window.
+ * \param[in] interval Swap interval.
+ * \return Whether the swap interval was set.
+ */
+bool set_swap_interval(window* window, int interval);
+
+/**
+ * Creates a readback ring for a window. The window's context must be current
+ * and support OpenGL 3.2 or ARB_sync.
+ * 
+ * \param[in] window Window.
+ * \param[in] width Capture width.
+ * \param[in] height Capture height.
+ * \param[in] depth Number of frames in flight, at least two.
+ * \param[in] callback Called with each captured frame.
+ * \param[in] user_data User data passed to the callback.
+ * \return New readback ring.
+ */
+readback* create_readback(window* window, unsigned width, unsigned height,
+    unsigned depth, readback_callback callback, void* user_data);
+
+/**
+ * Delivers every frame still in flight, then destroys a readback ring.
+ * 
+ * \param[in] readback Readback ring.
+ */
+void destroy_readback(readback* readback);
+
+/**
+ * Queues a copy of the window's default framebuffer into the next pixel
+ * buffer and delivers every earlier frame whose copy has finished. Only
+ * blocks when the ring is full. Call after rendering and before swapping.
+ * Leaves the pixel pack buffer unbound and the window's default framebuffer
+ * bound for reading.
+ * 
+ * \param[in] readback Readback ring.
+ */
+void capture_frame(readback* readback);
+
+/**
+ * Creates a pool of contexts that share objects with the window's context, so
+ * worker threads can upload textures and buffers without stalling the thread
+ * that renders. Each context has the window's version and error mode and
+ * renders into a 1x1 pbuffer or no surface at all. Must be called from the
+ * thread that created the window, and needs OpenGL 3.2 or ARB_sync.
+ * 
+ * \param[in] window Window.
+ * \param[in] count Number of contexts.
+ * \return New context pool.
+ */
+context_pool* create_context_pool(window* window, unsigned count);
+
+/**
+ * Destroys a context pool. Every context must have been released.
+ * 
+ * \param[in] pool Context pool.
+ */
+void destroy_context_pool(context_pool* pool);
+
+/**
+ * Takes a context from the pool and makes it current on the calling thread,
+ * waiting for another thread to release one if none are free.
+ * 
+ * \param[in] pool Context pool.
+ * \return Pooled context, or null if it could not be made current.
+ */
+pooled_context* acquire_pooled_context(context_pool* pool);
+
+/**
+ * Fences the commands issued on a pooled context, flushes them so the fence
+ * is visible to other contexts, then releases the context back to the pool.
+ * 
+ * \param[in] pool Context pool.
+ * \param[in] context Pooled context current on the calling thread.
+ * \return Fence signalled when the uploads are complete.
+ */
+upload_fence* release_pooled_context(context_pool* pool,
+    pooled_context* context);
+
+/**
+ * Checks without blocking whether the uploads behind a fence are complete.
+ * 
+ * \param[in] pool Context pool.
+ * \param[in] fence Upload fence.
+ * \return Whether the uploads are complete.
+ */
+bool is_upload_complete(context_pool* pool, upload_fence* fence);
+
+/**
+ * Makes the GPU wait for the uploads behind a fence before running later
+ * commands from the current context, then destroys the fence. Does not block
+ * the calling thread. Call before the first use of the uploaded objects.
+ * 
+ * \param[in] pool Context pool.
+ * \param[in] fence Upload fence.
+ */
+void wait_for_upload(context_pool* pool, upload_fence* fence);
+
 #endif
@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+"""
+Generates src/gl_functions.h, the list of OpenGL core profile functions the
+loader resolves, from the Khronos XML registry (gl.xml) or, when the registry
+is not at hand, from the glcorearb.h header generated from it.
+
+Usage:
+    generate_gl_functions.py --registry gl.xml [--version 4.6] [-o FILE]
+    generate_gl_functions.py --header glcorearb.h [--version 4.6] [-o FILE]
+"""
+
+import argparse
+import re
+import sys
+import xml.etree.ElementTree as ElementTree
+
+HEADER = """/**
+ * \\file gl_functions.h
+ * \\author Isaiah Lateer
+ * 
+ * OpenGL {version} core profile functions, generated by
+ * tools/generate_gl_functions.py from {source}. Do not edit.
+ * 
+ * Define GL_FUNCTION(type, name, parameters, arguments) and
+ * GL_VOID_FUNCTION(name, parameters, arguments) before including.
+ */
+
+"""
+
+
+def parse_version(text):
+    major, minor = text.split(".")
+    return int(major), int(minor)
+
+
+def argument_list(names):
+    return "(" + ", ".join(names) + ")"
+
+
+def read_registry(path, version):
+    """Returns (type, name, parameters, arguments) for each core command."""
+    root = ElementTree.parse(path).getroot()
+
+    commands = {}
+    for command in root.find("commands").findall("command"):
+        proto = command.find("proto")
+        name = proto.find("name").text
+        type_text = "".join(proto.itertext())
+        type_text = type_text[:type_text.rfind(name)].strip()
+
+        parameters = []
+        arguments = []
+        for parameter in command.findall("param"):
+            parameters.append(" ".join("".join(parameter.itertext()).split()))
+            arguments.append(parameter.find("name").text)
+
+        commands[name] = (type_text, name,
+            "(" + (", ".join(parameters) or "void") + ")",
+            argument_list(arguments))
+
+    order = []
+    removed = set()
+    for feature in root.findall("feature"):
+        if feature.get("api") != "gl":
+            continue
+
+        if parse_version(feature.get("number")) > version:
+            continue
+
+        for require in feature.findall("require"):
+            if require.get("profile") not in (None, "core"):
+                continue
+
+            for command in require.findall("command"):
+                if command.get("name") not in order:
+                    order.append(command.get("name"))
+
+        for remove in feature.findall("remove"):
+            if remove.get("profile") not in (None, "core"):
+                continue
+
+            for command in remove.findall("command"):
+                removed.add(command.get("name"))
+
+    return [commands[name] for name in order if name not in removed]
+
+
+def read_header(path, version):
+    """Returns (type, name, parameters, arguments) for each prototype in the
+    version sections of glcorearb.h."""
+    section = re.compile(r"^#ifndef GL_VERSION_(\d+)_(\d+)$")
+    prototype = re.compile(r"^GLAPI\s+(.+?)\s*APIENTRY\s+(\w+)\s*\((.*)\);$")
+    functions = []
+    current = None
+
+    with open(path) as header:
+        for line in header:
+            line = line.strip()
+
+            match = section.match(line)
+            if match:
+                current = (int(match.group(1)), int(match.group(2)))
+                continue
+
+            # Extension sections follow the version sections.
+            if line.startswith("#ifndef GL_"):
+                current = None
+                continue
+
+            match = prototype.match(line)
+            if not match or not current or current > version:
+                continue
+
+            type_text, name, parameters = match.groups()
+            arguments = []
+            if parameters.strip() != "void":
+                for parameter in parameters.split(","):
+                    parameter = re.sub(r"\[.*?\]", "", parameter).strip()
+                    arguments.append(re.search(r"(\w+)$", parameter).group(1))
+
+            functions.append((type_text, name, "(" + parameters + ")",
+                argument_list(arguments)))
+
+    return functions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().split("\n")[0])
+    source = parser.add_mutually_exclusive_group(required=True)
+    source.add_argument("--registry", help="path to gl.xml")
+    source.add_argument("--header", help="path to glcorearb.h")
+    parser.add_argument("--version", default="4.6",
+        help="highest OpenGL version to include")
+    parser.add_argument("-o", "--output", default="src/gl_functions.h",
+        help="output file")
+    options = parser.parse_args()
+
+    version = parse_version(options.version)
+    if options.registry:
+        functions = read_registry(options.registry, version)
+        source_name = "gl.xml"
+    else:
+        functions = read_header(options.header, version)
+        source_name = "glcorearb.h"
+
+    if not functions:
+        sys.exit("No functions found.")
+
+    with open(options.output, "w", newline="\n") as output:
+        output.write(HEADER.format(version=options.version,
+            source=source_name))
+
+        for type_text, name, parameters, arguments in functions:
+            if type_text == "void":
+                output.write("GL_VOID_FUNCTION({}, {}, {})\n".format(name,
+                    parameters, arguments))
+            else:
+                output.write("GL_FUNCTION({}, {}, {}, {})\n".format(type_text,
+                    name, parameters, arguments))
+
+    print("Wrote {} functions to {}.".format(len(functions), options.output))
+
+
+if __name__ == "__main__":
+    main()